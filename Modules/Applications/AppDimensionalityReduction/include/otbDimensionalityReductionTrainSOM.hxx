@@ -63,6 +63,16 @@ void TrainDimensionalityReductionApplicationBase<TInputValue, TOutputValue>::Ini
   SetParameterDescription("algorithm.som.iv", "Maximum initial neuron weight");
   MandatoryOff("algorithm.som.iv");
 
+  AddParameter(ParameterType_Bool, "algorithm.som.batch", "Batch training");
+  SetParameterDescription("algorithm.som.batch",
+                          "Update the map once per batch of samples, from the winners of the whole batch searched in parallel, "
+                          "instead of once per sample");
+
+  AddParameter(ParameterType_Int, "algorithm.som.bs", "BatchSize");
+  SetParameterDescription("algorithm.som.bs", "Number of samples per update in batch mode (0 means all the samples)");
+  MandatoryOff("algorithm.som.bs");
+  SetMinimumParameterIntValue("algorithm.som.bs", 0);
+
   std::vector<std::string> size(2, std::string("10"));
   std::vector<std::string> radius(2, std::string("3"));
   SetParameterStringList("algorithm.som.s", size, false);
@@ -74,6 +84,7 @@ void TrainDimensionalityReductionApplicationBase<TInputValue, TOutputValue>::Ini
   SetDefaultParameterFloat("algorithm.som.bi", 1.0);
   SetDefaultParameterFloat("algorithm.som.bf", 0.1);
   SetDefaultParameterFloat("algorithm.som.iv", 10.0);
+  SetDefaultParameterInt("algorithm.som.bs", 0);
 }
 
 template <class TInputValue, class TOutputValue>
@@ -123,6 +134,8 @@ void TrainDimensionalityReductionApplicationBase<TInputValue, TOutputValue>::Tra
   dimredTrainer->SetWriteMap(true);
   dimredTrainer->SetBetaEnd(GetParameterFloat("algorithm.som.bf"));
   dimredTrainer->SetMaxWeight(GetParameterFloat("algorithm.som.iv"));
+  dimredTrainer->SetBatchMode(GetParameterInt("algorithm.som.batch"));
+  dimredTrainer->SetBatchSize(GetParameterInt("algorithm.som.bs"));
   typename TSOM::SizeType  size;
   std::vector<std::string> s = GetParameterStringList("algorithm.som.s");
   for (unsigned int i = 0; i < s.size(); i++)
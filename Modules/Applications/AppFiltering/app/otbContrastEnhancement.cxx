@@ -32,6 +32,8 @@
 #include "otbComputeHistoFilter.h"
 #include "otbComputeGainLutFilter.h"
 #include "otbApplyGainFilter.h"
+#include "otbApplyGainVectorImageFilter.h"
+#include "otbStreamingLocalHistogramVectorImageFilter.h"
 #include "otbImageFileWriter.h"
 #include "itkImageRegionIterator.h"
 #include <string>
@@ -122,6 +124,10 @@ public:
 
   typedef otb::StreamingHistogramVectorImageFilter<FloatVectorImageType> HistoPersistentFilterType;
 
+  typedef otb::StreamingLocalHistogramVectorImageFilter<FloatVectorImageType, HistogramType> LocalHistoFilterType;
+
+  typedef otb::ApplyGainVectorImageFilter<FloatVectorImageType, LutType, FloatVectorImageType> ApplyVectorFilterType;
+
   /** Standard macro */
   itkNewMacro(Self);
 
@@ -333,24 +339,23 @@ private:
     WarningGlobalOrNot(inImage);
     WarningMinMax();
     LogInfo();
-    ImageListType::Pointer outputImageList(ImageListType::New());
-    m_VectorToImageListFilter = VectorToImageListFilterType::New();
-    m_VectorToImageListFilter->SetInput(inImage);
-    m_VectorToImageListFilter->UpdateOutputInformation();
-    ImageListType::Pointer inputImageList = m_VectorToImageListFilter->GetOutput();
-    unsigned int           nbChannel      = inImage->GetVectorLength();
+    unsigned int nbChannel = inImage->GetVectorLength();
 
     if (m_EqMode == "each")
     {
-      // Each channel will be equalized
+      // Each channel will be equalized, all of them in the same pass
       m_GainLutFilter.resize(nbChannel);
-      m_ApplyFilter.resize(nbChannel);
-      m_BufferFilter.resize(nbChannel);
-      m_StreamingFilter.resize(nbChannel);
-      PerBandEqualization(inImage, inputImageList, nbChannel, outputImageList);
+      PerBandEqualization(inImage, nbChannel);
+      SetParameterOutputImage("out", m_ApplyVectorFilter->GetOutput());
     }
     else if (m_EqMode == "lum")
     {
+      ImageListType::Pointer outputImageList(ImageListType::New());
+      m_VectorToImageListFilter = VectorToImageListFilterType::New();
+      m_VectorToImageListFilter->SetInput(inImage);
+      m_VectorToImageListFilter->UpdateOutputInformation();
+      ImageListType::Pointer inputImageList = m_VectorToImageListFilter->GetOutput();
+
       std::vector<unsigned int> rgb(3, 0);
       rgb[0] = GetParameterInt("mode.lum.red.ch");
       rgb[1] = GetParameterInt("mode.lum.green.ch");
@@ -364,11 +369,11 @@ private:
       }
       ComputeLuminance(inImage, rgb);
       LuminanceEqualization(inputImageList, rgb, outputImageList);
-    }
 
-    m_ImageListToVectorFilterOut = ImageListToVectorFilterType::New();
-    m_ImageListToVectorFilterOut->SetInput(outputImageList);
-    SetParameterOutputImage("out", m_ImageListToVectorFilterOut->GetOutput());
+      m_ImageListToVectorFilterOut = ImageListToVectorFilterType::New();
+      m_ImageListToVectorFilterOut->SetInput(outputImageList);
+      SetParameterOutputImage("out", m_ImageListToVectorFilterOut->GetOutput());
+    }
   }
 
   // Look for default values in the image metadata
@@ -568,24 +573,10 @@ private:
     otbAppLogINFO(<< oss.str());
   }
 
-  // Prepare the first half of the pipe that is common to every methode of
-  // equalization
-  void SetUpPipeline(unsigned int channel, const FloatImageType::Pointer input)
-  {
-    m_GainLutFilter[channel]   = GainLutFilterType::New();
-    m_ApplyFilter[channel]     = ApplyFilterType::New();
-    m_StreamingFilter[channel] = StreamingImageFilterType::New();
-    m_BufferFilter[channel]    = BufferFilterType::New();
-    m_BufferFilter[channel]->SetInput(input);
-    m_GainLutFilter[channel]->SetInput(m_Histogram[channel]);
-    m_StreamingFilter[channel]->SetInput(m_GainLutFilter[channel]->GetOutput());
-    m_ApplyFilter[channel]->SetInputImage(m_BufferFilter[channel]->GetOutput());
-    m_ApplyFilter[channel]->SetInputLut(m_StreamingFilter[channel]->GetOutput());
-  }
-
-  // Function corresponding to the "each" mode
-  void PerBandEqualization(const FloatVectorImageType::Pointer inImage, const ImageListType::Pointer inputImageList, const unsigned int nbChannel,
-                           ImageListType::Pointer outputImageList)
+  // Function corresponding to the "each" mode: the histograms of all the
+  // channels are computed in one pass, and the gains of all the channels are
+  // applied in one pass
+  void PerBandEqualization(const FloatVectorImageType::Pointer inImage, const unsigned int nbChannel)
   {
     FloatVectorImageType::PixelType min(nbChannel), max(nbChannel);
     min.Fill(0);
@@ -595,43 +586,65 @@ private:
     if (m_SpatialMode == "global")
       PersistentComputation(inImage, nbChannel, max, min);
     else
-    {
-      float thresh(-1);
-      if (HasValue("hfact"))
-      {
-        thresh = GetParameterInt("hfact");
-      }
+      LocalComputation(inImage, max, min);
 
-      m_HistoFilter.resize(nbChannel);
-      m_Histogram.resize(nbChannel);
-      for (unsigned int channel = 0; channel < nbChannel; channel++)
-      {
-        m_HistoFilter[channel] = HistoFilterType::New();
-        m_HistoFilter[channel]->SetInput(inputImageList->GetNthElement(channel));
-        SetHistoFilterParameter(m_HistoFilter[channel], min[channel], max[channel], GetParameterInt("bins"), thresh);
-        m_Histogram[channel] = m_HistoFilter[channel]->GetHistoOutput();
-      }
+    m_ApplyVectorFilter = ApplyVectorFilterType::New();
+    m_ApplyVectorFilter->SetInputImage(inImage);
+    m_ApplyVectorFilter->SetMin(min);
+    m_ApplyVectorFilter->SetMax(max);
+    if (IsParameterEnabled("nodata"))
+    {
+      m_ApplyVectorFilter->SetNoData(GetParameterFloat("nodata"));
+      m_ApplyVectorFilter->SetNoDataFlag(true);
     }
 
     for (unsigned int channel = 0; channel < nbChannel; channel++)
     {
-      SetUpPipeline(channel, inputImageList->GetNthElement(channel));
-
+      // Constant channels have no look up table and are copied
       if (min[channel] == max[channel])
       {
         std::ostringstream oss;
         oss << "Channel " << channel << " is constant : "
             << "min = " << min[channel] << " and max = " << max[channel];
         otbAppLogINFO(<< oss.str());
-        m_BufferFilter[channel]->SetInput(inputImageList->GetNthElement(channel));
-        outputImageList->PushBack(m_BufferFilter[channel]->GetOutput());
         continue;
       }
 
+      m_GainLutFilter[channel] = GainLutFilterType::New();
+      m_GainLutFilter[channel]->SetInput(m_Histogram[channel]);
       SetGainLutFilterParameter(m_GainLutFilter[channel], min[channel], max[channel]);
-      SetApplyFilterParameter(m_ApplyFilter[channel], min[channel], max[channel]);
+      m_ApplyVectorFilter->SetInputLut(channel, m_GainLutFilter[channel]->GetOutput());
+    }
+  }
 
-      outputImageList->PushBack(m_ApplyFilter[channel]->GetOutput());
+  // Compute the local histograms of every channel with LocalHistoFilterType
+  void LocalComputation(const FloatVectorImageType::Pointer inImage, const FloatVectorImageType::PixelType& max, const FloatVectorImageType::PixelType& min)
+  {
+    float thresh(-1);
+    if (HasValue("hfact"))
+    {
+      thresh = GetParameterInt("hfact");
+    }
+
+    m_LocalHistoFilter = LocalHistoFilterType::New();
+    m_LocalHistoFilter->SetInput(inImage);
+    m_LocalHistoFilter->GetFilter()->SetMin(min);
+    m_LocalHistoFilter->GetFilter()->SetMax(max);
+    m_LocalHistoFilter->GetFilter()->SetNbBin(GetParameterInt("bins"));
+    m_LocalHistoFilter->GetFilter()->SetThumbSize(m_ThumbSize);
+    m_LocalHistoFilter->GetFilter()->SetThreshold(thresh);
+    if (IsParameterEnabled("nodata"))
+    {
+      m_LocalHistoFilter->GetFilter()->SetNoData(GetParameterFloat("nodata"));
+      m_LocalHistoFilter->GetFilter()->SetNoDataFlag(true);
+    }
+    AddProcess(m_LocalHistoFilter->GetStreamer(), "Computing histograms");
+    m_LocalHistoFilter->Update();
+
+    m_Histogram.resize(m_LocalHistoFilter->GetNumberOfHistograms());
+    for (unsigned int channel = 0; channel < m_Histogram.size(); channel++)
+    {
+      m_Histogram[channel] = m_LocalHistoFilter->GetHistogramOutput(channel);
     }
   }
 
@@ -875,6 +888,8 @@ private:
   std::vector<ApplyFilterType::Pointer>          m_ApplyFilter;
   std::vector<StreamingImageFilterType::Pointer> m_StreamingFilter;
   std::vector<BufferFilterType::Pointer>         m_BufferFilter;
+  LocalHistoFilterType::Pointer                  m_LocalHistoFilter;
+  ApplyVectorFilterType::Pointer                 m_ApplyVectorFilter;
 };
 
 
@@ -33,6 +33,7 @@
 
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
 #include "otbStreamingShrinkImageFilter.h"
+#include "otbStreamingQuantilesVectorImageFilter.h"
 #include "itkListSample.h"
 #include "otbListSampleToHistogramListGenerator.h"
 
@@ -202,6 +203,7 @@ public:
   typedef RAMDrivenAdaptativeStreamingManager<FloatVectorImageType> RAMDrivenAdaptativeStreamingManagerType;
   typedef otb::StreamingShrinkImageFilter<FloatVectorImageType, FloatVectorImageType> ImageSamplingFilterType;
   typedef itk::Statistics::DenseFrequencyContainer2 DFContainerType;
+  typedef otb::StreamingQuantilesVectorImageFilter<FloatVectorImageType> QuantilesFilterType;
 
   typedef itk::NumericTraits<PixelType>::RealType   RealScalarType;
   typedef itk::VariableLengthVector<RealScalarType> InternalPixelType;
@@ -373,6 +375,10 @@ private:
     SetParameterInt("method.image.up", 2);
     SetMinimumParameterIntValue("method.image.up", 0);
     SetMaximumParameterIntValue("method.image.up", 100);
+    AddParameter(ParameterType_Bool, "method.image.fullres", "Full resolution quantiles");
+    SetParameterDescription("method.image.fullres",
+                            "Estimate the quantiles on the whole support image at full resolution, in a single "
+                            "streamed pass, instead of the histogram of a shrunk support image");
 
     AddRAMParameter();
 
@@ -484,89 +490,101 @@ private:
       FloatVectorImageType::Pointer supportImage = this->GetParameterImage("method.image.in");
       // supportImage->UpdateOutputInformation();
 
-      // normalisation
-      // first of all resampling
-
-      // calculate split number
-      RAMDrivenAdaptativeStreamingManagerType::Pointer streamingManager = RAMDrivenAdaptativeStreamingManagerType::New();
-      int                                              availableRAM     = GetParameterInt("ram");
-      streamingManager->SetAvailableRAMInMB(availableRAM);
-      float bias = 2.0; // empiric value;
-      streamingManager->SetBias(bias);
-      FloatVectorImageType::RegionType largestRegion     = supportImage->GetLargestPossibleRegion();
-      FloatVectorImageType::SizeType   largestRegionSize = largestRegion.GetSize();
-      streamingManager->PrepareStreaming(supportImage, largestRegion);
-
-      unsigned long nbDivisions  = streamingManager->GetNumberOfSplits();
-      unsigned long largestPixNb = largestRegionSize[0] * largestRegionSize[1];
-
-      unsigned long maxPixNb = largestPixNb / nbDivisions;
+      ImageMetadataInterfaceType::Pointer metadataInterface = ImageMetadataInterfaceFactory::CreateIMI(supportImage->GetMetaDataDictionary());
 
-      ImageSamplingFilterType::Pointer imageSampler = ImageSamplingFilterType::New();
-      imageSampler->SetInput(supportImage);
+      std::vector<unsigned int> RGBIndex;
 
-      double theoricNBSamplesForKMeans = maxPixNb;
+      if (supportImage->GetNumberOfComponentsPerPixel() < 3)
+      {
+        RGBIndex.push_back(0);
+        RGBIndex.push_back(0);
+        RGBIndex.push_back(0);
+      }
+      else
+        RGBIndex = metadataInterface->GetDefaultDisplay();
+      otbAppLogINFO(" RGB index are " << RGBIndex[0] << " " << RGBIndex[1] << " " << RGBIndex[2] << std::endl);
 
-      const double upperThresholdNBSamplesForKMeans = 1000 * 1000;
-      const double actualNBSamplesForKMeans         = std::min(theoricNBSamplesForKMeans, upperThresholdNBSamplesForKMeans);
+      FloatVectorImageType::PixelType minVal;
+      FloatVectorImageType::PixelType maxVal;
+      minVal.SetSize(supportImage->GetNumberOfComponentsPerPixel());
+      maxVal.SetSize(supportImage->GetNumberOfComponentsPerPixel());
 
-      const double shrinkFactor = std::floor(std::sqrt(supportImage->GetLargestPossibleRegion().GetNumberOfPixels() / actualNBSamplesForKMeans));
-      imageSampler->SetShrinkFactor(shrinkFactor);
-      imageSampler->Update();
+      // normalisation
+      if (GetParameterInt("method.image.fullres"))
+      {
+        ComputeFullResolutionSupportQuantiles(supportImage, minVal, maxVal);
+      }
+      else
+      {
+        ComputeShrunkSupportQuantiles(supportImage, minVal, maxVal);
+      }
 
-      otbAppLogINFO(<< imageSampler->GetOutput()->GetLargestPossibleRegion().GetNumberOfPixels()
-                    << ""
-                       " sample will be used to estimate extrema value for outliers rejection."
-                    << std::endl);
+      m_CasterToLabelImage = CasterToLabelImageType::New();
+      m_CasterToLabelImage->SetInput(GetParameterFloatImage("in"));
+      m_CasterToLabelImage->InPlaceOn();
 
-      // use histogram to compute quantile value
-      FloatVectorImageType::Pointer histogramSource;
-      histogramSource = imageSampler->GetOutput();
-      histogramSource->SetRequestedRegion(imageSampler->GetOutput()->GetLargestPossibleRegion());
+      m_CustomMapper = ChangeLabelFilterType::New();
+      m_CustomMapper->SetInput(m_CasterToLabelImage->GetOutput());
+      m_CustomMapper->SetNumberOfComponentsPerPixel(3);
 
-      // Iterate on the image
-      itk::ImageRegionConstIterator<FloatVectorImageType> it(histogramSource, histogramSource->GetBufferedRegion());
+      ReadLutFromFile(true);
 
-      // declare a list to store the samples
-      ListSampleType::Pointer listSample = ListSampleType::New();
-      listSample->Clear();
+      SetParameterOutputImage("out", m_CustomMapper->GetOutput());
+    }
+    else if (GetParameterInt("method") == 1)
+    {
+      otbAppLogINFO("Color mapping with continuous look-up table");
 
-      // unsigned int sampleSize = VisualizationPixelTraits::PixelSize(it.Get());
-      unsigned int sampleSize = itk::NumericTraits<SampleType>::GetLength(it.Get());
+      m_ContinuousColorMapper = ColorMapFilterType::New();
 
-      listSample->SetMeasurementVectorSize(sampleSize);
+      m_ContinuousColorMapper->SetInput(GetParameterFloatImage("in"));
 
-      // Fill the samples list
-      for (it.GoToBegin(); !it.IsAtEnd(); ++it)
-      {
-        SampleType sample(sampleSize);
-        // VisualizationPixelTraits::Convert(it.Get(), sample);
-        listSample->PushBack(it.Get());
-      }
+      // Disable automatic scaling
+      m_ContinuousColorMapper->UseInputImageExtremaForScalingOff();
 
-      // assign listSample
+      // Set the lut
+      std::string lutTmp       = GetParameterString("method.continuous.lut");
+      std::string lutNameParam = "method.continuous.lut." + lutTmp;
+      std::string lut          = GetParameterName(lutNameParam);
 
-      HistogramFilterType::Pointer histogramFilter = HistogramFilterType::New();
-      histogramFilter->SetListSample(listSample);
-      histogramFilter->SetNumberOfBins(255);
+      otbAppLogINFO("LUT: " << lut << std::endl);
 
-      if (this->IsParameterEnabled("method.image.nodatavalue") == true)
+      if (lut == "Relief")
       {
-        // NoData value extraction for the support image
-        float noDataValue = this->GetParameterFloat("method.image.nodatavalue");
-        otbAppLogINFO(" The NoData value: " << noDataValue << " will be rejected from the support image in the LUT estimation." << std::endl);
-        histogramFilter->SetNoDataValue(noDataValue);
-        histogramFilter->NoDataFlagOn();
+        ReliefColorMapFunctorType::Pointer reliefFunctor = ReliefColorMapFunctorType::New();
+        m_ContinuousColorMapper->SetColormap(reliefFunctor);
       }
       else
       {
-        otbAppLogINFO(" The NoData value of the support image is disabled. Thus, all the values will be handled in the LUT estimation." << std::endl);
-        histogramFilter->NoDataFlagOff();
+        m_ContinuousColorMapper->SetColormap((ColorMapFilterType::ColormapEnumType)m_LutMap[lut]);
       }
 
-      // Generate
-      histogramFilter->Update();
-      const HistogramListType* histogramList = histogramFilter->GetOutput();
+
+      m_ContinuousColorMapper->GetColormap()->SetMinimumInputValue(GetParameterFloat("method.continuous.min"));
+      m_ContinuousColorMapper->GetColormap()->SetMaximumInputValue(GetParameterFloat("method.continuous.max"));
+
+      SetParameterOutputImage("out", m_ContinuousColorMapper->GetOutput());
+    }
+    else if (GetParameterInt("method") == 2)
+    {
+      otbAppLogINFO("Color mapping with an optimized look-up table");
+
+      m_CasterToLabelImage = CasterToLabelImageType::New();
+      m_CasterToLabelImage->SetInput(GetParameterFloatImage("in"));
+      m_CasterToLabelImage->InPlaceOn();
+
+      m_SegmentationColorMapper = LabelToRGBFilterType::New();
+      m_SegmentationColorMapper->SetInput(m_CasterToLabelImage->GetOutput());
+      m_SegmentationColorMapper->SetBackgroundValue(GetParameterInt("method.optimal.background"));
+      SetParameterOutputImage("out", m_SegmentationColorMapper->GetOutput());
+    }
+    else if (GetParameterInt("method") == 3)
+    {
+      otbAppLogINFO("Color mapping with a look-up table computed on support image ");
+
+      // image normalisation of the sampling
+      FloatVectorImageType::Pointer supportImage = this->GetParameterImage("method.image.in");
+      // supportImage->UpdateOutputInformation();
 
       ImageMetadataInterfaceType::Pointer metadataInterface = ImageMetadataInterfaceFactory::CreateIMI(supportImage->GetMetaDataDictionary());
 
@@ -590,9 +608,9 @@ private:
       for (unsigned int index = 0; index < supportImage->GetNumberOfComponentsPerPixel(); index++)
       {
         minVal.SetElement(index, static_cast<FloatVectorImageType::PixelType::ValueType>(
-                                     histogramList->GetNthElement(index)->Quantile(0, static_cast<float>(this->GetParameterInt("method.image.low")) / 100.0)));
-        maxVal.SetElement(index, static_cast<FloatVectorImageType::PixelType::ValueType>(histogramList->GetNthElement(index)->Quantile(
-                                     0, (100.0 - static_cast<float>(this->GetParameterInt("method.image.up"))) / 100.0)));
+                                     quantilesFilter->GetQuantile(index, static_cast<float>(this->GetParameterInt("method.image.low")) / 100.0)));
+        maxVal.SetElement(index, static_cast<FloatVectorImageType::PixelType::ValueType>(quantilesFilter->GetQuantile(
+                                     index, (100.0 - static_cast<float>(this->GetParameterInt("method.image.up"))) / 100.0)));
       }
 
       m_CasterToLabelImage = CasterToLabelImageType::New();
@@ -650,6 +668,131 @@ private:
     }
   }
 
+  /** Quantiles of the support image from the histograms of a shrunk image */
+  void ComputeShrunkSupportQuantiles(FloatVectorImageType* supportImage, FloatVectorImageType::PixelType& minVal, FloatVectorImageType::PixelType& maxVal)
+  {
+    // first of all resampling
+
+    // calculate split number
+    RAMDrivenAdaptativeStreamingManagerType::Pointer streamingManager = RAMDrivenAdaptativeStreamingManagerType::New();
+    int                                              availableRAM     = GetParameterInt("ram");
+    streamingManager->SetAvailableRAMInMB(availableRAM);
+    float bias = 2.0; // empiric value;
+    streamingManager->SetBias(bias);
+    FloatVectorImageType::RegionType largestRegion     = supportImage->GetLargestPossibleRegion();
+    FloatVectorImageType::SizeType   largestRegionSize = largestRegion.GetSize();
+    streamingManager->PrepareStreaming(supportImage, largestRegion);
+
+    unsigned long nbDivisions  = streamingManager->GetNumberOfSplits();
+    unsigned long largestPixNb = largestRegionSize[0] * largestRegionSize[1];
+
+    unsigned long maxPixNb = largestPixNb / nbDivisions;
+
+    ImageSamplingFilterType::Pointer imageSampler = ImageSamplingFilterType::New();
+    imageSampler->SetInput(supportImage);
+
+    double theoricNBSamplesForKMeans = maxPixNb;
+
+    const double upperThresholdNBSamplesForKMeans = 1000 * 1000;
+    const double actualNBSamplesForKMeans         = std::min(theoricNBSamplesForKMeans, upperThresholdNBSamplesForKMeans);
+
+    const double shrinkFactor = std::floor(std::sqrt(supportImage->GetLargestPossibleRegion().GetNumberOfPixels() / actualNBSamplesForKMeans));
+    imageSampler->SetShrinkFactor(shrinkFactor);
+    imageSampler->Update();
+
+    otbAppLogINFO(<< imageSampler->GetOutput()->GetLargestPossibleRegion().GetNumberOfPixels()
+                  << ""
+                     " sample will be used to estimate extrema value for outliers rejection."
+                  << std::endl);
+
+    // use histogram to compute quantile value
+    FloatVectorImageType::Pointer histogramSource;
+    histogramSource = imageSampler->GetOutput();
+    histogramSource->SetRequestedRegion(imageSampler->GetOutput()->GetLargestPossibleRegion());
+
+    // Iterate on the image
+    itk::ImageRegionConstIterator<FloatVectorImageType> it(histogramSource, histogramSource->GetBufferedRegion());
+
+    // declare a list to store the samples
+    ListSampleType::Pointer listSample = ListSampleType::New();
+    listSample->Clear();
+
+    unsigned int sampleSize = itk::NumericTraits<SampleType>::GetLength(it.Get());
+
+    listSample->SetMeasurementVectorSize(sampleSize);
+
+    // Fill the samples list
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      listSample->PushBack(it.Get());
+    }
+
+    // assign listSample
+
+    HistogramFilterType::Pointer histogramFilter = HistogramFilterType::New();
+    histogramFilter->SetListSample(listSample);
+    histogramFilter->SetNumberOfBins(255);
+
+    if (this->IsParameterEnabled("method.image.nodatavalue") == true)
+    {
+      // NoData value extraction for the support image
+      float noDataValue = this->GetParameterFloat("method.image.nodatavalue");
+      otbAppLogINFO(" The NoData value: " << noDataValue << " will be rejected from the support image in the LUT estimation." << std::endl);
+      histogramFilter->SetNoDataValue(noDataValue);
+      histogramFilter->NoDataFlagOn();
+    }
+    else
+    {
+      otbAppLogINFO(" The NoData value of the support image is disabled. Thus, all the values will be handled in the LUT estimation." << std::endl);
+      histogramFilter->NoDataFlagOff();
+    }
+
+    // Generate
+    histogramFilter->Update();
+    const HistogramListType* histogramList = histogramFilter->GetOutput();
+
+    for (unsigned int index = 0; index < supportImage->GetNumberOfComponentsPerPixel(); index++)
+    {
+      minVal.SetElement(index, static_cast<FloatVectorImageType::PixelType::ValueType>(
+                                   histogramList->GetNthElement(index)->Quantile(0, static_cast<float>(this->GetParameterInt("method.image.low")) / 100.0)));
+      maxVal.SetElement(index, static_cast<FloatVectorImageType::PixelType::ValueType>(histogramList->GetNthElement(index)->Quantile(
+                                   0, (100.0 - static_cast<float>(this->GetParameterInt("method.image.up"))) / 100.0)));
+    }
+  }
+
+  /** Quantiles of the support image in one full resolution streamed pass */
+  void ComputeFullResolutionSupportQuantiles(FloatVectorImageType* supportImage, FloatVectorImageType::PixelType& minVal, FloatVectorImageType::PixelType& maxVal)
+  {
+    QuantilesFilterType::Pointer quantilesFilter = QuantilesFilterType::New();
+    quantilesFilter->SetInput(supportImage);
+    quantilesFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+
+    if (this->IsParameterEnabled("method.image.nodatavalue") == true)
+    {
+      // NoData value extraction for the support image
+      float noDataValue = this->GetParameterFloat("method.image.nodatavalue");
+      otbAppLogINFO(" The NoData value: " << noDataValue << " will be rejected from the support image in the LUT estimation." << std::endl);
+      quantilesFilter->SetNoDataValue(noDataValue);
+      quantilesFilter->SetNoDataFlag(true);
+    }
+    else
+    {
+      otbAppLogINFO(" The NoData value of the support image is disabled. Thus, all the values will be handled in the LUT estimation." << std::endl);
+      quantilesFilter->SetNoDataFlag(false);
+    }
+
+    AddProcess(quantilesFilter->GetStreamer(), "Computing support image quantiles...");
+    quantilesFilter->Update();
+
+    for (unsigned int index = 0; index < supportImage->GetNumberOfComponentsPerPixel(); index++)
+    {
+      minVal.SetElement(index, static_cast<FloatVectorImageType::PixelType::ValueType>(
+                                   quantilesFilter->GetQuantile(index, static_cast<float>(this->GetParameterInt("method.image.low")) / 100.0)));
+      maxVal.SetElement(index, static_cast<FloatVectorImageType::PixelType::ValueType>(quantilesFilter->GetQuantile(
+                                   index, (100.0 - static_cast<float>(this->GetParameterInt("method.image.up"))) / 100.0)));
+    }
+  }
+
   void ComputeColorToLabel()
   {
     if (GetParameterInt("method") == 1 || GetParameterInt("method") == 3)
@@ -24,6 +24,7 @@
 #include "otbVectorRescaleIntensityImageFilter.h"
 #include "otbFunctorImageFilter.h"
 #include "otbStreamingShrinkImageFilter.h"
+#include "otbStreamingQuantilesVectorImageFilter.h"
 #include "itkListSample.h"
 #include "otbListSampleToHistogramListGenerator.h"
 #include "itkImageRegionConstIterator.h"
@@ -63,6 +64,8 @@ public:
 
   typedef StreamingShrinkImageFilter<UInt8ImageType, UInt8ImageType> UInt8ShrinkFilterType;
 
+  typedef StreamingQuantilesVectorImageFilter<FloatVectorImageType, UInt8ImageType> QuantilesFilterType;
+
 private:
   void DoInit() override
   {
@@ -137,6 +140,12 @@ private:
     SetDefaultParameterFloat("quantile.low", 2.0);
     DisableParameter("quantile.low");
 
+    AddParameter(ParameterType_Bool, "quantile.fullres", "Full resolution quantiles");
+    SetParameterDescription("quantile.fullres",
+                            "Estimate the quantiles on the whole image at full resolution, in a single "
+                            "streamed pass, instead of the histogram of a shrunk image of at most "
+                            "1000 pixels square");
+
     AddParameter(ParameterType_Choice, "channels", "Channels selection");
     SetParameterDescription("channels",
                             "It's possible to select the channels "
@@ -228,19 +237,7 @@ private:
 
     const unsigned int nbComp(tempImage->GetNumberOfComponentsPerPixel());
 
-    // We need to subsample the input image in order to estimate its histogram
-    // Shrink factor is computed so as to load a quicklook of 1000
-    // pixels square at most
-    auto         imageSize    = tempImage->GetLargestPossibleRegion().GetSize();
-    unsigned int shrinkFactor = std::max({int(imageSize[0]) / 1000, int(imageSize[1]) / 1000, 1});
-    otbAppLogDEBUG(<< "Shrink factor used to compute Min/Max: " << shrinkFactor);
-
-    otbAppLogDEBUG(<< "Shrink starts...");
-    typename ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
-    shrinkFilter->SetShrinkFactor(shrinkFactor);
-    shrinkFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
-    AddProcess(shrinkFilter->GetStreamer(), "Computing shrink Image for min/max estimation...");
-
+    FloatVectorImageType::Pointer quantilesInput = tempImage;
     if (rescaleType == "log2")
     {
       // define lambda function that applies a log to all bands of the input pixel
@@ -262,81 +259,19 @@ private:
       transferLogFilter->SetInputs(tempImage);
       transferLogFilter->UpdateOutputInformation();
 
-      shrinkFilter->SetInput(transferLogFilter->GetOutput());
-      rescaler->SetInput(transferLogFilter->GetOutput());
-      shrinkFilter->Update();
-    }
-    else
-    {
-      shrinkFilter->SetInput(tempImage);
-      rescaler->SetInput(tempImage);
-      shrinkFilter->Update();
+      quantilesInput = transferLogFilter->GetOutput();
     }
-
-    otbAppLogDEBUG(<< "Evaluating input Min/Max...");
-    itk::ImageRegionConstIterator<FloatVectorImageType> it(shrinkFilter->GetOutput(), shrinkFilter->GetOutput()->GetLargestPossibleRegion());
-
-    typename ListSampleType::Pointer listSample = ListSampleType::New();
-    listSample->SetMeasurementVectorSize(tempImage->GetNumberOfComponentsPerPixel());
-
-    // Now we generate the list of samples
-    if (IsParameterEnabled("mask"))
-    {
-      UInt8ImageType::Pointer        mask             = this->GetParameterUInt8Image("mask");
-      UInt8ShrinkFilterType::Pointer maskShrinkFilter = UInt8ShrinkFilterType::New();
-      maskShrinkFilter->SetShrinkFactor(shrinkFactor);
-      maskShrinkFilter->SetInput(mask);
-      maskShrinkFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
-      maskShrinkFilter->Update();
-
-      auto itMask = itk::ImageRegionConstIterator<UInt8ImageType>(maskShrinkFilter->GetOutput(), maskShrinkFilter->GetOutput()->GetLargestPossibleRegion());
-
-      // Remove masked pixels
-      it.GoToBegin();
-      itMask.GoToBegin();
-      for (; !it.IsAtEnd(); ++it, ++itMask)
-      {
-        // valid pixels are non zero
-        if (itMask.Get() != 0)
-        {
-          listSample->PushBack(it.Get());
-        }
-      }
-      // if listSample is empty
-      if (listSample->Size() == 0)
-      {
-        otbAppLogINFO(<< "All pixels were masked, the application assume "
-                         "a wrong mask and include all the image");
-      }
-    }
-
-    // get all pixels : if mask is disable or all pixels were masked
-    if ((!IsParameterEnabled("mask")) || (listSample->Size() == 0))
-    {
-      for (it.GoToBegin(); !it.IsAtEnd(); ++it)
-      {
-        listSample->PushBack(it.Get());
-      }
-    }
-
-    // And then the histogram
-    typename HistogramsGeneratorType::Pointer histogramsGenerator = HistogramsGeneratorType::New();
-    histogramsGenerator->SetListSample(listSample);
-    histogramsGenerator->SetNumberOfBins(255);
-    // Samples with nodata values are ignored
-    histogramsGenerator->NoDataFlagOn();
-    histogramsGenerator->Update();
-    auto histOutput = histogramsGenerator->GetOutput();
-    assert(histOutput);
+    rescaler->SetInput(quantilesInput);
 
     // And extract the lower and upper quantile
     typename FloatVectorImageType::PixelType inputMin(nbComp), inputMax(nbComp);
-    for (unsigned int i = 0; i < nbComp; ++i)
+    if (GetParameterInt("quantile.fullres"))
     {
-      auto&& elm = histOutput->GetNthElement(i);
-      assert(elm);
-      inputMin[i] = elm->Quantile(0, 0.01 * GetParameterFloat("quantile.low"));
-      inputMax[i] = elm->Quantile(0, 1.0 - 0.01 * GetParameterFloat("quantile.high"));
+      ComputeFullResolutionQuantiles(quantilesInput, inputMin, inputMax);
+    }
+    else
+    {
+      ComputeShrunkQuantiles(quantilesInput, inputMin, inputMax);
     }
 
     otbAppLogDEBUG(<< std::setprecision(5) << "Min/Max computation done : min=" << inputMin << " max=" << inputMax);
@@ -455,6 +390,134 @@ private:
   }
 
 
+  /** Quantiles from the histograms of a shrunk image */
+  void ComputeShrunkQuantiles(FloatVectorImageType* image, FloatVectorImageType::PixelType& inputMin, FloatVectorImageType::PixelType& inputMax)
+  {
+    const unsigned int nbComp(image->GetNumberOfComponentsPerPixel());
+
+    // We need to subsample the input image in order to estimate its histogram
+    // Shrink factor is computed so as to load a quicklook of 1000
+    // pixels square at most
+    auto         imageSize    = image->GetLargestPossibleRegion().GetSize();
+    unsigned int shrinkFactor = std::max({int(imageSize[0]) / 1000, int(imageSize[1]) / 1000, 1});
+    otbAppLogDEBUG(<< "Shrink factor used to compute Min/Max: " << shrinkFactor);
+
+    otbAppLogDEBUG(<< "Shrink starts...");
+    ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
+    shrinkFilter->SetShrinkFactor(shrinkFactor);
+    shrinkFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    AddProcess(shrinkFilter->GetStreamer(), "Computing shrink Image for min/max estimation...");
+    shrinkFilter->SetInput(image);
+    shrinkFilter->Update();
+
+    otbAppLogDEBUG(<< "Evaluating input Min/Max...");
+    itk::ImageRegionConstIterator<FloatVectorImageType> it(shrinkFilter->GetOutput(), shrinkFilter->GetOutput()->GetLargestPossibleRegion());
+
+    ListSampleType::Pointer listSample = ListSampleType::New();
+    listSample->SetMeasurementVectorSize(nbComp);
+
+    // Now we generate the list of samples
+    if (IsParameterEnabled("mask"))
+    {
+      UInt8ImageType::Pointer        mask             = this->GetParameterUInt8Image("mask");
+      UInt8ShrinkFilterType::Pointer maskShrinkFilter = UInt8ShrinkFilterType::New();
+      maskShrinkFilter->SetShrinkFactor(shrinkFactor);
+      maskShrinkFilter->SetInput(mask);
+      maskShrinkFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+      maskShrinkFilter->Update();
+
+      auto itMask = itk::ImageRegionConstIterator<UInt8ImageType>(maskShrinkFilter->GetOutput(), maskShrinkFilter->GetOutput()->GetLargestPossibleRegion());
+
+      // Remove masked pixels
+      it.GoToBegin();
+      itMask.GoToBegin();
+      for (; !it.IsAtEnd(); ++it, ++itMask)
+      {
+        // valid pixels are non zero
+        if (itMask.Get() != 0)
+        {
+          listSample->PushBack(it.Get());
+        }
+      }
+      // if listSample is empty
+      if (listSample->Size() == 0)
+      {
+        otbAppLogINFO(<< "All pixels were masked, the application assume "
+                         "a wrong mask and include all the image");
+      }
+    }
+
+    // get all pixels : if mask is disable or all pixels were masked
+    if ((!IsParameterEnabled("mask")) || (listSample->Size() == 0))
+    {
+      for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+      {
+        listSample->PushBack(it.Get());
+      }
+    }
+
+    // And then the histogram
+    HistogramsGeneratorType::Pointer histogramsGenerator = HistogramsGeneratorType::New();
+    histogramsGenerator->SetListSample(listSample);
+    histogramsGenerator->SetNumberOfBins(255);
+    // Samples with nodata values are ignored
+    histogramsGenerator->NoDataFlagOn();
+    histogramsGenerator->Update();
+    auto histOutput = histogramsGenerator->GetOutput();
+    assert(histOutput);
+
+    for (unsigned int i = 0; i < nbComp; ++i)
+    {
+      auto&& elm = histOutput->GetNthElement(i);
+      assert(elm);
+      inputMin[i] = elm->Quantile(0, 0.01 * GetParameterFloat("quantile.low"));
+      inputMax[i] = elm->Quantile(0, 1.0 - 0.01 * GetParameterFloat("quantile.high"));
+    }
+  }
+
+  /** Quantiles from per-band quantile sketches, in one full resolution
+   * streamed pass */
+  void ComputeFullResolutionQuantiles(FloatVectorImageType* image, FloatVectorImageType::PixelType& inputMin, FloatVectorImageType::PixelType& inputMax)
+  {
+    const unsigned int nbComp(image->GetNumberOfComponentsPerPixel());
+
+    QuantilesFilterType::Pointer quantilesFilter = QuantilesFilterType::New();
+    quantilesFilter->SetInput(image);
+    quantilesFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    // Samples with nodata values are ignored
+    quantilesFilter->SetNoDataFlag(true);
+    quantilesFilter->SetNoDataValue(0);
+    AddProcess(quantilesFilter->GetStreamer(), "Computing quantiles for min/max estimation...");
+
+    otbAppLogDEBUG(<< "Evaluating input Min/Max...");
+    if (IsParameterEnabled("mask"))
+    {
+      // valid pixels are non zero
+      quantilesFilter->SetMaskImage(this->GetParameterUInt8Image("mask"));
+      quantilesFilter->Update();
+
+      const auto count     = quantilesFilter->GetCount();
+      const bool allMasked = std::accumulate(count.begin(), count.end(), itk::SizeValueType(0)) == 0;
+      if (allMasked)
+      {
+        otbAppLogINFO(<< "All pixels were masked, the application assume "
+                         "a wrong mask and include all the image");
+        quantilesFilter->SetMaskImage(nullptr);
+        quantilesFilter->Update();
+      }
+    }
+    else
+    {
+      quantilesFilter->Update();
+    }
+
+    for (unsigned int i = 0; i < nbComp; ++i)
+    {
+      inputMin[i] = quantilesFilter->GetQuantile(i, 0.01 * GetParameterFloat("quantile.low"));
+      inputMax[i] = quantilesFilter->GetQuantile(i, 1.0 - 0.01 * GetParameterFloat("quantile.high"));
+    }
+  }
+
   void DoExecute() override
   {
     switch (this->GetParameterOutputImagePixelType("out"))
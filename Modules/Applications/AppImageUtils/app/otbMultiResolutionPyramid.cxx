@@ -24,6 +24,9 @@
 #include "otbPerBandVectorImageFilter.h"
 #include "itkDiscreteGaussianImageFilter.h"
 #include "itkShrinkImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbImageFileReader.h"
 
 
 namespace otb
@@ -53,6 +56,12 @@ public:
 
   typedef itk::ShrinkImageFilter<FloatVectorImageType, FloatVectorImageType> ShrinkFilterType;
 
+  typedef itk::StreamingImageFilter<FloatVectorImageType, FloatVectorImageType> LevelBufferType;
+
+  typedef otb::RAMDrivenAdaptativeStreamingManager<FloatVectorImageType> RAMDrivenAdaptativeStreamingManagerType;
+
+  typedef otb::ImageFileReader<FloatVectorImageType> LevelReaderType;
+
 private:
   void DoInit() override
   {
@@ -62,7 +71,8 @@ private:
     // Documentation
     SetDocLongDescription(
         "This application builds a multi-resolution pyramid of the input image. User can specified the number of levels of the pyramid and the subsampling "
-        "factor. To speed up the process, you can use the fast scheme option");
+        "factor. To speed up the process, you can use the fast scheme option: the input image is then read only once, "
+        "and each level is computed from the previous one.");
     SetDocLimitations("None");
     SetDocAuthors("OTB-Team");
     SetDocSeeAlso(" ");
@@ -95,7 +105,11 @@ private:
     AddParameter(ParameterType_Bool, "fast", "Use Fast Scheme");
     std::ostringstream desc;
     desc << "If used, this option allows one to speed-up computation by iteratively"
-         << " subsampling previous level of pyramid instead of processing the full input.";
+         << " subsampling previous level of pyramid instead of processing the full input."
+         << " Each level is smoothed and subsampled from the previous one, so the full"
+         << " resolution input is only read once. The previous level is kept in memory as"
+         << " a float image when it fits in the available RAM, otherwise it is read back"
+         << " from its output file, with the precision of the output pixel type.";
     SetParameterDescription("fast", desc.str());
 
     AddRAMParameter();
@@ -121,8 +135,10 @@ private:
   void DoExecute() override
   {
     // Initializing the process
-    m_SmoothingFilter = SmoothingVectorImageFilterType::New();
-    m_ShrinkFilter    = ShrinkFilterType::New();
+    m_SmoothingFilters.clear();
+    m_ShrinkFilters.clear();
+    m_LevelBuffers.clear();
+    m_LevelReaders.clear();
 
     // Extract Parameters
     unsigned int nbLevels       = GetParameterInt("level");
@@ -146,28 +162,79 @@ private:
     unsigned int currentLevel  = 1;
     unsigned int currentFactor = shrinkFactor;
 
+    // In the fast scheme, each level is computed from the previous one, so
+    // the shrink factor and the smoothing variance are relative to the
+    // previous level and do not grow
+    FloatVectorImageType::Pointer levelInput = inImage;
+
     while (currentLevel <= nbLevels)
     {
       otbAppLogDEBUG(<< "Processing level " << currentLevel << " with shrink factor " << currentFactor);
 
-      m_SmoothingFilter->SetInput(inImage);
+      SmoothingVectorImageFilterType::Pointer smoothingFilter = SmoothingVectorImageFilterType::New();
+      ShrinkFilterType::Pointer               shrinkFilter    = ShrinkFilterType::New();
+      m_SmoothingFilters.push_back(smoothingFilter);
+      m_ShrinkFilters.push_back(shrinkFilter);
+
+      smoothingFilter->SetInput(levelInput);
 
       // According to
       // http://www.ipol.im/pub/algo/gjmr_line_segment_detector/
       // This is a good balance between blur and aliasing
       double variance = varianceFactor * static_cast<double>(currentFactor);
-      m_SmoothingFilter->GetFilter()->SetVariance(variance);
+      smoothingFilter->GetFilter()->SetVariance(variance);
 
-      m_ShrinkFilter->SetInput(m_SmoothingFilter->GetOutput());
-      m_ShrinkFilter->SetShrinkFactors(currentFactor);
+      shrinkFilter->SetInput(smoothingFilter->GetOutput());
+      shrinkFilter->SetShrinkFactors(currentFactor);
 
-      if (!fastScheme)
+      FloatVectorImageType::Pointer levelImage = shrinkFilter->GetOutput();
+
+      // In the fast scheme, the level feeding the next one is kept in memory
+      // only if it fits in the available RAM
+      bool bufferLevel = false;
+      if (fastScheme && currentLevel < nbLevels)
       {
-        currentFactor *= shrinkFactor;
+        shrinkFilter->UpdateOutputInformation();
+        const double levelSizeInMB = static_cast<double>(levelImage->GetLargestPossibleRegion().GetNumberOfPixels()) *
+                                     levelImage->GetNumberOfComponentsPerPixel() * sizeof(FloatVectorImageType::InternalPixelType) / (1024. * 1024.);
+        const unsigned int availableRAM = GetParameterInt("ram");
+        bufferLevel                     = levelSizeInMB <= availableRAM;
+        if (bufferLevel)
+        {
+          otbAppLogINFO(<< "Level " << currentLevel << " is kept in memory to compute the next level (" << levelSizeInMB << " MB)");
+        }
+        else
+        {
+          otbAppLogWARNING(<< "Level " << currentLevel << " needs " << levelSizeInMB << " MB, more than the available RAM (" << availableRAM
+                           << " MB): the next level is computed from the written file, with the precision of the output pixel type");
+        }
       }
-      else
+
+      if (bufferLevel)
       {
-        otbAppLogWARNING("fast scheme enabled : not implemented for the moment ");
+        // Buffer the level as a float image, in one streamed pass over the
+        // previous level: it is written from memory and feeds the next level
+        // without quantization. It is sf^2 times smaller than its input.
+        LevelBufferType::Pointer levelBuffer = LevelBufferType::New();
+        m_LevelBuffers.push_back(levelBuffer);
+        levelBuffer->SetInput(levelImage);
+
+        RAMDrivenAdaptativeStreamingManagerType::Pointer streamingManager = RAMDrivenAdaptativeStreamingManagerType::New();
+        streamingManager->SetAvailableRAMInMB(GetParameterInt("ram"));
+        streamingManager->PrepareStreaming(levelImage, levelImage->GetLargestPossibleRegion());
+        levelBuffer->SetNumberOfStreamDivisions(streamingManager->GetNumberOfSplits());
+
+        std::ostringstream ossbuffer;
+        ossbuffer << "level " << currentLevel;
+        AddProcess(levelBuffer, ossbuffer.str());
+        levelBuffer->Update();
+
+        levelImage = levelBuffer->GetOutput();
+      }
+
+      if (!fastScheme)
+      {
+        currentFactor *= shrinkFactor;
       }
 
       // Create an output parameter to write the current output image
@@ -188,13 +255,26 @@ private:
       // Set the filename of the current output image
       paramOut->SetFileName(oss.str());
       otbAppLogINFO(<< "File: " << paramOut->GetFileName() << " will be written.");
-      paramOut->SetValue(m_ShrinkFilter->GetOutput());
+      paramOut->SetValue(levelImage);
       paramOut->SetPixelType(this->GetParameterOutputImagePixelType("out"));
       // Add the current level to be written
       paramOut->InitializeWriters();
       AddProcess(paramOut->GetWriter(), osswriter.str());
       paramOut->Write();
 
+      if (bufferLevel)
+      {
+        levelInput = levelImage;
+      }
+      else if (fastScheme && currentLevel < nbLevels)
+      {
+        // Stream the next level from the level just written
+        LevelReaderType::Pointer levelReader = LevelReaderType::New();
+        m_LevelReaders.push_back(levelReader);
+        levelReader->SetFileName(paramOut->GetFileName());
+        levelInput = levelReader->GetOutput();
+      }
+
       ++currentLevel;
     }
 
@@ -202,8 +282,10 @@ private:
     DisableParameter("out");
   }
 
-  SmoothingVectorImageFilterType::Pointer m_SmoothingFilter;
-  ShrinkFilterType::Pointer               m_ShrinkFilter;
+  std::vector<SmoothingVectorImageFilterType::Pointer> m_SmoothingFilters;
+  std::vector<ShrinkFilterType::Pointer>               m_ShrinkFilters;
+  std::vector<LevelBufferType::Pointer>                m_LevelBuffers;
+  std::vector<LevelReaderType::Pointer>                m_LevelReaders;
 };
 }
 }
@@ -22,6 +22,7 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbStreamingMinMaxVectorImageFilter.h"
+#include "otbStreamingQuantilesVectorImageFilter.h"
 #include "otbVectorRescaleIntensityImageFilter.h"
 
 namespace otb
@@ -45,8 +46,9 @@ public:
   itkTypeMacro(Rescale, otb::Application);
 
   /** Filters typedef */
-  typedef otb::StreamingMinMaxVectorImageFilter<FloatVectorImageType>  MinMaxFilterType;
-  typedef otb::VectorRescaleIntensityImageFilter<FloatVectorImageType> RescaleImageFilterType;
+  typedef otb::StreamingMinMaxVectorImageFilter<FloatVectorImageType>    MinMaxFilterType;
+  typedef otb::StreamingQuantilesVectorImageFilter<FloatVectorImageType> QuantilesFilterType;
+  typedef otb::VectorRescaleIntensityImageFilter<FloatVectorImageType>   RescaleImageFilterType;
 
 private:
   void DoInit() override
@@ -57,7 +59,9 @@ private:
     SetDocLongDescription(
         "This application scales the given image pixel intensity between two given values.\n"
         "By default min (resp. max) value is set to 0 (resp. 255).\n"
-        "Input minimum and maximum values is automatically computed for all image bands.");
+        "Input minimum and maximum values is automatically computed for all image bands.\n"
+        "Optionally, the input range can be cut at low and high quantiles, estimated "
+        "on the whole image in a single streamed pass.");
     SetDocLimitations("None");
     SetDocAuthors("OTB-Team");
     SetDocSeeAlso("DynamicConvert");
@@ -79,6 +83,23 @@ private:
     MandatoryOff("outmin");
     MandatoryOff("outmax");
 
+    AddParameter(ParameterType_Group, "quantile", "Histogram quantile cutting");
+    SetParameterDescription("quantile", "Cut the histogram edges before rescaling. If disabled, the exact minimum and maximum are used.");
+    MandatoryOff("quantile");
+    DisableParameter("quantile");
+
+    AddParameter(ParameterType_Float, "quantile.high", "High cut quantile");
+    SetParameterDescription("quantile.high", "Quantiles to cut from histogram high values before computing min/max rescaling (in percent, 2 by default)");
+    SetDefaultParameterFloat("quantile.high", 2.0);
+    SetMinimumParameterFloatValue("quantile.high", 0.0);
+    SetMaximumParameterFloatValue("quantile.high", 100.0);
+
+    AddParameter(ParameterType_Float, "quantile.low", "Low cut quantile");
+    SetParameterDescription("quantile.low", "Quantiles to cut from histogram low values before computing min/max rescaling (in percent, 2 by default)");
+    SetDefaultParameterFloat("quantile.low", 2.0);
+    SetMinimumParameterFloatValue("quantile.low", 0.0);
+    SetMaximumParameterFloatValue("quantile.low", 100.0);
+
     AddRAMParameter();
 
     // Doc example parameter settings
@@ -99,25 +120,50 @@ private:
   {
     FloatVectorImageType::Pointer inImage = GetParameterImage("in");
 
-    otbAppLogDEBUG(<< "Starting Min/Max computation")
+    FloatVectorImageType::PixelType inMin, inMax;
+
+    if (IsParameterEnabled("quantile"))
+    {
+      otbAppLogDEBUG(<< "Starting quantiles computation");
+
+      QuantilesFilterType::Pointer quantilesFilter = QuantilesFilterType::New();
+      quantilesFilter->SetInput(inImage);
+      quantilesFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+
+      AddProcess(quantilesFilter->GetStreamer(), "Quantiles computing");
+      quantilesFilter->Update();
+
+      const unsigned int nbComp = inImage->GetNumberOfComponentsPerPixel();
+      inMin.SetSize(nbComp);
+      inMax.SetSize(nbComp);
+      for (unsigned int i = 0; i < nbComp; ++i)
+      {
+        inMin[i] = quantilesFilter->GetQuantile(i, 0.01 * GetParameterFloat("quantile.low"));
+        inMax[i] = quantilesFilter->GetQuantile(i, 1.0 - 0.01 * GetParameterFloat("quantile.high"));
+      }
+    }
+    else
+    {
+      otbAppLogDEBUG(<< "Starting Min/Max computation");
 
-        MinMaxFilterType::Pointer minMaxFilter = MinMaxFilterType::New();
-    minMaxFilter->SetInput(inImage);
-    minMaxFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+      MinMaxFilterType::Pointer minMaxFilter = MinMaxFilterType::New();
+      minMaxFilter->SetInput(inImage);
+      minMaxFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
 
-    AddProcess(minMaxFilter->GetStreamer(), "Min/Max computing");
-    minMaxFilter->Update();
+      AddProcess(minMaxFilter->GetStreamer(), "Min/Max computing");
+      minMaxFilter->Update();
 
-    otbAppLogDEBUG(<< "Min/Max computation done : min=" << minMaxFilter->GetMinimum() << " max=" << minMaxFilter->GetMaximum())
+      inMin = minMaxFilter->GetMinimum();
+      inMax = minMaxFilter->GetMaximum();
+    }
 
-        FloatVectorImageType::PixelType inMin,
-        inMax;
+    otbAppLogDEBUG(<< "Min/Max computation done : min=" << inMin << " max=" << inMax);
 
     RescaleImageFilterType::Pointer rescaleFilter = RescaleImageFilterType::New();
     rescaleFilter->SetInput(inImage);
     rescaleFilter->SetAutomaticInputMinMaxComputation(false);
-    rescaleFilter->SetInputMinimum(minMaxFilter->GetMinimum());
-    rescaleFilter->SetInputMaximum(minMaxFilter->GetMaximum());
+    rescaleFilter->SetInputMinimum(inMin);
+    rescaleFilter->SetInputMaximum(inMax);
 
     FloatVectorImageType::PixelType outMin, outMax;
     outMin.SetSize(inImage->GetNumberOfComponentsPerPixel());
@@ -23,8 +23,7 @@
 #include "otbWrapperApplication.h"
 #include "otbWrapperApplicationFactory.h"
 
-#include "otbImageToRadianceImageFilter.h"
-#include "otbRadianceToReflectanceImageFilter.h"
+#include "otbImageToSurfaceReflectanceImageFilter.h"
 #include "otbRadianceToImageImageFilter.h"
 #include "otbReflectanceToRadianceImageFilter.h"
 #include "otbReflectanceToSurfaceReflectanceImageFilter.h"
@@ -77,9 +76,7 @@ public:
 
   itkTypeMacro(OpticalCalibration, Application);
 
-  typedef ImageToRadianceImageFilter<FloatVectorImageType, DoubleVectorImageType> ImageToRadianceImageFilterType;
-
-  typedef RadianceToReflectanceImageFilter<DoubleVectorImageType, DoubleVectorImageType> RadianceToReflectanceImageFilterType;
+  typedef ImageToSurfaceReflectanceImageFilter<FloatVectorImageType, DoubleVectorImageType> ImageToSurfaceReflectanceImageFilterType;
 
   typedef RadianceToImageImageFilter<DoubleVectorImageType, DoubleVectorImageType> RadianceToImageImageFilterType;
 
@@ -601,11 +598,9 @@ private:
   void DoExecute() override
   {
     // Main filters instantiations
-    m_ImageToRadianceFilter                 = ImageToRadianceImageFilterType::New();
-    m_RadianceToReflectanceFilter           = RadianceToReflectanceImageFilterType::New();
-    m_ReflectanceToSurfaceReflectanceFilter = ReflectanceToSurfaceReflectanceImageFilterType::New();
-    m_ReflectanceToRadianceFilter           = ReflectanceToRadianceImageFilterType::New();
-    m_RadianceToImageFilter                 = RadianceToImageImageFilterType::New();
+    m_ImageToSurfaceReflectanceFilter = ImageToSurfaceReflectanceImageFilterType::New();
+    m_ReflectanceToRadianceFilter     = ReflectanceToRadianceImageFilterType::New();
+    m_RadianceToImageFilter           = RadianceToImageImageFilterType::New();
 
     // Other instantiations
     m_ScaleFilter = ScaleFilterOutDoubleType::New();
@@ -622,27 +617,27 @@ private:
     // Set (Date and Day) OR FluxNormalizationCoef to corresponding filters OR solardistance
     if (IsParameterEnabled("acqui.fluxnormcoeff"))
     {
-      m_RadianceToReflectanceFilter->SetFluxNormalizationCoefficient(GetParameterFloat("acqui.fluxnormcoeff"));
+      m_ImageToSurfaceReflectanceFilter->SetFluxNormalizationCoefficient(GetParameterFloat("acqui.fluxnormcoeff"));
 
       m_ReflectanceToRadianceFilter->SetFluxNormalizationCoefficient(GetParameterFloat("acqui.fluxnormcoeff"));
     }
     else if (IsParameterEnabled("acqui.solardistance"))
     {
-      m_RadianceToReflectanceFilter->SetSolarDistance(GetParameterFloat("acqui.solardistance"));
+      m_ImageToSurfaceReflectanceFilter->SetSolarDistance(GetParameterFloat("acqui.solardistance"));
 
       m_ReflectanceToRadianceFilter->SetSolarDistance(GetParameterFloat("acqui.solardistance"));
     }
     else
     {
-      m_RadianceToReflectanceFilter->SetDay(GetParameterInt("acqui.day"));
-      m_RadianceToReflectanceFilter->SetMonth(GetParameterInt("acqui.month"));
+      m_ImageToSurfaceReflectanceFilter->SetDay(GetParameterInt("acqui.day"));
+      m_ImageToSurfaceReflectanceFilter->SetMonth(GetParameterInt("acqui.month"));
 
       m_ReflectanceToRadianceFilter->SetDay(GetParameterInt("acqui.day"));
       m_ReflectanceToRadianceFilter->SetMonth(GetParameterInt("acqui.month"));
     }
 
     // Set Sun Elevation Angle to corresponding filters
-    m_RadianceToReflectanceFilter->SetElevationSolarAngle(GetParameterFloat("acqui.sun.elev"));
+    m_ImageToSurfaceReflectanceFilter->SetElevationSolarAngle(GetParameterFloat("acqui.sun.elev"));
     m_ReflectanceToRadianceFilter->SetElevationSolarAngle(GetParameterFloat("acqui.sun.elev"));
 
     // Set Gain and Bias to corresponding filters
@@ -684,13 +679,13 @@ private:
             switch (numLine)
             {
               case 1:
-                m_ImageToRadianceFilter->SetAlpha(vlvector);
+                m_ImageToSurfaceReflectanceFilter->SetAlpha(vlvector);
                 m_RadianceToImageFilter->SetAlpha(vlvector);
                 otbAppLogINFO("Using Acquisition gain from the user file (per band): " << vlvector);
               break;
 
               case 2:
-                m_ImageToRadianceFilter->SetBeta(vlvector);
+                m_ImageToSurfaceReflectanceFilter->SetBeta(vlvector);
                 m_RadianceToImageFilter->SetBeta(vlvector);
                 otbAppLogINFO("Using Acquisition biases from the user file (per band): " << vlvector);
               break;
@@ -711,11 +706,11 @@ private:
       if (hasOpticalSensorMetadata)
       {
         otbAppLogINFO("Using Acquisition gain from image metadata (per band): " << metadata.GetAsVector(MDNum::PhysicalGain));
-        m_ImageToRadianceFilter->SetAlpha(metadata.GetAsVector(MDNum::PhysicalGain));
+        m_ImageToSurfaceReflectanceFilter->SetAlpha(metadata.GetAsVector(MDNum::PhysicalGain));
         m_RadianceToImageFilter->SetAlpha(metadata.GetAsVector(MDNum::PhysicalGain));
 
         otbAppLogINFO("Using Acquisition bias from image metadata (per band): " <<  metadata.GetAsVector(MDNum::PhysicalBias));
-        m_ImageToRadianceFilter->SetBeta(metadata.GetAsVector(MDNum::PhysicalBias));
+        m_ImageToSurfaceReflectanceFilter->SetBeta(metadata.GetAsVector(MDNum::PhysicalBias));
         m_RadianceToImageFilter->SetBeta(metadata.GetAsVector(MDNum::PhysicalBias));
       }
       else
@@ -756,7 +751,7 @@ private:
             itk::VariableLengthVector<double> vlvector;
             vlvector.SetData(values.data(), values.size(), false);
 
-            m_RadianceToReflectanceFilter->SetSolarIllumination(vlvector);
+            m_ImageToSurfaceReflectanceFilter->SetSolarIllumination(vlvector);
             m_ReflectanceToRadianceFilter->SetSolarIllumination(vlvector);
           }
         }
@@ -770,7 +765,7 @@ private:
       // Try to retrieve information from image metadata
       if (hasOpticalSensorMetadata)
       {
-        m_RadianceToReflectanceFilter->SetSolarIllumination(metadata.GetAsVector(MDNum::SolarIrradiance));
+        m_ImageToSurfaceReflectanceFilter->SetSolarIllumination(metadata.GetAsVector(MDNum::SolarIrradiance));
         m_ReflectanceToRadianceFilter->SetSolarIllumination(metadata.GetAsVector(MDNum::SolarIrradiance));
       }
       else
@@ -786,6 +781,24 @@ private:
     m_paramAcqui->SetViewingZenithalAngle(90.0 - GetParameterFloat("acqui.view.elev"));
     m_paramAcqui->SetViewingAzimutalAngle(GetParameterFloat("acqui.view.azim"));
 
+    // Output scale
+    double scale = 1.;
+
+    if (GetParameterInt("milli"))
+    {
+      otbAppLogINFO("Use milli-reflectance\n");
+      if ((GetParameterInt("level") == Level_IM_TOA) || (GetParameterInt("level") == Level_TOC))
+        scale = 1000.;
+      if (GetParameterInt("level") == Level_TOA_IM)
+        scale = 1. / 1000.;
+    }
+    m_ScaleFilter->SetConstant(scale);
+
+    // The image to reflectance levels are computed in a single pass, the
+    // scaling and clamping being fused in the calibration filter when
+    // possible
+    DoubleVectorImageType* output = m_ScaleFilter->GetOutput();
+
     switch (GetParameterInt("level"))
     {
     case Level_IM_TOA:
@@ -793,17 +806,17 @@ private:
       otbAppLogINFO("Compute Top of Atmosphere reflectance\n");
 
       // Pipeline
-      m_ImageToRadianceFilter->SetInput(inImage);
-      m_RadianceToReflectanceFilter->SetInput(m_ImageToRadianceFilter->GetOutput());
+      m_ImageToSurfaceReflectanceFilter->SetInput(inImage);
 
       if (GetParameterInt("clamp"))
       {
         otbAppLogINFO("Clamp values between [0, 100]\n");
       }
 
-      m_RadianceToReflectanceFilter->SetUseClamp(GetParameterInt("clamp"));
-      m_RadianceToReflectanceFilter->UpdateOutputInformation();
-      m_ScaleFilter->SetInput(m_RadianceToReflectanceFilter->GetOutput());
+      m_ImageToSurfaceReflectanceFilter->SetUseClamp(GetParameterInt("clamp"));
+      m_ImageToSurfaceReflectanceFilter->SetScale(scale);
+      m_ImageToSurfaceReflectanceFilter->UpdateOutputInformation();
+      output = m_ImageToSurfaceReflectanceFilter->GetOutput();
     }
     break;
     case Level_TOA_IM:
@@ -822,11 +835,7 @@ private:
       otbAppLogINFO("Compute Top of Canopy reflectance\n");
 
       // Pipeline
-      m_ImageToRadianceFilter->SetInput(inImage);
-      m_RadianceToReflectanceFilter->SetInput(m_ImageToRadianceFilter->GetOutput());
-      m_ReflectanceToSurfaceReflectanceFilter->SetInput(m_RadianceToReflectanceFilter->GetOutput());
-      m_ReflectanceToSurfaceReflectanceFilter->SetAcquiCorrectionParameters(m_paramAcqui);
-      m_ReflectanceToSurfaceReflectanceFilter->SetAtmoCorrectionParameters(m_paramAtmo);
+      m_ImageToSurfaceReflectanceFilter->SetInput(inImage);
 
       // AerosolModelType aeroMod = AtmosphericCorrectionParametersType::NO_AEROSOL;
 
@@ -905,11 +914,9 @@ private:
                                        GetParameterInt("acqui.hour"), GetParameterInt("acqui.minute"), 0.4);
       }
 
-      m_ReflectanceToSurfaceReflectanceFilter->UpdateOutputInformation();
-      m_ReflectanceToSurfaceReflectanceFilter->SetIsSetAtmosphericRadiativeTerms(false);
-      m_ReflectanceToSurfaceReflectanceFilter->SetUseGenerateParameters(true);
-      m_ReflectanceToSurfaceReflectanceFilter->GenerateParameters();
-      m_ReflectanceToSurfaceReflectanceFilter->SetUseGenerateParameters(false);
+      AtmosphericRadiativeTerms::Pointer atmoTerms = RadiometryCorrectionParametersToAtmosphericRadiativeTerms::Compute(m_paramAtmo, m_paramAcqui);
+      m_ImageToSurfaceReflectanceFilter->SetAtmosphericRadiativeTerms(atmoTerms);
+      m_ImageToSurfaceReflectanceFilter->UpdateOutputInformation();
 
       // std::ostringstream oss_atmo;
       // oss_atmo << "Atmospheric parameters: " << std::endl;
@@ -920,7 +927,6 @@ private:
       oss.str("");
       oss << std::endl << m_paramAtmo;
 
-      AtmosphericRadiativeTerms::Pointer atmoTerms = m_ReflectanceToSurfaceReflectanceFilter->GetAtmosphericRadiativeTerms();
       oss << std::endl << std::endl << atmoTerms << std::endl;
 
       otbAppLogINFO("Atmospheric correction parameters compute by 6S : " + oss.str());
@@ -933,8 +939,8 @@ private:
         // Compute adjacency effect
         m_SurfaceAdjacencyEffectCorrectionSchemeFilter = SurfaceAdjacencyEffectCorrectionSchemeFilterType::New();
 
-        m_SurfaceAdjacencyEffectCorrectionSchemeFilter->SetInput(m_ReflectanceToSurfaceReflectanceFilter->GetOutput());
-        m_SurfaceAdjacencyEffectCorrectionSchemeFilter->SetAtmosphericRadiativeTerms(m_ReflectanceToSurfaceReflectanceFilter->GetAtmosphericRadiativeTerms());
+        m_SurfaceAdjacencyEffectCorrectionSchemeFilter->SetInput(m_ImageToSurfaceReflectanceFilter->GetOutput());
+        m_SurfaceAdjacencyEffectCorrectionSchemeFilter->SetAtmosphericRadiativeTerms(atmoTerms);
         m_SurfaceAdjacencyEffectCorrectionSchemeFilter->SetZenithalViewingAngle(m_paramAcqui->GetViewingZenithalAngle());
         m_SurfaceAdjacencyEffectCorrectionSchemeFilter->SetWindowRadius(GetParameterInt("atmo.radius"));
         m_SurfaceAdjacencyEffectCorrectionSchemeFilter->SetPixelSpacingInKilometers(GetParameterFloat("atmo.pixsize"));
@@ -943,22 +949,24 @@ private:
       }
 
       // Rescale the surface reflectance in milli-reflectance
-      if (!GetParameterInt("clamp"))
+      if (GetParameterInt("clamp"))
       {
-        if (!adjComputation)
-          m_ScaleFilter->SetInput(m_ReflectanceToSurfaceReflectanceFilter->GetOutput());
-        else
-          m_ScaleFilter->SetInput(m_SurfaceAdjacencyEffectCorrectionSchemeFilter->GetOutput());
+        otbAppLogINFO("Clamp values between [0, 100]\n");
+      }
+
+      if (!adjComputation)
+      {
+        m_ImageToSurfaceReflectanceFilter->SetUseOutputClamp(GetParameterInt("clamp"));
+        m_ImageToSurfaceReflectanceFilter->SetScale(scale);
+        output = m_ImageToSurfaceReflectanceFilter->GetOutput();
+      }
+      else if (!GetParameterInt("clamp"))
+      {
+        m_ScaleFilter->SetInput(m_SurfaceAdjacencyEffectCorrectionSchemeFilter->GetOutput());
       }
       else
       {
-        otbAppLogINFO("Clamp values between [0, 100]\n");
-
-        if (!adjComputation)
-          m_ClampFilter->SetInput(m_ReflectanceToSurfaceReflectanceFilter->GetOutput());
-        else
-          m_ClampFilter->SetInput(m_SurfaceAdjacencyEffectCorrectionSchemeFilter->GetOutput());
-
+        m_ClampFilter->SetInput(m_SurfaceAdjacencyEffectCorrectionSchemeFilter->GetOutput());
         m_ClampFilter->ClampOutside(0.0, 1.0);
         m_ScaleFilter->SetInput(m_ClampFilter->GetOutput());
       }
@@ -966,28 +974,13 @@ private:
     break;
     }
 
-    // Output Image
-    double scale = 1.;
-
-    if (GetParameterInt("milli"))
-    {
-      otbAppLogINFO("Use milli-reflectance\n");
-      if ((GetParameterInt("level") == Level_IM_TOA) || (GetParameterInt("level") == Level_TOC))
-        scale = 1000.;
-      if (GetParameterInt("level") == Level_TOA_IM)
-        scale = 1. / 1000.;
-    }
-    m_ScaleFilter->SetConstant(scale);
-
-    SetParameterOutputImage("out", m_ScaleFilter->GetOutput());
+    SetParameterOutputImage("out", output);
   }
 
   // Keep object references as a members of the class, else the pipeline will be broken after exiting DoExecute().
-  ImageToRadianceImageFilterType::Pointer                 m_ImageToRadianceFilter;
-  RadianceToReflectanceImageFilterType::Pointer           m_RadianceToReflectanceFilter;
+  ImageToSurfaceReflectanceImageFilterType::Pointer       m_ImageToSurfaceReflectanceFilter;
   ReflectanceToRadianceImageFilterType::Pointer           m_ReflectanceToRadianceFilter;
   RadianceToImageImageFilterType::Pointer                 m_RadianceToImageFilter;
-  ReflectanceToSurfaceReflectanceImageFilterType::Pointer m_ReflectanceToSurfaceReflectanceFilter;
   ScaleFilterOutDoubleType::Pointer                       m_ScaleFilter;
   AtmoCorrectionParametersPointerType                     m_paramAtmo;
   AcquiCorrectionParametersPointerType                    m_paramAcqui;
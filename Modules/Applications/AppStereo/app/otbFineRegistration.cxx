@@ -222,7 +222,10 @@ private:
                             "Available metrics are cross-correlation (CC), cross-correlation with "
                             "subtracted mean (CCSM), mean-square difference (MSD), mean reciprocal "
                             "square difference (MRSD) and mutual information (MI). Default is "
-                            "cross-correlation");
+                            "cross-correlation. FCCSM computes the cross-correlation with subtracted "
+                            "mean for the whole exploration area at once (in the Fourier domain for "
+                            "large radii) and refines the peak with a quadratic fit: it is much faster "
+                            "for large exploration radii, and ignores the spa and cva parameters.");
     MandatoryOff("m");
 
     AddParameter(ParameterType_Float, "spa", "SubPixelAccuracy");
@@ -389,6 +392,12 @@ private:
       m_Registration->SetMetric(m_NCCMetricPtr);
       m_Registration->MinimizeOn();
     }
+    else if (metricId == "FCCSM")
+    {
+      otbAppLogINFO("Metric : Fast cross-correlation (mean subtracted)");
+      m_Registration->UseFastCorrelationOn();
+      m_Registration->MinimizeOn();
+    }
     else if (metricId == "MSD")
     {
       otbAppLogINFO("Metric : Mean square difference");
@@ -412,7 +421,7 @@ private:
     }
     else
     {
-      itkExceptionMacro("Metric not recognized. Possible choices are: CC, CCSM, MSD, MRSD, MI");
+      itkExceptionMacro("Metric not recognized. Possible choices are: CC, CCSM, FCCSM, MSD, MRSD, MI");
     }
 
     m_XExtractor = VectorImageToImageFilterType::New();
@@ -428,7 +437,7 @@ private:
     m_ImgList->PushBack(m_YExtractor->GetOutput());
 
     // Invert correlation to get classical rendering
-    if (metricId == "CC" || metricId == "CCSM")
+    if (metricId == "CC" || metricId == "CCSM" || metricId == "FCCSM")
     {
       m_AbsFilter = AbsFilterType::New();
       m_AbsFilter->SetInput(m_Registration->GetOutput());
@@ -445,7 +454,7 @@ private:
     {
       m_Threshold = BinaryThresholdImageFilterType::New();
 
-      if (metricId == "CC" || metricId == "CCSM")
+      if (metricId == "CC" || metricId == "CCSM" || metricId == "FCCSM")
       {
         m_Threshold->SetInput(m_AbsFilter->GetOutput());
       }
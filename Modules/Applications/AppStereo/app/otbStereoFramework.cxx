@@ -335,6 +335,17 @@ private:
     SetDefaultParameterFloat("output.nodata", -32768);
     MandatoryOff("output.nodata");
 
+    AddParameter(ParameterType_Bool, "output.losgrid", "Interpolate lines of sight");
+    SetParameterDescription("output.losgrid",
+                            "The sensor models are only evaluated on a coarse grid, and the lines of sight"
+                            " of each pixel are interpolated from it (disabled by default)");
+
+    AddParameter(ParameterType_Int, "output.losgridstep", "Step of the lines of sight grid (in pixels)");
+    SetParameterDescription("output.losgridstep", "Step of the coarse grid of lines of sight, in sensor image pixels (used with output.losgrid)");
+    SetDefaultParameterInt("output.losgridstep", 16);
+    SetMinimumParameterIntValue("output.losgridstep", 1);
+    MandatoryOff("output.losgridstep");
+
     // UserDefined values
     AddParameter(ParameterType_Choice, "output.fusionmethod", "Method to fuse measures in each DSM cell");
     SetParameterDescription("output.fusionmethod",
@@ -355,6 +366,10 @@ private:
     SetParameterDescription("output.fusionmethod.acc",
                             "Accumulator mode. The"
                             " cell is filled with the the number of values (for debugging purposes).");
+    AddChoice("output.fusionmethod.median", "Median");
+    SetParameterDescription("output.fusionmethod.median",
+                            "The cell is filled with"
+                            " the median of measured elevation values");
 
     AddParameter(ParameterType_OutputImage, "output.out", "Output DSM");
     SetParameterDescription("output.out", "Output elevation image");
@@ -1147,6 +1162,8 @@ private:
       m_MultiDisparityTo3DFilterList[i]->SetVerticalDisparityMapInput(0, vDispOutput2);
       m_MultiDisparityTo3DFilterList[i]->SetMovingImageMetadata(0, &(inright->GetImageMetadata()));
       m_MultiDisparityTo3DFilterList[i]->SetDisparityMaskInput(0, translatedMaskImage);
+      m_MultiDisparityTo3DFilterList[i]->SetUseLineOfSightGrid(GetParameterInt("output.losgrid"));
+      m_MultiDisparityTo3DFilterList[i]->SetLineOfSightGridStep(GetParameterInt("output.losgridstep"));
       m_MultiDisparityTo3DFilterList[i]->UpdateOutputInformation();
 
       // PARAMETER ESTIMATION
@@ -1285,6 +1302,10 @@ private:
     {
       m_Multi3DMapToDEMFilter->SetCellFusionMode(otb::CellFusionMode::MEAN);
     }
+    else if (GetParameterString("output.fusionmethod") == "median")
+    {
+      m_Multi3DMapToDEMFilter->SetCellFusionMode(otb::CellFusionMode::MEDIAN);
+    }
     else if (GetParameterString("output.fusionmethod") == "acc")
     {
       m_Multi3DMapToDEMFilter->SetCellFusionMode(otb::CellFusionMode::ACC);
@@ -104,6 +104,16 @@ public:
    */
   static itk::LoggerBase::PriorityLevelType GetLoggerLevel();
 
+  /**
+   * ProfilerTraceFile is the path of the Chrome trace JSON file
+   * written by the pipeline profiler.
+   *
+   * If environment variable OTB_PROFILER_TRACE is defined, the
+   * pipeline profiler is enabled and its contents is returned as a
+   * string. Else, returns an empty string (profiler disabled).
+   */
+  static std::string GetProfilerTraceFile();
+
   /**
    * If OpenMP is enabled, the number of threads for openMP is set to the
    * same number as in ITK (see GetGlobalDefaultNumberOfThreads()). This number
@@ -51,6 +51,13 @@ std::string ConfigurationManager::GetGeoidFile()
   return svalue;
 }
 
+std::string ConfigurationManager::GetProfilerTraceFile()
+{
+  std::string svalue;
+  itksys::SystemTools::GetEnv("OTB_PROFILER_TRACE", svalue);
+  return svalue;
+}
+
 ConfigurationManager::RAMValueType ConfigurationManager::GetMaxRAMHint()
 {
   std::string max_ram_hint;
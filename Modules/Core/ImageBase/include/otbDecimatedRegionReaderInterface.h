@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDecimatedRegionReaderInterface_h
+#define otbDecimatedRegionReaderInterface_h
+
+namespace otb
+{
+
+/** \class DecimatedRegionReaderInterface
+ * \brief Interface of the image sources able to produce a decimated region
+ *
+ * Filters which only need one pixel every n pixels of their input (such as
+ * StreamingShrinkImageFilter) can check whether the source of their input
+ * implements this interface, and ask it for the decimated pixels directly
+ * instead of streaming the input at full resolution.
+ *
+ * \sa ImageFileReader
+ *
+ * \ingroup OTBImageBase
+ */
+template <class TImage>
+class DecimatedRegionReaderInterface
+{
+public:
+  typedef typename TImage::IndexType IndexType;
+  typedef typename TImage::SizeType  SizeType;
+
+  virtual ~DecimatedRegionReaderInterface() = default;
+
+  /** Fill the buffer of image with the pixels start + k * factor of the
+   * source output, for 0 <= k < size. The buffered region of image must
+   * have size pixels. When useOverviews is true, the pixels may be read at a
+   * lower resolution, not coarser than factor. Returns false, without
+   * modifying image, when the pixels can not be produced this way: the
+   * caller then has to go through the regular pipeline. */
+  virtual bool ReadDecimatedRegion(const IndexType& start, const SizeType& size, unsigned int factor, bool useOverviews, TImage* image) = 0;
+};
+
+} // end namespace otb
+
+#endif
@@ -119,7 +119,8 @@ void Image<TPixel, VImageDimension>::CopyInformation(const itk::DataObject* data
     }
     else
     {
-      SetImageMetadata(imd);
+      // No copy: the metadata is shared until one of the images modifies it
+      ShareImageMetadata(*imc);
     }
   }
 }
@@ -25,19 +25,60 @@
 #include "otbImageMetadataInterfaceBase.h"
 #include "OTBImageBaseExport.h"
 
+#include <memory>
+
 namespace otb
 {
 
+/** \class ImageCommons
+ *
+ * \brief Metadata part common to otb::Image and otb::VectorImage
+ *
+ * The ImageMetadata is held through a reference-counted pointer and is
+ * shared between images until one of them modifies it (copy-on-write).
+ * Pass-through filters copying the output information of their input
+ * thus do not duplicate the metadata dictionaries (sensor models,
+ * calibration LUTs, ...).
+ *
+ * Once an image owns its metadata (after its first modification), the
+ * metadata keeps the same address for the lifetime of the image: later
+ * updates are copied into it. Raw pointers taken with GetImageMetadata()
+ * (for instance by GenericRSTransform) thus stay valid and follow the
+ * image.
+ *
+ * \ingroup OTBImageBase
+ */
 class OTBImageBase_EXPORT ImageCommons
 {
 public:
+  using ImageMetadataConstPointerType = std::shared_ptr<const ImageMetadata>;
+
+  ImageCommons();
 
   void SetImageMetadata(ImageMetadata imd);
-  
+
+  /** Share the metadata of another image. No copy is done until one of
+   * the two images modifies its metadata, unless this image already owns
+   * unshared metadata: it is then copied in place to keep its address. */
+  void ShareImageMetadata(const ImageCommons & other);
+
   void SetBandImageMetadata(ImageMetadata::ImageMetadataBandsType imd);
 
+  /** Returns the metadata. Once the image owns its metadata, the reference
+   * stays valid and follows the image for its whole lifetime. While the
+   * metadata is still shared, a modification of the image detaches it to
+   * a new instance. */
   const ImageMetadata & GetImageMetadata() const;
 
+  /** Returns a modifiable reference to the metadata. If the metadata is
+   * shared with other images, it is copied first. */
+  ImageMetadata & GetWritableImageMetadata();
+
+  /** Returns the shared metadata instance. Holding it keeps the metadata
+   * alive and unchanged: the image detaches from it before any later
+   * modification. */
+  ImageMetadataConstPointerType GetSharedImageMetadata() const;
+
   // boilerplate code...
 
   /** Get the projection coordinate system of the image. */
@@ -66,8 +107,9 @@ public:
   /** Returns true if a sensor geometric model is present */
   bool HasSensorGeometry() const;
 
-  /** Image metadata */
-  ImageMetadata m_Imd;
+private:
+  /** Image metadata, shared with other images until modified */
+  std::shared_ptr<ImageMetadata> m_Imd;
 };
 
 } // end namespace otb
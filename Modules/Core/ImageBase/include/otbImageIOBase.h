@@ -340,6 +340,22 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   virtual void Read(void* buffer) = 0;
 
+  /** Determine if the ImageIO can read decimated regions (see
+      ReadDecimated()). Default is false. */
+  virtual bool CanReadDecimated() const
+  {
+    return false;
+  }
+
+  /** Reads one pixel every factor pixels, in each dimension, into the memory
+   * buffer provided. The index of the IORegion is the first pixel to read and
+   * its size is the number of pixels to read in each dimension, so that the
+   * buffer has the layout of a regular read of the IORegion. When
+   * useOverviews is true, the pixels may be read from the overview of
+   * closest resolution which is not coarser than the decimation. The
+   * default implementation throws an exception. */
+  virtual void ReadDecimated(void* buffer, unsigned int factor, bool useOverviews);
+
 
   /*-------- This part of the interfaces deals with writing data ----- */
 
@@ -120,7 +120,8 @@ void VectorImage<TPixel, VImageDimension>::CopyInformation(const itk::DataObject
     }
     else
     {
-      SetImageMetadata(imd);
+      // No copy: the metadata is shared until one of the images modifies it
+      ShareImageMetadata(*imc);
     }
   }
 }
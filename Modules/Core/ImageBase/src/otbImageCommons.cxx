@@ -23,17 +23,75 @@
 namespace otb
 {
 
+namespace
+{
+/** Empty metadata shared by all new images. It is never modified: images
+ * detach from it on their first write. */
+const std::shared_ptr<ImageMetadata> & EmptyImageMetadata()
+{
+  static const std::shared_ptr<ImageMetadata> empty = std::make_shared<ImageMetadata>();
+  return empty;
+}
+}
+
+ImageCommons::ImageCommons()
+  : m_Imd(EmptyImageMetadata())
+{
+}
+
 void ImageCommons::SetImageMetadata(ImageMetadata imd)
 {
-  m_Imd = std::move(imd);
+  // Keep the address of unshared metadata stable
+  if (m_Imd.use_count() == 1)
+  {
+    *m_Imd = std::move(imd);
+  }
+  else
+  {
+    m_Imd = std::make_shared<ImageMetadata>(std::move(imd));
+  }
+}
+
+void ImageCommons::ShareImageMetadata(const ImageCommons & other)
+{
+  if (m_Imd == other.m_Imd)
+  {
+    return;
+  }
+  // Metadata owned by this image only may be referenced by raw pointers
+  // (sensor model transforms, disparity filters, ...): copy it in place
+  // to keep its address. Otherwise, share the instance of the other image.
+  if (m_Imd.use_count() == 1)
+  {
+    *m_Imd = *other.m_Imd;
+  }
+  else
+  {
+    m_Imd = other.m_Imd;
+  }
 }
 
 void ImageCommons::SetBandImageMetadata(ImageMetadata::ImageMetadataBandsType bands)
 {
-  m_Imd.Bands = std::move(bands);
+  GetWritableImageMetadata().Bands = std::move(bands);
 }
 
 const ImageMetadata & ImageCommons::GetImageMetadata() const
+{
+  return *m_Imd;
+}
+
+ImageMetadata & ImageCommons::GetWritableImageMetadata()
+{
+  // Detach from the other images before any modification
+  if (m_Imd.use_count() > 1)
+  {
+    m_Imd = std::make_shared<ImageMetadata>(*m_Imd);
+  }
+  return *m_Imd;
+}
+
+ImageCommons::ImageMetadataConstPointerType ImageCommons::GetSharedImageMetadata() const
 {
   return m_Imd;
 }
@@ -41,22 +99,22 @@ const ImageMetadata & ImageCommons::GetImageMetadata() const
 std::string ImageCommons::GetProjectionRef(void) const
 {
   // TODO: support EPSG and proj as fallback
-  return m_Imd.GetProjectionWKT();
+  return m_Imd->GetProjectionWKT();
 }
 
 
 void ImageCommons::SetProjectionRef(const std::string& proj)
 {
   // TODO: support EPSG and proj as fallback
-  m_Imd.Add(MDGeom::ProjectionWKT, proj);
+  GetWritableImageMetadata().Add(MDGeom::ProjectionWKT, proj);
 }
 
 
 std::string ImageCommons::GetGCPProjection(void) const
 {
-  if (m_Imd.Has(MDGeom::GCP))
+  if (m_Imd->Has(MDGeom::GCP))
   {
-    return m_Imd.GetGCPParam().GCPProjection;
+    return m_Imd->GetGCPParam().GCPProjection;
   }
   return "";
 }
@@ -64,9 +122,9 @@ std::string ImageCommons::GetGCPProjection(void) const
 
 unsigned int ImageCommons::GetGCPCount(void) const
 {
-  if (m_Imd.Has(MDGeom::GCP))
+  if (m_Imd->Has(MDGeom::GCP))
     {
-    return m_Imd.GetGCPParam().GCPs.size();
+    return m_Imd->GetGCPParam().GCPs.size();
     }
   return 0;
 }
@@ -75,7 +133,7 @@ unsigned int ImageCommons::GetGCPCount(void) const
 const GCP& ImageCommons::GetGCPs(unsigned int GCPnum) const
 {
   assert(GCPnum < GetGCPCount());
-  return m_Imd.GetGCPParam().GCPs[GCPnum];
+  return m_Imd->GetGCPParam().GCPs[GCPnum];
 }
 
 
@@ -122,7 +180,7 @@ double ImageCommons::GetGCPZ(unsigned int GCPnum) const
 
 bool ImageCommons::HasSensorGeometry() const
 {
-  return m_Imd.HasSensorGeometry();
+  return m_Imd->HasSensorGeometry();
 }
 
 } // end namespace otb
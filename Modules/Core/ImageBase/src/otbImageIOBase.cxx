@@ -1118,6 +1118,11 @@ itk::ImageIORegion ImageIOBase::GetSplitRegionForWriting(unsigned int ithPiece,
   return largestPossibleRegion;
 }
 
+void ImageIOBase::ReadDecimated(void*, unsigned int, bool)
+{
+  itkExceptionMacro(<< "Decimated reading is not supported by " << this->GetNameOfClass());
+}
+
 /** Given a requested region, determine what could be the region that we can
  * read from the file. This is called the streamable region, which will be
  * smaller than the LargestPossibleRegion and greater or equal to the
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbVectorImage.h"
+
+#include <iostream>
+
+/** Check that the metadata is shared by CopyInformation and copied only
+ * when one of the images modifies it. */
+int otbImageMetadataSharingTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  using ImageType       = otb::Image<float, 2>;
+  using VectorImageType = otb::VectorImage<float, 2>;
+
+  otb::ImageMetadata imd;
+  imd.Add(otb::MDStr::SensorID, "PHR 1A");
+  imd.Add(otb::MDNum::PhysicalGain, 2.);
+  imd.Bands = otb::ImageMetadata::ImageMetadataBandsType(3);
+
+  auto input = VectorImageType::New();
+  input->SetNumberOfComponentsPerPixel(3);
+  input->SetImageMetadata(imd);
+
+  // Pass-through: same number of bands, the instance is shared
+  auto output = VectorImageType::New();
+  output->SetNumberOfComponentsPerPixel(3);
+  output->CopyInformation(input);
+
+  if (output->GetSharedImageMetadata() != input->GetSharedImageMetadata())
+  {
+    std::cout << "Metadata should be shared after CopyInformation" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Copy-on-write: modifying the output does not affect the input
+  output->GetWritableImageMetadata().Add(otb::MDNum::PhysicalGain, 3.);
+
+  if (output->GetSharedImageMetadata() == input->GetSharedImageMetadata())
+  {
+    std::cout << "Metadata should be detached after modification" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (input->GetImageMetadata()[otb::MDNum::PhysicalGain] != 2.
+      || output->GetImageMetadata()[otb::MDNum::PhysicalGain] != 3.
+      || output->GetImageMetadata()[otb::MDStr::SensorID] != "PHR 1A")
+  {
+    std::cout << "Unexpected metadata values after copy-on-write" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A mono-band image gets its own metadata with the right number of bands
+  auto mono = ImageType::New();
+  mono->CopyInformation(input);
+
+  if (mono->GetSharedImageMetadata() == input->GetSharedImageMetadata()
+      || mono->GetImageMetadata().Bands.size() != 1
+      || input->GetImageMetadata().Bands.size() != 3)
+  {
+    std::cout << "Band metadata should not be shared between images with different number of bands" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Metadata held by another object survives the changes of the image
+  auto held = output->GetSharedImageMetadata();
+  output->CopyInformation(input);
+  output->GetWritableImageMetadata().Add(otb::MDNum::PhysicalGain, 4.);
+
+  if ((*held)[otb::MDNum::PhysicalGain] != 3. || output->GetImageMetadata()[otb::MDNum::PhysicalGain] != 4.)
+  {
+    std::cout << "Held metadata should not be modified by the image" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Metadata owned by the image keeps its address when the information is
+  // copied again and modified, so that raw pointers on it stay valid
+  held.reset();
+  const otb::ImageMetadata* outputAddress = &output->GetImageMetadata();
+  output->CopyInformation(input);
+  output->GetWritableImageMetadata().Add(otb::MDNum::PhysicalGain, 5.);
+
+  if (&output->GetImageMetadata() != outputAddress || output->GetImageMetadata()[otb::MDNum::PhysicalGain] != 5.
+      || input->GetImageMetadata()[otb::MDNum::PhysicalGain] != 2.)
+  {
+    std::cout << "Owned metadata should be updated in place" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Replacing unshared metadata keeps its address
+  const otb::ImageMetadata* address = &input->GetImageMetadata();
+  input->SetImageMetadata(imd);
+
+  if (&input->GetImageMetadata() != address)
+  {
+    std::cout << "Unshared metadata should be replaced in place" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPipelineProfiler_h
+#define otbPipelineProfiler_h
+
+#include "itkObject.h"
+#include "itkProcessObject.h"
+#include "otbPipelineMemoryPrintCalculator.h"
+#include "OTBStreamingExport.h"
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace otb
+{
+
+/** \class PipelineProfiler
+ *  \brief Record where the time goes during a streamed pipeline execution.
+ *
+ * The profiler observes the StartEvent and EndEvent of the process objects
+ * upstream of watched data objects. For each execution of a process object,
+ * it records the wall and CPU times, the requested region of the first output
+ * and the memory print of the image outputs. Writers and streaming writers
+ * mark each stream split and the time spent writing it, so that executions
+ * can be attributed to a split.
+ *
+ * CPU time is the CPU time of the whole process during the event: the ratio
+ * of CPU to wall time of a filter shows how well it keeps the threads busy.
+ *
+ * The profiler is a singleton, disabled by default. It is enabled at creation
+ * if the OTB_PROFILER_TRACE environment variable is set (see
+ * ConfigurationManager::GetProfilerTraceFile()), or with SetEnabled(). Events
+ * can be exported in the Chrome trace JSON format, which chrome://tracing and
+ * Perfetto read, and summarized per process object.
+ *
+ * \ingroup OTBStreaming
+ */
+class OTBStreaming_EXPORT PipelineProfiler : public itk::Object
+{
+public:
+  typedef PipelineProfiler              Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  itkTypeMacro(PipelineProfiler, itk::Object);
+
+  typedef PipelineMemoryPrintCalculator::MemoryPrintType MemoryPrintType;
+
+  /** Region of any dimension */
+  struct RegionType
+  {
+    std::vector<long>          index;
+    std::vector<unsigned long> size;
+  };
+
+  /** A recorded event. Times are in microseconds, starts are relative to the
+   * last call to Reset(). */
+  struct EventType
+  {
+    std::string     name;
+    std::string     category;
+    double          start;
+    double          wallTime;
+    double          cpuTime;
+    int             split; // -1 outside of the splits
+    RegionType      region;
+    MemoryPrintType memory;
+    unsigned int    thread;
+  };
+
+  /** Stream split event, ended when the object is destroyed. Does nothing if
+   * the profiler is disabled. */
+  class OTBStreaming_EXPORT ScopedSplit
+  {
+  public:
+    template <class TRegion>
+    ScopedSplit(unsigned int split, const TRegion& region) : m_Active(PipelineProfiler::Instance()->GetEnabled())
+    {
+      if (m_Active)
+      {
+        PipelineProfiler::Instance()->BeginSplit(split, ConvertRegion(region));
+      }
+    }
+
+    ~ScopedSplit();
+
+  private:
+    ScopedSplit(const ScopedSplit&) = delete;
+    void operator=(const ScopedSplit&) = delete;
+
+    bool m_Active;
+  };
+
+  /** Generic event, ended when the object is destroyed. Does nothing if the
+   * profiler is disabled. */
+  class OTBStreaming_EXPORT ScopedEvent
+  {
+  public:
+    ScopedEvent(const std::string& name, const std::string& category);
+    ~ScopedEvent();
+
+  private:
+    ScopedEvent(const ScopedEvent&) = delete;
+    void operator=(const ScopedEvent&) = delete;
+
+    long m_Id;
+  };
+
+  static PipelineProfiler* Instance();
+
+  itkSetMacro(Enabled, bool);
+  itkGetConstMacro(Enabled, bool);
+  itkBooleanMacro(Enabled);
+
+  /** Observe all the process objects upstream of data. Process objects that
+   * are already observed are skipped. Observed process objects are kept alive
+   * until Unwatch(). */
+  void Watch(itk::DataObject* data);
+
+  /** Stop observing all process objects */
+  void Unwatch();
+
+  /** Remove all events and restart the clock */
+  void Reset();
+
+  /** Start an event, and return its identifier for EndEvent() */
+  long BeginEvent(const std::string& name, const std::string& category);
+  void EndEvent(long id);
+
+  /** Start a stream split. Events recorded until EndSplit() are attributed to
+   * this split. */
+  void BeginSplit(unsigned int split, const RegionType& region);
+  void EndSplit();
+
+  /** Copy of the recorded events */
+  std::vector<EventType> GetEvents() const;
+
+  /** Write the events in the Chrome trace JSON format. Returns false if the
+   * file can not be written. */
+  bool WriteTrace(const std::string& filename) const;
+
+  /** Print a table of the wall time, CPU time, memory print and number of
+   * executions of each process object */
+  void PrintSummary(std::ostream& os) const;
+
+  template <class TRegion>
+  static RegionType ConvertRegion(const TRegion& region)
+  {
+    RegionType converted;
+    for (unsigned int i = 0; i < TRegion::ImageDimension; ++i)
+    {
+      converted.index.push_back(region.GetIndex(i));
+      converted.size.push_back(region.GetSize(i));
+    }
+    return converted;
+  }
+
+protected:
+  PipelineProfiler();
+  ~PipelineProfiler() override = default;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  PipelineProfiler(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  typedef std::chrono::steady_clock ClockType;
+
+  /** Observer callbacks */
+  void OnStart(itk::Object* caller, const itk::EventObject& event);
+  void OnEnd(itk::Object* caller, const itk::EventObject& event);
+
+  /** Record the start of an event, the mutex must be locked */
+  long OpenEvent(const std::string& name, const std::string& category);
+
+  /** Record the end of an event, the mutex must be locked */
+  void CloseEvent(long id);
+
+  /** Stable small integer identifying the calling thread, the mutex must be
+   * locked */
+  unsigned int GetThreadNumber();
+
+  bool m_Enabled;
+
+  mutable std::mutex m_Mutex;
+
+  ClockType::time_point  m_Origin;
+  std::vector<EventType> m_Events;
+
+  /** CPU clock at the start of each open event */
+  std::map<long, std::clock_t> m_CPUStarts;
+
+  /** Open event of each running process object */
+  std::map<const itk::Object*, long> m_RunningProcesses;
+
+  /** Observed process object, held until Unwatch() */
+  struct WatchedProcessType
+  {
+    itk::ProcessObject::Pointer process;
+    unsigned long               startTag;
+    unsigned long               endTag;
+  };
+  std::map<const itk::ProcessObject*, WatchedProcessType> m_WatchedProcesses;
+
+  int  m_CurrentSplit;
+  long m_CurrentSplitEvent;
+
+  std::map<std::thread::id, unsigned int> m_ThreadNumbers;
+
+  PipelineMemoryPrintCalculator::Pointer m_MemoryPrintCalculator;
+};
+
+} // end namespace otb
+
+#endif
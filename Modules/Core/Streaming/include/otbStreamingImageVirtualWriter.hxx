@@ -32,6 +32,7 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbPipelineProfiler.h"
 #include "otbUtils.h"
 
 namespace otb
@@ -217,6 +218,7 @@ void StreamingImageVirtualWriter<TInputImage>::GenerateData(void)
        m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
   {
     streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    PipelineProfiler::ScopedSplit profiledSplit(m_CurrentDivision, streamRegion);
     // inputPtr->ReleaseData();
     // inputPtr->SetRequestedRegion(streamRegion);
     // inputPtr->Update();
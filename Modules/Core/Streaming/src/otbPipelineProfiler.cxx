@@ -0,0 +1,388 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbPipelineProfiler.h"
+
+#include "otbConfigurationManager.h"
+#include "itkCommand.h"
+#include "itkImageBase.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+namespace otb
+{
+
+namespace
+{
+std::string EscapeJSON(const std::string& str)
+{
+  std::ostringstream oss;
+  for (char c : str)
+  {
+    switch (c)
+    {
+    case '"':
+      oss << "\\\"";
+      break;
+    case '\\':
+      oss << "\\\\";
+      break;
+    case '\n':
+      oss << "\\n";
+      break;
+    case '\t':
+      oss << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+      {
+        oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+      }
+      else
+      {
+        oss << c;
+      }
+    }
+  }
+  return oss.str();
+}
+
+void WriteJSONRegion(std::ostream& os, const PipelineProfiler::RegionType& region)
+{
+  os << "\"index\":[";
+  for (size_t i = 0; i < region.index.size(); ++i)
+  {
+    os << (i ? "," : "") << region.index[i];
+  }
+  os << "],\"size\":[";
+  for (size_t i = 0; i < region.size.size(); ++i)
+  {
+    os << (i ? "," : "") << region.size[i];
+  }
+  os << "]";
+}
+}
+
+PipelineProfiler::ScopedSplit::~ScopedSplit()
+{
+  if (m_Active)
+  {
+    PipelineProfiler::Instance()->EndSplit();
+  }
+}
+
+PipelineProfiler::ScopedEvent::ScopedEvent(const std::string& name, const std::string& category) : m_Id(-1)
+{
+  if (PipelineProfiler::Instance()->GetEnabled())
+  {
+    m_Id = PipelineProfiler::Instance()->BeginEvent(name, category);
+  }
+}
+
+PipelineProfiler::ScopedEvent::~ScopedEvent()
+{
+  if (m_Id >= 0)
+  {
+    PipelineProfiler::Instance()->EndEvent(m_Id);
+  }
+}
+
+PipelineProfiler* PipelineProfiler::Instance()
+{
+  static PipelineProfiler* profiler_singleton = new PipelineProfiler;
+  return profiler_singleton;
+}
+
+PipelineProfiler::PipelineProfiler()
+  : m_Enabled(!ConfigurationManager::GetProfilerTraceFile().empty()),
+    m_Origin(ClockType::now()),
+    m_CurrentSplit(-1),
+    m_CurrentSplitEvent(-1),
+    m_MemoryPrintCalculator(PipelineMemoryPrintCalculator::New())
+{
+}
+
+void PipelineProfiler::Watch(itk::DataObject* data)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  typedef itk::MemberCommand<Self> CommandType;
+
+  std::vector<itk::DataObject*> toVisit(1, data);
+  while (!toVisit.empty())
+  {
+    itk::DataObject* current = toVisit.back();
+    toVisit.pop_back();
+    itk::ProcessObject* source = current ? current->GetSource() : nullptr;
+    if (!source || m_WatchedProcesses.count(source))
+    {
+      continue;
+    }
+
+    CommandType::Pointer startCommand = CommandType::New();
+    startCommand->SetCallbackFunction(this, &Self::OnStart);
+    CommandType::Pointer endCommand = CommandType::New();
+    endCommand->SetCallbackFunction(this, &Self::OnEnd);
+    WatchedProcessType& watched = m_WatchedProcesses[source];
+    watched.process             = source;
+    watched.startTag            = source->AddObserver(itk::StartEvent(), startCommand);
+    watched.endTag              = source->AddObserver(itk::EndEvent(), endCommand);
+
+    for (auto input : source->GetInputs())
+    {
+      toVisit.push_back(input.GetPointer());
+    }
+  }
+}
+
+void PipelineProfiler::Unwatch()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto const& watched : m_WatchedProcesses)
+  {
+    watched.second.process->RemoveObserver(watched.second.startTag);
+    watched.second.process->RemoveObserver(watched.second.endTag);
+  }
+  m_WatchedProcesses.clear();
+  m_RunningProcesses.clear();
+}
+
+void PipelineProfiler::Reset()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Events.clear();
+  m_CPUStarts.clear();
+  m_RunningProcesses.clear();
+  m_CurrentSplit      = -1;
+  m_CurrentSplitEvent = -1;
+  m_Origin            = ClockType::now();
+}
+
+long PipelineProfiler::BeginEvent(const std::string& name, const std::string& category)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return OpenEvent(name, category);
+}
+
+void PipelineProfiler::EndEvent(long id)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  CloseEvent(id);
+}
+
+void PipelineProfiler::BeginSplit(unsigned int split, const RegionType& region)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  std::ostringstream name;
+  name << "Split " << split;
+  m_CurrentSplit                       = split;
+  m_CurrentSplitEvent                  = OpenEvent(name.str(), "split");
+  m_Events[m_CurrentSplitEvent].region = region;
+}
+
+void PipelineProfiler::EndSplit()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  CloseEvent(m_CurrentSplitEvent);
+  m_CurrentSplit      = -1;
+  m_CurrentSplitEvent = -1;
+}
+
+std::vector<PipelineProfiler::EventType> PipelineProfiler::GetEvents() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Events;
+}
+
+long PipelineProfiler::OpenEvent(const std::string& name, const std::string& category)
+{
+  EventType event;
+  event.name     = name;
+  event.category = category;
+  event.start    = std::chrono::duration<double, std::micro>(ClockType::now() - m_Origin).count();
+  event.wallTime = 0.;
+  event.cpuTime  = 0.;
+  event.split    = m_CurrentSplit;
+  event.memory   = 0;
+  event.thread   = GetThreadNumber();
+
+  const long id = static_cast<long>(m_Events.size());
+  m_Events.push_back(event);
+  m_CPUStarts[id] = std::clock();
+  return id;
+}
+
+void PipelineProfiler::CloseEvent(long id)
+{
+  auto cpuStart = m_CPUStarts.find(id);
+  if (id < 0 || id >= static_cast<long>(m_Events.size()) || cpuStart == m_CPUStarts.end())
+  {
+    return;
+  }
+  EventType& event = m_Events[id];
+  event.wallTime   = std::chrono::duration<double, std::micro>(ClockType::now() - m_Origin).count() - event.start;
+  event.cpuTime    = 1e6 * static_cast<double>(std::clock() - cpuStart->second) / CLOCKS_PER_SEC;
+  m_CPUStarts.erase(cpuStart);
+}
+
+unsigned int PipelineProfiler::GetThreadNumber()
+{
+  auto inserted = m_ThreadNumbers.insert(std::make_pair(std::this_thread::get_id(), static_cast<unsigned int>(m_ThreadNumbers.size())));
+  return inserted.first->second;
+}
+
+void PipelineProfiler::OnStart(itk::Object* caller, const itk::EventObject& itkNotUsed(event))
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (!m_Enabled)
+  {
+    return;
+  }
+  m_RunningProcesses[caller] = OpenEvent(caller->GetNameOfClass(), "filter");
+}
+
+void PipelineProfiler::OnEnd(itk::Object* caller, const itk::EventObject& itkNotUsed(event))
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto running = m_RunningProcesses.find(caller);
+  if (running == m_RunningProcesses.end())
+  {
+    return;
+  }
+  const long id = running->second;
+  m_RunningProcesses.erase(running);
+  CloseEvent(id);
+
+  // Requested region of the first output, memory print of the image outputs
+  itk::ProcessObject* process = dynamic_cast<itk::ProcessObject*>(caller);
+  EventType&          event   = m_Events[id];
+  if (!process)
+  {
+    return;
+  }
+  for (auto output : process->GetOutputs())
+  {
+    typedef itk::ImageBase<2> ImageBaseType;
+    ImageBaseType* image = dynamic_cast<ImageBaseType*>(output.GetPointer());
+    if (!image)
+    {
+      continue;
+    }
+    if (event.region.size.empty())
+    {
+      event.region = ConvertRegion(image->GetRequestedRegion());
+    }
+    event.memory += m_MemoryPrintCalculator->EvaluateDataObjectPrint(image);
+  }
+}
+
+bool PipelineProfiler::WriteTrace(const std::string& filename) const
+{
+  std::ofstream ofs(filename.c_str());
+  if (!ofs)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  ofs << std::fixed << std::setprecision(3);
+  ofs << "{\"traceEvents\":[";
+  for (size_t i = 0; i < m_Events.size(); ++i)
+  {
+    const EventType& event = m_Events[i];
+    ofs << (i ? ",\n" : "\n");
+    ofs << "{\"name\":\"" << EscapeJSON(event.name) << "\",\"cat\":\"" << EscapeJSON(event.category) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+        << ",\"ts\":" << event.start << ",\"dur\":" << event.wallTime << ",\"args\":{\"cpu_us\":" << event.cpuTime << ",\"split\":" << event.split
+        << ",\"memory_bytes\":" << event.memory;
+    if (!event.region.size.empty())
+    {
+      ofs << ",";
+      WriteJSONRegion(ofs, event.region);
+    }
+    ofs << "}}";
+  }
+  ofs << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return static_cast<bool>(ofs);
+}
+
+void PipelineProfiler::PrintSummary(std::ostream& os) const
+{
+  struct SummaryType
+  {
+    std::string     name;
+    std::string     category;
+    unsigned long   count;
+    double          wallTime;
+    double          cpuTime;
+    MemoryPrintType maxMemory;
+  };
+
+  std::vector<SummaryType> summaries;
+  double                   totalWallTime = 0.;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::map<std::string, size_t> indices;
+    for (auto const& event : m_Events)
+    {
+      // Splits contain the other events
+      if (event.category == "split")
+      {
+        totalWallTime += event.wallTime;
+        continue;
+      }
+      auto inserted = indices.insert(std::make_pair(event.category + "/" + event.name, summaries.size()));
+      if (inserted.second)
+      {
+        summaries.push_back(SummaryType{event.name, event.category, 0, 0., 0., 0});
+      }
+      SummaryType& summary = summaries[inserted.first->second];
+      ++summary.count;
+      summary.wallTime += event.wallTime;
+      summary.cpuTime += event.cpuTime;
+      summary.maxMemory = std::max(summary.maxMemory, event.memory);
+    }
+  }
+
+  std::sort(summaries.begin(), summaries.end(), [](const SummaryType& a, const SummaryType& b) { return a.wallTime > b.wallTime; });
+
+  os << std::left << std::setw(48) << "Process" << std::right << std::setw(8) << "Calls" << std::setw(12) << "Wall (s)" << std::setw(8) << "Wall %"
+     << std::setw(12) << "CPU (s)" << std::setw(8) << "CPU/Wall" << std::setw(14) << "Max mem (MB)" << std::endl;
+  for (auto const& summary : summaries)
+  {
+    os << std::left << std::setw(48) << summary.name << std::right << std::setw(8) << summary.count << std::fixed << std::setprecision(3) << std::setw(12)
+       << summary.wallTime * 1e-6 << std::setprecision(1) << std::setw(8) << (totalWallTime > 0. ? 100. * summary.wallTime / totalWallTime : 0.)
+       << std::setprecision(3) << std::setw(12) << summary.cpuTime * 1e-6 << std::setprecision(2) << std::setw(8)
+       << (summary.wallTime > 0. ? summary.cpuTime / summary.wallTime : 0.) << std::setprecision(1) << std::setw(14)
+       << summary.maxMemory * PipelineMemoryPrintCalculator::ByteToMegabyte << std::endl;
+  }
+  os << "Total time in stream splits: " << std::setprecision(3) << totalWallTime * 1e-6 << " s" << std::endl;
+}
+
+void PipelineProfiler::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << m_Enabled << std::endl;
+  os << indent << "Number of events: " << GetEvents().size() << std::endl;
+}
+
+} // end namespace otb
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbPipelineProfiler.h"
+
+#include "otbVectorImage.h"
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "otbVectorImageToIntensityImageFilter.h"
+#include <iostream>
+
+int otbPipelineProfilerTest(int itkNotUsed(argc), char* argv[])
+{
+  typedef otb::VectorImage<double, 2>                                        VectorImageType;
+  typedef otb::Image<double, 2>                                              ImageType;
+  typedef otb::ImageFileReader<VectorImageType>                              ReaderType;
+  typedef otb::VectorImageToIntensityImageFilter<VectorImageType, ImageType> IntensityImageFilterType;
+  typedef otb::ImageFileWriter<ImageType>                                    WriterType;
+
+  const unsigned int nbDivisions = 4;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  IntensityImageFilterType::Pointer intensity = IntensityImageFilterType::New();
+  intensity->SetInput(reader->GetOutput());
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(intensity->GetOutput());
+  writer->SetFileName(argv[2]);
+  writer->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+
+  otb::PipelineProfiler* profiler = otb::PipelineProfiler::Instance();
+  profiler->EnabledOn();
+  profiler->Reset();
+  profiler->Watch(intensity->GetOutput());
+  writer->Update();
+  profiler->Unwatch();
+
+  unsigned int nbSplits = 0, nbWrites = 0, nbReads = 0, nbIntensity = 0;
+  for (auto const& event : profiler->GetEvents())
+  {
+    if (event.category == "split")
+    {
+      ++nbSplits;
+    }
+    else if (event.category == "write")
+    {
+      ++nbWrites;
+    }
+    else if (event.name == reader->GetNameOfClass())
+    {
+      ++nbReads;
+    }
+    else if (event.name == intensity->GetNameOfClass())
+    {
+      ++nbIntensity;
+      if (event.split < 0 || event.region.size.size() != 2 || event.memory == 0)
+      {
+        std::cerr << "Filter event without split, region or memory print" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (nbSplits != nbDivisions || nbWrites != nbDivisions || nbReads != nbDivisions || nbIntensity != nbDivisions)
+  {
+    std::cerr << "Unexpected number of events: " << nbSplits << " splits, " << nbWrites << " writes, " << nbReads << " reads, " << nbIntensity
+              << " intensity executions, " << nbDivisions << " expected" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  profiler->PrintSummary(std::cout);
+  if (!profiler->WriteTrace(argv[3]))
+  {
+    std::cerr << "Could not write " << argv[3] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  profiler->EnabledOff();
+  return EXIT_SUCCESS;
+}
@@ -134,6 +134,9 @@ public:
    * vector. This is used if we have a copy of m_Vector normalized. */
   RelativeFrequencyType GetFrequency(IndexValueType i, IndexValueType j, const VectorType& vect) const;
 
+  /** Get index of the pixelPair combination and save the result in index **/
+  bool GetIndex(const PixelPairType& pixelPair, IndexType& index) const;
+
 protected:
   GreyLevelCooccurrenceIndexedList();
   ~GreyLevelCooccurrenceIndexedList() override = default;
@@ -148,9 +151,6 @@ protected:
 
   void SetBinMax(const unsigned int dimension, const InstanceIdentifier nbin, PixelValueType max);
 
-  /** Get index of the pixelPair combination and save the result in index **/
-  bool GetIndex(const PixelPairType& pixelPair, IndexType& index) const;
-
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
 private:
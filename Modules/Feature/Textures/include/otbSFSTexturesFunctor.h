@@ -23,6 +23,8 @@
 
 #include "otbMath.h"
 #include "itkNumericTraits.h"
+#include <map>
+#include <utility>
 #include <vector>
 
 namespace otb
@@ -48,6 +50,11 @@ namespace otb
  *  IEEE Geoscience and Remote Sensing Letters,
  *  vol. 4, n. 2, 2007, pp 260-264
  *
+ *  The pixels visited along a line only depend on the offset where the line
+ *  stops, not on the central pixel: they are computed once per stop offset
+ *  and kept, with their position in the neighborhood, so that each pixel
+ *  only compares values along precomputed lines.
+ *
  * \ingroup Textures
  *
  * \ingroup OTBTextures
@@ -66,7 +73,10 @@ public:
     m_RatioMaxConsiderationNumber = 5;
     m_Alpha                       = 1;
     this->SetNumberOfDirections(20); // set the step too
-    m_SelectedTextures = std::vector<bool>(6, 1);
+    m_SelectedTextures          = std::vector<bool>(6, 1);
+    m_DirectionOffsetsThreshold = 0;
+    m_DirectionOffsetsStep      = 0.;
+    m_RayRadius.Fill(0);
   }
   virtual ~SFSTexturesFunctor()
   {
@@ -130,10 +140,8 @@ public:
   {
     double                    length                   = itk::NumericTraits<double>::NonpositiveMin();
     double                    width                    = itk::NumericTraits<double>::max();
-    double                    SpatialThresholdDouble   = static_cast<double>(m_SpatialThreshold);
     double                    NumberOfDirectionsDouble = static_cast<double>(m_NumberOfDirections);
     double                    dist                     = 0.;
-    double                    angle                    = 0.;
     double                    sdiVal                   = 0.;
     double                    sumWMean                 = 0.;
     double                    sum                      = 0.;
@@ -149,14 +157,12 @@ public:
     OffsetType off;
     off.Fill(0);
 
+    this->UpdateDirectionOffsets();
+
     for (unsigned int d = 0; d < m_NumberOfDirections; d++)
     {
-      // Current angle direction
-      angle = m_DirectionStep * static_cast<double>(d);
-
       // last offset in the direction respecting spatial threshold
-      off[0] = static_cast<int>(std::floor(SpatialThresholdDouble * std::cos(angle) + 0.5));
-      off[1] = static_cast<int>(std::floor(SpatialThresholdDouble * std::sin(angle) + 0.5));
+      off = m_DirectionOffsets[d];
       // last indices in the direction respecting spectral threshold
       OffsetType offEnd = this->FindLastOffset(it, off);
 
@@ -272,89 +278,122 @@ public:
    */
   OffsetType FindLastOffset(const TIter& it, const OffsetType& stopOffset)
   {
-    bool res   = true;
-    int  signX = this->ComputeStep(stopOffset[0]);
-    int  signY = this->ComputeStep(stopOffset[1]);
-
-    OffsetType currentOff;
-    currentOff.Fill(0);
-    currentOff[0] = signX;
+    const RayType&          ray    = this->GetRay(it, stopOffset);
+    const InternalPixelType center = it.GetCenterPixel();
 
-    double slop = 0.;
-    if (stopOffset[0] != 0)
-      slop = static_cast<double>(stopOffset[1] / static_cast<double>(stopOffset[0]));
-
-    bool isInside = true;
-    while (isInside == true && res == true)
+    for (unsigned int k = 0; k < ray.neighbors.size(); ++k)
     {
-      this->ComputePointLine(currentOff, slop, signY, stopOffset[0]);
-
-      if (std::abs(it.GetPixel(currentOff) - it.GetCenterPixel()) > m_SpectralThreshold)
+      if (std::abs(it.GetPixel(ray.neighbors[k]) - center) > m_SpectralThreshold)
       {
-        res = false;
+        return ray.offsets[k];
       }
-      else
-        currentOff[0] += signX;
+    }
+    return ray.end;
+  }
 
-      isInside = this->CheckIsInside(signX, signY, currentOff, stopOffset);
+  /** Computes SD in the ith direction. It is 0 if the line does not reach
+   * stopOffset within the spectral threshold. */
+  double ComputeSDi(const TIter& it, const OffsetType& stopOffset)
+  {
+    const RayType&          ray    = this->GetRay(it, stopOffset);
+    const InternalPixelType center = it.GetCenterPixel();
+
+    // First compute mean
+    double mean = 0.;
+    for (unsigned int k = 0; k < ray.neighbors.size(); ++k)
+    {
+      const InternalPixelType value = it.GetPixel(ray.neighbors[k]);
+      mean += static_cast<double>(value);
+      if (std::abs(value - center) >= m_SpectralThreshold)
+        return 0.;
     }
+    mean /= static_cast<double>(ray.neighbors.size());
 
-    return currentOff;
+    double SDi = 0.;
+    for (unsigned int k = 0; k < ray.neighbors.size(); ++k)
+    {
+      SDi += std::pow((static_cast<double>(it.GetPixel(ray.neighbors[k])) - mean), 2);
+    }
+    return std::sqrt(SDi);
   }
 
-  /** Computes SD in the ith direction */
-  double ComputeSDi(const TIter& it, const OffsetType& stopOffset)
+  /** Pixels visited on the line from the center to stopOffset */
+  struct RayType
   {
-    bool         canGo = true;
-    unsigned int nbElt = 0;
-    double       SDi   = 0.;
-    double       mean  = 0.;
-    double       slop  = 0.;
-    if (stopOffset[0] != 0)
-      slop = static_cast<double>(stopOffset[1] / static_cast<double>(stopOffset[0]));
+    /** Offsets of the visited pixels */
+    std::vector<OffsetType> offsets;
+    /** Position of the visited pixels in the neighborhood */
+    std::vector<unsigned int> neighbors;
+    /** Offset returned when all pixels respect the spectral threshold */
+    OffsetType end;
+  };
+
+  typedef std::pair<long, long>         RayKeyType;
+  typedef std::map<RayKeyType, RayType> RayMapType;
+
+  /** Get the line to stopOffset, computing it on the first call */
+  const RayType& GetRay(const TIter& it, const OffsetType& stopOffset)
+  {
+    if (it.GetRadius() != m_RayRadius)
+    {
+      m_Rays.clear();
+      m_RayRadius = it.GetRadius();
+    }
+
+    const RayKeyType                    key(stopOffset[0], stopOffset[1]);
+    typename RayMapType::const_iterator rayIt = m_Rays.find(key);
+    if (rayIt != m_Rays.end())
+    {
+      return rayIt->second;
+    }
 
-    int signX = this->ComputeStep(stopOffset[0]);
-    int signY = this->ComputeStep(stopOffset[1]);
+    RayType& ray   = m_Rays[key];
+    int      signX = this->ComputeStep(stopOffset[0]);
+    int      signY = this->ComputeStep(stopOffset[1]);
 
     OffsetType currentOff;
     currentOff.Fill(0);
     currentOff[0] = signX;
 
+    double slop = 0.;
+    if (stopOffset[0] != 0)
+      slop = static_cast<double>(stopOffset[1] / static_cast<double>(stopOffset[0]));
+
     bool isInside = true;
-    // First compute mean
-    while (isInside == true && canGo == true)
+    while (isInside == true)
     {
       this->ComputePointLine(currentOff, slop, signY, stopOffset[0]);
-
-      mean += static_cast<double>(it.GetPixel(currentOff));
-      nbElt++;
-
-      if (std::abs(it.GetPixel(currentOff) - it.GetCenterPixel()) >= m_SpectralThreshold)
-        canGo = false;
-      else
-        currentOff[0] += signX;
-
+      ray.offsets.push_back(currentOff);
+      ray.neighbors.push_back(it.GetNeighborhoodIndex(currentOff));
+      currentOff[0] += signX;
       isInside = this->CheckIsInside(signX, signY, currentOff, stopOffset);
     }
+    ray.end = currentOff;
 
-    mean /= static_cast<double>(nbElt);
-    currentOff[0] = signX;
-    currentOff[1] = 0;
-    isInside      = true;
+    return ray;
+  }
 
-    while (isInside == true && canGo == true)
+  /** Compute the last offset of each direction, if the spatial threshold or
+   * the directions changed */
+  void UpdateDirectionOffsets()
+  {
+    if (m_DirectionOffsets.size() == m_NumberOfDirections && m_DirectionOffsetsThreshold == m_SpatialThreshold && m_DirectionOffsetsStep == m_DirectionStep)
     {
-      this->ComputePointLine(currentOff, slop, signY, stopOffset[0]);
+      return;
+    }
 
-      SDi += std::pow((static_cast<double>(it.GetPixel(currentOff)) - mean), 2);
-      if (std::abs(it.GetPixel(currentOff) - it.GetCenterPixel()) >= m_SpectralThreshold)
-        canGo = false;
-      else
-        currentOff[0] += signX;
+    const double SpatialThresholdDouble = static_cast<double>(m_SpatialThreshold);
+    m_DirectionOffsets.resize(m_NumberOfDirections);
+    for (unsigned int d = 0; d < m_NumberOfDirections; d++)
+    {
+      // Current angle direction
+      double angle = m_DirectionStep * static_cast<double>(d);
 
-      isInside = this->CheckIsInside(signX, signY, currentOff, stopOffset);
+      m_DirectionOffsets[d][0] = static_cast<int>(std::floor(SpatialThresholdDouble * std::cos(angle) + 0.5));
+      m_DirectionOffsets[d][1] = static_cast<int>(std::floor(SpatialThresholdDouble * std::sin(angle) + 0.5));
     }
-    return std::sqrt(SDi);
+    m_DirectionOffsetsThreshold = m_SpatialThreshold;
+    m_DirectionOffsetsStep      = m_DirectionStep;
   }
 
   /** Check if the current offset is inside the stop one. */
@@ -416,6 +455,16 @@ protected:
    *  Set to 1 means the texture will be computed.
    **/
   std::vector<bool> m_SelectedTextures;
+
+  /** Last offset of each direction */
+  std::vector<OffsetType> m_DirectionOffsets;
+  unsigned int            m_DirectionOffsetsThreshold;
+  double                  m_DirectionOffsetsStep;
+
+  /** Lines computed so far, by stop offset, for neighborhoods of radius
+   * m_RayRadius */
+  RayMapType m_Rays;
+  SizeType   m_RayRadius;
 };
 
 } // end namespace functor
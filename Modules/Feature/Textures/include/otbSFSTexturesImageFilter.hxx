@@ -233,6 +233,8 @@ void SFSTexturesImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateDa
     itkExceptionMacro(<< "Spatial Threshold (" << this->GetSpatialThreshold() << ") is lower than Ration Max Consideration Number ("
                       << this->GetRatioMaxConsiderationNumber() << ") what is not allowed.");
   }
+  // One copy of the functor per thread, as each one keeps its own lines
+  m_FunctorList.clear();
   for (unsigned int i = 0; i < this->GetNumberOfThreads(); ++i)
   {
     m_FunctorList.push_back(m_Functor);
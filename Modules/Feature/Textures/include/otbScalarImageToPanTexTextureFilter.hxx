@@ -22,11 +22,13 @@
 #define otbScalarImageToPanTexTextureFilter_hxx
 
 #include "otbScalarImageToPanTexTextureFilter.h"
-#include "itkImageRegionIteratorWithIndex.h"
-#include "itkConstNeighborhoodIterator.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include "itkNumericTraits.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
 
 namespace otb
 {
@@ -90,99 +92,175 @@ void ScalarImageToPanTexTextureFilter<TInputImage, TOutputImage>::ThreadedGenera
                                                                                        itk::ThreadIdType threadId)
 {
   // Retrieve the input and output pointers
-  InputImagePointerType  inputPtr  = const_cast<InputImageType*>(this->GetInput());
+  const InputImageType*  inputPtr  = this->GetInput();
   OutputImagePointerType outputPtr = this->GetOutput();
 
-  itk::ImageRegionIteratorWithIndex<OutputImageType> outputIt(outputPtr, outputRegionForThread);
-  outputIt.GoToBegin();
+  const InputRegionType& requestedRegion = inputPtr->GetRequestedRegion();
+  const InputRegionType& bufferedRegion  = inputPtr->GetBufferedRegion();
 
   // Set-up progress reporting
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize()[1] * m_OffsetList.size());
+
+  // Input pixels covered by the windows of this thread
+  InputRegionType windowRegion = outputRegionForThread;
+  windowRegion.PadByRadius(m_Radius);
+  windowRegion.Crop(requestedRegion);
 
-  // Iterate on outputs to compute textures
-  while (!outputIt.IsAtEnd())
+  // Input pixels reached by the offsets from the windows
+  SizeType maxOffsetSize;
+  maxOffsetSize.Fill(0);
+  for (const auto& offset : m_OffsetList)
   {
-    // Initialise output value
-    double out = itk::NumericTraits<double>::max();
+    for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+    {
+      maxOffsetSize[dim] = std::max(maxOffsetSize[dim], static_cast<typename SizeType::SizeValueType>(std::abs(offset[dim])));
+    }
+  }
+  InputRegionType binRegion = windowRegion;
+  binRegion.PadByRadius(maxOffsetSize);
+  binRegion.Crop(bufferedRegion);
 
-    // For each offset
-    typename OffsetListType::const_iterator offIt;
-    for (offIt = m_OffsetList.begin(); offIt != m_OffsetList.end(); ++offIt)
+  // Co-occurrence bin of each pixel, computed once instead of once per pair
+  // and per window. Pixels outside [min, max] are left out (bin -1).
+  CooccurrenceIndexedListPointerType binning = CooccurrenceIndexedListType::New();
+  binning->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
+
+  const PixelValueType minimum  = m_InputImageMinimum;
+  const PixelValueType maximum  = m_InputImageMaximum;
+  const long           binStart = binRegion.GetIndex()[0];
+  const long           binRow   = binRegion.GetIndex()[1];
+  const long           binWidth = binRegion.GetSize()[0];
+  std::vector<long>    bins(binRegion.GetNumberOfPixels());
+
+  itk::ImageRegionConstIterator<InputImageType> inIt(inputPtr, binRegion);
+  typename std::vector<long>::iterator          binIt = bins.begin();
+  for (inIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++binIt)
+  {
+    const PixelValueType value = inIt.Get();
+    *binIt                     = -1;
+    if (value >= minimum && value <= maximum)
     {
-      OffsetType currentOffset = *offIt;
+      typename CooccurrenceIndexedListType::PixelPairType pair;
+      pair.Fill(value);
+      CooccurrenceIndexType index;
+      binning->GetIndex(pair, index);
+      *binIt = index[0];
+    }
+  }
 
-      // Compute the region on which co-occurence will be estimated
-      typename InputRegionType::IndexType inputIndex;
-      typename InputRegionType::SizeType  inputSize;
+  const long firstColumn = windowRegion.GetIndex()[0];
+  const long lastColumn  = firstColumn + static_cast<long>(windowRegion.GetSize()[0]) - 1;
+  const long firstRow    = windowRegion.GetIndex()[1];
+  const long lastRow     = firstRow + static_cast<long>(windowRegion.GetSize()[1]) - 1;
+  const long radiusX     = m_Radius[0];
+  const long radiusY     = m_Radius[1];
 
-      // First, create an window for neighborhood iterator based on m_Radius
-      // For example, if xradius and yradius is 2. window size is 5x5 (2 *
-      // radius + 1).
-      for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
-      {
-        inputIndex[dim] = outputIt.GetIndex()[dim] - m_Radius[dim];
-        inputSize[dim]  = 2 * m_Radius[dim] + 1;
-      }
-      
-      // Build the input region
-      InputRegionType inputRegion = {inputIndex, inputSize};
-      inputRegion.Crop(inputPtr->GetRequestedRegion());
-
-      SizeType neighborhoodRadius;
-      /** calculate minimum offset and set it as neighborhood radius **/
-      unsigned int minRadius = 0;
-      for (unsigned int i = 0; i < currentOffset.GetOffsetDimension(); i++)
-      {
-        unsigned int distance = std::abs(currentOffset[i]);
-        if (distance > minRadius)
-        {
-          minRadius = distance;
-        }
-      }
-      neighborhoodRadius.Fill(minRadius);
+  const long outStartX = outputRegionForThread.GetIndex()[0];
+  const long outStartY = outputRegionForThread.GetIndex()[1];
+  const long outSizeX  = outputRegionForThread.GetSize()[0];
+  const long outSizeY  = outputRegionForThread.GetSize()[1];
 
-      CooccurrenceIndexedListPointerType GLCIList = CooccurrenceIndexedListType::New();
-      GLCIList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
+  // Minimum contrast over the offsets, for each output pixel
+  std::vector<double> minContrast(outputRegionForThread.GetNumberOfPixels(), itk::NumericTraits<double>::max());
 
-      typedef itk::ConstNeighborhoodIterator<InputImageType> NeighborhoodIteratorType;
-      NeighborhoodIteratorType neighborIt = NeighborhoodIteratorType(neighborhoodRadius, inputPtr, inputRegion);
+  // Sums of squared bin differences and number of pairs, for each column of
+  // the current window rows
+  std::vector<itk::SizeValueType> columnContrast(windowRegion.GetSize()[0]);
+  std::vector<itk::SizeValueType> columnPairs(windowRegion.GetSize()[0]);
 
-      for (neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt)
+  for (const auto& offset : m_OffsetList)
+  {
+    // Add (sign = 1) or remove (sign = -1) the pairs starting on row y
+    auto updateRow = [&](long y, int sign) {
+      for (long x = firstColumn; x <= lastColumn; ++x)
       {
-        const InputPixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-        bool                 pixelInBounds;
-        const InputPixelType pixelIntensity = neighborIt.GetPixel(currentOffset, pixelInBounds);
-        if (!pixelInBounds)
+        typename InputImageType::IndexType other;
+        other[0] = x + offset[0];
+        other[1] = y + offset[1];
+        if (!bufferedRegion.IsInside(other))
         {
-          continue; // don't put a pixel in the histogram if it's out-of-bounds.
+          continue;
+        }
+        const long b1 = bins[(y - binRow) * binWidth + x - binStart];
+        const long b2 = bins[(other[1] - binRow) * binWidth + other[0] - binStart];
+        if (b1 < 0 || b2 < 0)
+        {
+          continue;
+        }
+        const itk::SizeValueType contrast = (b1 - b2) * (b1 - b2);
+        if (sign > 0)
+        {
+          columnContrast[x - firstColumn] += contrast;
+          columnPairs[x - firstColumn] += 1;
+        }
+        else
+        {
+          columnContrast[x - firstColumn] -= contrast;
+          columnPairs[x - firstColumn] -= 1;
         }
-        GLCIList->AddPixelPair(centerPixelIntensity, pixelIntensity);
       }
+    };
 
-      VectorConstIteratorType constVectorIt;
-      VectorType              glcVector      = GLCIList->GetVector();
-      double                  totalFrequency = static_cast<double>(GLCIList->GetTotalFrequency());
+    std::fill(columnContrast.begin(), columnContrast.end(), 0);
+    std::fill(columnPairs.begin(), columnPairs.end(), 0);
+    long windowTop    = std::max(outStartY - radiusY, firstRow);
+    long windowBottom = windowTop - 1;
 
-      // Compute inertia aka contrast
-      double inertia = 0;
-      constVectorIt  = glcVector.begin();
-      while (constVectorIt != glcVector.end())
+    for (long j = 0; j < outSizeY; ++j)
+    {
+      // Slide the window rows down to the current output row
+      const long y      = outStartY + j;
+      const long bottom = std::min(y + radiusY, lastRow);
+      const long top    = std::max(y - radiusY, firstRow);
+      while (windowBottom < bottom)
+      {
+        updateRow(++windowBottom, 1);
+      }
+      while (windowTop < top)
       {
-        CooccurrenceIndexType index     = constVectorIt->first;
-        RelativeFrequencyType frequency = constVectorIt->second / totalFrequency;
-        inertia += (index[0] - index[1]) * (index[0] - index[1]) * frequency;
-        ++constVectorIt;
+        updateRow(windowTop++, -1);
       }
 
-      if (inertia < out)
+      // Slide the window columns along the row
+      itk::SizeValueType contrast = 0;
+      itk::SizeValueType pairs    = 0;
+      long               left     = std::max(outStartX - radiusX, firstColumn);
+      long               right    = left - 1;
+      double*            out      = &minContrast[j * outSizeX];
+      for (long i = 0; i < outSizeX; ++i)
       {
-        out = inertia;
+        const long x     = outStartX + i;
+        const long end   = std::min(x + radiusX, lastColumn);
+        const long start = std::max(x - radiusX, firstColumn);
+        while (right < end)
+        {
+          ++right;
+          contrast += columnContrast[right - firstColumn];
+          pairs += columnPairs[right - firstColumn];
+        }
+        while (left < start)
+        {
+          contrast -= columnContrast[left - firstColumn];
+          pairs -= columnPairs[left - firstColumn];
+          ++left;
+        }
+
+        // Inertia aka contrast of the co-occurrences of the window
+        const double inertia = pairs > 0 ? static_cast<double>(contrast) / static_cast<double>(pairs) : 0.;
+        if (inertia < out[i])
+        {
+          out[i] = inertia;
+        }
       }
+      progress.CompletedPixel();
     }
+  }
 
-    outputIt.Set(out);
-    ++outputIt;
-    progress.CompletedPixel();
+  itk::ImageRegionIterator<OutputImageType>    outputIt(outputPtr, outputRegionForThread);
+  typename std::vector<double>::const_iterator resIt = minContrast.begin();
+  for (outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++outputIt, ++resIt)
+  {
+    outputIt.Set(*resIt);
   }
 }
 
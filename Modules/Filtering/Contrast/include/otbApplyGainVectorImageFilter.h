@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbApplyGainVectorImageFilter_h
+#define otbApplyGainVectorImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class ApplyGainVectorImageFilter
+ *  \brief Apply gains on all the bands of a vector image with a bilinear interpolation
+ *
+ *  This class is the multi-band counterpart of ApplyGainFilter: each band
+ *  has its own look up table, minimum and maximum, and all the bands are
+ *  equalized in a single pass. The position of a pixel in the look up table
+ *  grid and the interpolation weights are computed once per pixel and shared
+ *  by all the bands, which requires all the look up tables to have the same
+ *  grid. The result of each band is identical to the one of ApplyGainFilter.
+ *
+ *  Bands without look up table are copied to the output.
+ *
+ * \sa ApplyGainFilter
+ *
+ * \ingroup OTBContrast
+ */
+
+template <class TInputImage, class TLut, class TOutputImage>
+class ITK_EXPORT ApplyGainVectorImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** typedef for standard classes. */
+
+  typedef TInputImage  InputImageType;
+  typedef TOutputImage OutputImageType;
+
+  typedef ApplyGainVectorImageFilter Self;
+  typedef itk::ImageToImageFilter<InputImageType, OutputImageType> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  typedef TLut                                        LutType;
+  typedef typename InputImageType::PixelType          InputVectorPixelType;
+  typedef typename InputImageType::InternalPixelType  InputPixelType;
+  typedef typename OutputImageType::InternalPixelType OutputPixelType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ApplyGainVectorImageFilter, ImageToImageFilter);
+
+  /** Get/Set macro to get/set the nodata value */
+  itkSetMacro(NoData, InputPixelType);
+  itkGetMacro(NoData, InputPixelType);
+
+  /** Get/Set macro to get/set the nodata flag value */
+  itkBooleanMacro(NoDataFlag);
+  itkGetMacro(NoDataFlag, bool);
+  itkSetMacro(NoDataFlag, bool);
+
+  /** Get/Set macro to get/set the minimum value of each band */
+  itkSetMacro(Min, InputVectorPixelType);
+  itkGetConstReferenceMacro(Min, InputVectorPixelType);
+
+  /** Get/Set macro to get/set the maximum value of each band */
+  itkSetMacro(Max, InputVectorPixelType);
+  itkGetConstReferenceMacro(Max, InputVectorPixelType);
+
+  /** Set the input image*/
+  void SetInputImage(const InputImageType* input);
+
+  /** Set the look up table of a band. A null look up table copies the band. */
+  void SetInputLut(unsigned int band, const LutType* lut);
+
+protected:
+  ApplyGainVectorImageFilter();
+  ~ApplyGainVectorImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Get the input image*/
+  const InputImageType* GetInputImage() const;
+
+  /** Get the look up table of a band, null if the band is copied */
+  const LutType* GetInputLut(unsigned int band) const;
+
+  void GenerateOutputInformation() override;
+
+  void GenerateInputRequestedRegion() override;
+
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+  void VerifyInputInformation() override{};
+
+private:
+  ApplyGainVectorImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  InputPixelType       m_NoData;
+  InputVectorPixelType m_Min;
+  InputVectorPixelType m_Max;
+  bool                 m_NoDataFlag;
+  std::vector<double>  m_Step;
+  const LutType*       m_ReferenceLut;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbApplyGainVectorImageFilter.hxx"
+#endif
+
+
+#endif
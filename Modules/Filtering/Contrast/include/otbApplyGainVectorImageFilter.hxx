@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbApplyGainVectorImageFilter_hxx
+#define otbApplyGainVectorImageFilter_hxx
+
+#include "otbApplyGainVectorImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkContinuousIndex.h"
+
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+template <class TInputImage, class TLut, class TOutputImage>
+ApplyGainVectorImageFilter<TInputImage, TLut, TOutputImage>::ApplyGainVectorImageFilter()
+{
+  this->SetNumberOfRequiredInputs(1);
+  m_NoData       = std::numeric_limits<InputPixelType>::quiet_NaN();
+  m_NoDataFlag   = false;
+  m_ReferenceLut = nullptr;
+}
+
+template <class TInputImage, class TLut, class TOutputImage>
+void ApplyGainVectorImageFilter<TInputImage, TLut, TOutputImage>::SetInputImage(const InputImageType* input)
+{
+  // Process object is not const-correct so the const casting is required.
+  this->SetNthInput(0, const_cast<InputImageType*>(input));
+}
+
+template <class TInputImage, class TLut, class TOutputImage>
+const TInputImage* ApplyGainVectorImageFilter<TInputImage, TLut, TOutputImage>::GetInputImage() const
+{
+  return static_cast<const InputImageType*>(this->itk::ProcessObject::GetInput(0));
+}
+
+template <class TInputImage, class TLut, class TOutputImage>
+void ApplyGainVectorImageFilter<TInputImage, TLut, TOutputImage>::SetInputLut(unsigned int band, const LutType* lut)
+{
+  // Process object is not const-correct so the const casting is required.
+  this->SetNthInput(band + 1, const_cast<LutType*>(lut));
+}
+
+template <class TInputImage, class TLut, class TOutputImage>
+const TLut* ApplyGainVectorImageFilter<TInputImage, TLut, TOutputImage>::GetInputLut(unsigned int band) const
+{
+  if (band + 1 >= this->GetNumberOfIndexedInputs())
+  {
+    return nullptr;
+  }
+  return static_cast<const LutType*>(this->itk::ProcessObject::GetInput(band + 1));
+}
+
+template <class TInputImage, class TLut, class TOutputImage>
+void ApplyGainVectorImageFilter<TInputImage, TLut, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  this->GetOutput()->SetNumberOfComponentsPerPixel(GetInputImage()->GetNumberOfComponentsPerPixel());
+}
+
+template <class TInputImage, class TLut, class TOutputImage>
+void ApplyGainVectorImageFilter<TInputImage, TLut, TOutputImage>::GenerateInputRequestedRegion()
+{
+  typename InputImageType::Pointer  input(const_cast<InputImageType*>(GetInputImage()));
+  typename OutputImageType::Pointer output(this->GetOutput());
+
+  const unsigned int nbBands = input->GetNumberOfComponentsPerPixel();
+  for (unsigned int band = 0; band < nbBands; ++band)
+  {
+    typename LutType::Pointer lut(const_cast<LutType*>(GetInputLut(band)));
+    if (lut.IsNotNull())
+    {
+      lut->SetRequestedRegion(lut->GetLargestPossibleRegion());
+    }
+  }
+
+  input->SetRequestedRegion(output->GetRequestedRegion());
+  if (input->GetRequestedRegion().GetNumberOfPixels() == 0)
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <class TInputImage, class TLut, class TOutputImage>
+void ApplyGainVectorImageFilter<TInputImage, TLut, TOutputImage>::BeforeThreadedGenerateData()
+{
+  const unsigned int nbBands = GetInputImage()->GetNumberOfComponentsPerPixel();
+  if (m_Min.GetSize() != nbBands || m_Max.GetSize() != nbBands)
+  {
+    itkExceptionMacro(<< "Minimum and maximum must have one value per band (" << nbBands << ")");
+  }
+
+  // The interpolation weights are shared by all the bands, so every look up
+  // table must be defined on the same grid
+  m_ReferenceLut = nullptr;
+  m_Step.assign(nbBands, -1);
+  for (unsigned int band = 0; band < nbBands; ++band)
+  {
+    const LutType* lut = GetInputLut(band);
+    if (!lut)
+    {
+      continue;
+    }
+    if (!m_ReferenceLut)
+    {
+      m_ReferenceLut = lut;
+    }
+    else if (lut->GetLargestPossibleRegion() != m_ReferenceLut->GetLargestPossibleRegion() || lut->GetOrigin() != m_ReferenceLut->GetOrigin() ||
+             lut->GetSignedSpacing() != m_ReferenceLut->GetSignedSpacing())
+    {
+      itkExceptionMacro(<< "Look up table of band " << band << " is not defined on the same grid as the other ones");
+    }
+    if (lut->GetBufferedRegion() != lut->GetLargestPossibleRegion())
+    {
+      itkExceptionMacro(<< "Look up table of band " << band << " is not fully buffered");
+    }
+    m_Step[band] = static_cast<double>(m_Max[band] - m_Min[band]) / static_cast<double>(lut->GetVectorLength() - 1);
+  }
+}
+
+template <class TInputImage, class TLut, class TOutputImage>
+void ApplyGainVectorImageFilter<TInputImage, TLut, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                       itk::ThreadIdType itkNotUsed(threadId))
+{
+  typedef typename LutType::InternalPixelType LutValueType;
+
+  const InputImageType*             input(GetInputImage());
+  typename OutputImageType::Pointer output(this->GetOutput());
+  const unsigned int                nbBands(input->GetNumberOfComponentsPerPixel());
+
+  // Direct access to the look up tables, null for copied bands
+  std::vector<const LutValueType*> lutBuffers(nbBands, nullptr);
+  std::vector<unsigned int>        lutLengths(nbBands, 0);
+  for (unsigned int band = 0; band < nbBands; ++band)
+  {
+    const LutType* lut = GetInputLut(band);
+    if (lut)
+    {
+      assert(m_Step[band] > 0);
+      lutBuffers[band] = lut->GetBufferPointer();
+      lutLengths[band] = lut->GetVectorLength();
+    }
+  }
+
+  typename LutType::IndexType maxIndex;
+  maxIndex.Fill(0);
+  if (m_ReferenceLut)
+  {
+    maxIndex[0] = m_ReferenceLut->GetLargestPossibleRegion().GetSize()[0];
+    maxIndex[1] = m_ReferenceLut->GetLargestPossibleRegion().GetSize()[1];
+  }
+
+  itk::ImageRegionConstIteratorWithIndex<InputImageType> it(input, outputRegionForThread);
+  itk::ImageRegionIterator<OutputImageType>              oit(output, outputRegionForThread);
+
+  typename OutputImageType::PixelType      outputPixel(nbBands);
+  typename InputImageType::PointType       pixelPoint;
+  typename itk::ContinuousIndex<double, 2> pixelIndex;
+  typename LutType::IndexType              neighbors[4];
+  itk::OffsetValueType                     offsets[4];
+  float                                    weights[4];
+  unsigned int                             nbNeighbors(0);
+
+  for (it.GoToBegin(), oit.GoToBegin(); !oit.IsAtEnd(); ++oit, ++it)
+  {
+    const InputVectorPixelType pixel(it.Get());
+    bool                       located(false);
+
+    for (unsigned int band = 0; band < nbBands; ++band)
+    {
+      const InputPixelType currentPixel(pixel[band]);
+      double               newValue(static_cast<double>(currentPixel));
+      if (lutBuffers[band] && !((currentPixel == m_NoData && m_NoDataFlag) || currentPixel > m_Max[band] || currentPixel < m_Min[band]))
+      {
+        if (!located)
+        {
+          // Neighboring thumbnails and weights, with the same arithmetic as
+          // ApplyGainFilter::InterpolateGain()
+          input->TransformIndexToPhysicalPoint(it.GetIndex(), pixelPoint);
+          m_ReferenceLut->TransformPhysicalPointToContinuousIndex(pixelPoint, pixelIndex);
+          neighbors[0][0] = std::floor(pixelIndex[0]);
+          neighbors[0][1] = std::floor(pixelIndex[1]);
+          neighbors[1][0] = neighbors[0][0] + 1;
+          neighbors[1][1] = neighbors[0][1];
+          neighbors[2][0] = neighbors[0][0];
+          neighbors[2][1] = neighbors[0][1] + 1;
+          neighbors[3][0] = neighbors[0][0] + 1;
+          neighbors[3][1] = neighbors[0][1] + 1;
+          nbNeighbors     = 0;
+          for (const auto& i : neighbors)
+          {
+            if (i[0] < 0 || i[1] < 0 || i[0] >= maxIndex[0] || i[1] >= maxIndex[1])
+              continue;
+            offsets[nbNeighbors] = m_ReferenceLut->ComputeOffset(i);
+            weights[nbNeighbors] = (1 - std::abs(pixelIndex[0] - i[0])) * (1 - std::abs(pixelIndex[1] - i[1]));
+            ++nbNeighbors;
+          }
+          located = true;
+        }
+
+        const unsigned int pixelLutValue = static_cast<unsigned int>(std::round((currentPixel - m_Min[band]) / m_Step[band]));
+
+        float gain(0.f), w(0.f);
+        for (unsigned int n = 0; n < nbNeighbors; ++n)
+        {
+          const LutValueType value(lutBuffers[band][offsets[n] * lutLengths[band] + pixelLutValue]);
+          if (value == -1)
+            continue;
+          gain += value * weights[n];
+          w += weights[n];
+        }
+        if (w == 0)
+        {
+          w    = 1;
+          gain = 1;
+        }
+        newValue *= gain / w;
+      }
+      outputPixel[band] = static_cast<OutputPixelType>(newValue);
+    }
+    oit.Set(outputPixel);
+  }
+}
+
+/**
+ * Standard "PrintSelf" method
+ */
+template <class TInputImage, class TLut, class TOutputImage>
+void ApplyGainVectorImageFilter<TInputImage, TLut, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Is no data activated : " << m_NoDataFlag << std::endl;
+  os << indent << "No Data : " << m_NoData << std::endl;
+  os << indent << "Minimum : " << m_Min << std::endl;
+  os << indent << "Maximum : " << m_Max << std::endl;
+}
+
+
+} // End namespace otb
+
+#endif
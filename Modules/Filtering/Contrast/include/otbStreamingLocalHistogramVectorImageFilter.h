@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingLocalHistogramVectorImageFilter_h
+#define otbStreamingLocalHistogramVectorImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentLocalHistogramVectorImageFilter
+ * \brief Compute the local histograms of all the bands of an image, using streaming
+ *
+ * This filter is the multi-band counterpart of ComputeHistoFilter: the image
+ * is divided in thumbnails of ThumbSize pixels, and the histogram of each
+ * thumbnail is computed for every band, in a single pass over the vector
+ * image. Binning, nodata handling and contrast limitation (Threshold) are the
+ * same as in ComputeHistoFilter, so that the histograms are identical to the
+ * ones of a ComputeHistoFilter applied to each band.
+ *
+ * Each thread accumulates its own histograms, which are summed when
+ * Synthetize() is called. Bands whose minimum is not lower than their maximum
+ * are skipped and get empty histograms.
+ *
+ * The histograms of each band are VectorImage with one pixel per thumbnail
+ * and one component per bin, with the spacing and origin expected by
+ * ComputeGainLutFilter and ApplyGainFilter.
+ *
+ * \sa ComputeHistoFilter
+ * \sa PersistentImageFilter
+ *
+ * \ingroup OTBContrast
+ */
+template <class TInputImage, class THistogramImage>
+class ITK_EXPORT PersistentLocalHistogramVectorImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentLocalHistogramVectorImageFilter       Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>                         Pointer;
+  typedef itk::SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentLocalHistogramVectorImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                             ImageType;
+  typedef typename TInputImage::RegionType        RegionType;
+  typedef typename TInputImage::SizeType          SizeType;
+  typedef typename TInputImage::IndexType         IndexType;
+  typedef typename TInputImage::PixelType         PixelType;
+  typedef typename TInputImage::InternalPixelType InternalPixelType;
+
+  typedef THistogramImage                                HistogramImageType;
+  typedef typename HistogramImageType::Pointer           HistogramImagePointerType;
+  typedef typename HistogramImageType::InternalPixelType CountType;
+
+  /** Get/Set macro to get/set the number of bin. Default value is 256 */
+  itkSetMacro(NbBin, unsigned int);
+  itkGetMacro(NbBin, unsigned int);
+
+  /** Get/Set macro to get/set the minimum value of each band */
+  itkSetMacro(Min, PixelType);
+  itkGetConstReferenceMacro(Min, PixelType);
+
+  /** Get/Set macro to get/set the maximum value of each band */
+  itkSetMacro(Max, PixelType);
+  itkGetConstReferenceMacro(Max, PixelType);
+
+  /** Get/Set macro to get/set the nodata value */
+  itkSetMacro(NoData, InternalPixelType);
+  itkGetMacro(NoData, InternalPixelType);
+
+  /** Get/Set macro to get/set the nodata flag value */
+  itkBooleanMacro(NoDataFlag);
+  itkGetMacro(NoDataFlag, bool);
+  itkSetMacro(NoDataFlag, bool);
+
+  /** Get/Set macro to get/set the thumbnail's size */
+  itkSetMacro(ThumbSize, SizeType);
+  itkGetMacro(ThumbSize, SizeType);
+
+  /** Get/Set macro to get/set the threshold parameter */
+  itkSetMacro(Threshold, float);
+  itkGetMacro(Threshold, float);
+
+  /** Number of histogram images, one per band */
+  unsigned int GetNumberOfHistograms() const
+  {
+    return static_cast<unsigned int>(m_Histograms.size());
+  }
+
+  /** Return the local histograms of a band. The same image is returned
+   * after each Reset(), as long as the number of bands does not change. */
+  HistogramImageType* GetHistogramOutput(unsigned int band);
+
+  /** Pass the input through unmodified. Do this by Grafting in the
+   *  AllocateOutputs method.
+   */
+  void AllocateOutputs() override;
+  void GenerateOutputInformation() override;
+  void Synthetize(void) override;
+  void Reset(void) override;
+
+protected:
+  PersistentLocalHistogramVectorImageFilter();
+  ~PersistentLocalHistogramVectorImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Multi-thread version GenerateData. */
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  PersistentLocalHistogramVectorImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Contrast limitation of one histogram, as in ComputeHistoFilter */
+  void ApplyThreshold(CountType* histogram, unsigned int total) const;
+
+  /** Histograms of each thread, ordered by thumbnail, band and bin */
+  std::vector<std::vector<CountType>>    m_ThreadHistograms;
+  std::vector<HistogramImagePointerType> m_Histograms;
+  std::vector<double>                    m_Step;
+  SizeType                               m_GridSize;
+  PixelType                              m_Min;
+  PixelType                              m_Max;
+  InternalPixelType                      m_NoData;
+  SizeType                               m_ThumbSize;
+  bool                                   m_NoDataFlag;
+  float                                  m_Threshold;
+  unsigned int                           m_NbBin;
+};
+
+/**===========================================================================*/
+
+/** \class StreamingLocalHistogramVectorImageFilter
+ * \brief This class streams the whole input image through the PersistentLocalHistogramVectorImageFilter.
+ *
+ * It calls the Reset() method of the PersistentLocalHistogramVectorImageFilter
+ * before streaming the image and the Synthetize() method after having
+ * streamed the image. The accessors on the results are wrapping the accessors
+ * of the internal PersistentLocalHistogramVectorImageFilter.
+ *
+ * \sa PersistentLocalHistogramVectorImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ *
+ * \ingroup OTBContrast
+ */
+template <class TInputImage, class THistogramImage>
+class ITK_EXPORT StreamingLocalHistogramVectorImageFilter
+    : public PersistentFilterStreamingDecorator<PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingLocalHistogramVectorImageFilter                                                                    Self;
+  typedef PersistentFilterStreamingDecorator<PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>> Superclass;
+  typedef itk::SmartPointer<Self>                                                                                     Pointer;
+  typedef itk::SmartPointer<const Self>                                                                               ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingLocalHistogramVectorImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef TInputImage                     InputImageType;
+  typedef typename Superclass::FilterType InternalFilterType;
+  typedef THistogramImage                 HistogramImageType;
+
+  using Superclass::SetInput;
+  void SetInput(InputImageType* input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+  const InputImageType* GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  /** Return the local histograms of a band */
+  HistogramImageType* GetHistogramOutput(unsigned int band)
+  {
+    return this->GetFilter()->GetHistogramOutput(band);
+  }
+
+  unsigned int GetNumberOfHistograms() const
+  {
+    return this->GetFilter()->GetNumberOfHistograms();
+  }
+
+protected:
+  /** Constructor */
+  StreamingLocalHistogramVectorImageFilter()
+  {
+  }
+  /** Destructor */
+  ~StreamingLocalHistogramVectorImageFilter() override
+  {
+  }
+
+private:
+  StreamingLocalHistogramVectorImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingLocalHistogramVectorImageFilter.hxx"
+#endif
+
+#endif
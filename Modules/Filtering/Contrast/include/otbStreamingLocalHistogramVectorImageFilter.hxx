@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingLocalHistogramVectorImageFilter_hxx
+#define otbStreamingLocalHistogramVectorImageFilter_hxx
+
+#include "otbStreamingLocalHistogramVectorImageFilter.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+
+template <class TInputImage, class THistogramImage>
+PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>::PersistentLocalHistogramVectorImageFilter()
+  : m_NoData(std::numeric_limits<InternalPixelType>::quiet_NaN()), m_NoDataFlag(false), m_Threshold(-1), m_NbBin(256)
+{
+  m_ThumbSize.Fill(0);
+  m_GridSize.Fill(0);
+}
+
+template <class TInputImage, class THistogramImage>
+typename PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>::HistogramImageType*
+PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>::GetHistogramOutput(unsigned int band)
+{
+  assert(band < m_Histograms.size());
+  return m_Histograms[band];
+}
+
+template <class TInputImage, class THistogramImage>
+void PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TInputImage, class THistogramImage>
+void PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>::AllocateOutputs()
+{
+  // Nothing to allocate: the output image of this filter is not intended to be used.
+}
+
+template <class TInputImage, class THistogramImage>
+void PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>::Reset()
+{
+  TInputImage* inputPtr = const_cast<TInputImage*>(this->GetInput());
+  inputPtr->UpdateOutputInformation();
+
+  const unsigned int nbBands = inputPtr->GetNumberOfComponentsPerPixel();
+
+  if (m_ThumbSize[0] == 0 || m_ThumbSize[1] == 0)
+  {
+    itkExceptionMacro(<< "Thumbnail size must not be null: " << m_ThumbSize);
+  }
+  if (m_NbBin < 2)
+  {
+    itkExceptionMacro(<< "At least two bins are needed, got " << m_NbBin);
+  }
+  if (m_Min.GetSize() != nbBands || m_Max.GetSize() != nbBands)
+  {
+    itkExceptionMacro(<< "Minimum and maximum must have one value per band (" << nbBands << ")");
+  }
+
+  // Same step as in ComputeHistoFilter, bands with an empty range are skipped
+  m_Step.assign(nbBands, 0.);
+  for (unsigned int band = 0; band < nbBands; ++band)
+  {
+    if (m_Min[band] < m_Max[band])
+    {
+      m_Step[band] = static_cast<double>(m_Max[band] - m_Min[band]) / static_cast<double>(m_NbBin - 1);
+    }
+  }
+
+  // Thumbnail grid and geometry, as in ComputeHistoFilter
+  const typename TInputImage::RegionType largestRegion(inputPtr->GetLargestPossibleRegion());
+  m_GridSize[0] = std::ceil(largestRegion.GetSize()[0] / static_cast<double>(m_ThumbSize[0]));
+  m_GridSize[1] = std::ceil(largestRegion.GetSize()[1] / static_cast<double>(m_ThumbSize[1]));
+
+  typename HistogramImageType::RegionType histoRegion;
+  histoRegion.GetModifiableIndex().Fill(0);
+  histoRegion.SetSize(0, m_GridSize[0]);
+  histoRegion.SetSize(1, m_GridSize[1]);
+
+  const typename TInputImage::SpacingType inputSpacing(inputPtr->GetSignedSpacing());
+  const typename TInputImage::PointType   inputOrigin(inputPtr->GetOrigin());
+
+  typename HistogramImageType::SpacingType histoSpacing;
+  histoSpacing[0] = inputSpacing[0] * m_ThumbSize[0];
+  histoSpacing[1] = inputSpacing[1] * m_ThumbSize[1];
+
+  typename HistogramImageType::PointType histoOrigin;
+  histoOrigin[0] = histoSpacing[0] / 2 + inputOrigin[0] - inputSpacing[0] / 2;
+  histoOrigin[1] = histoSpacing[1] / 2 + inputOrigin[1] - inputSpacing[1] / 2;
+
+  m_Histograms.resize(nbBands);
+  for (auto& histogram : m_Histograms)
+  {
+    if (histogram.IsNull())
+    {
+      histogram = HistogramImageType::New();
+    }
+    histogram->Initialize();
+    histogram->SetNumberOfComponentsPerPixel(m_NbBin);
+    histogram->SetRegions(histoRegion);
+    histogram->SetSignedSpacing(histoSpacing);
+    histogram->SetOrigin(histoOrigin);
+    histogram->Allocate();
+  }
+
+  const size_t histoSize = static_cast<size_t>(m_GridSize[0]) * m_GridSize[1] * nbBands * m_NbBin;
+  m_ThreadHistograms.resize(this->GetNumberOfThreads());
+  for (auto& threadHistograms : m_ThreadHistograms)
+  {
+    threadHistograms.assign(histoSize, 0);
+  }
+}
+
+template <class TInputImage, class THistogramImage>
+void PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>::Synthetize()
+{
+  const unsigned int nbBands  = static_cast<unsigned int>(m_Histograms.size());
+  const size_t       nbThumbs = static_cast<size_t>(m_GridSize[0]) * m_GridSize[1];
+
+  for (unsigned int band = 0; band < nbBands; ++band)
+  {
+    // Histogram images are stored thumbnail by thumbnail, bins being contiguous
+    CountType* output = m_Histograms[band]->GetBufferPointer();
+    for (size_t thumb = 0; thumb < nbThumbs; ++thumb)
+    {
+      CountType*   histogram = output + thumb * m_NbBin;
+      const size_t offset    = (thumb * nbBands + band) * m_NbBin;
+      unsigned int total(0);
+      for (unsigned int bin = 0; bin < m_NbBin; ++bin)
+      {
+        CountType agreg(0);
+        for (const auto& threadHistograms : m_ThreadHistograms)
+        {
+          agreg += threadHistograms[offset + bin];
+        }
+        histogram[bin] = agreg;
+        total += agreg;
+      }
+      if (m_Threshold > 0)
+      {
+        ApplyThreshold(histogram, total);
+      }
+    }
+  }
+
+  // Release the thread histograms, they are reallocated by Reset()
+  m_ThreadHistograms.clear();
+}
+
+template <class TInputImage, class THistogramImage>
+void PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>::ApplyThreshold(CountType* histogram, unsigned int total) const
+{
+  unsigned int rest(0);
+  unsigned int height(static_cast<unsigned int>(m_Threshold * (total / m_NbBin)));
+
+  for (unsigned int i = 0; i < m_NbBin; i++)
+  {
+    if (static_cast<unsigned int>(histogram[i]) > height)
+    {
+      rest += histogram[i] - height;
+      histogram[i] = height;
+    }
+  }
+  height = rest / m_NbBin;
+  rest   = rest % m_NbBin;
+  for (unsigned int i = 0; i < m_NbBin; i++)
+  {
+    histogram[i] += height;
+    if (i > (m_NbBin - rest) / 2 && i <= (m_NbBin - rest) / 2 + rest)
+    {
+      ++histogram[i];
+    }
+  }
+}
+
+template <class TInputImage, class THistogramImage>
+void PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>::ThreadedGenerateData(const RegionType& outputRegionForThread,
+                                                                                                   itk::ThreadIdType threadId)
+{
+  const TInputImage* inputPtr = this->GetInput();
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize()[1]);
+
+  const unsigned int nbBands        = static_cast<unsigned int>(m_Histograms.size());
+  const size_t       thumbHistoSize = static_cast<size_t>(nbBands) * m_NbBin;
+  CountType*         threadHisto    = m_ThreadHistograms[threadId].data();
+
+  itk::ImageScanlineConstIterator<TInputImage> it(inputPtr, outputRegionForThread);
+  for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+  {
+    // Thumbnail of the first pixel of the line, and number of pixels left in it
+    const IndexType lineStart(it.GetIndex());
+    const size_t    thumbRow    = lineStart[1] / m_ThumbSize[1];
+    const size_t    thumbColumn = lineStart[0] / m_ThumbSize[0];
+    CountType*      thumbHisto  = threadHisto + (thumbRow * m_GridSize[0] + thumbColumn) * thumbHistoSize;
+    unsigned int    remaining   = m_ThumbSize[0] - lineStart[0] % m_ThumbSize[0];
+
+    for (; !it.IsAtEndOfLine(); ++it)
+    {
+      if (remaining == 0)
+      {
+        thumbHisto += thumbHistoSize;
+        remaining = m_ThumbSize[0];
+      }
+      --remaining;
+
+      const PixelType pixel(it.Get());
+      for (unsigned int band = 0; band < nbBands; ++band)
+      {
+        const InternalPixelType currentPixel(pixel[band]);
+        if (m_Step[band] <= 0 || (currentPixel == m_NoData && m_NoDataFlag) || currentPixel > m_Max[band] || currentPixel < m_Min[band])
+          continue;
+
+        const unsigned int bin = static_cast<unsigned int>(std::round((currentPixel - m_Min[band]) / m_Step[band]));
+        ++thumbHisto[band * m_NbBin + std::min(bin, m_NbBin - 1)];
+      }
+    }
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class THistogramImage>
+void PersistentLocalHistogramVectorImageFilter<TInputImage, THistogramImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Is no data activated: " << m_NoDataFlag << std::endl;
+  os << indent << "No Data: " << m_NoData << std::endl;
+  os << indent << "Minimum: " << m_Min << std::endl;
+  os << indent << "Maximum: " << m_Max << std::endl;
+  os << indent << "Number of bin: " << m_NbBin << std::endl;
+  os << indent << "Thumbnail size: " << m_ThumbSize << std::endl;
+  os << indent << "Threshold value: " << m_Threshold << std::endl;
+}
+
+} // end namespace otb
+
+#endif
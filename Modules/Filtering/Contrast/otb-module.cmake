@@ -26,6 +26,7 @@ otb_module(OTBContrast
     OTBITK
   	OTBCommon
   	OTBImageBase  
+    OTBStreaming
 
   TEST_DEPENDS
     OTBTestKernel
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageFileReader.h"
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "otbVectorImageToImageListFilter.h"
+#include "otbComputeHistoFilter.h"
+#include "otbComputeGainLutFilter.h"
+#include "otbApplyGainFilter.h"
+#include "otbStreamingLocalHistogramVectorImageFilter.h"
+#include "otbApplyGainVectorImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+/* Equalize all the bands in one pass with StreamingLocalHistogramVectorImageFilter
+ * and ApplyGainVectorImageFilter, and check that histograms and output are the
+ * same as the ones of the single band filters applied to each band */
+int otbApplyGainVectorImageFilter(int itkNotUsed(argc), char* argv[])
+{
+  typedef float InputPixelType;
+  const unsigned int Dimension = 2;
+
+  typedef otb::Image<InputPixelType, Dimension>       ImageType;
+  typedef otb::VectorImage<InputPixelType, Dimension> VectorImageType;
+  typedef otb::VectorImage<unsigned int, Dimension>   HistogramType;
+  typedef otb::VectorImage<double, Dimension>         LutType;
+  typedef otb::ImageList<ImageType>                   ImageListType;
+
+  typedef otb::ImageFileReader<VectorImageType>                                         ReaderType;
+  typedef otb::VectorImageToImageListFilter<VectorImageType, ImageListType>             VectorToListFilterType;
+  typedef otb::ComputeHistoFilter<ImageType, HistogramType>                             HistoFilterType;
+  typedef otb::ComputeGainLutFilter<HistogramType, LutType>                             GainLutFilterType;
+  typedef itk::StreamingImageFilter<LutType, LutType>                                   StreamingFilterType;
+  typedef otb::ApplyGainFilter<ImageType, LutType, ImageType>                           ApplyFilterType;
+  typedef otb::StreamingLocalHistogramVectorImageFilter<VectorImageType, HistogramType> LocalHistoFilterType;
+  typedef otb::ApplyGainVectorImageFilter<VectorImageType, LutType, VectorImageType>    ApplyVectorFilterType;
+
+  ReaderType::Pointer reader(ReaderType::New());
+  reader->SetFileName(argv[1]);
+  reader->UpdateOutputInformation();
+
+  const unsigned int nbBands(reader->GetOutput()->GetNumberOfComponentsPerPixel());
+  const unsigned int nbBin(256);
+  const float        threshold(3);
+
+  auto thumbSize = reader->GetOutput()->GetLargestPossibleRegion().GetSize();
+  thumbSize[0] /= 4;
+  thumbSize[1] /= 3;
+
+  VectorImageType::PixelType min(nbBands), max(nbBands);
+  min.Fill(0);
+  max.Fill(255);
+  // Last band is constant in the range, and copied
+  max[nbBands - 1] = 0;
+
+  // Joint histograms and gains
+  LocalHistoFilterType::Pointer localHisto(LocalHistoFilterType::New());
+  localHisto->SetInput(reader->GetOutput());
+  localHisto->GetFilter()->SetMin(min);
+  localHisto->GetFilter()->SetMax(max);
+  localHisto->GetFilter()->SetNbBin(nbBin);
+  localHisto->GetFilter()->SetThumbSize(thumbSize);
+  localHisto->GetFilter()->SetThreshold(threshold);
+  localHisto->GetStreamer()->SetNumberOfLinesStrippedStreaming(50);
+  localHisto->Update();
+
+  ApplyVectorFilterType::Pointer applyVector(ApplyVectorFilterType::New());
+  applyVector->SetInputImage(reader->GetOutput());
+  applyVector->SetMin(min);
+  applyVector->SetMax(max);
+
+  std::vector<GainLutFilterType::Pointer> gainLut(nbBands);
+  for (unsigned int band = 0; band + 1 < nbBands; ++band)
+  {
+    gainLut[band] = GainLutFilterType::New();
+    gainLut[band]->SetInput(localHisto->GetHistogramOutput(band));
+    gainLut[band]->SetMin(min[band]);
+    gainLut[band]->SetMax(max[band]);
+    gainLut[band]->SetNbPixel(thumbSize[0] * thumbSize[1]);
+    applyVector->SetInputLut(band, gainLut[band]->GetOutput());
+  }
+
+  applyVector->Update();
+
+  // Reference, band by band
+  VectorToListFilterType::Pointer vectorToList(VectorToListFilterType::New());
+  vectorToList->SetInput(reader->GetOutput());
+  vectorToList->UpdateOutputInformation();
+
+  VectorImageType::Pointer fused(applyVector->GetOutput());
+  unsigned int             nbErrors(0);
+  for (unsigned int band = 0; band + 1 < nbBands; ++band)
+  {
+    HistoFilterType::Pointer histo(HistoFilterType::New());
+    histo->SetInput(vectorToList->GetOutput()->GetNthElement(band));
+    histo->SetMin(min[band]);
+    histo->SetMax(max[band]);
+    histo->SetNbBin(nbBin);
+    histo->SetThumbSize(thumbSize);
+    histo->SetThreshold(threshold);
+
+    GainLutFilterType::Pointer lut(GainLutFilterType::New());
+    lut->SetInput(histo->GetHistoOutput());
+    lut->SetMin(min[band]);
+    lut->SetMax(max[band]);
+    lut->SetNbPixel(thumbSize[0] * thumbSize[1]);
+
+    StreamingFilterType::Pointer streaming(StreamingFilterType::New());
+    streaming->SetInput(lut->GetOutput());
+
+    ApplyFilterType::Pointer apply(ApplyFilterType::New());
+    apply->SetInputImage(vectorToList->GetOutput()->GetNthElement(band));
+    apply->SetInputLut(streaming->GetOutput());
+    apply->SetMin(min[band]);
+    apply->SetMax(max[band]);
+    apply->Update();
+
+    itk::ImageRegionConstIterator<HistogramType> hit(histo->GetHistoOutput(), histo->GetHistoOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<HistogramType> jit(localHisto->GetHistogramOutput(band), localHisto->GetHistogramOutput(band)->GetLargestPossibleRegion());
+    for (hit.GoToBegin(), jit.GoToBegin(); !hit.IsAtEnd(); ++hit, ++jit)
+    {
+      if (hit.Get() != jit.Get())
+      {
+        std::cerr << "Histogram of band " << band << " differs at " << hit.GetIndex() << std::endl;
+        ++nbErrors;
+      }
+    }
+
+    itk::ImageRegionConstIterator<ImageType>       it(apply->GetOutput(), apply->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<VectorImageType> fit(fused, fused->GetLargestPossibleRegion());
+    for (it.GoToBegin(), fit.GoToBegin(); !it.IsAtEnd(); ++it, ++fit)
+    {
+      if (it.Get() != fit.Get()[band])
+      {
+        ++nbErrors;
+      }
+    }
+  }
+
+  // The constant band is left unchanged
+  itk::ImageRegionConstIterator<VectorImageType> iit(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<VectorImageType> fit(fused, fused->GetLargestPossibleRegion());
+  for (iit.GoToBegin(), fit.GoToBegin(); !iit.IsAtEnd(); ++iit, ++fit)
+  {
+    if (iit.Get()[nbBands - 1] != fit.Get()[nbBands - 1])
+    {
+      ++nbErrors;
+    }
+  }
+
+  if (nbErrors > 0)
+  {
+    std::cerr << nbErrors << " differences with the single band filters" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
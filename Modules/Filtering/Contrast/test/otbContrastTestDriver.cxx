@@ -27,4 +27,5 @@ void RegisterTests()
   REGISTER_TEST(otbApplyGainFilter);
   REGISTER_TEST(otbCLHistogramEqualizationFilter);
   REGISTER_TEST(otbHelperCLAHE);
+  REGISTER_TEST(otbApplyGainVectorImageFilter);
 }
@@ -166,7 +166,9 @@ public:
     // this->SetOutputStartIndex ( image->GetLargestPossibleRegion().GetIndex() );
     this->SetOutputSize(image->GetLargestPossibleRegion().GetSize());
     this->SetOutputProjectionRef(image->GetProjectionRef());
-    this->SetOutputImageMetadata(&(image->GetImageMetadata()));
+    // Hold the metadata: the transform only keeps a pointer to it
+    m_OutputImageMetadata = image->GetSharedImageMetadata();
+    this->SetOutputImageMetadata(m_OutputImageMetadata.get());
 
     InstantiateTransform();
   }
@@ -193,6 +195,9 @@ private:
   void operator=(const Self&) = delete;
 
   GenericRSTransformPointerType m_Transform;
+
+  /** Metadata of the image given to SetOutputParametersFromImage() */
+  ImageCommons::ImageMetadataConstPointerType m_OutputImageMetadata;
 };
 
 } // namespace otb
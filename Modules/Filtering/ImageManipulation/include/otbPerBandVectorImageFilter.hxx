@@ -50,7 +50,7 @@ void PerBandVectorImageFilter<TInputImage, TOutputImage, TFilter>::GenerateOutpu
     this->GetOutput()->SetNumberOfComponentsPerPixel(this->GetInput()->GetNumberOfComponentsPerPixel());
     
     // Override default metadata copying behavior and copy all metadata from input to output.
-    this->GetOutput()->SetImageMetadata(this->GetInput()->GetImageMetadata());
+    this->GetOutput()->ShareImageMetadata(*this->GetInput());
   }
 }
 
@@ -26,6 +26,7 @@
 #include "otbPersistentFilterStreamingDecorator.h"
 
 #include "otbStreamingManager.h"
+#include "otbDecimatedRegionReaderInterface.h"
 #include "otbMacro.h"
 
 namespace otb
@@ -211,6 +212,20 @@ public:
   itkSetMacro(ShrinkFactor, unsigned int);
   itkGetMacro(ShrinkFactor, unsigned int);
 
+  /** Allow the decimated read to take the pixels from the image overviews,
+   * when the input reader supports it. The result is then no longer
+   * identical to the streamed decimation. Default is false. */
+  itkSetMacro(UseOverviews, bool);
+  itkGetMacro(UseOverviews, bool);
+  itkBooleanMacro(UseOverviews);
+
+  /** Fill the shrunk output by asking the source of the input for the
+   * decimated pixels only. This requires the input to be produced by a
+   * DecimatedRegionReaderInterface (such as ImageFileReader) able to read it.
+   * Returns false, without changing the shrunk output, if this is not the
+   * case: the input then has to be streamed. */
+  bool ReadDecimatedInput();
+
 protected:
   PersistentShrinkImageFilter();
 
@@ -245,6 +260,9 @@ private:
 
   /** The offset to get the cell center */
   IndexType m_Offset;
+
+  /** Allow reading from the overviews */
+  bool m_UseOverviews;
 }; // end of class PersistentStatisticsVectorImageFilter
 
 
@@ -304,8 +322,17 @@ public:
   otbSetObjectMemberMacro(Filter, ShrinkFactor, unsigned int);
   otbGetObjectMemberMacro(Filter, ShrinkFactor, unsigned int);
 
+  otbSetObjectMemberMacro(Filter, UseOverviews, bool);
+  otbGetObjectMemberMacro(Filter, UseOverviews, bool);
+
   void Update(void) override
   {
+    // When the input comes straight from a reader, only the decimated pixels
+    // are read, instead of streaming the whole image
+    if (this->GetFilter()->ReadDecimatedInput())
+    {
+      return;
+    }
     m_StreamingManager->SetShrinkFactor(this->GetFilter()->GetShrinkFactor());
     Superclass::Update();
   }
@@ -58,7 +58,7 @@ void StreamingShrinkStreamingManager<TImage>::PrepareStreaming(itk::DataObject*
 
 /** Constructor */
 template <class TInputImage, class TOutputImage>
-PersistentShrinkImageFilter<TInputImage, TOutputImage>::PersistentShrinkImageFilter() : m_ShrinkFactor(10)
+PersistentShrinkImageFilter<TInputImage, TOutputImage>::PersistentShrinkImageFilter() : m_ShrinkFactor(10), m_UseOverviews(false)
 {
   this->SetNumberOfRequiredInputs(1);
   this->SetNumberOfRequiredOutputs(1);
@@ -149,6 +149,59 @@ void PersistentShrinkImageFilter<TInputImage, TOutputImage>::Reset()
   m_ShrunkOutput->Allocate();
 }
 
+template <class TInputImage, class TOutputImage>
+bool PersistentShrinkImageFilter<TInputImage, TOutputImage>::ReadDecimatedInput()
+{
+  typedef DecimatedRegionReaderInterface<OutputImageType> DecimatedReaderType;
+
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (inputPtr == nullptr || m_ShrinkFactor == 0)
+  {
+    return false;
+  }
+
+  // The reader fills the shrunk image itself, so the pixel types must match
+  DecimatedReaderType* reader = dynamic_cast<DecimatedReaderType*>(inputPtr->GetSource().GetPointer());
+  if (reader == nullptr)
+  {
+    return false;
+  }
+
+  this->Reset();
+
+  // Shrunk pixel k is input pixel m_Offset + k * m_ShrinkFactor: they must
+  // all be inside the input, as the streamed version never reaches the others
+  const RegionType&                         inputRegion = inputPtr->GetLargestPossibleRegion();
+  const typename OutputImageType::SizeType& shrunkSize  = m_ShrunkOutput->GetLargestPossibleRegion().GetSize();
+  IndexType                                 start;
+  IndexType                                 last;
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    start[i] = m_Offset[i];
+    last[i]  = m_Offset[i] + static_cast<typename IndexType::IndexValueType>(shrunkSize[i] - 1) * m_ShrinkFactor;
+  }
+  if (!inputRegion.IsInside(start) || !inputRegion.IsInside(last))
+  {
+    return false;
+  }
+
+  typename DecimatedReaderType::IndexType readStart;
+  typename DecimatedReaderType::SizeType  readSize;
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    readStart[i] = start[i];
+    readSize[i]  = shrunkSize[i];
+  }
+
+  if (!reader->ReadDecimatedRegion(readStart, readSize, m_ShrinkFactor, m_UseOverviews, m_ShrunkOutput))
+  {
+    return false;
+  }
+
+  this->Synthetize();
+  return true;
+}
+
 template <class TInputImage, class TOutputImage>
 void PersistentShrinkImageFilter<TInputImage, TOutputImage>::Synthetize()
 {
@@ -192,6 +245,7 @@ void PersistentShrinkImageFilter<TImage, TOutputImage>::PrintSelf(std::ostream&
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Shrink factor: " << m_ShrinkFactor << std::endl;
+  os << indent << "Use overviews: " << m_UseOverviews << std::endl;
 }
 
 } // End namespace otb
@@ -22,9 +22,11 @@
 #define otbUnaryImageFunctorWithVectorImageFilter_hxx
 
 #include "otbUnaryImageFunctorWithVectorImageFilter.h"
-#include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
@@ -74,6 +76,10 @@ void UnaryImageFunctorWithVectorImageFilter<TInputImage, TOutputImage, TFunction
 
 /**
  * ThreadedGenerateData Performs the pixel-wise addition
+ *
+ * The band-interleaved buffers are walked line by line with raw pointers, so
+ * that no pixel is allocated and each functor is applied to contiguous
+ * components.
  */
 template <class TInputImage, class TOutputImage, class TFunction>
 void UnaryImageFunctorWithVectorImageFilter<TInputImage, TOutputImage, TFunction>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
@@ -82,37 +88,54 @@ void UnaryImageFunctorWithVectorImageFilter<TInputImage, TOutputImage, TFunction
   typename Superclass::OutputImagePointer     outputPtr = this->GetOutput();
   typename Superclass::InputImageConstPointer inputPtr  = this->GetInput();
 
+  const unsigned int       nbComponents = inputPtr->GetNumberOfComponentsPerPixel();
+  const itk::SizeValueType lineLength   = outputRegionForThread.GetSize(0);
+
+  if (lineLength == 0)
+  {
+    return;
+  }
+
   // Define the iterators
-  itk::ImageRegionConstIterator<InputImageType> inputIt(inputPtr, outputRegionForThread);
-  itk::ImageRegionIterator<OutputImageType>     outputIt(outputPtr, outputRegionForThread);
+  itk::ImageScanlineConstIterator<InputImageType> inputIt(inputPtr, outputRegionForThread);
+  itk::ImageScanlineIterator<OutputImageType>     outputIt(outputPtr, outputRegionForThread);
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels() / lineLength);
 
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+  const OutputInternalPixelType nullValue = itk::NumericTraits<OutputInternalPixelType>::Zero;
 
   inputIt.GoToBegin();
   outputIt.GoToBegin();
 
-  // Null pixel construction
-  InputPixelType nullPixel;
-  nullPixel.SetSize(inputPtr->GetNumberOfComponentsPerPixel());
-  nullPixel.Fill(itk::NumericTraits<OutputInternalPixelType>::Zero);
-
   while (!inputIt.IsAtEnd())
   {
-    InputPixelType  inPixel = inputIt.Get();
-    OutputPixelType outPixel;
-    outPixel.SetSize(inputPtr->GetNumberOfComponentsPerPixel());
-    outPixel.Fill(itk::NumericTraits<OutputInternalPixelType>::Zero);
-    // if the input pixel in null, the output is considered as null ( no sensor information )
-    if (inPixel != nullPixel)
+    const InputInternalPixelType* inPixel  = inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(inputIt.GetIndex()) * nbComponents;
+    OutputInternalPixelType*      outPixel = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(outputIt.GetIndex()) * nbComponents;
+
+    for (itk::SizeValueType i = 0; i < lineLength; ++i, inPixel += nbComponents, outPixel += nbComponents)
     {
-      for (unsigned int j = 0; j < inputPtr->GetNumberOfComponentsPerPixel(); ++j)
+      // if the input pixel in null, the output is considered as null ( no sensor information )
+      unsigned int j = 0;
+      while (j < nbComponents && inPixel[j] == static_cast<InputInternalPixelType>(nullValue))
+      {
+        ++j;
+      }
+
+      if (j == nbComponents)
+      {
+        std::fill(outPixel, outPixel + nbComponents, nullValue);
+      }
+      else
       {
-        outPixel[j] = m_FunctorVector[j](inPixel[j]);
+        for (j = 0; j < nbComponents; ++j)
+        {
+          outPixel[j] = m_FunctorVector[j](inPixel[j]);
+        }
       }
     }
-    outputIt.Set(outPixel);
-    ++inputIt;
-    ++outputIt;
+
+    inputIt.NextLine();
+    outputIt.NextLine();
     progress.CompletedPixel(); // potential exception thrown here
   }
 }
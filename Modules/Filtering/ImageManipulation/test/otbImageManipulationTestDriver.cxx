@@ -29,6 +29,7 @@ void RegisterTests()
   REGISTER_TEST(otbFunctionWithNeighborhoodToImageFilter);
   REGISTER_TEST(otbSqrtSpectralAngleImageFilter);
   REGISTER_TEST(otbStreamingShrinkImageFilter);
+  REGISTER_TEST(otbStreamingShrinkImageFilterDecimatedRead);
   REGISTER_TEST(otbUnaryImageFunctorWithVectorImageFilter);
   REGISTER_TEST(otbPrintableImageFilterWithMask);
   REGISTER_TEST(otbStreamingResampleImageFilter);
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageFileReader.h"
+#include "otbVectorImage.h"
+#include "otbMultiChannelExtractROI.h"
+#include "otbStreamingShrinkImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+int otbStreamingShrinkImageFilterDecimatedRead(int itkNotUsed(argc), char* argv[])
+{
+  char*              inputFilename = argv[1];
+  unsigned int       shrinkFactor  = atoi(argv[2]);
+  const unsigned int Dimension     = 2;
+
+  typedef unsigned short                                        PixelType;
+  typedef otb::VectorImage<PixelType, Dimension>                ImageType;
+  typedef otb::ImageFileReader<ImageType>                       ReaderType;
+  typedef otb::MultiChannelExtractROI<PixelType, PixelType>     ExtractType;
+  typedef otb::StreamingShrinkImageFilter<ImageType, ImageType> ShrinkType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+
+  // Decimated read from the reader
+  ShrinkType::Pointer decimated = ShrinkType::New();
+  decimated->SetShrinkFactor(shrinkFactor);
+  decimated->SetInput(reader->GetOutput());
+  decimated->Update();
+
+  // The extract filter hides the reader: the whole image is streamed
+  ExtractType::Pointer extract = ExtractType::New();
+  extract->SetInput(reader->GetOutput());
+
+  ShrinkType::Pointer streamed = ShrinkType::New();
+  streamed->SetShrinkFactor(shrinkFactor);
+  streamed->SetInput(extract->GetOutput());
+  streamed->Update();
+
+  if (decimated->GetOutput()->GetLargestPossibleRegion() != streamed->GetOutput()->GetLargestPossibleRegion() ||
+      decimated->GetOutput()->GetOrigin() != streamed->GetOutput()->GetOrigin() ||
+      decimated->GetOutput()->GetSignedSpacing() != streamed->GetOutput()->GetSignedSpacing())
+  {
+    std::cerr << "Decimated and streamed shrunk images have different geometries" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  itk::ImageRegionConstIterator<ImageType> decIt(decimated->GetOutput(), decimated->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> strIt(streamed->GetOutput(), streamed->GetOutput()->GetLargestPossibleRegion());
+  for (decIt.GoToBegin(), strIt.GoToBegin(); !decIt.IsAtEnd(); ++decIt, ++strIt)
+  {
+    if (decIt.Get() != strIt.Get())
+    {
+      std::cerr << "Pixel " << decIt.GetIndex() << " differs: " << decIt.Get() << " (decimated read) vs " << strIt.Get() << " (streamed)" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -81,9 +81,7 @@ public:
 
     for (unsigned int i = 0; i < m_AAttributes.size(); ++i)
     {
-
-      std::string name = (m_AttributesName[i]);
-      m_AAttributes[i] = a.GetAttribute(name.c_str());
+      m_AAttributes[i] = a.GetAttribute(m_AttributesName[i].c_str());
     }
 
     try
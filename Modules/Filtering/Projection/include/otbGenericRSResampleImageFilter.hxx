@@ -101,8 +101,8 @@ void GenericRSResampleImageFilter<TInputImage, TOutputImage>::GenerateOutputInfo
 
   // Encapsulate output projRef and metadata
   if (this->GetOutputImageMetadata() != nullptr)
-    this->GetOutput()->m_Imd.Merge(*(this->GetOutputImageMetadata()));
-  this->GetOutput()->m_Imd.Add(MDGeom::ProjectionWKT, this->GetOutputProjectionRef());
+    this->GetOutput()->GetWritableImageMetadata().Merge(*(this->GetOutputImageMetadata()));
+  this->GetOutput()->GetWritableImageMetadata().Add(MDGeom::ProjectionWKT, this->GetOutputProjectionRef());
 }
 
 /**
@@ -121,7 +121,7 @@ void GenericRSResampleImageFilter<TInputImage, TOutputImage>::EstimateOutputRpcM
   tempPtr->SetRegions(region);
 
   // Encapsulate the output metadata in the temp image
-  tempPtr->m_Imd.Add(MDGeom::ProjectionWKT, this->GetOutputProjectionRef());
+  tempPtr->GetWritableImageMetadata().Add(MDGeom::ProjectionWKT, this->GetOutputProjectionRef());
   tempPtr->SetImageMetadata(*(this->GetOutputImageMetadata()));
 
   // Estimate the rpc model from the temp image
@@ -199,7 +199,7 @@ void GenericRSResampleImageFilter<TInputImage, TOutputImage>::SetOutputParameter
   this->SetOutputStartIndex(src->GetLargestPossibleRegion().GetIndex());
   this->SetOutputSize(src->GetLargestPossibleRegion().GetSize());
   this->SetOutputProjectionRef(src->GetProjectionRef());
-  this->GetOutput()->SetImageMetadata(src->GetImageMetadata());
+  this->GetOutput()->ShareImageMetadata(*src);
 }
 
 /**
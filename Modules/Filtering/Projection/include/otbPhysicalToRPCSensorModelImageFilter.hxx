@@ -92,7 +92,7 @@ void PhysicalToRPCSensorModelImageFilter<TImage>::GenerateOutputInformation()
                             << ", Mean error: " << m_GCPsToSensorModelFilter->GetMeanError());
 
 
-    this->GetOutput()->SetImageMetadata(m_GCPsToSensorModelFilter->GetOutput()->GetImageMetadata());
+    this->GetOutput()->ShareImageMetadata(*m_GCPsToSensorModelFilter->GetOutput());
 
     // put the flag to true
     m_OutputInformationGenerated = true;
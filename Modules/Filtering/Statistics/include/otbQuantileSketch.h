@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbQuantileSketch_h
+#define otbQuantileSketch_h
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "OTBStatisticsExport.h"
+
+namespace otb
+{
+
+/** \class QuantileSketch
+ * \brief Mergeable streaming quantile summary of a scalar distribution.
+ *
+ * This class implements the KLL sketch (Karnin, Lang and Liberty, "Optimal
+ * quantile approximation in streams", 2016). Values are pushed into a
+ * hierarchy of compactors: when a level is full it is sorted and every
+ * other value is promoted to the next level with a doubled weight. The
+ * memory footprint only depends on the accuracy parameter K (roughly 3K
+ * values), whatever the number of inserted values.
+ *
+ * The rank error of a quantile is in O(1/K) with high probability; with
+ * the default K=200 it is about 1%, and 0.1% for K=2000. As long as fewer
+ * than K values have been inserted, quantiles are exact. Minimum and
+ * maximum are always exact.
+ *
+ * Sketches can be merged, which allows to compute one summary per thread
+ * and per stream region and to combine them at the end. The compaction
+ * offsets alternate instead of being drawn at random, so that the result
+ * only depends on the order of insertions and merges.
+ *
+ * \sa PersistentQuantilesVectorImageFilter
+ *
+ * \ingroup OTBStatistics
+ */
+class OTBStatistics_EXPORT QuantileSketch
+{
+public:
+  typedef double ValueType;
+
+  /** Constructor, K sets the accuracy of the sketch (see SetK()) */
+  explicit QuantileSketch(unsigned int k = 200);
+
+  /** Set the accuracy parameter. The sketch is cleared. */
+  void SetK(unsigned int k);
+
+  unsigned int GetK() const
+  {
+    return m_K;
+  }
+
+  /** Remove all the values from the sketch */
+  void Clear();
+
+  /** Insert a value */
+  void Insert(ValueType value)
+  {
+    m_Compactors[0].push_back(value);
+    if (value < m_Minimum || m_Count == 0)
+    {
+      m_Minimum = value;
+    }
+    if (value > m_Maximum || m_Count == 0)
+    {
+      m_Maximum = value;
+    }
+    ++m_Count;
+    if (++m_Size >= m_MaxSize)
+    {
+      this->Compress();
+    }
+  }
+
+  /** Merge the values summarized by another sketch into this one.
+   * Both sketches should have the same K parameter. */
+  void Merge(const QuantileSketch& other);
+
+  /** Get the value of quantile q, q being in [0, 1]. Returns 0 if the
+   * sketch is empty. */
+  ValueType GetQuantile(double q) const;
+
+  /** Get several quantiles at once, sorting the summary only once */
+  std::vector<ValueType> GetQuantiles(const std::vector<double>& q) const;
+
+  /** Get the rank (fraction of values lower or equal) of a value */
+  double GetRank(ValueType value) const;
+
+  /** Number of inserted values */
+  std::uint64_t GetCount() const
+  {
+    return m_Count;
+  }
+
+  bool IsEmpty() const
+  {
+    return m_Count == 0;
+  }
+
+  ValueType GetMinimum() const
+  {
+    return m_Minimum;
+  }
+
+  ValueType GetMaximum() const
+  {
+    return m_Maximum;
+  }
+
+  /** Number of values actually stored in the sketch */
+  std::size_t GetNumberOfRetainedValues() const
+  {
+    return m_Size;
+  }
+
+private:
+  typedef std::vector<ValueType>              CompactorType;
+  typedef std::pair<ValueType, std::uint64_t> WeightedValueType;
+
+  /** Capacity of a given level, which decreases geometrically with the
+   * distance to the top level */
+  std::size_t Capacity(unsigned int level) const;
+
+  /** Add a level on top of the hierarchy */
+  void Grow();
+
+  /** Compact the first full levels until the sketch fits in its budget */
+  void Compress();
+
+  /** Build the sorted list of (value, cumulated weight) */
+  std::vector<WeightedValueType> GetSortedValues() const;
+
+  unsigned int               m_K;
+  std::vector<CompactorType> m_Compactors;
+  std::vector<bool>          m_CompactionParity;
+  std::size_t                m_Size;
+  std::size_t                m_MaxSize;
+  std::uint64_t              m_Count;
+  ValueType                  m_Minimum;
+  ValueType                  m_Maximum;
+};
+
+} // end namespace otb
+
+#endif
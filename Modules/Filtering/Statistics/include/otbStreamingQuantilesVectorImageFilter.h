@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingQuantilesVectorImageFilter_h
+#define otbStreamingQuantilesVectorImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include "otbQuantileSketch.h"
+#include "otbMacro.h"
+#include "otbImage.h"
+#include "itkVariableLengthVector.h"
+#include "itkNumericTraits.h"
+
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentQuantilesVectorImageFilter
+ * \brief Compute per-band quantiles of a large image using streaming
+ *
+ * Each band is summarized by a mergeable QuantileSketch: one sketch per
+ * band is filled by each thread, and the sketches of all threads and all
+ * stream regions are merged by Synthetize(). Unlike
+ * PersistentHistogramVectorImageFilter, the range of the values does not
+ * need to be known beforehand, and all the pixels of the image are taken
+ * into account, which allows to compute percentiles in a single
+ * full-resolution pass.
+ *
+ * The accuracy of the quantiles is set with SketchSize (see
+ * QuantileSketch::SetK()). The minimum and maximum of each band are exact.
+ *
+ * Pixels where the optional mask is 0 are ignored. If NoDataFlag is On,
+ * components equal to NoDataValue are ignored in their band. Non-finite
+ * values are always ignored.
+ *
+ *  This filter persists its temporary data. It means that if you Update it n times on n different
+ * requested regions, the output quantiles will be the quantiles of the whole set of n regions.
+ *
+ * To reset the temporary data, one should call the Reset() function.
+ *
+ * To get the quantiles once the regions have been processed via the pipeline, use the Synthetize() method.
+ *
+ * \sa PersistentImageFilter
+ * \sa QuantileSketch
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ * \ingroup MathematicalStatisticsImageFilters
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TInputImage, class TMaskImage = otb::Image<unsigned char, 2>>
+class ITK_EXPORT PersistentQuantilesVectorImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentQuantilesVectorImageFilter Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentQuantilesVectorImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                             ImageType;
+  typedef typename TInputImage::Pointer           InputImagePointer;
+  typedef typename TInputImage::RegionType        RegionType;
+  typedef typename TInputImage::SizeType          SizeType;
+  typedef typename TInputImage::IndexType         IndexType;
+  typedef typename TInputImage::PixelType         PixelType;
+  typedef typename TInputImage::InternalPixelType InternalPixelType;
+
+  typedef TMaskImage                      MaskImageType;
+  typedef typename TMaskImage::PixelType  MaskPixelType;
+
+  itkStaticConstMacro(InputImageDimension, unsigned int, TInputImage::ImageDimension);
+
+  /** Type to use for computations. */
+  typedef typename itk::NumericTraits<InternalPixelType>::RealType RealType;
+  typedef itk::VariableLengthVector<RealType>                      RealPixelType;
+
+  typedef QuantileSketch                  SketchType;
+  typedef std::vector<SketchType>         SketchVectorType;
+  typedef std::vector<SketchVectorType>   ThreadSketchVectorType;
+  typedef std::vector<itk::SizeValueType> CountVectorType;
+
+  /** Set the mask image. Pixels where the mask is 0 are ignored. The
+   *  mask must have the same size as the input image. */
+  void SetMaskImage(const MaskImageType* mask);
+  const MaskImageType* GetMaskImage() const;
+
+  /** Set the no data value. These value are ignored in quantiles
+   *  computation if NoDataFlag is On
+   */
+  itkSetMacro(NoDataValue, InternalPixelType);
+
+  /** Get the no data value. These value are ignored in quantiles
+   *  computation if NoDataFlag is On
+   */
+  itkGetConstReferenceMacro(NoDataValue, InternalPixelType);
+
+  /** Set the NoDataFlag. If set to true, components with values equal to
+   *  m_NoDataValue are ignored.
+   */
+  itkSetMacro(NoDataFlag, bool);
+  itkGetMacro(NoDataFlag, bool);
+  itkBooleanMacro(NoDataFlag);
+
+  /** Set the accuracy parameter of the sketches: the rank error of the
+   *  quantiles is roughly 2/SketchSize. Default is 2000. */
+  itkSetMacro(SketchSize, unsigned int);
+  itkGetMacro(SketchSize, unsigned int);
+
+  /** Get the quantile q (in [0, 1]) of each band */
+  RealPixelType GetQuantile(double q) const;
+
+  /** Get the quantile q (in [0, 1]) of a given band */
+  RealType GetQuantile(unsigned int band, double q) const;
+
+  /** Get several quantiles of a given band */
+  std::vector<RealType> GetQuantiles(unsigned int band, const std::vector<double>& q) const;
+
+  /** Get the exact minimum and maximum of each band */
+  RealPixelType GetMinimum() const;
+  RealPixelType GetMaximum() const;
+
+  /** Get the number of values taken into account in each band */
+  CountVectorType GetCount() const;
+
+  /** Get the synthetized sketch of a given band */
+  const SketchType& GetSketch(unsigned int band) const;
+
+  /** Pass the input through unmodified. Do this by Grafting in the
+   *  AllocateOutputs method.
+   */
+  void AllocateOutputs() override;
+  void GenerateOutputInformation() override;
+  void GenerateInputRequestedRegion() override;
+  void Synthetize(void) override;
+  void Reset(void) override;
+
+protected:
+  PersistentQuantilesVectorImageFilter();
+  ~PersistentQuantilesVectorImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+  /** Multi-thread version GenerateData. */
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  PersistentQuantilesVectorImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  ThreadSketchVectorType m_ThreadSketches;
+  SketchVectorType       m_Sketches;
+  unsigned int           m_SketchSize;
+  bool                   m_NoDataFlag;
+  InternalPixelType      m_NoDataValue;
+
+}; // end of class PersistentQuantilesVectorImageFilter
+
+/**===========================================================================*/
+
+/** \class StreamingQuantilesVectorImageFilter
+ * \brief This class streams the whole input image through the PersistentQuantilesVectorImageFilter.
+ *
+ * This way, it allows computing the quantiles of each band of this image. It calls the
+ * Reset() method of the PersistentQuantilesVectorImageFilter before streaming the image and the
+ * Synthetize() method of the PersistentQuantilesVectorImageFilter after having streamed the image
+ * to compute the quantiles. The accessors on the results are wrapping the accessors of the
+ * internal PersistentQuantilesVectorImageFilter.
+ *
+ * \sa PersistentQuantilesVectorImageFilter
+ * \sa PersistentImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ * \sa StreamingImageVirtualWriter
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ * \ingroup MathematicalStatisticsImageFilters
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TInputImage, class TMaskImage = otb::Image<unsigned char, 2>>
+class ITK_EXPORT StreamingQuantilesVectorImageFilter
+    : public PersistentFilterStreamingDecorator<PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingQuantilesVectorImageFilter Self;
+  typedef PersistentFilterStreamingDecorator<PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingQuantilesVectorImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef TInputImage                     InputImageType;
+  typedef TMaskImage                      MaskImageType;
+  typedef typename Superclass::FilterType InternalFilterType;
+
+  typedef typename InternalFilterType::RealType        RealType;
+  typedef typename InternalFilterType::RealPixelType   RealPixelType;
+  typedef typename InternalFilterType::CountVectorType CountVectorType;
+
+  using Superclass::SetInput;
+  void SetInput(InputImageType* input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+  const InputImageType* GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  void SetMaskImage(const MaskImageType* mask)
+  {
+    this->GetFilter()->SetMaskImage(mask);
+  }
+
+  RealPixelType GetQuantile(double q) const
+  {
+    return this->GetFilter()->GetQuantile(q);
+  }
+
+  RealType GetQuantile(unsigned int band, double q) const
+  {
+    return this->GetFilter()->GetQuantile(band, q);
+  }
+
+  RealPixelType GetMinimum() const
+  {
+    return this->GetFilter()->GetMinimum();
+  }
+
+  RealPixelType GetMaximum() const
+  {
+    return this->GetFilter()->GetMaximum();
+  }
+
+  CountVectorType GetCount() const
+  {
+    return this->GetFilter()->GetCount();
+  }
+
+  otbSetObjectMemberMacro(Filter, NoDataValue, typename InputImageType::InternalPixelType);
+  otbGetObjectMemberMacro(Filter, NoDataValue, typename InputImageType::InternalPixelType);
+  otbSetObjectMemberMacro(Filter, NoDataFlag, bool);
+  otbGetObjectMemberMacro(Filter, NoDataFlag, bool);
+  otbSetObjectMemberMacro(Filter, SketchSize, unsigned int);
+  otbGetObjectMemberMacro(Filter, SketchSize, unsigned int);
+
+protected:
+  /** Constructor */
+  StreamingQuantilesVectorImageFilter()
+  {
+  }
+  /** Destructor */
+  ~StreamingQuantilesVectorImageFilter() override
+  {
+  }
+
+private:
+  StreamingQuantilesVectorImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingQuantilesVectorImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingQuantilesVectorImageFilter_hxx
+#define otbStreamingQuantilesVectorImageFilter_hxx
+#include "otbStreamingQuantilesVectorImageFilter.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkProgressReporter.h"
+#include <cmath>
+
+namespace otb
+{
+
+template <class TInputImage, class TMaskImage>
+PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::PersistentQuantilesVectorImageFilter()
+  : m_ThreadSketches(), m_Sketches(), m_SketchSize(2000), m_NoDataFlag(false), m_NoDataValue(itk::NumericTraits<InternalPixelType>::Zero)
+{
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::SetMaskImage(const MaskImageType* mask)
+{
+  this->itk::ProcessObject::SetNthInput(1, const_cast<MaskImageType*>(mask));
+}
+
+template <class TInputImage, class TMaskImage>
+const TMaskImage* PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::GetMaskImage() const
+{
+  if (this->GetNumberOfInputs() < 2)
+  {
+    return nullptr;
+  }
+  return static_cast<const MaskImageType*>(this->itk::ProcessObject::GetInput(1));
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+
+  const MaskImageType* mask = this->GetMaskImage();
+  if (mask && this->GetInput() && mask->GetLargestPossibleRegion() != this->GetInput()->GetLargestPossibleRegion())
+  {
+    itkExceptionMacro(<< "Mask and input image have a different size!");
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  MaskImageType* mask = const_cast<MaskImageType*>(this->GetMaskImage());
+  if (mask)
+  {
+    mask->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::AllocateOutputs()
+{
+  // Nothing that needs to be allocated for the outputs: the output image
+  // of this filter is not intended to be used.
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::Reset()
+{
+  TInputImage* inputPtr = const_cast<TInputImage*>(this->GetInput());
+  inputPtr->UpdateOutputInformation();
+
+  const unsigned int numberOfThreads   = this->GetNumberOfThreads();
+  const unsigned int numberOfComponent = inputPtr->GetNumberOfComponentsPerPixel();
+
+  m_Sketches.assign(numberOfComponent, SketchType(m_SketchSize));
+  m_ThreadSketches.assign(numberOfThreads, m_Sketches);
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::Synthetize()
+{
+  const unsigned int numberOfComponent = m_Sketches.size();
+
+  // Merge in thread order, so that the result does not depend on timing
+  for (unsigned int k = 0; k < numberOfComponent; ++k)
+  {
+    m_Sketches[k].Clear();
+    for (unsigned int i = 0; i < m_ThreadSketches.size(); ++i)
+    {
+      m_Sketches[k].Merge(m_ThreadSketches[i][k]);
+    }
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  const TInputImage*   inputPtr = this->GetInput();
+  const MaskImageType* maskPtr  = this->GetMaskImage();
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  SketchVectorType& sketches = m_ThreadSketches[threadId];
+
+  itk::ImageRegionConstIterator<TInputImage>   it(inputPtr, outputRegionForThread);
+  itk::ImageRegionConstIterator<MaskImageType> maskIt;
+  if (maskPtr)
+  {
+    maskIt = itk::ImageRegionConstIterator<MaskImageType>(maskPtr, outputRegionForThread);
+    maskIt.GoToBegin();
+  }
+
+  const unsigned int numberOfComponent = sketches.size();
+
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it, progress.CompletedPixel())
+  {
+    if (maskPtr)
+    {
+      const bool masked = (maskIt.Get() == itk::NumericTraits<MaskPixelType>::Zero);
+      ++maskIt;
+      if (masked)
+      {
+        continue;
+      }
+    }
+
+    const PixelType& vectorValue = it.Get();
+
+    for (unsigned int k = 0; k < numberOfComponent; ++k)
+    {
+      const InternalPixelType value = vectorValue[k];
+      if (m_NoDataFlag && value == m_NoDataValue)
+      {
+        continue;
+      }
+      const double realValue = static_cast<double>(value);
+      if (!std::isfinite(realValue))
+      {
+        continue;
+      }
+      sketches[k].Insert(realValue);
+    }
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::RealPixelType
+PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::GetQuantile(double q) const
+{
+  RealPixelType result(m_Sketches.size());
+  for (unsigned int k = 0; k < m_Sketches.size(); ++k)
+  {
+    result[k] = static_cast<RealType>(m_Sketches[k].GetQuantile(q));
+  }
+  return result;
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::RealType
+PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::GetQuantile(unsigned int band, double q) const
+{
+  return static_cast<RealType>(this->GetSketch(band).GetQuantile(q));
+}
+
+template <class TInputImage, class TMaskImage>
+std::vector<typename PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::RealType>
+PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::GetQuantiles(unsigned int band, const std::vector<double>& q) const
+{
+  const std::vector<SketchType::ValueType> values = this->GetSketch(band).GetQuantiles(q);
+  return std::vector<RealType>(values.begin(), values.end());
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::RealPixelType
+PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::GetMinimum() const
+{
+  RealPixelType result(m_Sketches.size());
+  for (unsigned int k = 0; k < m_Sketches.size(); ++k)
+  {
+    result[k] = static_cast<RealType>(m_Sketches[k].GetMinimum());
+  }
+  return result;
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::RealPixelType
+PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::GetMaximum() const
+{
+  RealPixelType result(m_Sketches.size());
+  for (unsigned int k = 0; k < m_Sketches.size(); ++k)
+  {
+    result[k] = static_cast<RealType>(m_Sketches[k].GetMaximum());
+  }
+  return result;
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::CountVectorType
+PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::GetCount() const
+{
+  CountVectorType result(m_Sketches.size());
+  for (unsigned int k = 0; k < m_Sketches.size(); ++k)
+  {
+    result[k] = static_cast<itk::SizeValueType>(m_Sketches[k].GetCount());
+  }
+  return result;
+}
+
+template <class TInputImage, class TMaskImage>
+const QuantileSketch& PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::GetSketch(unsigned int band) const
+{
+  if (band >= m_Sketches.size())
+  {
+    itkExceptionMacro(<< "Band " << band << " out of range: quantiles were computed for " << m_Sketches.size() << " bands");
+  }
+  return m_Sketches[band];
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentQuantilesVectorImageFilter<TInputImage, TMaskImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Sketch size: " << m_SketchSize << std::endl;
+  os << indent << "Use NoData: " << (m_NoDataFlag ? "true" : "false") << std::endl;
+  os << indent << "NoData value: " << static_cast<RealType>(m_NoDataValue) << std::endl;
+  for (unsigned int k = 0; k < m_Sketches.size(); ++k)
+  {
+    os << indent << "Band " << k << ": " << m_Sketches[k].GetCount() << " values in [" << m_Sketches[k].GetMinimum() << ", "
+       << m_Sketches[k].GetMaximum() << "]" << std::endl;
+  }
+}
+
+} // end namespace otb
+#endif
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbQuantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+QuantileSketch::QuantileSketch(unsigned int k)
+  : m_K(std::max(k, 2U)), m_Compactors(), m_CompactionParity(), m_Size(0), m_MaxSize(0), m_Count(0), m_Minimum(0), m_Maximum(0)
+{
+  this->Clear();
+}
+
+void QuantileSketch::SetK(unsigned int k)
+{
+  m_K = std::max(k, 2U);
+  this->Clear();
+}
+
+void QuantileSketch::Clear()
+{
+  m_Compactors.assign(1, CompactorType());
+  m_CompactionParity.assign(1, false);
+  m_Size    = 0;
+  m_Count   = 0;
+  m_Minimum = 0;
+  m_Maximum = 0;
+  m_MaxSize = this->Capacity(0);
+}
+
+std::size_t QuantileSketch::Capacity(unsigned int level) const
+{
+  const unsigned int depth = static_cast<unsigned int>(m_Compactors.size()) - level - 1;
+  const double       cap   = std::ceil(m_K * std::pow(2. / 3., static_cast<double>(depth)));
+  return std::max(static_cast<std::size_t>(cap), static_cast<std::size_t>(2));
+}
+
+void QuantileSketch::Grow()
+{
+  m_Compactors.push_back(CompactorType());
+  m_CompactionParity.push_back(false);
+
+  m_MaxSize = 0;
+  for (unsigned int h = 0; h < m_Compactors.size(); ++h)
+  {
+    m_MaxSize += this->Capacity(h);
+  }
+}
+
+void QuantileSketch::Compress()
+{
+  for (unsigned int h = 0; h < m_Compactors.size(); ++h)
+  {
+    if (m_Compactors[h].size() < this->Capacity(h))
+    {
+      continue;
+    }
+    if (h + 1 >= m_Compactors.size())
+    {
+      this->Grow();
+    }
+
+    CompactorType& current = m_Compactors[h];
+    CompactorType& next    = m_Compactors[h + 1];
+
+    // An odd value stays at this level so that the total weight is kept
+    bool      hasLeftOver = (current.size() % 2) == 1;
+    ValueType leftOver    = 0;
+    if (hasLeftOver)
+    {
+      leftOver = current.back();
+      current.pop_back();
+    }
+
+    std::sort(current.begin(), current.end());
+
+    // Alternate the kept half between compactions instead of drawing it
+    // at random: the error is still balanced, and results are reproducible
+    const std::size_t offset = m_CompactionParity[h] ? 1 : 0;
+    m_CompactionParity[h]    = !m_CompactionParity[h];
+
+    for (std::size_t i = offset; i < current.size(); i += 2)
+    {
+      next.push_back(current[i]);
+    }
+    m_Size -= current.size() / 2;
+
+    current.clear();
+    if (hasLeftOver)
+    {
+      current.push_back(leftOver);
+    }
+
+    if (m_Size < m_MaxSize)
+    {
+      break;
+    }
+  }
+}
+
+void QuantileSketch::Merge(const QuantileSketch& other)
+{
+  if (other.m_Count == 0)
+  {
+    return;
+  }
+
+  while (m_Compactors.size() < other.m_Compactors.size())
+  {
+    this->Grow();
+  }
+
+  for (unsigned int h = 0; h < other.m_Compactors.size(); ++h)
+  {
+    m_Compactors[h].insert(m_Compactors[h].end(), other.m_Compactors[h].begin(), other.m_Compactors[h].end());
+  }
+  m_Size += other.m_Size;
+
+  if (m_Count == 0)
+  {
+    m_Minimum = other.m_Minimum;
+    m_Maximum = other.m_Maximum;
+  }
+  else
+  {
+    m_Minimum = std::min(m_Minimum, other.m_Minimum);
+    m_Maximum = std::max(m_Maximum, other.m_Maximum);
+  }
+  m_Count += other.m_Count;
+
+  while (m_Size >= m_MaxSize)
+  {
+    this->Compress();
+  }
+}
+
+std::vector<QuantileSketch::WeightedValueType> QuantileSketch::GetSortedValues() const
+{
+  std::vector<WeightedValueType> values;
+  values.reserve(m_Size);
+
+  for (unsigned int h = 0; h < m_Compactors.size(); ++h)
+  {
+    const std::uint64_t weight = static_cast<std::uint64_t>(1) << h;
+    for (CompactorType::const_iterator it = m_Compactors[h].begin(); it != m_Compactors[h].end(); ++it)
+    {
+      values.push_back(WeightedValueType(*it, weight));
+    }
+  }
+
+  std::sort(values.begin(), values.end());
+
+  // Turn weights into cumulated weights
+  std::uint64_t cumulated = 0;
+  for (std::vector<WeightedValueType>::iterator it = values.begin(); it != values.end(); ++it)
+  {
+    cumulated += it->second;
+    it->second = cumulated;
+  }
+  return values;
+}
+
+std::vector<QuantileSketch::ValueType> QuantileSketch::GetQuantiles(const std::vector<double>& q) const
+{
+  std::vector<ValueType> result(q.size(), 0);
+  if (m_Count == 0)
+  {
+    return result;
+  }
+
+  const std::vector<WeightedValueType> values = this->GetSortedValues();
+
+  for (unsigned int i = 0; i < q.size(); ++i)
+  {
+    if (q[i] <= 0.)
+    {
+      result[i] = m_Minimum;
+    }
+    else if (q[i] >= 1.)
+    {
+      result[i] = m_Maximum;
+    }
+    else
+    {
+      // First value whose cumulated weight reaches the requested rank
+      const double  target = q[i] * static_cast<double>(m_Count);
+      std::uint64_t rank   = static_cast<std::uint64_t>(std::ceil(target));
+      rank                 = std::max(rank, static_cast<std::uint64_t>(1));
+
+      std::vector<WeightedValueType>::const_iterator it =
+          std::lower_bound(values.begin(), values.end(), rank,
+                           [](const WeightedValueType& a, std::uint64_t r) { return a.second < r; });
+      result[i] = (it != values.end()) ? it->first : m_Maximum;
+    }
+  }
+  return result;
+}
+
+QuantileSketch::ValueType QuantileSketch::GetQuantile(double q) const
+{
+  return this->GetQuantiles(std::vector<double>(1, q))[0];
+}
+
+double QuantileSketch::GetRank(ValueType value) const
+{
+  if (m_Count == 0)
+  {
+    return 0.;
+  }
+
+  std::uint64_t below = 0;
+  for (unsigned int h = 0; h < m_Compactors.size(); ++h)
+  {
+    const std::uint64_t weight = static_cast<std::uint64_t>(1) << h;
+    for (CompactorType::const_iterator it = m_Compactors[h].begin(); it != m_Compactors[h].end(); ++it)
+    {
+      if (*it <= value)
+      {
+        below += weight;
+      }
+    }
+  }
+  return static_cast<double>(below) / static_cast<double>(m_Count);
+}
+
+} // end namespace otb
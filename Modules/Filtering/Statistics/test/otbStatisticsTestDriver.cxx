@@ -24,6 +24,7 @@ void RegisterTests()
 {
   REGISTER_TEST(otbStreamingMinMaxImageFilter);
   REGISTER_TEST(otbStreamingHistogramVectorImageFilterTest);
+  REGISTER_TEST(otbStreamingQuantilesVectorImageFilterTest);
   REGISTER_TEST(otbRealImageToComplexImageFilterTest);
   REGISTER_TEST(otbHistogramStatisticsFunction);
   REGISTER_TEST(otbGaussianAdditiveNoiseSampleListFilter);
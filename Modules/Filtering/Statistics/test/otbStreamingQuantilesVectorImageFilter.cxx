@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbStreamingQuantilesVectorImageFilter.h"
+#include "otbVectorImage.h"
+#include "otbImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+typedef otb::VectorImage<float>                                          VectorImageType;
+typedef otb::Image<unsigned char>                                        MaskImageType;
+typedef otb::StreamingQuantilesVectorImageFilter<VectorImageType, MaskImageType> QuantilesFilterType;
+
+int otbStreamingQuantilesVectorImageFilterTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  const unsigned int nbComp  = 2;
+  const float        noData  = -1.f;
+  const double       epsilon = 0.005;
+
+  VectorImageType::SizeType size;
+  size[0] = 200;
+  size[1] = 150;
+  VectorImageType::IndexType idx;
+  idx.Fill(0);
+  VectorImageType::RegionType region;
+  region.SetSize(size);
+  region.SetIndex(idx);
+
+  VectorImageType::Pointer image = VectorImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(nbComp);
+  image->Allocate();
+
+  MaskImageType::Pointer mask = MaskImageType::New();
+  mask->SetRegions(region);
+  mask->Allocate();
+
+  // Deterministic pseudo-random values, a masked stripe and some no-data
+  // values in the second band
+  std::vector<std::vector<double>> expected(nbComp);
+  unsigned int                     seed = 12345;
+
+  itk::ImageRegionIteratorWithIndex<VectorImageType> it(image, region);
+  itk::ImageRegionIteratorWithIndex<MaskImageType>   maskIt(mask, region);
+  VectorImageType::PixelType                         pixel(nbComp);
+
+  for (it.GoToBegin(), maskIt.GoToBegin(); !it.IsAtEnd(); ++it, ++maskIt)
+  {
+    seed     = seed * 1103515245 + 12345;
+    pixel[0] = static_cast<float>((seed >> 8) % 10000) / 100.f;
+    seed     = seed * 1103515245 + 12345;
+    pixel[1] = static_cast<float>((seed >> 8) % 1000);
+    if (pixel[1] < 100)
+    {
+      pixel[1] = noData;
+    }
+    it.Set(pixel);
+
+    const bool valid = (it.GetIndex()[0] % 7) != 0;
+    maskIt.Set(valid ? 1 : 0);
+
+    if (valid)
+    {
+      expected[0].push_back(pixel[0]);
+      if (pixel[1] != noData)
+      {
+        expected[1].push_back(pixel[1]);
+      }
+    }
+  }
+
+  QuantilesFilterType::Pointer filter = QuantilesFilterType::New();
+  filter->SetInput(image);
+  filter->SetMaskImage(mask);
+  filter->SetNoDataFlag(true);
+  filter->SetNoDataValue(noData);
+  filter->SetSketchSize(1000);
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(10);
+  filter->Update();
+
+  QuantilesFilterType::CountVectorType count = filter->GetCount();
+  const double                         q[]   = {0., 0.02, 0.25, 0.5, 0.75, 0.98, 1.};
+
+  bool success = true;
+  for (unsigned int k = 0; k < nbComp; ++k)
+  {
+    std::vector<double>& values = expected[k];
+    std::sort(values.begin(), values.end());
+
+    if (count[k] != values.size())
+    {
+      std::cerr << "Band " << k << ": " << count[k] << " values taken into account instead of " << values.size() << std::endl;
+      success = false;
+    }
+    if (filter->GetMinimum()[k] != values.front() || filter->GetMaximum()[k] != values.back())
+    {
+      std::cerr << "Band " << k << ": wrong minimum or maximum" << std::endl;
+      success = false;
+    }
+
+    for (unsigned int i = 0; i < sizeof(q) / sizeof(double); ++i)
+    {
+      const double value = filter->GetQuantile(k, q[i]);
+
+      // Rank interval of the returned value in the exact distribution
+      const double rankLow  = static_cast<double>(std::lower_bound(values.begin(), values.end(), value) - values.begin()) / values.size();
+      const double rankHigh = static_cast<double>(std::upper_bound(values.begin(), values.end(), value) - values.begin()) / values.size();
+
+      std::cout << "Band " << k << " quantile " << q[i] << ": " << value << " (rank in [" << rankLow << ", " << rankHigh << "])" << std::endl;
+
+      if (q[i] < rankLow - epsilon || q[i] > rankHigh + epsilon)
+      {
+        std::cerr << "Band " << k << ": quantile " << q[i] << " out of tolerance" << std::endl;
+        success = false;
+      }
+    }
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
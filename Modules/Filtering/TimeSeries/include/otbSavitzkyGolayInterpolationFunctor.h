@@ -23,6 +23,7 @@
 
 #include "otbTimeSeries.h"
 #include "otbTimeSeriesLeastSquareFittingFunctor.h"
+#include "otbTimeSeriesLinearSmoother.h"
 
 
 namespace otb
@@ -44,6 +45,10 @@ namespace Functor
  *  squares estimation can be set (the higher the weight, the lower the
  *  confidence in the value).
  *
+ *  The least squares coefficients only depend on the dates and the
+ *  weights: they are computed by SetDates() and SetWeights(), so that
+ *  operator() only applies them to the series.
+ *
  *  Savitzky, A.; Golay, M.J.E. (1964). "Smoothing and Differentiation of
  *  Data by Simplified Least Squares Procedures". Analytical Chemistry 36
  *  (8): 1627-1639. doi:10.1021/ac60214a047
@@ -75,6 +80,13 @@ public:
   /// Constructor
   SavitzkyGolayInterpolationFunctor()
   {
+    for (unsigned int i = 0; i < m_WeightSeries.Size(); ++i)
+      m_WeightSeries[i] = 1.0;
+    for (unsigned int i = 0; i < m_DoySeries.Size(); ++i)
+      m_DoySeries[i]    = i;
+    m_Smoother.SetRadius(Radius);
+    m_Smoother.SetDegree(Degree);
+    this->UpdateSmoother();
   }
   /// Destructor
   virtual ~SavitzkyGolayInterpolationFunctor()
@@ -85,52 +97,35 @@ public:
   {
     for (unsigned int i = 0; i < m_WeightSeries.Size(); ++i)
       m_WeightSeries[i] = weights[i];
+    this->UpdateSmoother();
   }
 
   inline void SetDates(const TDates doy)
   {
     for (unsigned int i = 0; i < m_DoySeries.Size(); ++i)
       m_DoySeries[i]    = doy[i];
+    this->UpdateSmoother();
   }
 
   inline TSeries operator()(const TSeries& series) const
   {
     TSeries outSeries;
-
-    unsigned int firstSample = Radius;
-    unsigned int lastSample  = nbDates - Radius - 1;
-
-    for (unsigned int i = 0; i < firstSample; ++i)
-      outSeries[i]      = series[i];
-    for (unsigned int i = lastSample + 1; i < nbDates; ++i)
-      outSeries[i]      = series[i];
-
-    for (unsigned int i = firstSample; i <= lastSample; ++i)
-    {
-      InterpolatedSeriesType tmpInSeries;
-      InterpolatedDatesType  tmpDates;
-      InterpolatedWeightType tmpWeights;
-
-      for (unsigned int j = 0; j <= 2 * Radius; ++j)
-      {
-        tmpInSeries[j] = series[i + j - Radius];
-        tmpDates[j]    = m_DoySeries[i + j - Radius];
-        tmpWeights[j]  = m_WeightSeries[i + j - Radius];
-      }
-
-      TLSFunctorType f;
-      f.SetDates(tmpDates);
-      f.SetWeights(tmpWeights);
-      InterpolatedSeriesType tmpOutSeries = f(tmpInSeries);
-      outSeries[i]                        = tmpOutSeries[Radius];
-    }
-
+    m_Smoother.Smooth(series.GetDataPointer(), outSeries.GetDataPointer());
     return outSeries;
   }
 
 private:
+  void UpdateSmoother()
+  {
+    m_Smoother.SetDates(m_DoySeries.Begin(), m_DoySeries.End());
+    m_Smoother.SetWeights(m_WeightSeries.Begin(), m_WeightSeries.End());
+    m_Smoother.Initialize();
+  }
+
   TWeight m_WeightSeries;
   TDates  m_DoySeries;
+
+  TimeSeriesLinearSmoother<CoefficientPrecisionType> m_Smoother;
 };
 }
 } // namespace otb
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbTimeSeriesLinearSmoother_h
+#define otbTimeSeriesLinearSmoother_h
+
+#include "itkMacro.h"
+#include "vnl/algo/vnl_matrix_inverse.h"
+#include "vnl/vnl_matrix.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace otb
+{
+/** \class TimeSeriesLinearSmoother
+ * \brief Local polynomial smoothing of time series with precomputed weights
+ *
+ * Each output date is the value, at this date, of the weighted least
+ * squares polynomial fitted on a window of dates around it (Savitzky-Golay
+ * smoothing), or on the whole series. Since the dates are the same for all
+ * the pixels, the fit is a linear function of the series: Initialize()
+ * computes once, for each output date, the coefficients to apply to the
+ * values of its window. Smoothing a series is then a small matrix-vector
+ * product.
+ *
+ * As in TimeSeriesLeastSquareFittingFunctor, the weights are the errors of
+ * the measures (the higher the weight, the lower the confidence in the
+ * value). In addition, a validity mask can be given with each series: the
+ * invalid dates are left out of the fits and their output is interpolated.
+ * The coefficients of each window are cached per validity pattern, as
+ * masks of a stack usually only produce a few of them. When a window does
+ * not have more valid dates than the degree of the polynomial, the input
+ * value is kept.
+ *
+ * With a radius R, the first and last R dates are copied, as in
+ * SavitzkyGolayInterpolationFunctor.
+ *
+ * Copies share the cache, and the Smooth methods are thread safe: the
+ * coefficients of a known pattern are looked up under a shared lock, and
+ * the lock is only exclusive while a new pattern is computed.
+ *
+ * \sa SavitzkyGolayInterpolationFunctor
+ * \sa TimeSeriesLeastSquareFittingFunctor
+ *
+ * \ingroup OTBTimeSeries
+ */
+template <class TPrecision = double>
+class TimeSeriesLinearSmoother
+{
+public:
+  typedef TPrecision                 PrecisionType;
+  typedef std::vector<PrecisionType> CoefficientsType;
+
+  TimeSeriesLinearSmoother() : m_Degree(2), m_Radius(2), m_WholeSeries(false), m_Cache(std::make_shared<CacheType>())
+  {
+  }
+
+  /** Set the dates of the series */
+  template <class TIterator>
+  void SetDates(TIterator first, TIterator last)
+  {
+    m_Dates.assign(first, last);
+  }
+
+  const std::vector<double>& GetDates() const
+  {
+    return m_Dates;
+  }
+
+  /** Set the error of each date. All weights are 1 if not set. */
+  template <class TIterator>
+  void SetWeights(TIterator first, TIterator last)
+  {
+    m_Weights.assign(first, last);
+  }
+
+  const std::vector<double>& GetWeights() const
+  {
+    return m_Weights;
+  }
+
+  /** Degree of the local polynomials (default 2) */
+  void SetDegree(unsigned int degree)
+  {
+    m_Degree = degree;
+  }
+
+  unsigned int GetDegree() const
+  {
+    return m_Degree;
+  }
+
+  /** Radius of the window, in number of dates (default 2) */
+  void SetRadius(unsigned int radius)
+  {
+    m_Radius = radius;
+  }
+
+  unsigned int GetRadius() const
+  {
+    return m_Radius;
+  }
+
+  /** Fit the polynomials on the whole series instead of a window */
+  void SetWholeSeries(bool flag)
+  {
+    m_WholeSeries = flag;
+  }
+
+  bool GetWholeSeries() const
+  {
+    return m_WholeSeries;
+  }
+
+  unsigned int GetNumberOfDates() const
+  {
+    return static_cast<unsigned int>(m_Dates.size());
+  }
+
+  /** Compute the coefficients of each output date. Must be called after the
+   * parameters have been set, and before smoothing. */
+  void Initialize()
+  {
+    const unsigned int nbDates = GetNumberOfDates();
+    if (!m_Weights.empty() && m_Weights.size() != nbDates)
+    {
+      itkGenericExceptionMacro(<< "TimeSeriesLinearSmoother: " << m_Weights.size() << " weights for " << nbDates << " dates");
+    }
+    if (m_Weights.empty())
+    {
+      m_Weights.assign(nbDates, 1.);
+    }
+
+    m_Rows.assign(nbDates, RowType());
+    m_Cache = std::make_shared<CacheType>();
+    m_Cache->rows.resize(nbDates);
+
+    for (unsigned int i = 0; i < nbDates; ++i)
+    {
+      unsigned int first, last;
+      if (!GetSupport(i, first, last))
+      {
+        continue;
+      }
+      ComputeRow(i, first, std::vector<bool>(last - first + 1, true), m_Rows[i]);
+    }
+  }
+
+  /** Smooth one series of GetNumberOfDates() values */
+  template <class TInput, class TOutput>
+  void Smooth(const TInput* series, TOutput* out) const
+  {
+    for (unsigned int i = 0; i < m_Rows.size(); ++i)
+    {
+      out[i] = static_cast<TOutput>(Apply(m_Rows[i], series, i));
+    }
+  }
+
+  /** Smooth one series, leaving out the dates whose valid flag is 0 */
+  template <class TInput, class TMask, class TOutput>
+  void Smooth(const TInput* series, const TMask* valid, TOutput* out) const
+  {
+    std::vector<bool> pattern;
+
+    for (unsigned int i = 0; i < m_Rows.size(); ++i)
+    {
+      unsigned int first, last;
+      bool         complete = true;
+      if (GetSupport(i, first, last))
+      {
+        for (unsigned int k = first; k <= last && complete; ++k)
+        {
+          complete = (valid[k] != 0);
+        }
+      }
+
+      if (complete)
+      {
+        out[i] = static_cast<TOutput>(Apply(m_Rows[i], series, i));
+        continue;
+      }
+
+      pattern.resize(last - first + 1);
+      for (unsigned int k = first; k <= last; ++k)
+      {
+        pattern[k - first] = (valid[k] != 0);
+      }
+
+      out[i] = static_cast<TOutput>(Apply(GetMaskedRow(i, first, pattern), series, i));
+    }
+  }
+
+  /** Coefficients applied to the dates GetFirstDate(i), ... for output date
+   * i when all dates are valid. Empty when the input value is copied. */
+  const CoefficientsType& GetCoefficients(unsigned int i) const
+  {
+    return m_Rows[i].coefficients;
+  }
+
+  unsigned int GetFirstDate(unsigned int i) const
+  {
+    return m_Rows[i].first;
+  }
+
+private:
+  struct RowType
+  {
+    RowType() : first(0)
+    {
+    }
+    unsigned int     first;
+    CoefficientsType coefficients;
+  };
+
+  typedef std::map<std::vector<bool>, RowType> RowMapType;
+
+  struct CacheType
+  {
+    std::shared_timed_mutex mutex;
+    std::vector<RowMapType> rows;
+  };
+
+  /** Dates used to fit output date i. Returns false if it is copied. */
+  bool GetSupport(unsigned int i, unsigned int& first, unsigned int& last) const
+  {
+    const unsigned int nbDates = GetNumberOfDates();
+    if (m_WholeSeries)
+    {
+      first = 0;
+      last  = nbDates - 1;
+      return true;
+    }
+    first = last = i;
+    if (i < m_Radius || i + m_Radius >= nbDates)
+    {
+      return false;
+    }
+    first = i - m_Radius;
+    last  = i + m_Radius;
+    return true;
+  }
+
+  /** Coefficients of output date i for a validity pattern of the window
+   * starting at first, computed on first use. The rows are never modified
+   * once inserted, and the nodes of a map are stable, so the reference
+   * stays valid after the lock is released. */
+  const RowType& GetMaskedRow(unsigned int i, unsigned int first, const std::vector<bool>& pattern) const
+  {
+    RowMapType& rows = m_Cache->rows[i];
+    {
+      std::shared_lock<std::shared_timed_mutex> lock(m_Cache->mutex);
+      typename RowMapType::const_iterator       it = rows.find(pattern);
+      if (it != rows.end())
+      {
+        return it->second;
+      }
+    }
+
+    std::unique_lock<std::shared_timed_mutex> lock(m_Cache->mutex);
+    typename RowMapType::iterator             it = rows.find(pattern);
+    if (it == rows.end())
+    {
+      it = rows.insert(std::make_pair(pattern, RowType())).first;
+      ComputeRow(i, first, pattern, it->second);
+    }
+    return it->second;
+  }
+
+  /** Least squares coefficients of output date i, using the dates of the
+   * window starting at first whose flag is set */
+  void ComputeRow(unsigned int i, unsigned int first, const std::vector<bool>& valid, RowType& row) const
+  {
+    const unsigned int nbCoefs = m_Degree + 1;
+    const unsigned int nbValid = static_cast<unsigned int>(std::count(valid.begin(), valid.end(), true));
+
+    row.first = first;
+    row.coefficients.clear();
+    if (nbValid < nbCoefs)
+    {
+      return;
+    }
+
+    // The polynomial is centered on the output date, so that its value there
+    // is the constant coefficient
+    vnl_matrix<double> A(nbValid, nbCoefs);
+    unsigned int       r = 0;
+    for (unsigned int k = 0; k < valid.size(); ++k)
+    {
+      if (!valid[k])
+        continue;
+      const double t    = m_Dates[first + k] - m_Dates[i];
+      double       tPow = 1. / m_Weights[first + k];
+      for (unsigned int j = 0; j < nbCoefs; ++j, tPow *= t)
+      {
+        A.put(r, j, tPow);
+      }
+      ++r;
+    }
+
+    // c = (At * A)^-1 * At * b, with b = series / weights
+    vnl_matrix<double> atainv   = vnl_matrix_inverse<double>(A.transpose() * A);
+    vnl_matrix<double> atainvat = atainv * A.transpose();
+
+    row.coefficients.assign(valid.size(), PrecisionType(0));
+    r = 0;
+    for (unsigned int k = 0; k < valid.size(); ++k)
+    {
+      if (!valid[k])
+        continue;
+      row.coefficients[k] = static_cast<PrecisionType>(atainvat.get(0, r) / m_Weights[first + k]);
+      ++r;
+    }
+  }
+
+  template <class TInput>
+  PrecisionType Apply(const RowType& row, const TInput* series, unsigned int i) const
+  {
+    if (row.coefficients.empty())
+    {
+      return static_cast<PrecisionType>(series[i]);
+    }
+    PrecisionType value = 0;
+    for (unsigned int k = 0; k < row.coefficients.size(); ++k)
+    {
+      value += row.coefficients[k] * static_cast<PrecisionType>(series[row.first + k]);
+    }
+    return value;
+  }
+
+  std::vector<double> m_Dates;
+  std::vector<double> m_Weights;
+  unsigned int        m_Degree;
+  unsigned int        m_Radius;
+  bool                m_WholeSeries;
+
+  /** Coefficients of each output date when all dates are valid */
+  std::vector<RowType> m_Rows;
+
+  /** Coefficients per validity pattern of the windows */
+  std::shared_ptr<CacheType> m_Cache;
+};
+
+} // namespace otb
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbTimeSeriesSmoothingFunctor_h
+#define otbTimeSeriesSmoothingFunctor_h
+
+#include "otbTimeSeriesLinearSmoother.h"
+#include "itkVariableLengthVector.h"
+#include <array>
+
+namespace otb
+{
+namespace Functor
+{
+/** \class TimeSeriesSmoothingFunctor
+ * \brief Smooth the time series stored in the bands of a pixel
+ *
+ * This functor applies a TimeSeriesLinearSmoother to each pixel, and can
+ * be used with FunctorImageFilter on a stack with one band per date. The
+ * smoother must be initialized before the filter is updated.
+ *
+ * \sa TimeSeriesLinearSmoother
+ *
+ * \ingroup OTBTimeSeries
+ */
+template <class TInput, class TOutput = TInput, class TPrecision = double>
+class TimeSeriesSmoothingFunctor
+{
+public:
+  typedef TimeSeriesLinearSmoother<TPrecision> SmootherType;
+
+  void SetSmoother(const SmootherType& smoother)
+  {
+    m_Smoother = smoother;
+  }
+
+  const SmootherType& GetSmoother() const
+  {
+    return m_Smoother;
+  }
+
+  itk::VariableLengthVector<TOutput> operator()(const itk::VariableLengthVector<TInput>& series) const
+  {
+    itk::VariableLengthVector<TOutput> out(m_Smoother.GetNumberOfDates());
+    m_Smoother.Smooth(series.GetDataPointer(), out.GetDataPointer());
+    return out;
+  }
+
+  size_t OutputSize(const std::array<size_t, 1>&) const
+  {
+    return m_Smoother.GetNumberOfDates();
+  }
+
+private:
+  SmootherType m_Smoother;
+};
+
+/** \class MaskedTimeSeriesSmoothingFunctor
+ * \brief Smooth the time series stored in the bands of a pixel, with a
+ * validity mask
+ *
+ * The second input has one band per date, non zero for the valid dates.
+ * The invalid dates are left out of the fits, and their output is
+ * interpolated from the valid ones.
+ *
+ * \sa TimeSeriesLinearSmoother
+ *
+ * \ingroup OTBTimeSeries
+ */
+template <class TInput, class TMask, class TOutput = TInput, class TPrecision = double>
+class MaskedTimeSeriesSmoothingFunctor
+{
+public:
+  typedef TimeSeriesLinearSmoother<TPrecision> SmootherType;
+
+  void SetSmoother(const SmootherType& smoother)
+  {
+    m_Smoother = smoother;
+  }
+
+  const SmootherType& GetSmoother() const
+  {
+    return m_Smoother;
+  }
+
+  itk::VariableLengthVector<TOutput> operator()(const itk::VariableLengthVector<TInput>& series, const itk::VariableLengthVector<TMask>& valid) const
+  {
+    itk::VariableLengthVector<TOutput> out(m_Smoother.GetNumberOfDates());
+    m_Smoother.Smooth(series.GetDataPointer(), valid.GetDataPointer(), out.GetDataPointer());
+    return out;
+  }
+
+  size_t OutputSize(const std::array<size_t, 2>&) const
+  {
+    return m_Smoother.GetNumberOfDates();
+  }
+
+private:
+  SmootherType m_Smoother;
+};
+
+} // namespace Functor
+} // namespace otb
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbTimeSeriesLinearSmoother.h"
+#include "otbTimeSeriesSmoothingFunctor.h"
+#include "otbTimeSeriesLeastSquareFittingFunctor.h"
+#include "otbTimeSeries.h"
+#include "itkFixedArray.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+int otbTimeSeriesLinearSmootherTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  const unsigned int Radius  = 3;
+  const unsigned int nbDates = 73;
+  const unsigned int Window  = 2 * Radius + 1;
+
+  typedef itk::FixedArray<double, Window>                                               WindowType;
+  typedef otb::PolynomialTimeSeries<2>                                                  PolynomialType;
+  typedef otb::Functor::TimeSeriesLeastSquareFittingFunctor<WindowType, PolynomialType> LSFunctorType;
+  typedef otb::TimeSeriesLinearSmoother<double>                                         SmootherType;
+
+  // Irregular dates over one year, with weights
+  std::vector<double> dates(nbDates);
+  std::vector<double> weights(nbDates);
+  std::vector<double> series(nbDates);
+  for (unsigned int i = 0; i < nbDates; ++i)
+  {
+    dates[i]   = 5 * i + (i % 3);
+    weights[i] = 1. + (i % 4) * 0.5;
+    series[i]  = 10 * std::cos(dates[i] / 50.) + (i % 5);
+  }
+
+  SmootherType smoother;
+  smoother.SetDates(dates.begin(), dates.end());
+  smoother.SetWeights(weights.begin(), weights.end());
+  smoother.SetRadius(Radius);
+  smoother.SetDegree(2);
+  smoother.Initialize();
+
+  std::vector<double> out(nbDates);
+  smoother.Smooth(series.data(), out.data());
+
+  // Reference: the least squares fit solved on each window
+  for (unsigned int i = 0; i < nbDates; ++i)
+  {
+    double expected = series[i];
+    if (i >= Radius && i + Radius < nbDates)
+    {
+      WindowType windowSeries, windowDates, windowWeights;
+      for (unsigned int j = 0; j < Window; ++j)
+      {
+        windowSeries[j]  = series[i + j - Radius];
+        windowDates[j]   = dates[i + j - Radius];
+        windowWeights[j] = weights[i + j - Radius];
+      }
+      LSFunctorType f;
+      f.SetDates(windowDates);
+      f.SetWeights(windowWeights);
+      expected = f(windowSeries)[Radius];
+    }
+    if (std::fabs(out[i] - expected) > 1e-6)
+    {
+      std::cout << "Date " << i << ": smoothed value " << out[i] << " instead of " << expected << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Masked dates of a quadratic series are interpolated exactly, as long as
+  // each window has enough valid dates. Otherwise the input value is kept.
+  std::vector<unsigned char> valid(nbDates, 1);
+  for (unsigned int i = 10; i < 30; i += 4)
+    valid[i] = 0;
+  valid[50] = valid[51] = valid[52] = valid[53] = valid[54] = 0;
+
+  std::vector<double> quadratic(nbDates);
+  for (unsigned int i = 0; i < nbDates; ++i)
+  {
+    quadratic[i] = 0.001 * dates[i] * dates[i] - 0.2 * dates[i] + 3. + (valid[i] ? 0. : 1000.);
+  }
+
+  otb::Functor::MaskedTimeSeriesSmoothingFunctor<double, unsigned char> functor;
+  functor.SetSmoother(smoother);
+
+  itk::VariableLengthVector<double>        pixel(quadratic.data(), nbDates);
+  itk::VariableLengthVector<unsigned char> mask(valid.data(), nbDates);
+  itk::VariableLengthVector<double>        result = functor(pixel, mask);
+
+  for (unsigned int i = 0; i < nbDates; ++i)
+  {
+    unsigned int nbValid = 0;
+    for (unsigned int j = i - std::min(i, Radius); j <= std::min(i + Radius, nbDates - 1); ++j)
+      nbValid += valid[j];
+
+    const bool   copied   = (i < Radius || i + Radius >= nbDates || nbValid < 3);
+    const double expected = copied ? quadratic[i] : 0.001 * dates[i] * dates[i] - 0.2 * dates[i] + 3.;
+    if (std::fabs(result[i] - expected) > 1e-6)
+    {
+      std::cout << "Masked date " << i << ": smoothed value " << result[i] << " instead of " << expected << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -27,4 +27,5 @@ void RegisterTests()
   REGISTER_TEST(otbSavitzkyGolayInterpolationFunctorTest);
   REGISTER_TEST(otbTimeSeriesLeastSquareFittingFunctorTest);
   REGISTER_TEST(otbTimeSeriesLeastSquareFittingFunctorWeightsTest);
+  REGISTER_TEST(otbTimeSeriesLinearSmootherTest);
 }
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef otbBenchmarkRunner_h
+#define otbBenchmarkRunner_h
+
+#include "OTBBenchmarkExport.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class BenchmarkRunner
+ * \brief Time kernels, report their throughput and compare it to a baseline.
+ *
+ * Each benchmark is a callable processing a known number of items (pixels,
+ * samples, points) per call. It is called once to warm up caches and lazy
+ * initializations, then repeatedly until both a minimum number of repeats
+ * and a minimum total time are reached. The median time of a call gives the
+ * throughput, the fastest call is reported as well.
+ *
+ * A benchmark can be run for several thread counts: the global default
+ * number of threads of ITK is set before the calls, and the count is also
+ * given to the callable for the objects created beforehand. The speedup is
+ * computed against the single thread result of the same benchmark.
+ *
+ * Results are written to a JSON file, one benchmark per line. When a
+ * baseline file produced by an earlier build is given, each benchmark found
+ * in both files is compared, and a throughput lower than the baseline by
+ * more than the tolerance is reported as a regression.
+ *
+ * The command line of a benchmark test is:
+ * \code
+ * <output.json> [<baseline.json> [<tolerance>]]
+ * \endcode
+ * where the baseline may be an empty string, and the tolerance is a ratio
+ * (0.2 by default).
+ *
+ * \ingroup OTBBenchmark
+ */
+class OTBBenchmark_EXPORT BenchmarkRunner
+{
+public:
+  /** The kernel receives the number of threads it should use */
+  typedef std::function<void(unsigned int)> KernelType;
+  typedef std::vector<unsigned int>         ThreadCountListType;
+
+  struct ResultType
+  {
+    std::string  name;
+    std::string  unit;
+    unsigned int threads;
+    double       items;
+    unsigned int repeats;
+    double       medianTime;
+    double       minimumTime;
+    double       throughput; // items per second
+    double       speedup;    // against one thread, 0 if unknown
+  };
+  typedef std::vector<ResultType> ResultListType;
+
+  /** Parse the command line of a benchmark test, argv[0] being the test name */
+  BenchmarkRunner(int argc, char* argv[]);
+
+  /** Minimum cumulated time of the timed calls, in seconds (0.5 by default) */
+  void SetMinimumTime(double seconds)
+  {
+    m_MinimumTime = seconds;
+  }
+
+  /** Minimum number of timed calls (3 by default) */
+  void SetMinimumRepeats(unsigned int repeats)
+  {
+    m_MinimumRepeats = repeats;
+  }
+
+  /** Maximum number of timed calls (1000 by default) */
+  void SetMaximumRepeats(unsigned int repeats)
+  {
+    m_MaximumRepeats = repeats;
+  }
+
+  /** Directory of the output file, for the temporary files of I/O benchmarks */
+  std::string GetOutputDirectory() const;
+
+  /** Powers of two up to the global default number of threads, which is
+   * always included */
+  ThreadCountListType GetDefaultThreadCounts() const;
+
+  /** Time a kernel processing items units per call, for each thread count */
+  void Run(const std::string& name, const std::string& unit, double items, const KernelType& kernel, const ThreadCountListType& threadCounts);
+
+  /** Time a kernel processing items units per call, with one thread */
+  void Run(const std::string& name, const std::string& unit, double items, const KernelType& kernel);
+
+  /** Keep the compiler from discarding a computation whose result is unused */
+  static void KeepResult(double value);
+
+  const ResultListType& GetResults() const
+  {
+    return m_Results;
+  }
+
+  /** Write the results, compare them to the baseline and print a summary.
+   * Returns EXIT_FAILURE if the output cannot be written, if a benchmark
+   * failed or if a regression is detected. */
+  int Finish();
+
+private:
+  /** Read the throughput of the benchmarks of a result file, as results
+   * with only name, threads and throughput set */
+  static bool ReadResults(const std::string& filename, ResultListType& results);
+
+  bool WriteResults(const std::string& filename) const;
+
+  /** Returns the number of regressions */
+  unsigned int CompareToBaseline(const ResultListType& baseline) const;
+
+  std::string  m_OutputFile;
+  std::string  m_BaselineFile;
+  double       m_Tolerance;
+  double       m_MinimumTime;
+  unsigned int m_MinimumRepeats;
+  unsigned int m_MaximumRepeats;
+  unsigned int m_MaximumThreads;
+  bool         m_Failed;
+
+  ResultListType m_Results;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef otbBenchmarkSyntheticData_h
+#define otbBenchmarkSyntheticData_h
+
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include <cmath>
+
+namespace otb
+{
+namespace Benchmark
+{
+
+/** Deterministic value of band b at pixel (x, y): a smooth pattern with some
+ * high frequency texture, so that compression and interpolation behave as
+ * on real images rather than on constant or random data. */
+inline double SyntheticValue(unsigned int x, unsigned int y, unsigned int b)
+{
+  unsigned int hash = (x * 73856093u) ^ (y * 19349663u) ^ (b * 83492791u);
+  hash              = (hash ^ (hash >> 13)) * 1274126177u;
+  return 1000. + 500. * std::sin(0.013 * x + 0.7 * b) * std::cos(0.021 * y) + 200. * std::sin(0.002 * (x + y)) + (hash >> 24) % 32;
+}
+
+/** Generate a synthetic image of sizeX x sizeY pixels */
+template <class TPixel>
+typename otb::Image<TPixel, 2>::Pointer GenerateSyntheticImage(unsigned int sizeX, unsigned int sizeY)
+{
+  typedef otb::Image<TPixel, 2> ImageType;
+
+  typename ImageType::SizeType size;
+  size[0] = sizeX;
+  size[1] = sizeY;
+  typename ImageType::RegionType region;
+  region.SetSize(size);
+
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  TPixel* buffer = image->GetBufferPointer();
+  for (unsigned int y = 0; y < sizeY; ++y)
+  {
+    for (unsigned int x = 0; x < sizeX; ++x)
+    {
+      *buffer++ = static_cast<TPixel>(SyntheticValue(x, y, 0));
+    }
+  }
+  return image;
+}
+
+/** Generate a synthetic image of sizeX x sizeY pixels with nbBands bands */
+template <class TPixel>
+typename otb::VectorImage<TPixel, 2>::Pointer GenerateSyntheticVectorImage(unsigned int sizeX, unsigned int sizeY, unsigned int nbBands)
+{
+  typedef otb::VectorImage<TPixel, 2> ImageType;
+
+  typename ImageType::SizeType size;
+  size[0] = sizeX;
+  size[1] = sizeY;
+  typename ImageType::RegionType region;
+  region.SetSize(size);
+
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(nbBands);
+  image->Allocate();
+
+  TPixel* buffer = image->GetBufferPointer();
+  for (unsigned int y = 0; y < sizeY; ++y)
+  {
+    for (unsigned int x = 0; x < sizeX; ++x)
+    {
+      for (unsigned int b = 0; b < nbBands; ++b)
+      {
+        *buffer++ = static_cast<TPixel>(SyntheticValue(x, y, b));
+      }
+    }
+  }
+  return image;
+}
+
+} // end namespace Benchmark
+} // end namespace otb
+
+#endif
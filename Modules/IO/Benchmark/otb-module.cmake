@@ -0,0 +1,52 @@
+#
+# Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+#
+# This file is part of Orfeo Toolbox
+#
+#     https://www.orfeo-toolbox.org/
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+set(DOCUMENTATION "This module contains micro-benchmarks of the core kernels
+and of the I/O paths: interpolators, functor filters, streaming statistics,
+GDAL reading and writing, machine learning predictions and geometric
+transforms. Benchmarks run on synthetic data, report throughput and scaling
+across thread counts, and store JSON results that can be compared between
+builds to catch performance regressions.")
+
+otb_module(OTBBenchmark
+  ENABLE_SHARED
+  DEPENDS
+    OTBCommon
+    OTBITK
+    OTBImageBase
+
+  TEST_DEPENDS
+    OTBTestKernel
+    OTBInterpolation
+    OTBFunctor
+    OTBStatistics
+    OTBImageIO
+    OTBIOGDAL
+    OTBGdalAdapters
+    OTBMetadata
+    OTBTransform
+    OTBLearningBase
+    OTBSupervised
+
+  DESCRIPTION
+    "${DOCUMENTATION}"
+
+  EXCLUDE_FROM_DEFAULT
+)
@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "otbBenchmarkRunner.h"
+#include "itkMultiThreader.h"
+#include "itksys/SystemTools.hxx"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace otb
+{
+
+namespace
+{
+volatile double KeptResult = 0.;
+
+/** Find the value of "key": in a line of a result file */
+bool ExtractField(const std::string& line, const std::string& key, std::string& value)
+{
+  const std::string token = "\"" + key + "\":";
+  size_t            pos   = line.find(token);
+  if (pos == std::string::npos)
+  {
+    return false;
+  }
+  pos = line.find_first_not_of(' ', pos + token.size());
+  if (pos == std::string::npos)
+  {
+    return false;
+  }
+  if (line[pos] == '"')
+  {
+    const size_t end = line.find('"', pos + 1);
+    if (end == std::string::npos)
+    {
+      return false;
+    }
+    value = line.substr(pos + 1, end - pos - 1);
+  }
+  else
+  {
+    const size_t end = line.find_first_of(",}", pos);
+    value            = line.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+  }
+  return true;
+}
+
+/** Benchmark names are plain identifiers, only quotes and backslashes are escaped */
+std::string EscapeJSON(const std::string& str)
+{
+  std::string ret;
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      ret += '\\';
+    }
+    ret += c;
+  }
+  return ret;
+}
+}
+
+BenchmarkRunner::BenchmarkRunner(int argc, char* argv[])
+  : m_Tolerance(0.2),
+    m_MinimumTime(0.5),
+    m_MinimumRepeats(3),
+    m_MaximumRepeats(1000),
+    m_MaximumThreads(std::max<unsigned int>(1u, itk::MultiThreader::GetGlobalDefaultNumberOfThreads())),
+    m_Failed(false)
+{
+  if (argc > 1)
+  {
+    m_OutputFile = argv[1];
+  }
+  if (argc > 2)
+  {
+    m_BaselineFile = argv[2];
+  }
+  if (argc > 3)
+  {
+    m_Tolerance = std::atof(argv[3]);
+  }
+}
+
+std::string BenchmarkRunner::GetOutputDirectory() const
+{
+  std::string dir = itksys::SystemTools::GetFilenamePath(m_OutputFile);
+  return dir.empty() ? std::string(".") : dir;
+}
+
+BenchmarkRunner::ThreadCountListType BenchmarkRunner::GetDefaultThreadCounts() const
+{
+  ThreadCountListType threadCounts;
+  for (unsigned int nbThreads = 1; nbThreads < m_MaximumThreads; nbThreads *= 2)
+  {
+    threadCounts.push_back(nbThreads);
+  }
+  threadCounts.push_back(m_MaximumThreads);
+  return threadCounts;
+}
+
+void BenchmarkRunner::Run(const std::string& name, const std::string& unit, double items, const KernelType& kernel)
+{
+  Run(name, unit, items, kernel, ThreadCountListType(1, 1));
+}
+
+void BenchmarkRunner::Run(const std::string& name, const std::string& unit, double items, const KernelType& kernel, const ThreadCountListType& threadCounts)
+{
+  typedef std::chrono::steady_clock ClockType;
+
+  const int defaultThreads = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+
+  double singleThreadTime = 0.;
+  for (unsigned int nbThreads : threadCounts)
+  {
+    itk::MultiThreader::SetGlobalDefaultNumberOfThreads(nbThreads);
+
+    std::vector<double> times;
+    try
+    {
+      kernel(nbThreads);
+
+      double totalTime = 0.;
+      while (times.size() < m_MaximumRepeats && (times.size() < m_MinimumRepeats || totalTime < m_MinimumTime))
+      {
+        const ClockType::time_point start = ClockType::now();
+        kernel(nbThreads);
+        const double time = std::chrono::duration<double>(ClockType::now() - start).count();
+        times.push_back(time);
+        totalTime += time;
+      }
+    }
+    catch (std::exception& err)
+    {
+      std::cerr << "Benchmark " << name << " failed with " << nbThreads << " threads: " << err.what() << std::endl;
+      m_Failed = true;
+      continue;
+    }
+
+    std::sort(times.begin(), times.end());
+
+    ResultType result;
+    result.name        = name;
+    result.unit        = unit;
+    result.threads     = nbThreads;
+    result.items       = items;
+    result.repeats     = static_cast<unsigned int>(times.size());
+    result.medianTime  = times[times.size() / 2];
+    result.minimumTime = times.front();
+    result.throughput  = result.medianTime > 0. ? items / result.medianTime : std::numeric_limits<double>::max();
+    if (nbThreads == 1)
+    {
+      singleThreadTime = result.medianTime;
+    }
+    result.speedup = (singleThreadTime > 0. && result.medianTime > 0.) ? singleThreadTime / result.medianTime : 0.;
+
+    std::cout << std::left << std::setw(48) << name << std::right << std::setw(4) << nbThreads << " threads " << std::setw(12) << std::setprecision(4)
+              << result.throughput * 1e-6 << " M" << unit << "/s";
+    if (nbThreads != 1 && result.speedup > 0.)
+    {
+      std::cout << "  x" << std::setprecision(3) << result.speedup;
+    }
+    std::cout << std::endl;
+
+    m_Results.push_back(result);
+  }
+
+  itk::MultiThreader::SetGlobalDefaultNumberOfThreads(defaultThreads);
+}
+
+void BenchmarkRunner::KeepResult(double value)
+{
+  KeptResult = value;
+}
+
+int BenchmarkRunner::Finish()
+{
+  if (m_OutputFile.empty())
+  {
+    std::cerr << "Usage: <output.json> [<baseline.json> [<tolerance>]]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!WriteResults(m_OutputFile))
+  {
+    std::cerr << "Can't write benchmark results to " << m_OutputFile << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  unsigned int nbRegressions = 0;
+  if (!m_BaselineFile.empty())
+  {
+    ResultListType baseline;
+    if (!ReadResults(m_BaselineFile, baseline))
+    {
+      std::cerr << "Can't read benchmark baseline " << m_BaselineFile << std::endl;
+      return EXIT_FAILURE;
+    }
+    nbRegressions = CompareToBaseline(baseline);
+  }
+
+  if (nbRegressions > 0)
+  {
+    std::cerr << nbRegressions << " benchmark(s) slower than the baseline by more than " << 100. * m_Tolerance << "%" << std::endl;
+  }
+
+  return (m_Failed || nbRegressions > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+bool BenchmarkRunner::WriteResults(const std::string& filename) const
+{
+  std::ofstream file(filename.c_str());
+  if (!file)
+  {
+    return false;
+  }
+
+  file << std::setprecision(std::numeric_limits<double>::digits10);
+  file << "{\n";
+  file << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+  file << "  \"benchmarks\": [\n";
+  for (size_t i = 0; i < m_Results.size(); ++i)
+  {
+    const ResultType& result = m_Results[i];
+    file << "    {\"name\": \"" << EscapeJSON(result.name) << "\", \"threads\": " << result.threads << ", \"unit\": \"" << EscapeJSON(result.unit)
+         << "\", \"items\": " << result.items << ", \"repeats\": " << result.repeats << ", \"median_seconds\": " << result.medianTime
+         << ", \"min_seconds\": " << result.minimumTime << ", \"throughput\": " << result.throughput << ", \"speedup\": " << result.speedup << "}"
+         << (i + 1 < m_Results.size() ? "," : "") << "\n";
+  }
+  file << "  ]\n";
+  file << "}\n";
+
+  return static_cast<bool>(file);
+}
+
+bool BenchmarkRunner::ReadResults(const std::string& filename, ResultListType& results)
+{
+  std::ifstream file(filename.c_str());
+  if (!file)
+  {
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(file, line))
+  {
+    std::string name, threads, throughput;
+    if (ExtractField(line, "name", name) && ExtractField(line, "threads", threads) && ExtractField(line, "throughput", throughput))
+    {
+      ResultType result = ResultType();
+      result.name       = name;
+      result.threads    = static_cast<unsigned int>(std::atoi(threads.c_str()));
+      result.throughput = std::atof(throughput.c_str());
+      results.push_back(result);
+    }
+  }
+  return true;
+}
+
+unsigned int BenchmarkRunner::CompareToBaseline(const ResultListType& baseline) const
+{
+  unsigned int nbRegressions = 0;
+  for (const ResultType& result : m_Results)
+  {
+    auto reference = std::find_if(baseline.begin(), baseline.end(), [&result](const ResultType& r) {
+      return r.name == EscapeJSON(result.name) && r.threads == result.threads;
+    });
+    if (reference == baseline.end() || reference->throughput <= 0.)
+    {
+      std::cout << "No baseline for " << result.name << " with " << result.threads << " threads" << std::endl;
+      continue;
+    }
+
+    const double ratio = result.throughput / reference->throughput;
+    if (ratio < 1. - m_Tolerance)
+    {
+      std::cerr << "Regression: " << result.name << " with " << result.threads << " threads runs at " << std::setprecision(3) << 100. * ratio
+                << "% of the baseline throughput" << std::endl;
+      ++nbRegressions;
+    }
+  }
+  return nbRegressions;
+}
+
+} // end namespace otb
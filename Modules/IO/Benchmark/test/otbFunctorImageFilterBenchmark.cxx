@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "otbBenchmarkRunner.h"
+#include "otbBenchmarkSyntheticData.h"
+#include "otbFunctorImageFilter.h"
+
+namespace
+{
+const unsigned int ImageSize = 2048;
+
+typedef otb::Image<float, 2>       ImageType;
+typedef otb::VectorImage<float, 2> VectorImageType;
+typedef VectorImageType::PixelType VectorPixelType;
+
+template <class TFilter>
+void RunFilter(otb::BenchmarkRunner& runner, const std::string& name, TFilter* filter)
+{
+  runner.Run(name, "pix", static_cast<double>(ImageSize) * ImageSize,
+             [filter](unsigned int nbThreads) {
+               filter->SetNumberOfThreads(nbThreads);
+               filter->Modified();
+               filter->Update();
+             },
+             runner.GetDefaultThreadCounts());
+}
+}
+
+int otbFunctorImageFilterBenchmark(int argc, char* argv[])
+{
+  otb::BenchmarkRunner runner(argc, argv);
+
+  VectorImageType::Pointer vectorImage = otb::Benchmark::GenerateSyntheticVectorImage<float>(ImageSize, ImageSize, 4);
+  ImageType::Pointer       image       = otb::Benchmark::GenerateSyntheticImage<float>(ImageSize, ImageSize);
+
+  // Pixel to scalar, as radiometric indices
+  auto ndvi       = [](const VectorPixelType& in) { return (in[3] - in[2]) / (in[3] + in[2] + 1e-6f); };
+  auto ndviFilter = otb::NewFunctorFilter(ndvi);
+  ndviFilter->SetInputs(vectorImage);
+  RunFilter(runner, "FunctorImageFilter.PixelToScalar", ndviFilter.GetPointer());
+
+  // Pixel to vector, as band math with several outputs
+  auto gains = [](VectorPixelType& out, const VectorPixelType& in) {
+    for (unsigned int b = 0; b < in.Size(); ++b)
+    {
+      out[b] = 0.5f * in[b] + 10.f;
+    }
+  };
+  auto gainsFilter = otb::NewFunctorFilter(gains, vectorImage->GetNumberOfComponentsPerPixel(), {{0, 0}});
+  gainsFilter->SetInputs(vectorImage);
+  RunFilter(runner, "FunctorImageFilter.PixelToVector", gainsFilter.GetPointer());
+
+  // Neighborhood to scalar, as local filters
+  auto mean = [](const itk::ConstNeighborhoodIterator<ImageType>& it) {
+    float sum = 0.f;
+    for (unsigned int i = 0; i < it.Size(); ++i)
+    {
+      sum += it.GetPixel(i);
+    }
+    return sum / it.Size();
+  };
+  auto meanFilter = otb::NewFunctorFilter(mean, {{1, 1}});
+  meanFilter->SetInputs(image);
+  RunFilter(runner, "FunctorImageFilter.Neighborhood3x3", meanFilter.GetPointer());
+
+  return runner.Finish();
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "otbBenchmarkRunner.h"
+#include "otbBenchmarkSyntheticData.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+
+/** Write then read back a synthetic image through GDALImageIO, for several
+ * GeoTIFF compressions. The temporary images are written next to the output
+ * results, and read back by a new reader at each call so that the decoding is
+ * timed, not a cached buffer. */
+int otbGDALImageIOBenchmark(int argc, char* argv[])
+{
+  typedef otb::VectorImage<unsigned short, 2> ImageType;
+  typedef otb::ImageFileReader<ImageType>     ReaderType;
+  typedef otb::ImageFileWriter<ImageType>     WriterType;
+
+  const unsigned int ImageSize = 2048;
+
+  // Name and creation options of each compression
+  const std::vector<std::pair<std::string, std::string>> compressions = {{"None", "&gdal:co:COMPRESS=NONE"},
+                                                                          {"LZW", "&gdal:co:COMPRESS=LZW"},
+                                                                          {"Deflate", "&gdal:co:COMPRESS=DEFLATE"},
+                                                                          {"DeflateTiled", "&gdal:co:COMPRESS=DEFLATE&gdal:co:TILED=YES"}};
+
+  otb::BenchmarkRunner runner(argc, argv);
+  const double         nbPixels = static_cast<double>(ImageSize) * ImageSize;
+
+  ImageType::Pointer image = otb::Benchmark::GenerateSyntheticVectorImage<unsigned short>(ImageSize, ImageSize, 4);
+
+  for (const auto& compression : compressions)
+  {
+    const std::string filename = runner.GetOutputDirectory() + "/bmGDALImageIO" + compression.first + ".tif";
+
+    runner.Run("GDALImageIO.Write." + compression.first, "pix", nbPixels, [&image, &filename, &compression](unsigned int) {
+      WriterType::Pointer writer = WriterType::New();
+      writer->SetInput(image);
+      writer->SetFileName(filename + "?" + compression.second);
+      writer->Update();
+    });
+
+    runner.Run("GDALImageIO.Read." + compression.first, "pix", nbPixels, [&filename](unsigned int) {
+      ReaderType::Pointer reader = ReaderType::New();
+      reader->SetFileName(filename);
+      reader->Update();
+      otb::BenchmarkRunner::KeepResult(reader->GetOutput()->GetBufferPointer()[0]);
+    });
+  }
+
+  return runner.Finish();
+}
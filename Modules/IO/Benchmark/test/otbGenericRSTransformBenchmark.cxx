@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "otbBenchmarkRunner.h"
+#include "otbBenchmarkSyntheticData.h"
+#include "otbGenericRSTransform.h"
+#include "otbImageFileWriter.h"
+#include "otbDEMHandler.h"
+#include "otbSpatialReference.h"
+#include "otbImageMetadata.h"
+
+namespace
+{
+const unsigned int ImageSize      = 10000;
+const unsigned int NumberOfPoints = 100000;
+
+const double CenterLon = 1.44;
+const double CenterLat = 43.6;
+const double Extent    = 0.1;
+
+typedef otb::GenericRSTransform<double, 2, 2> TransformType;
+typedef TransformType::InputPointType         PointType;
+typedef std::vector<PointType>                PointListType;
+
+/** Affine RPC model of a north-up image, with a small height dependency so
+ * that the elevation source matters */
+otb::ImageMetadata GenerateRPCMetadata()
+{
+  otb::Projection::RPCParam rpc;
+  rpc.LineOffset   = 0.5 * ImageSize;
+  rpc.SampleOffset = 0.5 * ImageSize;
+  rpc.LatOffset    = CenterLat;
+  rpc.LonOffset    = CenterLon;
+  rpc.HeightOffset = 200.;
+  rpc.LineScale    = 0.5 * ImageSize;
+  rpc.SampleScale  = 0.5 * ImageSize;
+  rpc.LatScale     = 0.5 * Extent;
+  rpc.LonScale     = 0.5 * Extent;
+  rpc.HeightScale  = 500.;
+
+  // rn = -y + 0.01 z, cn = x + 0.02 z + 0.001 x y
+  rpc.LineNum[2]   = -1.;
+  rpc.LineNum[3]   = 0.01;
+  rpc.LineDen[0]   = 1.;
+  rpc.SampleNum[1] = 1.;
+  rpc.SampleNum[3] = 0.02;
+  rpc.SampleNum[4] = 0.001;
+  rpc.SampleDen[0] = 1.;
+
+  otb::ImageMetadata imd;
+  imd.Add(otb::MDGeom::RPC, rpc);
+  return imd;
+}
+
+/** Regular grid of points over a rectangle */
+PointListType GeneratePoints(double x0, double y0, double width, double height)
+{
+  const unsigned int side = static_cast<unsigned int>(std::sqrt(static_cast<double>(NumberOfPoints)));
+
+  PointListType points;
+  for (unsigned int j = 0; j < side; ++j)
+  {
+    for (unsigned int i = 0; i < side; ++i)
+    {
+      PointType point;
+      point[0] = x0 + width * (i + 0.5) / side;
+      point[1] = y0 + height * (j + 0.5) / side;
+      points.push_back(point);
+    }
+  }
+  return points;
+}
+
+/** Write a DEM covering the image footprint, with a margin */
+void WriteSyntheticDEM(const std::string& filename)
+{
+  typedef otb::Image<float, 2> DEMType;
+
+  const unsigned int size = 1201;
+
+  DEMType::Pointer dem = otb::Benchmark::GenerateSyntheticImage<float>(size, size);
+
+  // Heights between 0 and about 700m
+  for (float* height = dem->GetBufferPointer(); height != dem->GetBufferPointer() + size * size; ++height)
+  {
+    *height = 0.4f * (*height - 300.f);
+  }
+
+  DEMType::PointType origin;
+  origin[0] = CenterLon - Extent;
+  origin[1] = CenterLat + Extent;
+  DEMType::SpacingType spacing;
+  spacing[0] = 2. * Extent / size;
+  spacing[1] = -2. * Extent / size;
+  dem->SetOrigin(origin);
+  dem->SetSignedSpacing(spacing);
+  dem->SetProjectionRef(otb::SpatialReference::FromWGS84().ToWkt());
+
+  typedef otb::ImageFileWriter<DEMType> WriterType;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(dem);
+  writer->SetFileName(filename);
+  writer->Update();
+}
+
+void RunTransform(otb::BenchmarkRunner& runner, const std::string& name, const TransformType* transform, const PointListType& points)
+{
+  runner.Run(name, "points", points.size(), [transform, &points](unsigned int) {
+    double sum = 0.;
+    for (const PointType& point : points)
+    {
+      sum += transform->TransformPoint(point)[0];
+    }
+    otb::BenchmarkRunner::KeepResult(sum);
+  });
+}
+
+/** Image to ground and ground to image RPC transforms, the height being
+ * taken from the DEM handler */
+void RunRPCTransforms(otb::BenchmarkRunner& runner, const std::string& suffix, const otb::ImageMetadata& imd)
+{
+  TransformType::Pointer forward = TransformType::New();
+  forward->SetInputImageMetadata(&imd);
+  forward->InstantiateTransform();
+  RunTransform(runner, "GenericRSTransform.RPCImageToGround." + suffix, forward, GeneratePoints(0., 0., ImageSize, ImageSize));
+
+  TransformType::Pointer inverse = TransformType::New();
+  inverse->SetOutputImageMetadata(&imd);
+  inverse->InstantiateTransform();
+  RunTransform(runner, "GenericRSTransform.RPCGroundToImage." + suffix, inverse,
+               GeneratePoints(CenterLon - 0.5 * Extent, CenterLat - 0.5 * Extent, Extent, Extent));
+}
+}
+
+int otbGenericRSTransformBenchmark(int argc, char* argv[])
+{
+  otb::BenchmarkRunner runner(argc, argv);
+
+  const otb::ImageMetadata imd = GenerateRPCMetadata();
+
+  otb::DEMHandler& demHandler = otb::DEMHandler::GetInstance();
+  demHandler.ClearDEMs();
+  demHandler.SetDefaultHeightAboveEllipsoid(200.);
+  RunRPCTransforms(runner, "NoDEM", imd);
+
+  const std::string demFilename = runner.GetOutputDirectory() + "/bmGenericRSTransformDEM.tif";
+  WriteSyntheticDEM(demFilename);
+  demHandler.OpenDEMFile(demFilename);
+  RunRPCTransforms(runner, "DEM", imd);
+  demHandler.ClearDEMs();
+
+  // Map projection, without sensor model
+  TransformType::Pointer mapTransform = TransformType::New();
+  mapTransform->SetInputProjectionRef(otb::SpatialReference::FromWGS84().ToWkt());
+  mapTransform->SetOutputProjectionRef(otb::SpatialReference::FromUTM(31, otb::SpatialReference::hemisphere::north).ToWkt());
+  mapTransform->InstantiateTransform();
+  RunTransform(runner, "GenericRSTransform.WGS84ToUTM", mapTransform,
+               GeneratePoints(CenterLon - 0.5 * Extent, CenterLat - 0.5 * Extent, Extent, Extent));
+
+  return runner.Finish();
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "otbBenchmarkRunner.h"
+#include "otbBenchmarkSyntheticData.h"
+#include "otbBCOInterpolateImageFunction.h"
+#include "otbWindowedSincInterpolateImageGaussianFunction.h"
+#include "otbWindowedSincInterpolateImageLanczosFunction.h"
+
+namespace
+{
+const unsigned int ImageSize = 512;
+const unsigned int Radius    = 3;
+
+typedef otb::Image<double, 2>            ImageType;
+typedef otb::VectorImage<double, 2>      VectorImageType;
+typedef itk::ContinuousIndex<double, 2>  ContinuousIndexType;
+typedef std::vector<ContinuousIndexType> ContinuousIndexListType;
+
+/** Sub-pixel positions covering the image, away from the borders so that
+ * the boundary conditions are not benchmarked */
+ContinuousIndexListType GenerateIndices()
+{
+  ContinuousIndexListType indices;
+  for (unsigned int y = Radius; y + Radius + 1 < ImageSize; ++y)
+  {
+    for (unsigned int x = Radius; x + Radius + 1 < ImageSize; ++x)
+    {
+      ContinuousIndexType index;
+      index[0] = x + 0.37;
+      index[1] = y + 0.61;
+      indices.push_back(index);
+    }
+  }
+  return indices;
+}
+
+template <class TInterpolator>
+void RunScalarInterpolator(otb::BenchmarkRunner& runner, const std::string& name, TInterpolator* interpolator, const ContinuousIndexListType& indices)
+{
+  runner.Run(name, "pix", indices.size(), [interpolator, &indices](unsigned int) {
+    double sum = 0.;
+    for (const ContinuousIndexType& index : indices)
+    {
+      sum += interpolator->EvaluateAtContinuousIndex(index);
+    }
+    otb::BenchmarkRunner::KeepResult(sum);
+  });
+}
+}
+
+/** Interpolators are evaluated pixel by pixel in the threads of the filters
+ * using them, so they are only benchmarked with one thread */
+int otbInterpolatorsBenchmark(int argc, char* argv[])
+{
+  typedef otb::BCOInterpolateImageFunction<ImageType, double>          BCOInterpolatorType;
+  typedef otb::BCOInterpolateImageFunction<VectorImageType, double>    VectorBCOInterpolatorType;
+  typedef otb::WindowedSincInterpolateImageGaussianFunction<ImageType> GaussianInterpolatorType;
+  typedef otb::WindowedSincInterpolateImageLanczosFunction<ImageType>  LanczosInterpolatorType;
+
+  otb::BenchmarkRunner runner(argc, argv);
+
+  ImageType::Pointer            image       = otb::Benchmark::GenerateSyntheticImage<double>(ImageSize, ImageSize);
+  VectorImageType::Pointer      vectorImage = otb::Benchmark::GenerateSyntheticVectorImage<double>(ImageSize, ImageSize, 4);
+  const ContinuousIndexListType indices     = GenerateIndices();
+
+  BCOInterpolatorType::Pointer bco = BCOInterpolatorType::New();
+  bco->SetInputImage(image);
+  bco->SetRadius(Radius);
+  RunScalarInterpolator(runner, "BCOInterpolateImageFunction", bco.GetPointer(), indices);
+
+  VectorBCOInterpolatorType::Pointer vectorBco = VectorBCOInterpolatorType::New();
+  vectorBco->SetInputImage(vectorImage);
+  vectorBco->SetRadius(Radius);
+  runner.Run("BCOInterpolateImageFunction.VectorImage", "pix", indices.size(), [&vectorBco, &indices](unsigned int) {
+    double sum = 0.;
+    for (const ContinuousIndexType& index : indices)
+    {
+      sum += vectorBco->EvaluateAtContinuousIndex(index)[0];
+    }
+    otb::BenchmarkRunner::KeepResult(sum);
+  });
+
+  GaussianInterpolatorType::Pointer gaussian = GaussianInterpolatorType::New();
+  gaussian->SetInputImage(image);
+  gaussian->SetRadius(Radius);
+  gaussian->Initialize();
+  RunScalarInterpolator(runner, "WindowedSincInterpolateImageGaussianFunction", gaussian.GetPointer(), indices);
+
+  LanczosInterpolatorType::Pointer lanczos = LanczosInterpolatorType::New();
+  lanczos->SetInputImage(image);
+  lanczos->SetRadius(Radius);
+  lanczos->Initialize();
+  RunScalarInterpolator(runner, "WindowedSincInterpolateImageLanczosFunction", lanczos.GetPointer(), indices);
+
+  return runner.Finish();
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "otbBenchmarkRunner.h"
+#include "otbMachineLearningModel.h"
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef OTB_USE_OPENCV
+#include "otbRandomForestsMachineLearningModel.h"
+#include "otbKNearestNeighborsMachineLearningModel.h"
+#include "otbSVMMachineLearningModel.h"
+#include "otbNormalBayesMachineLearningModel.h"
+#include "otbDecisionTreeMachineLearningModel.h"
+#endif
+
+#ifdef OTB_USE_LIBSVM
+#include "otbLibSVMMachineLearningModel.h"
+#endif
+
+#ifdef OTB_USE_SHARK
+#include "otbSharkRandomForestsMachineLearningModel.h"
+#endif
+
+namespace
+{
+const unsigned int NumberOfFeatures        = 8;
+const unsigned int NumberOfClasses         = 4;
+const unsigned int NumberOfTrainingSamples = 2000;
+const unsigned int NumberOfSamples         = 100000;
+
+typedef otb::MachineLearningModel<float, short>        MachineLearningModelType;
+typedef MachineLearningModelType::InputSampleType      InputSampleType;
+typedef MachineLearningModelType::InputListSampleType  InputListSampleType;
+typedef MachineLearningModelType::TargetSampleType     TargetSampleType;
+typedef MachineLearningModelType::TargetListSampleType TargetListSampleType;
+
+/** Overlapping clusters, one per class, drawn with a fixed seed */
+void GenerateSamples(unsigned int nbSamples, unsigned int seed, InputListSampleType* samples, TargetListSampleType* labels)
+{
+  std::mt19937                          generator(seed);
+  std::uniform_real_distribution<float> noise(-1.5f, 1.5f);
+
+  samples->SetMeasurementVectorSize(NumberOfFeatures);
+  labels->SetMeasurementVectorSize(1);
+
+  InputSampleType  sample(NumberOfFeatures);
+  TargetSampleType label;
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    const unsigned int c = i % NumberOfClasses;
+    for (unsigned int f = 0; f < NumberOfFeatures; ++f)
+    {
+      sample[f] = static_cast<float>(c) * ((f % 3) + 1) + noise(generator);
+    }
+    label[0] = static_cast<short>(c + 1);
+    samples->PushBack(sample);
+    labels->PushBack(label);
+  }
+}
+
+template <class TModel>
+void RunModel(otb::BenchmarkRunner& runner, const std::string& name, TModel* model, InputListSampleType* trainingSamples, TargetListSampleType* trainingLabels,
+              const InputListSampleType* samples)
+{
+  model->SetInputListSample(trainingSamples);
+  model->SetTargetListSample(trainingLabels);
+  model->Train();
+
+  runner.Run("PredictBatch." + name, "samples", samples->Size(),
+             [model, samples](unsigned int nbThreads) {
+#ifdef _OPENMP
+               omp_set_num_threads(nbThreads);
+#endif
+               TargetListSampleType::Pointer predicted = model->PredictBatch(samples);
+               otb::BenchmarkRunner::KeepResult(predicted->GetMeasurementVector(0)[0]);
+             },
+             runner.GetDefaultThreadCounts());
+}
+}
+
+/** PredictBatch() of each available model, trained on synthetic samples. The
+ * batch prediction splits the samples between the threads of an OpenMP
+ * parallel region, whose size is set before each run to the timed thread
+ * count. Without OpenMP, the prediction runs on a single thread. */
+int otbMachineLearningModelBenchmark(int argc, char* argv[])
+{
+  otb::BenchmarkRunner runner(argc, argv);
+
+  InputListSampleType::Pointer  trainingSamples = InputListSampleType::New();
+  TargetListSampleType::Pointer trainingLabels  = TargetListSampleType::New();
+  GenerateSamples(NumberOfTrainingSamples, 1, trainingSamples, trainingLabels);
+
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+  GenerateSamples(NumberOfSamples, 2, samples, labels);
+
+#ifdef OTB_USE_OPENCV
+  typedef otb::RandomForestsMachineLearningModel<float, short>     RandomForestsType;
+  typedef otb::KNearestNeighborsMachineLearningModel<float, short> KNearestNeighborsType;
+  typedef otb::SVMMachineLearningModel<float, short>               SVMType;
+  typedef otb::NormalBayesMachineLearningModel<float, short>       NormalBayesType;
+  typedef otb::DecisionTreeMachineLearningModel<float, short>      DecisionTreeType;
+
+  RandomForestsType::Pointer randomForests = RandomForestsType::New();
+  RunModel(runner, "RandomForests", randomForests.GetPointer(), trainingSamples, trainingLabels, samples);
+
+  KNearestNeighborsType::Pointer knn = KNearestNeighborsType::New();
+  RunModel(runner, "KNearestNeighbors", knn.GetPointer(), trainingSamples, trainingLabels, samples);
+
+  SVMType::Pointer svm = SVMType::New();
+  RunModel(runner, "SVM", svm.GetPointer(), trainingSamples, trainingLabels, samples);
+
+  NormalBayesType::Pointer normalBayes = NormalBayesType::New();
+  RunModel(runner, "NormalBayes", normalBayes.GetPointer(), trainingSamples, trainingLabels, samples);
+
+  DecisionTreeType::Pointer decisionTree = DecisionTreeType::New();
+  RunModel(runner, "DecisionTree", decisionTree.GetPointer(), trainingSamples, trainingLabels, samples);
+#endif
+
+#ifdef OTB_USE_LIBSVM
+  typedef otb::LibSVMMachineLearningModel<float, short> LibSVMType;
+
+  LibSVMType::Pointer libSVM = LibSVMType::New();
+  RunModel(runner, "LibSVM", libSVM.GetPointer(), trainingSamples, trainingLabels, samples);
+#endif
+
+#ifdef OTB_USE_SHARK
+  typedef otb::SharkRandomForestsMachineLearningModel<float, short> SharkRandomForestsType;
+
+  SharkRandomForestsType::Pointer sharkRandomForests = SharkRandomForestsType::New();
+  RunModel(runner, "SharkRandomForests", sharkRandomForests.GetPointer(), trainingSamples, trainingLabels, samples);
+#endif
+
+  return runner.Finish();
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "otbBenchmarkRunner.h"
+#include "otbBenchmarkSyntheticData.h"
+#include "otbStreamingStatisticsImageFilter.h"
+#include "otbStreamingStatisticsVectorImageFilter.h"
+
+namespace
+{
+const unsigned int ImageSize = 2048;
+
+/** Persistent filters only run again when the persistent part is modified */
+template <class TStreamingFilter>
+void RunStatistics(otb::BenchmarkRunner& runner, const std::string& name, TStreamingFilter* filter)
+{
+  runner.Run(name, "pix", static_cast<double>(ImageSize) * ImageSize,
+             [filter](unsigned int nbThreads) {
+               filter->GetFilter()->SetNumberOfThreads(nbThreads);
+               filter->GetFilter()->Modified();
+               filter->Update();
+             },
+             runner.GetDefaultThreadCounts());
+}
+}
+
+int otbStreamingStatisticsBenchmark(int argc, char* argv[])
+{
+  typedef otb::Image<float, 2>                                       ImageType;
+  typedef otb::VectorImage<float, 2>                                 VectorImageType;
+  typedef otb::StreamingStatisticsImageFilter<ImageType>             StatisticsFilterType;
+  typedef otb::StreamingStatisticsVectorImageFilter<VectorImageType> VectorStatisticsFilterType;
+
+  otb::BenchmarkRunner runner(argc, argv);
+
+  ImageType::Pointer       image       = otb::Benchmark::GenerateSyntheticImage<float>(ImageSize, ImageSize);
+  VectorImageType::Pointer vectorImage = otb::Benchmark::GenerateSyntheticVectorImage<float>(ImageSize, ImageSize, 4);
+
+  StatisticsFilterType::Pointer statistics = StatisticsFilterType::New();
+  statistics->SetInput(image);
+  RunStatistics(runner, "StreamingStatisticsImageFilter", statistics.GetPointer());
+
+  // First order statistics only, then with the covariance and correlation
+  // matrices whose accumulation dominates with many bands
+  VectorStatisticsFilterType::Pointer vectorStatistics = VectorStatisticsFilterType::New();
+  vectorStatistics->SetInput(vectorImage);
+  vectorStatistics->SetEnableSecondOrderStats(false);
+  RunStatistics(runner, "StreamingStatisticsVectorImageFilter.FirstOrder", vectorStatistics.GetPointer());
+
+  vectorStatistics->SetEnableSecondOrderStats(true);
+  RunStatistics(runner, "StreamingStatisticsVectorImageFilter.SecondOrder", vectorStatistics.GetPointer());
+
+  return runner.Finish();
+}
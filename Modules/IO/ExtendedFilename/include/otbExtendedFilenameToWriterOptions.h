@@ -41,6 +41,8 @@ namespace otb
  * - &nodata=<VALUE>/<VALUE:VALUE...> : to set specific nodata values
  * - &multiwrite=<(bool)false> : to desactivate multi-writing
  * - &epsg=<VALUE> : to set the spatial reference system
+ * - &overviews=<N>/auto : to write N internal overview levels while streaming
+ * - &overviews:resampling=<average/nearest> : resampling of the overviews
  *
  * See http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for
  * more information
@@ -83,6 +85,8 @@ public:
     std::pair<bool, std::string> box;
     std::pair<bool, std::string> bandRange;
     std::pair<bool, unsigned int> srsValue;
+    std::pair<bool, int>          overviews;
+    std::pair<bool, std::string>  overviewsResampling;
     std::vector<std::string> optionList;
   };
 
@@ -120,6 +124,10 @@ public:
   std::string GetBandRange() const;
   bool        SrsValueIsSet() const;
   unsigned int GetSrsValue() const;
+  bool        OverviewsIsSet() const;
+  int         GetOverviews() const;
+  bool        OverviewsResamplingIsSet() const;
+  std::string GetOverviewsResampling() const;
 
   bool        BoxIsSet() const;
   std::string GetBox() const;
@@ -54,8 +54,14 @@ ExtendedFilenameToWriterOptions::ExtendedFilenameToWriterOptions() : ExtendedFil
 
   m_Options.srsValue.first = false;
 
+  m_Options.overviews.first            = false;
+  m_Options.overviews.second           = 0;
+  m_Options.overviewsResampling.first  = false;
+  m_Options.overviewsResampling.second = "average";
+
   m_Options.optionList = {"writegeom", "writerpctags", "multiwrite", "streaming:type",
-    "streaming:sizemode", "streaming:sizevalue", "nodata", "box", "bands", "epsg"};
+    "streaming:sizemode", "streaming:sizevalue", "nodata", "box", "bands", "epsg",
+    "overviews", "overviews:resampling"};
 }
 
 void ExtendedFilenameToWriterOptions::SetExtendedFileName(const char* extFname)
@@ -246,6 +252,48 @@ void ExtendedFilenameToWriterOptions::SetExtendedFileName(const std::string& ext
     }
   }
 
+  if (!map["overviews"].empty())
+  {
+    if (map["overviews"] == "auto")
+    {
+      m_Options.overviews.first  = true;
+      m_Options.overviews.second = -1;
+    }
+    else
+    {
+      int levels = -1;
+      try
+      {
+        levels = std::stoi(map["overviews"]);
+      }
+      catch (const std::exception&)
+      {
+      }
+      if (levels >= 0)
+      {
+        m_Options.overviews.first  = true;
+        m_Options.overviews.second = levels;
+      }
+      else
+      {
+        itkWarningMacro("Invalid value (" << map["overviews"] << ") for overviews. Must be a positive number of levels or auto.");
+      }
+    }
+  }
+
+  if (!map["overviews:resampling"].empty())
+  {
+    if (map["overviews:resampling"] == "average" || map["overviews:resampling"] == "nearest")
+    {
+      m_Options.overviewsResampling.first  = true;
+      m_Options.overviewsResampling.second = map["overviews:resampling"];
+    }
+    else
+    {
+      itkWarningMacro("Unkwown value " << map["overviews:resampling"] << " for overviews:resampling option. Available values are average,nearest.");
+    }
+  }
+
   // Option Checking
   for (it = map.begin(); it != map.end(); it++)
   {
@@ -376,4 +424,24 @@ unsigned int ExtendedFilenameToWriterOptions::GetSrsValue() const
   return m_Options.srsValue.second;
 }
 
+bool ExtendedFilenameToWriterOptions::OverviewsIsSet() const
+{
+  return m_Options.overviews.first;
+}
+
+int ExtendedFilenameToWriterOptions::GetOverviews() const
+{
+  return m_Options.overviews.second;
+}
+
+bool ExtendedFilenameToWriterOptions::OverviewsResamplingIsSet() const
+{
+  return m_Options.overviewsResampling.first;
+}
+
+std::string ExtendedFilenameToWriterOptions::GetOverviewsResampling() const
+{
+  return m_Options.overviewsResampling.second;
+}
+
 } // end namespace otb
@@ -21,7 +21,10 @@
 #include "otbImage.h"
 #include "otbVectorImage.h"
 #include "itkMacro.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <sstream>
 
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
@@ -84,3 +87,142 @@ int otbImageFileWriterWithExtendedFilename(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbImageFileWriterWithOverviews(int itkNotUsed(argc), char* argv[])
+{
+  const char*       inputFilename = argv[1];
+  const std::string outputPrefix  = argv[2];
+
+  typedef unsigned char InputPixelType;
+  const unsigned int    Dimension = 2;
+
+  typedef otb::VectorImage<InputPixelType, Dimension> InputImageType;
+
+  typedef otb::ImageFileReader<InputImageType> ReaderType;
+  typedef otb::ImageFileWriter<InputImageType> WriterType;
+
+  const unsigned int nbLevels = 2;
+
+  // Write the same image twice: once in odd-height strips, once in a single
+  // region. The inline overviews must not depend on the streaming layout.
+  const std::string streamedFilename   = outputPrefix + "_streamed.tif";
+  const std::string unstreamedFilename = outputPrefix + "_unstreamed.tif";
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+  reader->UpdateOutputInformation();
+  const InputImageType::SizeType fullSize = reader->GetOutput()->GetLargestPossibleRegion().GetSize();
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput(reader->GetOutput());
+  writer->SetFileName(streamedFilename + "?&overviews=2&streaming:type=stripped&streaming:sizemode=height&streaming:sizevalue=7");
+  writer->Update();
+
+  writer = WriterType::New();
+  writer->SetInput(reader->GetOutput());
+  writer->SetFileName(unstreamedFilename + "?&overviews=2&streaming:type=none");
+  writer->Update();
+
+  for (unsigned int level = 1; level <= nbLevels; ++level)
+  {
+    std::ostringstream resol;
+    resol << "?&resol=" << level;
+
+    ReaderType::Pointer streamedReader = ReaderType::New();
+    streamedReader->SetFileName(streamedFilename + resol.str());
+    streamedReader->Update();
+
+    ReaderType::Pointer unstreamedReader = ReaderType::New();
+    unstreamedReader->SetFileName(unstreamedFilename + resol.str());
+    unstreamedReader->Update();
+
+    if (streamedReader->GetOverviewsCount() < nbLevels + 1)
+    {
+      std::cerr << "Expected at least " << nbLevels << " overviews in " << streamedFilename << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const InputImageType*    streamed   = streamedReader->GetOutput();
+    const InputImageType*    unstreamed = unstreamedReader->GetOutput();
+    InputImageType::SizeType size       = streamed->GetLargestPossibleRegion().GetSize();
+
+    const unsigned int factor = 1u << level;
+    for (unsigned int dim = 0; dim < Dimension; ++dim)
+    {
+      if (size[dim] != (fullSize[dim] + factor - 1) / factor)
+      {
+        std::cerr << "Unexpected size " << size << " for overview level " << level << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    if (size != unstreamed->GetLargestPossibleRegion().GetSize())
+    {
+      std::cerr << "Overview level " << level << " sizes differ between streamed and unstreamed outputs" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const unsigned int    nbBands  = streamed->GetNumberOfComponentsPerPixel();
+    const size_t          nbValues = size[0] * size[1] * nbBands;
+    const InputPixelType* bufferA  = streamed->GetBufferPointer();
+    const InputPixelType* bufferB  = unstreamed->GetBufferPointer();
+    for (size_t i = 0; i < nbValues; ++i)
+    {
+      if (bufferA[i] != bufferB[i])
+      {
+        std::cerr << "Overview level " << level << " differs at value " << i << ": " << static_cast<int>(bufferA[i]) << " vs "
+                  << static_cast<int>(bufferB[i]) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The first level must be the 2x2 average of the full resolution image,
+  // over partial blocks on the right and bottom edges, rounded to the
+  // output pixel type
+  ReaderType::Pointer fullReader = ReaderType::New();
+  fullReader->SetFileName(inputFilename);
+  fullReader->Update();
+
+  ReaderType::Pointer levelReader = ReaderType::New();
+  levelReader->SetFileName(streamedFilename + "?&resol=1");
+  levelReader->Update();
+
+  const InputImageType*          full        = fullReader->GetOutput();
+  const InputImageType*          level       = levelReader->GetOutput();
+  const InputImageType::SizeType levelSize   = level->GetLargestPossibleRegion().GetSize();
+  const unsigned int             nbBands     = full->GetNumberOfComponentsPerPixel();
+  const InputPixelType*          fullBuffer  = full->GetBufferPointer();
+  const InputPixelType*          levelBuffer = level->GetBufferPointer();
+
+  for (unsigned int y = 0; y < levelSize[1]; ++y)
+  {
+    for (unsigned int x = 0; x < levelSize[0]; ++x)
+    {
+      for (unsigned int band = 0; band < nbBands; ++band)
+      {
+        double       sum   = 0.;
+        unsigned int count = 0;
+        for (unsigned int sy = 2 * y; sy < std::min<unsigned int>(2 * y + 2, fullSize[1]); ++sy)
+        {
+          for (unsigned int sx = 2 * x; sx < std::min<unsigned int>(2 * x + 2, fullSize[0]); ++sx)
+          {
+            sum += fullBuffer[(sy * fullSize[0] + sx) * nbBands + band];
+            ++count;
+          }
+        }
+
+        const double mean  = sum / count;
+        const double value = levelBuffer[(y * levelSize[0] + x) * nbBands + band];
+        if (std::abs(value - mean) > 0.5)
+        {
+          std::cerr << "Overview level 1 at (" << x << ", " << y << ") band " << band << " is " << value << ", expected the 2x2 mean " << mean
+                    << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
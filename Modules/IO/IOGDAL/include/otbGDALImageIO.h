@@ -24,6 +24,7 @@
 
 
 /* C++ Libraries */
+#include <memory>
 #include <string>
 
 /* ITK Libraries */
@@ -33,11 +34,13 @@
 
 #include "OTBIOGDALExport.h"
 #include "otbSpatialReference.h"
+#include "otbGDALOverviewsBuilder.h"
 
 namespace otb
 {
 class GDALDatasetWrapper;
 class GDALDataTypeWrapper;
+class GDALStreamingOverviews;
 
 /** \class GDALImageIO
  *
@@ -156,6 +159,17 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   void Read(void* buffer) override;
 
+  /** Decimated reading is available for non indexed images read at full
+   * resolution */
+  bool CanReadDecimated() const override
+  {
+    return !m_IsIndexed && m_ResolutionFactor == 0;
+  }
+
+  /** Reads one pixel every factor pixels, starting from the first pixel of
+   * the IORegion. Only the sampled lines are read. */
+  void ReadDecimated(void* buffer, unsigned int factor, bool useOverviews) override;
+
   /** Reads 3D data from multiple files assuming one slice per file. */
   virtual void ReadVolume(void* buffer);
 
@@ -219,6 +233,18 @@ public:
   /** Set the projection system from EPSG code */
   void SetEpsgCode(const unsigned int wellKnownCRS);
 
+  /** Set/Get the number of internal overview levels (factors 2, 4, ...)
+   *  built while the image is streamed to the file. 0 (default) disables
+   *  them, a negative value builds as many levels as needed to reach a
+   *  256x256 block. Only used by drivers which support streaming and
+   *  internal overviews (GTiff). */
+  itkSetMacro(WriteOverviewsCount, int);
+  itkGetMacro(WriteOverviewsCount, int);
+
+  /** Set/Get the resampling of the written overviews (AVERAGE or NEAREST) */
+  itkSetEnumMacro(WriteOverviewsResampling, GDALResampling);
+  itkGetEnumMacro(WriteOverviewsResampling, GDALResampling);
+
 protected:
   /**
    * Constructor.
@@ -326,6 +352,11 @@ private:
 
 
   NoDataListType m_NoDataList;
+
+  /** Overviews written while streaming */
+  int                                     m_WriteOverviewsCount;
+  GDALResampling                          m_WriteOverviewsResampling;
+  std::unique_ptr<GDALStreamingOverviews> m_StreamingOverviews;
 };
 
 } // end namespace otb
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGDALStreamingOverviews_h
+#define otbGDALStreamingOverviews_h
+
+#include <map>
+#include <vector>
+
+#include "gdal.h"
+
+#include "otbGDALOverviewsBuilder.h"
+#include "OTBIOGDALExport.h"
+
+class GDALDataset;
+
+namespace otb
+{
+
+/** \class GDALStreamingOverviews
+ *
+ * \brief Builds the internal overviews of a dataset while it is being written
+ *
+ * The overview structure (levels of factor 2, 4, ... 2^n) is created
+ * empty when the dataset is created. Each region written at full
+ * resolution is then passed to AddRegion(): it is decimated in cascade,
+ * each level being computed from the completed lines of the previous one,
+ * and each overview line is written as soon as all the full resolution
+ * pixels it depends on have been received. This avoids a second pass that
+ * re-reads the whole file with GDALDataset::BuildOverviews().
+ *
+ * Pending overview lines are kept in memory until they are complete, so
+ * the memory footprint stays small as long as regions are written in
+ * natural order (strips, or rows of tiles).
+ *
+ * Only AVERAGE and NEAREST resampling are supported.
+ *
+ * \sa GDALImageIO
+ *
+ * \ingroup OTBIOGDAL
+ */
+class OTBIOGDAL_EXPORT GDALStreamingOverviews
+{
+public:
+  /** Constructor. The dataset must be writable and outlive this object. */
+  GDALStreamingOverviews(GDALDataset* dataset, GDALResampling resampling);
+
+  /** Create the empty overview levels. A negative number of levels means
+   *  as many levels as needed to fit the smallest one in a 256x256 block.
+   *  Returns false if the driver cannot create overviews. */
+  bool Initialize(int nbLevels);
+
+  /** Number of overview levels being built */
+  unsigned int GetNumberOfLevels() const
+  {
+    return static_cast<unsigned int>(m_Levels.size());
+  }
+
+  /** Decimate a region written at full resolution. The buffer is pixel
+   *  interleaved, with the data type and number of bands of the dataset. */
+  void AddRegion(const void* buffer, int firstColumn, int firstLine, int nbColumns, int nbLines);
+
+  /** True once every overview line has been written */
+  bool IsComplete() const;
+
+private:
+  struct PendingLine
+  {
+    PendingLine() : Values(), Received(0)
+    {
+    }
+
+    std::vector<double> Values;
+    long                Received;
+  };
+
+  struct Level
+  {
+    int                        InputWidth;
+    int                        InputHeight;
+    int                        Width;
+    int                        Height;
+    int                        WrittenLines;
+    std::map<int, PendingLine> Pending;
+  };
+
+  /** Accumulate a segment of a line of level (index-1) into level index */
+  void AddLine(unsigned int index, int line, int firstColumn, int nbColumns, const double* values);
+
+  /** Write a complete line of a level and propagate it to the next level */
+  void FlushLine(unsigned int index, int line, PendingLine& pending);
+
+  GDALStreamingOverviews(const GDALStreamingOverviews&) = delete;
+  void operator=(const GDALStreamingOverviews&) = delete;
+
+  GDALDataset*       m_Dataset;
+  GDALResampling     m_Resampling;
+  GDALDataType       m_DataType;
+  GDALDataType       m_WorkType;
+  int                m_NbBands;
+  int                m_NbComponents;
+  std::vector<Level> m_Levels;
+};
+
+} // end namespace otb
+
+#endif // otbGDALStreamingOverviews_h
@@ -22,6 +22,10 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
 
 #include "otbGDALImageIO.h"
 #include "otbMacro.h"
@@ -46,6 +50,7 @@
 #include "itksys/RegularExpression.hxx"
 
 #include "otbGDALDriverManagerWrapper.h"
+#include "otbGDALStreamingOverviews.h"
 
 #include "otb_boost_string_header.h"
 
@@ -123,6 +128,9 @@ GDALImageIO::GDALImageIO()
   m_WriteRPCTags      = true;
 
   m_epsgCode          = 0;
+
+  m_WriteOverviewsCount      = 0;
+  m_WriteOverviewsResampling = GDAL_RESAMPLING_AVERAGE;
 }
 
 GDALImageIO::~GDALImageIO()
@@ -272,6 +280,112 @@ void GDALImageIO::Read(void* buffer)
   }
 }
 
+void GDALImageIO::ReadDecimated(void* buffer, unsigned int factor, bool useOverviews)
+{
+  unsigned char* p = static_cast<unsigned char*>(buffer);
+
+  if (p == nullptr)
+  {
+    itkExceptionMacro(<< "Buffer passed to GDALImageIO for reading is NULL.");
+  }
+
+  if (!this->CanReadDecimated() || factor == 0)
+  {
+    itkExceptionMacro(<< "Decimated reading is not supported for file " << m_FileName);
+  }
+
+  const int firstLine     = this->GetIORegion().GetIndex()[1];
+  const int firstColumn   = this->GetIORegion().GetIndex()[0];
+  const int nbLinesRegion = this->GetIORegion().GetSize()[1];
+  const int nbColumns     = this->GetIORegion().GetSize()[0];
+  const int step          = static_cast<int>(factor);
+
+  if (nbLinesRegion == 0 || nbColumns == 0)
+  {
+    return;
+  }
+
+  const int lastLine   = firstLine + (nbLinesRegion - 1) * step;
+  const int lastColumn = firstColumn + (nbColumns - 1) * step;
+  if (firstLine < 0 || firstColumn < 0 || lastLine >= static_cast<int>(m_OriginalDimensions[1]) || lastColumn >= static_cast<int>(m_OriginalDimensions[0]))
+  {
+    itkExceptionMacro(<< "Decimated region is outside of image (GDAL format) '" << m_FileName << "'");
+  }
+
+  // Same layout as in Read()
+  int pixelOffset = m_BytePerPixel * m_NbBands;
+  int bandOffset  = m_BytePerPixel;
+  if (!GDALDataTypeIsComplex(m_PxType->pixType) && m_IsComplex && m_IsVectorImage && (m_NbBands > 1))
+  {
+    pixelOffset = m_BytePerPixel * 2;
+  }
+
+  GDALDataset* dataset = m_Dataset->GetDataSet();
+
+  // Pick the coarsest overview which is not coarser than the decimation. Its
+  // scale is the ratio of the full resolution width to the overview width.
+  int overview = -1;
+  int scale    = 1;
+  if (useOverviews && step > 1)
+  {
+    GDALRasterBand* band = dataset->GetRasterBand(1);
+    for (int i = 0; i < band->GetOverviewCount(); ++i)
+    {
+      GDALRasterBand* ovBand = band->GetOverview(i);
+      if (ovBand == nullptr || ovBand->GetXSize() == 0)
+        continue;
+      const int ovScale = static_cast<int>(std::floor(static_cast<double>(m_OriginalDimensions[0]) / ovBand->GetXSize() + 0.5));
+      if (ovScale > scale && ovScale <= step)
+      {
+        scale    = ovScale;
+        overview = i;
+      }
+    }
+  }
+
+  otbLogMacro(Debug, << "GDAL reads one pixel every " << step << " in [" << firstColumn << ", " << lastColumn << "]x[" << firstLine << ", " << lastLine << "] x "
+                     << m_NbBands << " bands of type " << GDALGetDataTypeName(m_PxType->pixType) << " from file " << m_FileName
+                     << (overview >= 0 ? " (overview " + std::to_string(overview) + ")" : std::string()));
+
+  otb::Stopwatch chrono = otb::Stopwatch::StartNew();
+
+  std::vector<unsigned char> lineBuffer;
+  for (int b = 0; b < m_NbBands; ++b)
+  {
+    GDALRasterBand* band = dataset->GetRasterBand(b + 1);
+    if (overview >= 0)
+      band = band->GetOverview(overview);
+
+    // Pixels of the band holding the first and last sampled columns
+    const int bandWidth  = band->GetXSize();
+    const int bandHeight = band->GetYSize();
+    const int colStart   = std::min(firstColumn / scale, bandWidth - 1);
+    const int colEnd     = std::min(lastColumn / scale, bandWidth - 1);
+    const int nbRead     = colEnd - colStart + 1;
+    lineBuffer.resize(static_cast<size_t>(nbRead) * m_BytePerPixel);
+
+    for (int l = 0; l < nbLinesRegion; ++l)
+    {
+      const int    bandLine = std::min((firstLine + l * step) / scale, bandHeight - 1);
+      const CPLErr lCrGdal  = band->RasterIO(GF_Read, colStart, bandLine, nbRead, 1, lineBuffer.data(), nbRead, 1, m_PxType->pixType, 0, 0);
+      if (lCrGdal == CE_Failure)
+      {
+        itkExceptionMacro(<< "Error while reading image (GDAL format) '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+      }
+
+      unsigned char* out = p + (static_cast<size_t>(l) * nbColumns * pixelOffset) + static_cast<size_t>(b) * bandOffset;
+      for (int k = 0; k < nbColumns; ++k, out += pixelOffset)
+      {
+        const int column = std::min((firstColumn + k * step) / scale, bandWidth - 1) - colStart;
+        std::memcpy(out, &lineBuffer[static_cast<size_t>(column) * m_BytePerPixel], m_BytePerPixel);
+      }
+    }
+  }
+  chrono.Stop();
+
+  otbLogMacro(Debug, << "GDAL read took " << chrono.GetElapsedMilliseconds() << " ms")
+}
+
 bool GDALImageIO::GetSubDatasetInfo(std::vector<std::string>& names, std::vector<std::string>& desc)
 {
   // Note: we assume that the subdatasets are in order : SUBDATASET_ID_NAME, SUBDATASET_ID_DESC, SUBDATASET_ID+1_NAME, SUBDATASET_ID+1_DESC
@@ -1247,6 +1361,12 @@ void GDALImageIO::Write(const void* buffer)
 
     otbLogMacro(Debug, << "GDAL write took " << chrono.GetElapsedMilliseconds() << " ms")
 
+    // Decimate the region into the overview levels while it is in memory
+    if (m_StreamingOverviews)
+    {
+      m_StreamingOverviews->AddRegion(buffer, lFirstColumn, lFirstLine, lNbColumns, lNbLines);
+    }
+
         // Flush dataset cache
         m_Dataset->GetDataSet()
             ->FlushCache();
@@ -1281,6 +1401,14 @@ void GDALImageIO::Write(const void* buffer)
   if (lFirstLine + lNbLines == m_Dimensions[1] && lFirstColumn + lNbColumns == m_Dimensions[0])
   {
     // Last pixel written
+    if (m_StreamingOverviews)
+    {
+      if (!m_StreamingOverviews->IsComplete())
+      {
+        otbLogMacro(Warning, << "Some overview lines of " << m_FileName << " were not written");
+      }
+      m_StreamingOverviews.reset();
+    }
     // Reinitialize to close the file
     m_Dataset = GDALDatasetWrapperPointer();
   }
@@ -1638,6 +1766,31 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
   // Write no-data flags from extended filenames
   for (auto const& noData : m_NoDataList)
     dataset->GetRasterBand(noData.first)->SetNoDataValue(noData.second);
+
+  /* -------------------------------------------------------------------- */
+  /*      Overviews built while streaming.                                */
+  /* -------------------------------------------------------------------- */
+  m_StreamingOverviews.reset();
+  if (m_WriteOverviewsCount != 0)
+  {
+    if (m_CanStreamWrite)
+    {
+      m_StreamingOverviews.reset(new GDALStreamingOverviews(dataset, m_WriteOverviewsResampling));
+      if (m_StreamingOverviews->Initialize(m_WriteOverviewsCount))
+      {
+        otbLogMacro(Info, << m_StreamingOverviews->GetNumberOfLevels() << " overview levels will be written along with " << m_FileName);
+      }
+      else
+      {
+        otbLogMacro(Warning, << "GDAL driver " << driverShortName << " can not create internal overviews for " << m_FileName);
+        m_StreamingOverviews.reset();
+      }
+    }
+    else
+    {
+      otbLogMacro(Warning, << "GDAL driver " << driverShortName << " does not support streaming, no overviews will be written to " << m_FileName);
+    }
+  }
 }
 
 std::string GDALImageIO::FilenameToGdalDriverShortName(const std::string& name) const
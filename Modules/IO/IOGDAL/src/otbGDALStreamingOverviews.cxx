@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGDALStreamingOverviews.h"
+
+#include <algorithm>
+
+#include "gdal_priv.h"
+#include "itkMacro.h"
+
+namespace otb
+{
+
+GDALStreamingOverviews::GDALStreamingOverviews(GDALDataset* dataset, GDALResampling resampling)
+  : m_Dataset(dataset), m_Resampling(resampling), m_DataType(GDT_Unknown), m_WorkType(GDT_Float64), m_NbBands(0), m_NbComponents(0), m_Levels()
+{
+  if (m_Resampling != GDAL_RESAMPLING_NEAREST)
+  {
+    m_Resampling = GDAL_RESAMPLING_AVERAGE;
+  }
+}
+
+bool GDALStreamingOverviews::Initialize(int nbLevels)
+{
+  m_Levels.clear();
+
+  if (m_Dataset == nullptr || m_Dataset->GetRasterCount() == 0)
+  {
+    return false;
+  }
+
+  const int width  = m_Dataset->GetRasterXSize();
+  const int height = m_Dataset->GetRasterYSize();
+
+  if (nbLevels < 0)
+  {
+    // Stop when the smallest level fits in a typical 256x256 block
+    nbLevels = 0;
+    while (((std::max(width, height) - 1) >> nbLevels) + 1 > 256)
+    {
+      ++nbLevels;
+    }
+  }
+  if (nbLevels == 0)
+  {
+    return true;
+  }
+
+  m_NbBands      = m_Dataset->GetRasterCount();
+  m_DataType     = m_Dataset->GetRasterBand(1)->GetRasterDataType();
+  m_WorkType     = GDALDataTypeIsComplex(m_DataType) ? GDT_CFloat64 : GDT_Float64;
+  m_NbComponents = GDALDataTypeIsComplex(m_DataType) ? 2 * m_NbBands : m_NbBands;
+
+  std::vector<int> factors(nbLevels);
+  for (int i = 0; i < nbLevels; ++i)
+  {
+    factors[i] = 1 << (i + 1);
+  }
+
+  // NONE only creates the (empty) overview structure
+  CPLErrorReset();
+  if (m_Dataset->BuildOverviews("NONE", nbLevels, &factors.front(), 0, nullptr, nullptr, nullptr) != CE_None ||
+      m_Dataset->GetRasterBand(1)->GetOverviewCount() < nbLevels)
+  {
+    return false;
+  }
+
+  int inputWidth  = width;
+  int inputHeight = height;
+  for (int i = 0; i < nbLevels; ++i)
+  {
+    GDALRasterBand* overview = m_Dataset->GetRasterBand(1)->GetOverview(i);
+
+    Level level;
+    level.InputWidth   = inputWidth;
+    level.InputHeight  = inputHeight;
+    level.Width        = overview->GetXSize();
+    level.Height       = overview->GetYSize();
+    level.WrittenLines = 0;
+
+    // Each level must be exactly half the previous one for the cascade
+    if (level.Width != (inputWidth + 1) / 2 || level.Height != (inputHeight + 1) / 2)
+    {
+      m_Levels.clear();
+      return false;
+    }
+
+    m_Levels.push_back(level);
+    inputWidth  = level.Width;
+    inputHeight = level.Height;
+  }
+  return true;
+}
+
+void GDALStreamingOverviews::AddRegion(const void* buffer, int firstColumn, int firstLine, int nbColumns, int nbLines)
+{
+  if (m_Levels.empty())
+  {
+    return;
+  }
+
+  const int         sampleSize = GDALGetDataTypeSize(m_DataType) / 8;
+  const int         workSize   = GDALGetDataTypeSize(m_WorkType) / 8;
+  const std::size_t lineSize   = static_cast<std::size_t>(sampleSize) * m_NbBands * nbColumns;
+
+  std::vector<double> line(static_cast<std::size_t>(nbColumns) * m_NbComponents);
+
+  for (int y = 0; y < nbLines; ++y)
+  {
+    const GByte* src = static_cast<const GByte*>(buffer) + y * lineSize;
+    GDALCopyWords(const_cast<GByte*>(src), m_DataType, sampleSize, &line.front(), m_WorkType, workSize, nbColumns * m_NbBands);
+    this->AddLine(0, firstLine + y, firstColumn, nbColumns, &line.front());
+  }
+}
+
+void GDALStreamingOverviews::AddLine(unsigned int index, int line, int firstColumn, int nbColumns, const double* values)
+{
+  Level&       level   = m_Levels[index];
+  const int    outLine = line / 2;
+  PendingLine& pending = level.Pending[outLine];
+
+  if (pending.Values.empty())
+  {
+    pending.Values.assign(static_cast<std::size_t>(level.Width) * m_NbComponents, 0.);
+  }
+
+  if (m_Resampling == GDAL_RESAMPLING_NEAREST)
+  {
+    // Keep the top-left pixel of each 2x2 block
+    if (line % 2 == 0)
+    {
+      for (int i = (firstColumn % 2 == 0) ? 0 : 1; i < nbColumns; i += 2)
+      {
+        const int column = (firstColumn + i) / 2;
+        std::copy(values + i * m_NbComponents, values + (i + 1) * m_NbComponents, &pending.Values[column * m_NbComponents]);
+      }
+    }
+  }
+  else
+  {
+    for (int i = 0; i < nbColumns; ++i)
+    {
+      double*       dst = &pending.Values[((firstColumn + i) / 2) * m_NbComponents];
+      const double* src = values + i * m_NbComponents;
+      for (int k = 0; k < m_NbComponents; ++k)
+      {
+        dst[k] += src[k];
+      }
+    }
+  }
+
+  pending.Received += nbColumns;
+
+  const long expected = static_cast<long>(std::min(2, level.InputHeight - 2 * outLine)) * level.InputWidth;
+  if (pending.Received >= expected)
+  {
+    this->FlushLine(index, outLine, pending);
+    level.Pending.erase(outLine);
+  }
+}
+
+void GDALStreamingOverviews::FlushLine(unsigned int index, int line, PendingLine& pending)
+{
+  Level& level = m_Levels[index];
+
+  if (m_Resampling != GDAL_RESAMPLING_NEAREST)
+  {
+    const int nbLines = std::min(2, level.InputHeight - 2 * line);
+    for (int column = 0; column < level.Width; ++column)
+    {
+      const double count = static_cast<double>(nbLines * std::min(2, level.InputWidth - 2 * column));
+      double*      dst   = &pending.Values[column * m_NbComponents];
+      for (int k = 0; k < m_NbComponents; ++k)
+      {
+        dst[k] /= count;
+      }
+    }
+  }
+
+  const int componentsPerBand = m_NbComponents / m_NbBands;
+  const int workSize          = GDALGetDataTypeSize(m_WorkType) / 8;
+  for (int band = 0; band < m_NbBands; ++band)
+  {
+    GDALRasterBand* overview = m_Dataset->GetRasterBand(band + 1)->GetOverview(index);
+    if (overview->RasterIO(GF_Write, 0, line, level.Width, 1, &pending.Values[band * componentsPerBand], level.Width, 1, m_WorkType,
+                           workSize * m_NbBands, 0, nullptr) != CE_None)
+    {
+      itkGenericExceptionMacro(<< "Error while writing overview " << index + 1 << " line " << line << ": " << CPLGetLastErrorMsg());
+    }
+  }
+  ++level.WrittenLines;
+
+  // Cascade the completed line to the next level
+  if (index + 1 < m_Levels.size())
+  {
+    this->AddLine(index + 1, line, 0, level.Width, &pending.Values.front());
+  }
+}
+
+bool GDALStreamingOverviews::IsComplete() const
+{
+  for (std::vector<Level>::const_iterator it = m_Levels.begin(); it != m_Levels.end(); ++it)
+  {
+    if (it->WrittenLines != it->Height)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end namespace otb
@@ -30,6 +30,7 @@
 #include "itkImageSource.h"
 #endif
 #include "otbImageIOBase.h"
+#include "otbDecimatedRegionReaderInterface.h"
 #include "itkExceptionObject.h"
 #include "itkImageRegion.h"
 #include "OTBImageIOExport.h"
@@ -66,7 +67,7 @@ namespace otb
  * \ingroup OTBImageIO
  */
 template <class TOutputImage, class ConvertPixelTraits = DefaultConvertPixelTraits<typename TOutputImage::IOPixelType>>
-class OTBImageIO_EXPORT_TEMPLATE ImageFileReader : public itk::ImageSource<TOutputImage>
+class OTBImageIO_EXPORT_TEMPLATE ImageFileReader : public itk::ImageSource<TOutputImage>, public DecimatedRegionReaderInterface<TOutputImage>
 {
 public:
   /** Standard class typedefs. */
@@ -130,6 +131,11 @@ public:
    * Returns: overview info, empty if none.*/
   std::vector<std::string> GetOverviewsInfo();
 
+  /** Read the pixels start + k * factor of the output, for 0 <= k < size,
+   * directly into image, without updating the output. Returns false if the
+   * ImageIO can not read decimated regions. */
+  bool ReadDecimatedRegion(const IndexType& start, const SizeType& size, unsigned int factor, bool useOverviews, TOutputImage* image) override;
+
 protected:
   ImageFileReader();
   ~ImageFileReader() override;
@@ -138,12 +144,19 @@ protected:
   /** Convert a block of pixels from one type to another. */
   void DoConvertBuffer(void* buffer, size_t numberOfPixels);
 
+  /** Convert a block of pixels from one type to another, into the buffer of image. */
+  void DoConvertBuffer(void* buffer, size_t numberOfPixels, TOutputImage* image);
+
 private:
   /** Test whether m_ImageIO is valid (not NULL). This is intended to be called
    * after trying to create it via an ImageIOFactory. Throws an exception with
    * an appropriate message otherwise. */
   void TestValidImageIO();
 
+  /** Read the current IORegion of the ImageIO into the buffer of image,
+   * converting and mapping the bands when needed */
+  void ReadIORegion(TOutputImage* image, unsigned int factor, bool useOverviews);
+
   /** Generate the filename (for GDALImageI for example). If filename is a directory, look if is a
     * CEOS product (file "DAT...") In this case, the GdalFileName contain the open image file.
     */
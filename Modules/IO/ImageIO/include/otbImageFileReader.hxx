@@ -130,7 +130,6 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   this->TestValidImageIO();
 
   // Tell the ImageIO to read the file
-  OutputImagePixelType* buffer = output->GetPixelContainer()->GetBufferPointer();
   this->m_ImageIO->SetFileName(this->m_FileName);
 
   itk::ImageIORegion ioRegion(TOutputImage::ImageDimension);
@@ -178,21 +177,65 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
   this->m_ImageIO->SetIORegion(ioRegion);
 
+  this->ReadIORegion(output, 1, false);
+}
+
+template <class TOutputImage, class ConvertPixelTraits>
+bool ImageFileReader<TOutputImage, ConvertPixelTraits>::ReadDecimatedRegion(const IndexType& start, const SizeType& size, unsigned int factor,
+                                                                            bool useOverviews, TOutputImage* image)
+{
+  this->UpdateOutputInformation();
+  this->TestValidImageIO();
+
+  if (factor == 0 || !this->m_ImageIO->CanStreamRead() || !this->m_ImageIO->CanReadDecimated())
+  {
+    return false;
+  }
+
+  if (image->GetBufferedRegion().GetSize() != size)
+  {
+    itkExceptionMacro(<< "Buffered region of the decimated image " << image->GetBufferedRegion() << " does not match the decimated size " << size);
+  }
+
+  itk::ImageIORegion ioRegion(TOutputImage::ImageDimension);
+  for (unsigned int i = 0; i < TOutputImage::ImageDimension; ++i)
+  {
+    ioRegion.SetIndex(i, start[i]);
+    ioRegion.SetSize(i, size[i]);
+  }
+
+  this->m_ImageIO->SetFileName(this->m_FileName);
+  this->m_ImageIO->SetIORegion(ioRegion);
+
+  otbLogMacro(Debug, << "Reading one pixel every " << factor << " pixels from " << start << ", " << size << " pixels from file " << m_FileName);
+  this->ReadIORegion(image, factor, useOverviews);
+  return true;
+}
+
+template <class TOutputImage, class ConvertPixelTraits>
+void ImageFileReader<TOutputImage, ConvertPixelTraits>::ReadIORegion(TOutputImage* image, unsigned int factor, bool useOverviews)
+{
   typedef otb::DefaultConvertPixelTraits<typename TOutputImage::IOPixelType> ConvertIOPixelTraits;
   typedef otb::DefaultConvertPixelTraits<typename TOutputImage::PixelType>   ConvertOutputPixelTraits;
 
+  const bool decimated = factor > 1 || useOverviews;
+
   if (this->m_ImageIO->GetComponentTypeInfo() == typeid(typename ConvertOutputPixelTraits::ComponentType) &&
       (this->m_ImageIO->GetNumberOfComponents() == ConvertIOPixelTraits::GetNumberOfComponents()) && !m_FilenameHelper->BandRangeIsSet())
   {
     // Have the ImageIO read directly into the allocated buffer
-    this->m_ImageIO->Read(buffer);
+    OutputImagePixelType* buffer = image->GetPixelContainer()->GetBufferPointer();
+    if (decimated)
+      this->m_ImageIO->ReadDecimated(buffer, factor, useOverviews);
+    else
+      this->m_ImageIO->Read(buffer);
     return;
   }
   else // a type conversion is necessary
   {
     // note: char is used here because the buffer is read in bytes
     // regardless of the actual type of the pixels.
-    ImageRegionType region = output->GetBufferedRegion();
+    ImageRegionType region = image->GetBufferedRegion();
 
     // Adapt the image size with the region and take into account a potential
     // remapping of the components. m_BandList is empty if no band range is set
@@ -201,12 +244,15 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
     char* loadBuffer = new char[nbBytes];
 
-    this->m_ImageIO->Read(loadBuffer);
+    if (decimated)
+      this->m_ImageIO->ReadDecimated(loadBuffer, factor, useOverviews);
+    else
+      this->m_ImageIO->Read(loadBuffer);
 
     if (m_FilenameHelper->BandRangeIsSet())
       this->m_ImageIO->DoMapBuffer(loadBuffer, region.GetNumberOfPixels(), this->m_BandList);
 
-    this->DoConvertBuffer(loadBuffer, region.GetNumberOfPixels());
+    this->DoConvertBuffer(loadBuffer, region.GetNumberOfPixels(), image);
 
     delete[] loadBuffer;
   }
@@ -577,7 +623,7 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformatio
 
   if (img_common != nullptr)
     {
-    img_common->SetImageMetadata(imd);
+    img_common->SetImageMetadata(std::move(imd));
     }
 
   output->SetLargestPossibleRegion(region);
@@ -762,9 +808,15 @@ std::vector<std::string> ImageFileReader<TOutputImage, ConvertPixelTraits>::GetO
 
 template <class TOutputImage, class ConvertPixelTraits>
 void ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void* inputData, size_t numberOfPixels)
+{
+  this->DoConvertBuffer(inputData, numberOfPixels, this->GetOutput());
+}
+
+template <class TOutputImage, class ConvertPixelTraits>
+void ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void* inputData, size_t numberOfPixels, TOutputImage* image)
 {
   // get the pointer to the destination buffer
-  OutputImagePixelType* outputData = this->GetOutput()->GetPixelContainer()->GetBufferPointer();
+  OutputImagePixelType* outputData = image->GetPixelContainer()->GetBufferPointer();
 
 // TODO:
 // Pass down the PixelType (RGB, VECTOR, etc.) so that any vector to
@@ -785,7 +837,7 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void* in
 #define OTB_CONVERT_BUFFER_IF_BLOCK(type)                                                                                                                     \
   else if (m_ImageIO->GetComponentTypeInfo() == typeid(type))                                                                                                 \
   {                                                                                                                                                           \
-    if (strcmp(this->GetOutput()->GetNameOfClass(), "VectorImage") == 0)                                                                                      \
+    if (strcmp(image->GetNameOfClass(), "VectorImage") == 0)                                                                                                  \
     {                                                                                                                                                         \
       ConvertPixelBuffer<type, OutputImagePixelType, ConvertPixelTraits>::ConvertVectorImage(static_cast<type*>(inputData), m_IOComponents, outputData,       \
                                                                                              numberOfPixels);                                                 \
@@ -798,7 +850,7 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::DoConvertBuffer(void* in
 #define OTB_CONVERT_CBUFFER_IF_BLOCK(type)                                                                                                                \
   else if (m_ImageIO->GetComponentTypeInfo() == typeid(type))                                                                                             \
   {                                                                                                                                                       \
-    if (strcmp(this->GetOutput()->GetNameOfClass(), "VectorImage") == 0)                                                                                  \
+    if (strcmp(image->GetNameOfClass(), "VectorImage") == 0)                                                                                              \
     {                                                                                                                                                     \
       if ((typeid(OutputImagePixelType) == typeid(std::complex<double>)) || (typeid(OutputImagePixelType) == typeid(std::complex<float>)) ||              \
           (typeid(OutputImagePixelType) == typeid(std::complex<int>)) || (typeid(OutputImagePixelType) == typeid(std::complex<short>)))                   \
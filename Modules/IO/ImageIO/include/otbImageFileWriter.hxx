@@ -46,6 +46,7 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbPipelineProfiler.h"
 
 #include "otb_boost_tokenizer_header.h"
 
@@ -422,7 +423,8 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
 
   // Manage extended filename
   if ((strcmp(m_ImageIO->GetNameOfClass(), "GDALImageIO") == 0) &&
-      (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet() || m_FilenameHelper->NoDataValueIsSet() || m_FilenameHelper->SrsValueIsSet()))
+      (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet() || m_FilenameHelper->NoDataValueIsSet() || m_FilenameHelper->SrsValueIsSet() ||
+       m_FilenameHelper->OverviewsIsSet()))
   {
     typename GDALImageIO::Pointer imageIO = dynamic_cast<GDALImageIO*>(m_ImageIO.GetPointer());
 
@@ -441,6 +443,15 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
       imageIO->SetNoDataList(m_FilenameHelper->GetNoDataList());
     if  (m_FilenameHelper->SrsValueIsSet())
 	  imageIO->SetEpsgCode(m_FilenameHelper->GetSrsValue());
+    if (m_FilenameHelper->OverviewsIsSet())
+    {
+      imageIO->SetWriteOverviewsCount(m_FilenameHelper->GetOverviews());
+      imageIO->SetWriteOverviewsResampling(m_FilenameHelper->GetOverviewsResampling() == "nearest" ? GDAL_RESAMPLING_NEAREST : GDAL_RESAMPLING_AVERAGE);
+    }
+  }
+  else if (m_FilenameHelper->OverviewsIsSet())
+  {
+    otbLogMacro(Warning, << "Overviews can only be written with GDAL, the overviews option is ignored for " << m_FileName);
   }
 
 
@@ -622,6 +633,7 @@ void ImageFileWriter<TInputImage>::Update()
        m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
   {
     streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    PipelineProfiler::ScopedSplit profiledSplit(m_CurrentDivision, streamRegion);
 
     inputPtr->SetRequestedRegion(streamRegion);
     inputPtr->PropagateRequestedRegion();
@@ -639,6 +651,7 @@ void ImageFileWriter<TInputImage>::Update()
     m_ImageIO->SetIORegion(m_IORegion);
 
     // Start writing stream region in the image file
+    PipelineProfiler::ScopedEvent profiledWrite(this->GetNameOfClass(), "write");
     this->GenerateData();
   }
 
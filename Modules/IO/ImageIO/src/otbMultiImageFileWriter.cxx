@@ -20,6 +20,7 @@
 
 #include "otbMultiImageFileWriter.h"
 #include "otbImageIOFactory.h"
+#include "otbPipelineProfiler.h"
 
 namespace otb
 {
@@ -276,6 +277,7 @@ void MultiImageFileWriter::UpdateOutputData(itk::DataObject* itkNotUsed(output))
     {
       m_StreamRegionList[inputIndex] = GetStreamRegion(inputIndex);
     }
+    PipelineProfiler::ScopedSplit profiledSplit(m_CurrentDivision, m_StreamRegionList[0]);
 
     // NOTE : this reset was probably designed to work with the next section
     // Where the final requested region is the "union" between the computed
@@ -93,6 +93,10 @@ public:
   itkGetMacro(RandomInit, bool);
   itkSetMacro(Seed, unsigned int);
   itkGetMacro(Seed, unsigned int);
+  itkSetMacro(BatchMode, bool);
+  itkGetMacro(BatchMode, bool);
+  itkSetMacro(BatchSize, unsigned int);
+  itkGetMacro(BatchSize, unsigned int);
 
   bool CanReadFile(const std::string& filename) override;
   bool CanWriteFile(const std::string& filename) override;
@@ -135,6 +139,10 @@ private:
   SOMNeighborhoodBehaviorFunctorType m_NeighborhoodSizeFunctor;
   /** Write the SOM Map vectors in a txt file */
   bool m_WriteMap;
+  /** Batch training mode */
+  bool m_BatchMode{false};
+  /** Number of samples per update in batch mode (0 for all the samples) */
+  unsigned int m_BatchSize{0};
 };
 
 } // end namespace otb
@@ -24,6 +24,7 @@
 #include "itkInPlaceImageFilter.h"
 #include "itkListSample.h"
 #include "itkEuclideanDistanceMetric.h"
+#include "otbNearestCentroidSearch.h"
 
 namespace otb
 {
@@ -33,7 +34,12 @@ namespace otb
  *  This filter is streamed and threaded, allowing to classify huge images. Because the
  *  internal sample type has to be an itk::FixedArray, one must specify at compilation time
  *  the maximum sample dimension. It is up to the user to specify a MaxSampleDimension sufficiently
- *  high to integrate all its features. This filter internally use one SVMClassifier per thread.
+ *  high to integrate all its features.
+ *
+ *  Pixels are assigned to their nearest centroid by blocks, with a NearestCentroidSearch.
+ *  Ties are resolved in favor of the lowest label. When many centroids are used, enabling
+ *  UseTrianglePruning skips the centroids that the triangle inequality proves to be farther
+ *  than the current best one.
  *
  * \sa SVMClassifier
  * \ingroup Streamed
@@ -89,6 +95,11 @@ public:
   itkSetMacro(DefaultLabel, LabelType);
   itkGetMacro(DefaultLabel, LabelType);
 
+  /** Set/Get the use of triangle inequality pruning in the nearest centroid search */
+  itkSetMacro(UseTrianglePruning, bool);
+  itkGetMacro(UseTrianglePruning, bool);
+  itkBooleanMacro(UseTrianglePruning);
+
   /**
    * If set, only pixels within the mask will be classified.
    * \param mask The input mask.
@@ -122,8 +133,10 @@ private:
   KMeansParametersType m_Centroids;
   /** Default label for invalid pixels (when using a mask) */
   LabelType m_DefaultLabel;
-  /** Centroids - labels map */
-  CentroidsMapType m_CentroidsMap;
+  /** Use triangle inequality pruning */
+  bool m_UseTrianglePruning;
+  /** Nearest centroid search, centroid i having label i + 1 */
+  NearestCentroidSearch m_CentroidSearch;
 };
 } // End namespace otb
 #ifndef OTB_MANUAL_INSTANTIATION
@@ -24,6 +24,8 @@
 #include "otbKMeansImageClassificationFilter.h"
 #include "itkImageRegionIterator.h"
 #include "itkNumericTraits.h"
+#include <algorithm>
+#include <vector>
 
 namespace otb
 {
@@ -35,7 +37,8 @@ KMeansImageClassificationFilter<TInputImage, TOutputImage, VMaxSampleDimension,
 {
   this->SetNumberOfRequiredInputs(2);
   this->SetNumberOfRequiredInputs(1);
-  m_DefaultLabel = itk::NumericTraits<LabelType>::ZeroValue();
+  m_DefaultLabel       = itk::NumericTraits<LabelType>::ZeroValue();
+  m_UseTrianglePruning = false;
 }
 
 template <class TInputImage, class TOutputImage, unsigned int VMaxSampleDimension, class TMaskImage>
@@ -61,17 +64,14 @@ void KMeansImageClassificationFilter<TInputImage, TOutputImage, VMaxSampleDimens
   unsigned int sample_size = MaxSampleDimension;
   unsigned int nb_classes  = m_Centroids.Size() / sample_size;
 
-  for (LabelType label = 1; label <= static_cast<LabelType>(nb_classes); ++label)
+  // Centroids are rounded to the pixel value type, as the pixels they are compared to
+  std::vector<double> centroids(nb_classes * sample_size);
+  for (unsigned int i = 0; i < centroids.size(); ++i)
   {
-    SampleType new_centroid;
-    new_centroid.Fill(0);
-    m_CentroidsMap[label] = new_centroid;
-
-    for (unsigned int i = 0; i < MaxSampleDimension; ++i)
-    {
-      m_CentroidsMap[label][i] = static_cast<ValueType>(m_Centroids[MaxSampleDimension * (static_cast<unsigned int>(label) - 1) + i]);
-    }
+    centroids[i] = static_cast<ValueType>(m_Centroids[i]);
   }
+  m_CentroidSearch.SetCentroids(centroids, sample_size);
+  m_CentroidSearch.SetUseTrianglePruning(m_UseTrianglePruning);
 }
 
 template <class TInputImage, class TOutputImage, unsigned int VMaxSampleDimension, class TMaskImage>
@@ -95,56 +95,47 @@ void KMeansImageClassificationFilter<TInputImage, TOutputImage, VMaxSampleDimens
     maskIt = MaskIteratorType(inputMaskPtr, outputRegionForThread);
     maskIt.GoToBegin();
   }
-  unsigned int maxDimension = SampleType::Dimension;
-  unsigned int sampleSize   = std::min(inputPtr->GetNumberOfComponentsPerPixel(), maxDimension);
-
-  bool validPoint = true;
-
-  while (!outIt.IsAtEnd())
-  {
-    outIt.Set(m_DefaultLabel);
-    ++outIt;
-  }
-
-  outIt.GoToBegin();
-
-  validPoint = true;
+  const unsigned int maxDimension = MaxSampleDimension;
+  const unsigned int sampleSize   = std::min(inputPtr->GetNumberOfComponentsPerPixel(), maxDimension);
 
-  typename DistanceType::Pointer distance = DistanceType::New();
+  // Pixels are gathered by blocks along the region, missing components being
+  // zero, and assigned to their nearest centroid at once
+  const unsigned int        blockSize = 1024;
+  std::vector<double>       samples(static_cast<size_t>(blockSize) * maxDimension);
+  std::vector<unsigned int> assignments(blockSize);
+  std::vector<bool>         validPoints(blockSize);
 
-  while (!outIt.IsAtEnd() && (!inIt.IsAtEnd()))
+  while (!inIt.IsAtEnd())
   {
-    if (inputMaskPtr)
+    unsigned int nbPixels = 0;
+    unsigned int nbValid  = 0;
+    for (; nbPixels < blockSize && !inIt.IsAtEnd(); ++nbPixels, ++inIt)
     {
-      validPoint = maskIt.Get() > 0;
-      ++maskIt;
-    }
-    if (validPoint)
-    {
-      LabelType  label         = 1;
-      LabelType  current_label = 1;
-      SampleType pixel;
-      pixel.Fill(0);
-      for (unsigned int i = 0; i < sampleSize; ++i)
+      bool validPoint = true;
+      if (inputMaskPtr)
       {
-        pixel[i] = inIt.Get()[i];
+        validPoint = maskIt.Get() > 0;
+        ++maskIt;
       }
-
-      double current_distance = distance->Evaluate(pixel, m_CentroidsMap[label]);
-
-      for (label = 2; label <= static_cast<LabelType>(m_CentroidsMap.size()); ++label)
+      validPoints[nbPixels] = validPoint;
+      if (validPoint)
       {
-        double tmp_dist = distance->Evaluate(pixel, m_CentroidsMap[label]);
-        if (tmp_dist < current_distance)
+        double* sample = &samples[static_cast<size_t>(nbValid) * maxDimension];
+        std::fill(sample, sample + maxDimension, 0.);
+        for (unsigned int i = 0; i < sampleSize; ++i)
         {
-          current_label    = label;
-          current_distance = tmp_dist;
+          sample[i] = static_cast<ValueType>(inIt.Get()[i]);
         }
+        ++nbValid;
       }
-      outIt.Set(current_label);
     }
-    ++outIt;
-    ++inIt;
+
+    m_CentroidSearch.Assign(samples.data(), nbValid, assignments.data());
+
+    for (unsigned int p = 0, v = 0; p < nbPixels; ++p, ++outIt)
+    {
+      outIt.Set(validPoints[p] ? static_cast<LabelType>(assignments[v++] + 1) : m_DefaultLabel);
+    }
   }
 }
 /**
@@ -154,6 +145,7 @@ template <class TInputImage, class TOutputImage, unsigned int VMaxSampleDimensio
 void KMeansImageClassificationFilter<TInputImage, TOutputImage, VMaxSampleDimension, TMaskImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "UseTrianglePruning: " << m_UseTrianglePruning << std::endl;
 }
 } // End namespace otb
 #endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbNearestCentroidSearch_h
+#define otbNearestCentroidSearch_h
+
+#include "OTBLearningBaseExport.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class NearestCentroidSearch
+ * \brief Assign samples to their nearest centroid (euclidean distance).
+ *
+ * The centroids are stored component-major (structure of arrays), so that
+ * the distances from one sample to all the centroids are computed by
+ * contiguous, vectorizable loops. Samples are processed by blocks, using the
+ * expansion \f$ |x-c|^2 = |x|^2 - 2x.c + |c|^2 \f$ where the centroid norms
+ * are computed once.
+ *
+ * The expansion may lose precision when two centroids are almost at the same
+ * distance from a sample. In that case the candidates are compared again with
+ * the direct distance, so that the result is always the one of a plain
+ * sequential search: the nearest centroid, the lowest index winning ties.
+ *
+ * When triangle pruning is enabled, each sample is instead compared first to
+ * the centroid assigned to the previous sample, and the centroids c that
+ * satisfy \f$ d(c^*, c) > 2 d(x, c^*) \f$ are skipped (Elkan's bound with
+ * precomputed inter-centroid distances). This pays off with many centroids
+ * and spatially coherent samples, such as image pixels.
+ *
+ * Assign() is const and allocates its own buffers, so it can be called
+ * concurrently from several threads.
+ *
+ * \ingroup OTBLearningBase
+ */
+class OTBLearningBase_EXPORT NearestCentroidSearch
+{
+public:
+  NearestCentroidSearch();
+
+  /** Set the centroids, as a row-major nbCentroids x dimension matrix */
+  void SetCentroids(const std::vector<double>& centroids, unsigned int dimension);
+
+  /** Enable or disable the triangle inequality pruning */
+  void SetUseTrianglePruning(bool flag)
+  {
+    m_UseTrianglePruning = flag;
+  }
+
+  bool GetUseTrianglePruning() const
+  {
+    return m_UseTrianglePruning;
+  }
+
+  unsigned int GetNumberOfCentroids() const
+  {
+    return m_NumberOfCentroids;
+  }
+
+  unsigned int GetDimension() const
+  {
+    return m_Dimension;
+  }
+
+  /** Find the index of the nearest centroid of nbSamples samples, stored as a
+   * row-major nbSamples x GetDimension() matrix */
+  void Assign(const double* samples, unsigned int nbSamples, unsigned int* assignments) const;
+
+  /** Direct euclidean distance between a sample and a centroid */
+  double Distance(const double* sample, unsigned int centroid) const;
+
+private:
+  void AssignBlock(const double* samples, unsigned int nbSamples, unsigned int* assignments, std::vector<double>& distances) const;
+
+  void AssignWithPruning(const double* samples, unsigned int nbSamples, unsigned int* assignments) const;
+
+  /** Sequential search with direct distances, among the centroids whose
+   * squared distance estimate is below threshold */
+  unsigned int ResolveTie(const double* sample, const double* estimates, double threshold) const;
+
+  unsigned int m_Dimension;
+  unsigned int m_NumberOfCentroids;
+  bool         m_UseTrianglePruning;
+
+  /** Centroids, row-major (one centroid after the other) */
+  std::vector<double> m_Centroids;
+
+  /** Centroids, component-major (one component of all centroids after the other) */
+  std::vector<double> m_CentroidsSoA;
+
+  /** Squared norm of each centroid */
+  std::vector<double> m_SquaredNorms;
+  double              m_MaxSquaredNorm;
+
+  /** Half distances between centroids, nbCentroids x nbCentroids */
+  std::vector<double> m_HalfCentroidDistances;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbNearestCentroidSearch.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+namespace otb
+{
+
+namespace
+{
+// Number of samples whose distances are computed together
+const unsigned int SampleBlockSize = 64;
+}
+
+NearestCentroidSearch::NearestCentroidSearch() : m_Dimension(0), m_NumberOfCentroids(0), m_UseTrianglePruning(false), m_MaxSquaredNorm(0.)
+{
+}
+
+void NearestCentroidSearch::SetCentroids(const std::vector<double>& centroids, unsigned int dimension)
+{
+  assert(dimension == 0 || centroids.size() % dimension == 0);
+
+  m_Centroids         = centroids;
+  m_Dimension         = dimension;
+  m_NumberOfCentroids = dimension ? static_cast<unsigned int>(centroids.size() / dimension) : 0;
+
+  const unsigned int nbCentroids = m_NumberOfCentroids;
+
+  m_CentroidsSoA.resize(centroids.size());
+  m_SquaredNorms.assign(nbCentroids, 0.);
+  m_MaxSquaredNorm = 0.;
+  for (unsigned int c = 0; c < nbCentroids; ++c)
+  {
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      const double value = m_Centroids[static_cast<size_t>(c) * dimension + d];
+      m_CentroidsSoA[static_cast<size_t>(d) * nbCentroids + c] = value;
+      m_SquaredNorms[c] += value * value;
+    }
+    m_MaxSquaredNorm = std::max(m_MaxSquaredNorm, m_SquaredNorms[c]);
+  }
+
+  m_HalfCentroidDistances.assign(static_cast<size_t>(nbCentroids) * nbCentroids, 0.);
+  for (unsigned int i = 0; i < nbCentroids; ++i)
+  {
+    for (unsigned int j = i + 1; j < nbCentroids; ++j)
+    {
+      const double half = 0.5 * Distance(&m_Centroids[static_cast<size_t>(i) * dimension], j);
+      m_HalfCentroidDistances[static_cast<size_t>(i) * nbCentroids + j] = half;
+      m_HalfCentroidDistances[static_cast<size_t>(j) * nbCentroids + i] = half;
+    }
+  }
+}
+
+double NearestCentroidSearch::Distance(const double* sample, unsigned int centroid) const
+{
+  const double* c   = &m_Centroids[static_cast<size_t>(centroid) * m_Dimension];
+  double        sum = 0.;
+  for (unsigned int d = 0; d < m_Dimension; ++d)
+  {
+    const double diff = sample[d] - c[d];
+    sum += diff * diff;
+  }
+  return std::sqrt(sum);
+}
+
+void NearestCentroidSearch::Assign(const double* samples, unsigned int nbSamples, unsigned int* assignments) const
+{
+  if (m_NumberOfCentroids == 0)
+  {
+    std::fill(assignments, assignments + nbSamples, 0);
+    return;
+  }
+
+  if (m_UseTrianglePruning)
+  {
+    AssignWithPruning(samples, nbSamples, assignments);
+    return;
+  }
+
+  std::vector<double> distances(static_cast<size_t>(std::min(nbSamples, SampleBlockSize)) * m_NumberOfCentroids);
+  for (unsigned int blockStart = 0; blockStart < nbSamples; blockStart += SampleBlockSize)
+  {
+    const unsigned int blockSize = std::min(SampleBlockSize, nbSamples - blockStart);
+    AssignBlock(samples + static_cast<size_t>(blockStart) * m_Dimension, blockSize, assignments + blockStart, distances);
+  }
+}
+
+void NearestCentroidSearch::AssignBlock(const double* samples, unsigned int nbSamples, unsigned int* assignments, std::vector<double>& distances) const
+{
+  const unsigned int nbCentroids = m_NumberOfCentroids;
+
+  // Bound on the rounding error of the expansion, relative to |x|^2 + |c|^2
+  const double relativeTolerance = 4. * (m_Dimension + 2) * DBL_EPSILON;
+
+  // Squared distance estimates |x|^2 - 2x.c + |c|^2 of the whole block. The
+  // inner loops run over the centroids, contiguous in the SoA table.
+  for (unsigned int s = 0; s < nbSamples; ++s)
+  {
+    const double* x   = samples + static_cast<size_t>(s) * m_Dimension;
+    double*       row = &distances[static_cast<size_t>(s) * nbCentroids];
+    std::copy(m_SquaredNorms.begin(), m_SquaredNorms.end(), row);
+    for (unsigned int d = 0; d < m_Dimension; ++d)
+    {
+      const double  minusTwoX = -2. * x[d];
+      const double* component = &m_CentroidsSoA[static_cast<size_t>(d) * nbCentroids];
+      for (unsigned int c = 0; c < nbCentroids; ++c)
+      {
+        row[c] += minusTwoX * component[c];
+      }
+    }
+  }
+
+  for (unsigned int s = 0; s < nbSamples; ++s)
+  {
+    const double* x   = samples + static_cast<size_t>(s) * m_Dimension;
+    const double* row = &distances[static_cast<size_t>(s) * nbCentroids];
+
+    double sampleNorm = 0.;
+    for (unsigned int d = 0; d < m_Dimension; ++d)
+    {
+      sampleNorm += x[d] * x[d];
+    }
+
+    // |x|^2 is common to all centroids and left out of the comparison
+    unsigned int best     = 0;
+    double       bestDist = row[0];
+    for (unsigned int c = 1; c < nbCentroids; ++c)
+    {
+      if (row[c] < bestDist)
+      {
+        best     = c;
+        bestDist = row[c];
+      }
+    }
+
+    // Any other centroid within twice the rounding error may actually be
+    // nearer, or at the same distance with a lower index
+    const double threshold = bestDist + 2. * relativeTolerance * (sampleNorm + m_MaxSquaredNorm);
+    bool         ambiguous = false;
+    for (unsigned int c = 0; c < nbCentroids && !ambiguous; ++c)
+    {
+      ambiguous = (c != best && row[c] <= threshold);
+    }
+
+    assignments[s] = ambiguous ? ResolveTie(x, row, threshold) : best;
+  }
+}
+
+unsigned int NearestCentroidSearch::ResolveTie(const double* sample, const double* estimates, double threshold) const
+{
+  unsigned int best     = m_NumberOfCentroids;
+  double       bestDist = 0.;
+  for (unsigned int c = 0; c < m_NumberOfCentroids; ++c)
+  {
+    if (estimates[c] > threshold)
+    {
+      continue;
+    }
+    const double dist = Distance(sample, c);
+    if (best == m_NumberOfCentroids || dist < bestDist)
+    {
+      best     = c;
+      bestDist = dist;
+    }
+  }
+  return best;
+}
+
+void NearestCentroidSearch::AssignWithPruning(const double* samples, unsigned int nbSamples, unsigned int* assignments) const
+{
+  const unsigned int nbCentroids = m_NumberOfCentroids;
+
+  // Safety factor on the bound, so that rounding never prunes a centroid that
+  // could be at the same distance as the current best
+  const double pruningFactor = 1. - std::min(0.5, 4. * (m_Dimension + 4) * DBL_EPSILON);
+
+  unsigned int previous = 0;
+  for (unsigned int s = 0; s < nbSamples; ++s)
+  {
+    const double* x = samples + static_cast<size_t>(s) * m_Dimension;
+
+    // Neighboring samples are likely to share the same centroid
+    unsigned int best     = previous;
+    double       bestDist = Distance(x, best);
+
+    for (unsigned int c = 0; c < nbCentroids; ++c)
+    {
+      // d(x, c) >= d(best, c) - d(x, best) > d(x, best)
+      if (c == best || m_HalfCentroidDistances[static_cast<size_t>(best) * nbCentroids + c] * pruningFactor > bestDist)
+      {
+        continue;
+      }
+      const double dist = Distance(x, c);
+      if (dist < bestDist || (dist == bestDist && c < best))
+      {
+        best     = c;
+        bestDist = dist;
+      }
+    }
+
+    assignments[s] = best;
+    previous       = best;
+  }
+}
+
+} // end namespace otb
@@ -24,7 +24,7 @@
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
 
-int otbKMeansImageClassificationFilter(int itkNotUsed(argc), char* argv[])
+int otbKMeansImageClassificationFilter(int argc, char* argv[])
 {
   const char*        infname   = argv[1];
   const char*        outfname  = argv[2];
@@ -65,6 +65,13 @@ int otbKMeansImageClassificationFilter(int itkNotUsed(argc), char* argv[])
 
   std::cout << "Parameters: " << parameters << std::endl;
 
+  // Optional last argument: use triangle inequality pruning
+  const int nbCentroidArgs = static_cast<int>(nbClasses * reader->GetOutput()->GetNumberOfComponentsPerPixel());
+  if (argc > 4 + nbCentroidArgs)
+  {
+    filter->SetUseTrianglePruning(atoi(argv[4 + nbCentroidArgs]) != 0);
+  }
+
   filter->SetCentroids(parameters);
   filter->SetInput(reader->GetOutput());
 
@@ -24,6 +24,7 @@ void RegisterTests()
 {
   REGISTER_TEST(otbDecisionTreeBuild);
   REGISTER_TEST(otbKMeansImageClassificationFilter);
+  REGISTER_TEST(otbNearestCentroidSearch);
   REGISTER_TEST(otbDecisionTreeWithRealValues);
 #ifdef OTB_USE_SHARK
   REGISTER_TEST(otbSharkNormalizeLabels);
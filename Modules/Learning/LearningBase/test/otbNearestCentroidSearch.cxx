@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include "otbNearestCentroidSearch.h"
+#include <iostream>
+#include <random>
+
+int otbNearestCentroidSearch(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // Integer coordinates produce many samples at the same distance of several
+  // centroids, where the lowest centroid index must win
+  std::mt19937                       generator(42);
+  std::uniform_int_distribution<int> coordinate(0, 7);
+
+  const unsigned int nbSamples = 1000;
+  unsigned int       nbErrors  = 0;
+
+  for (unsigned int nbCentroids = 1; nbCentroids <= 32; nbCentroids += 3)
+  {
+    for (unsigned int dimension = 1; dimension <= 12; dimension += 2)
+    {
+      std::vector<double> centroids(nbCentroids * dimension);
+      for (auto& value : centroids)
+      {
+        value = coordinate(generator);
+      }
+      std::vector<double> samples(nbSamples * dimension);
+      for (auto& value : samples)
+      {
+        value = 0.5 * coordinate(generator);
+      }
+
+      otb::NearestCentroidSearch search;
+      search.SetCentroids(centroids, dimension);
+
+      std::vector<unsigned int> assignments(nbSamples);
+      for (bool pruning : {false, true})
+      {
+        search.SetUseTrianglePruning(pruning);
+        search.Assign(samples.data(), nbSamples, assignments.data());
+
+        for (unsigned int s = 0; s < nbSamples; ++s)
+        {
+          // Sequential search with the direct distance
+          unsigned int expected     = 0;
+          double       expectedDist = search.Distance(&samples[s * dimension], 0);
+          for (unsigned int c = 1; c < nbCentroids; ++c)
+          {
+            const double dist = search.Distance(&samples[s * dimension], c);
+            if (dist < expectedDist)
+            {
+              expected     = c;
+              expectedDist = dist;
+            }
+          }
+          if (assignments[s] != expected)
+          {
+            if (nbErrors < 10)
+            {
+              std::cout << "Sample " << s << " (" << nbCentroids << " centroids, dimension " << dimension << ", pruning " << pruning << "): got "
+                        << assignments[s] << ", expected " << expected << std::endl;
+            }
+            ++nbErrors;
+          }
+        }
+      }
+    }
+  }
+
+  if (nbErrors > 0)
+  {
+    std::cout << nbErrors << " wrong assignments" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
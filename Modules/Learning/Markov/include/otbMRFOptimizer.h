@@ -71,6 +71,22 @@ public:
 
   virtual bool Compute(double deltaEnergy) = 0;
 
+  /** Create a new optimizer of the same type and with the same parameters.
+   * It is used to give each thread of the parallel sweep of the
+   * otb::MarkovRandomFieldFilter its own optimizer. Optimizers drawing
+   * random values reimplement it to seed the random generator of the copy. */
+  virtual Pointer CreateThreadCopy(unsigned int itkNotUsed(seed)) const
+  {
+    Pointer copy = dynamic_cast<Self*>(this->CreateAnother().GetPointer());
+    if (copy.IsNull())
+    {
+      itkExceptionMacro(<< "Unable to create a copy of the optimizer");
+    }
+    copy->m_NumberOfParameters = m_NumberOfParameters;
+    copy->m_Parameters         = m_Parameters;
+    return copy;
+  }
+
 protected:
   MRFOptimizer() : m_NumberOfParameters(1), m_Parameters(1)
   {
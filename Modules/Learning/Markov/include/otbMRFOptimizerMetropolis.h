@@ -92,6 +92,16 @@ public:
     return false;
   }
 
+  /** The copy has its own random generator, seeded with the given value */
+  Superclass::Pointer CreateThreadCopy(unsigned int seed) const override
+  {
+    Superclass::Pointer copy    = Superclass::CreateThreadCopy(seed);
+    Self*               copyPtr = static_cast<Self*>(copy.GetPointer());
+    copyPtr->m_Generator        = RandomGeneratorType::New();
+    copyPtr->m_Generator->SetSeed(seed);
+    return copy;
+  }
+
   /** Methods to cancel random effects.*/
   void InitializeSeed(int seed)
   {
@@ -81,6 +81,25 @@ public:
 
   virtual int Compute(const InputImageNeighborhoodIterator& itData, const LabelledImageNeighborhoodIterator& itRegul) = 0;
 
+  /** Create a new sampler of the same type, with the same parameters and
+   * sharing the same energies. It is used to give each thread of the
+   * parallel sweep of the otb::MarkovRandomFieldFilter its own sampler.
+   * Samplers drawing random values reimplement it to seed the random
+   * generator of the copy. */
+  virtual Pointer CreateThreadCopy(unsigned int itkNotUsed(seed)) const
+  {
+    Pointer copy = dynamic_cast<Self*>(this->CreateAnother().GetPointer());
+    if (copy.IsNull())
+    {
+      itkExceptionMacro(<< "Unable to create a copy of the sampler");
+    }
+    copy->SetNumberOfClasses(m_NumberOfClasses);
+    copy->SetLambda(m_Lambda);
+    copy->SetEnergyRegularization(m_EnergyRegularization);
+    copy->SetEnergyFidelity(m_EnergyFidelity);
+    return copy;
+  }
+
 protected:
   unsigned int m_NumberOfClasses;
   double       m_EnergyBefore;
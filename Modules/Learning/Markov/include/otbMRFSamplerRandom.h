@@ -79,6 +79,16 @@ public:
     return 0;
   }
 
+  /** The copy has its own random generator, seeded with the given value */
+  typename Superclass::Pointer CreateThreadCopy(unsigned int seed) const override
+  {
+    typename Superclass::Pointer copy    = Superclass::CreateThreadCopy(seed);
+    Self*                        copyPtr = static_cast<Self*>(copy.GetPointer());
+    copyPtr->m_Generator                 = RandomGeneratorType::New();
+    copyPtr->m_Generator->SetSeed(seed);
+    return copy;
+  }
+
   /** Methods to cancel random effects.*/
   void InitializeSeed(int seed)
   {
@@ -234,6 +234,28 @@ public:
   itkSetMacro(Lambda, double);
   itkGetMacro(Lambda, double);
 
+  /** Set/Get the multi-threaded sweep mode. When on, the pixels are
+   * visited color by color, according to a coloring of the image grid
+   * with period (radius + 1) along each dimension: two pixels of the same
+   * color never belong to each other neighborhood, so that they can be
+   * updated concurrently. Each thread uses its own copy of the sampler and
+   * of the optimizer (see MRFSampler::CreateThreadCopy()). The visiting
+   * order differs from the raster scan, so the results are not identical
+   * to the single-threaded mode. Default is off. */
+  itkSetMacro(ParallelSweep, bool);
+  itkGetMacro(ParallelSweep, bool);
+  itkBooleanMacro(ParallelSweep);
+
+  /** Set/Get the size of the input tiles used in streamed mode. When all
+   * dimensions are non null, the input image is never requested as a
+   * whole: each iteration requests it tile by tile, padded with the
+   * neighborhood radius (the halo), and only the labelled image is held
+   * entirely in memory. Labels of the halo are read from the labelled
+   * image, so that they are always up to date with the previous tiles.
+   * Default is a null size (the whole input image is requested once). */
+  itkSetMacro(StreamingTileSize, SizeType);
+  itkGetConstReferenceMacro(StreamingTileSize, SizeType);
+
   /** Set the neighborhood radius */
   void SetNeighborhoodRadius(const NeighborhoodRadiusType&);
 
@@ -361,6 +383,49 @@ protected:
 
   virtual void MinimizeOnce();
 
+  /** Apply one sweep on the given region, either in raster order or in
+   * parallel color by color */
+  virtual void SweepRegion(const LabelledImageRegionType& region);
+
+  /** Apply the sweep of one color on the part of the region assigned to
+   * the thread */
+  virtual void ThreadedSweep(const LabelledImageRegionType& region, unsigned int color, itk::ThreadIdType threadId);
+
+  /** Request the input image on the tile padded by the neighborhood radius */
+  void UpdateInputTile(const LabelledImageRegionType& tile);
+
+  /** Return true if the input image is requested tile by tile */
+  bool IsInputStreamed() const;
+
+  /** Color of a pixel in the parallel sweep */
+  unsigned int GetColor(const LabelledImageIndexType& index) const;
+
+  /** Number of colors needed in the parallel sweep */
+  unsigned int GetNumberOfColors() const;
+
+  /** Static function used as a "callback" by the MultiThreader */
+  static ITK_THREAD_RETURN_TYPE SweepThreaderCallback(void* arg);
+
+  /** Internal structure used for passing the sweep parameters to the threads */
+  struct SweepThreadStruct
+  {
+    Pointer                 Filter;
+    LabelledImageRegionType Region;
+    unsigned int            Color;
+  };
+
+  bool     m_ParallelSweep;
+  SizeType m_StreamingTileSize;
+
+  /** Tiles of the labelled image processed in streamed mode */
+  std::vector<LabelledImageRegionType> m_Tiles;
+
+  /** Per-thread samplers, optimizers and accumulators */
+  std::vector<SamplerPointer>   m_ThreadSamplers;
+  std::vector<OptimizerPointer> m_ThreadOptimizers;
+  std::vector<int>              m_ThreadErrorCounter;
+  std::vector<double>           m_ThreadDeltaEnergy;
+
 private:
 }; // class MarkovRandomFieldFilter
 
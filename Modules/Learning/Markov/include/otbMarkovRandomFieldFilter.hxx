@@ -39,8 +39,11 @@ MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MarkovRandomFieldFilter(
     m_NumberOfIterations(0),
     m_Lambda(1.0),
     m_ExternalClassificationSet(false),
-    m_StopCondition(MaximumNumberOfIterations)
+    m_StopCondition(MaximumNumberOfIterations),
+    m_ParallelSweep(false)
 {
+  m_StreamingTileSize.Fill(0);
+
   m_Generator = RandomGeneratorType::GetInstance();
   m_Generator->SetSeed();
 
@@ -52,6 +55,7 @@ MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MarkovRandomFieldFilter(
     throw itk::ExceptionObject(__FILE__, __LINE__, msg.str(), ITK_LOCATION);
   }
   m_InputImageNeighborhoodRadius.Fill(m_NeighborhoodRadius);
+  m_LabelledImageNeighborhoodRadius.Fill(m_NeighborhoodRadius);
   //     m_MRFNeighborhoodWeight.resize(0);
   //     m_NeighborInfluence.resize(0);
   //     m_DummyVector.resize(0);
@@ -101,6 +105,10 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::PrintSelf(std::ostr
   os << indent << " Number of iterations: " << m_NumberOfIterations << std::endl;
 
   os << indent << " Lambda: " << m_Lambda << std::endl;
+
+  os << indent << " Parallel sweep: " << m_ParallelSweep << std::endl;
+
+  os << indent << " Streaming tile size: " << m_StreamingTileSize << std::endl;
 } // end PrintSelf
 
 /**
@@ -113,7 +121,20 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GenerateInputReques
   // to be at the size of the output requested region
   InputImagePointer  inputPtr  = const_cast<InputImageType*>(this->GetInput());
   OutputImagePointer outputPtr = this->GetOutput();
-  inputPtr->SetRequestedRegion(outputPtr->GetRequestedRegion());
+
+  if (this->IsInputStreamed())
+  {
+    // The input tiles are requested one by one during the iterations
+    InputImageRegionType emptyRegion = inputPtr->GetLargestPossibleRegion();
+    SizeType             emptySize;
+    emptySize.Fill(0);
+    emptyRegion.SetSize(emptySize);
+    inputPtr->SetRequestedRegion(emptyRegion);
+  }
+  else
+  {
+    inputPtr->SetRequestedRegion(outputPtr->GetRequestedRegion());
+  }
 }
 
 /**
@@ -258,7 +279,8 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::Initialize()
 
   m_ImageDeltaEnergy = 0.0;
 
-  InputImageSizeType inputImageSize = this->GetInput()->GetBufferedRegion().GetSize();
+  // The input buffer only holds one tile in streamed mode
+  InputImageSizeType inputImageSize = this->GetOutput()->GetRequestedRegion().GetSize();
 
   //---------------------------------------------------------------------
   // Get the number of valid pixels in the output MRF image
@@ -300,6 +322,58 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::Initialize()
   m_Sampler->SetEnergyRegularization(m_EnergyRegularization);
   m_Sampler->SetEnergyFidelity(m_EnergyFidelity);
   m_Sampler->SetNumberOfClasses(m_NumberOfClasses);
+
+  // Tiles of the streamed mode
+  m_Tiles.clear();
+  if (this->IsInputStreamed())
+  {
+    const LabelledImageRegionType largestRegion = this->GetOutput()->GetLargestPossibleRegion();
+    LabelledImageIndexType        tileIndex     = largestRegion.GetIndex();
+    bool                          lastTile      = false;
+    while (!lastTile)
+    {
+      LabelledImageRegionType tile(tileIndex, m_StreamingTileSize);
+      tile.Crop(largestRegion);
+      m_Tiles.push_back(tile);
+
+      // Move to the next tile, along the first dimension first
+      unsigned int dim = 0;
+      for (; dim < ClassifiedImageDimension; ++dim)
+      {
+        tileIndex[dim] += m_StreamingTileSize[dim];
+        if (tileIndex[dim] < largestRegion.GetIndex()[dim] + static_cast<IndexValueType>(largestRegion.GetSize()[dim]))
+        {
+          break;
+        }
+        tileIndex[dim] = largestRegion.GetIndex()[dim];
+      }
+      lastTile = (dim == ClassifiedImageDimension);
+    }
+  }
+
+  // Each thread of the parallel sweep gets its own sampler and optimizer
+  m_ThreadSamplers.clear();
+  m_ThreadOptimizers.clear();
+  if (m_ParallelSweep)
+  {
+    const unsigned int nbThreads = this->GetNumberOfThreads();
+
+    // Seeds are drawn before creating the copies, as their constructors may
+    // reset the shared random generator
+    std::vector<unsigned int> seeds(2 * nbThreads);
+    for (auto& seed : seeds)
+    {
+      seed = m_Generator->GetIntegerVariate();
+    }
+
+    for (unsigned int i = 0; i < nbThreads; ++i)
+    {
+      m_ThreadSamplers.push_back(m_Sampler->CreateThreadCopy(seeds[2 * i]));
+      m_ThreadOptimizers.push_back(m_Optimizer->CreateThreadCopy(seeds[2 * i + 1]));
+    }
+    m_ThreadErrorCounter.assign(nbThreads, 0);
+    m_ThreadDeltaEnergy.assign(nbThreads, 0.0);
+  }
 }
 
 /**
@@ -350,25 +424,183 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::ApplyMarkovRandomFi
 template <class TInputImage, class TClassifiedImage>
 void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MinimizeOnce()
 {
-  LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, this->GetOutput(), this->GetOutput()->GetLargestPossibleRegion());
-  InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), this->GetInput()->GetLargestPossibleRegion());
   m_ErrorCounter = 0;
 
+  if (this->IsInputStreamed())
+  {
+    for (const auto& tile : m_Tiles)
+    {
+      this->UpdateInputTile(tile);
+      this->SweepRegion(tile);
+    }
+  }
+  else
+  {
+    this->SweepRegion(this->GetOutput()->GetLargestPossibleRegion());
+  }
+}
+
+/**
+*Apply the MRF image filter once on a region
+*/
+template <class TInputImage, class TClassifiedImage>
+void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::SweepRegion(const LabelledImageRegionType& region)
+{
+  if (!m_ParallelSweep)
+  {
+    LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, this->GetOutput(), region);
+    InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), region);
+
+    for (labelledIterator.GoToBegin(), dataIterator.GoToBegin(); !labelledIterator.IsAtEnd(); ++labelledIterator, ++dataIterator)
+    {
+
+      LabelledImagePixelType value;
+      bool                   changeValueBool;
+      m_Sampler->Compute(dataIterator, labelledIterator);
+      value           = m_Sampler->GetValue();
+      changeValueBool = m_Optimizer->Compute(m_Sampler->GetDeltaEnergy());
+      if (changeValueBool)
+      {
+        labelledIterator.SetCenterPixel(value);
+        ++m_ErrorCounter;
+        m_ImageDeltaEnergy += m_Sampler->GetDeltaEnergy();
+      }
+    }
+    return;
+  }
+
+  // Pixels of a given color are independent: each color is processed in
+  // parallel, the colors one after the other
+  SweepThreadStruct str;
+  str.Filter = this;
+  str.Region = region;
+
+  const unsigned int nbSplits = this->GetImageRegionSplitter()->GetNumberOfSplits(region, this->GetNumberOfThreads());
+  this->GetMultiThreader()->SetNumberOfThreads(nbSplits);
+  this->GetMultiThreader()->SetSingleMethod(Self::SweepThreaderCallback, &str);
+
+  for (unsigned int color = 0; color < this->GetNumberOfColors(); ++color)
+  {
+    str.Color = color;
+    this->GetMultiThreader()->SingleMethodExecute();
+  }
+
+  for (unsigned int i = 0; i < m_ThreadErrorCounter.size(); ++i)
+  {
+    m_ErrorCounter += m_ThreadErrorCounter[i];
+    m_ImageDeltaEnergy += m_ThreadDeltaEnergy[i];
+    m_ThreadErrorCounter[i] = 0;
+    m_ThreadDeltaEnergy[i]  = 0.0;
+  }
+}
+
+template <class TInputImage, class TClassifiedImage>
+void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::ThreadedSweep(const LabelledImageRegionType& region, unsigned int color,
+                                                                           itk::ThreadIdType threadId)
+{
+  SamplerType*   sampler   = m_ThreadSamplers[threadId];
+  OptimizerType* optimizer = m_ThreadOptimizers[threadId];
+
+  LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, this->GetOutput(), region);
+  InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), region);
+
+  int    errorCounter = 0;
+  double deltaEnergy  = 0.0;
+
   for (labelledIterator.GoToBegin(), dataIterator.GoToBegin(); !labelledIterator.IsAtEnd(); ++labelledIterator, ++dataIterator)
   {
+    if (this->GetColor(labelledIterator.GetIndex()) != color)
+    {
+      continue;
+    }
+
+    sampler->Compute(dataIterator, labelledIterator);
+    if (optimizer->Compute(sampler->GetDeltaEnergy()))
+    {
+      labelledIterator.SetCenterPixel(sampler->GetValue());
+      ++errorCounter;
+      deltaEnergy += sampler->GetDeltaEnergy();
+    }
+  }
+
+  m_ThreadErrorCounter[threadId] += errorCounter;
+  m_ThreadDeltaEnergy[threadId] += deltaEnergy;
+}
+
+template <class TInputImage, class TClassifiedImage>
+ITK_THREAD_RETURN_TYPE MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::SweepThreaderCallback(void* arg)
+{
+  SweepThreadStruct* str = (SweepThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+
+  itk::ThreadIdType threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  itk::ThreadIdType threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+
+  LabelledImageRegionType splitRegion = str->Region;
+  const unsigned int      total       = str->Filter->GetImageRegionSplitter()->GetSplit(threadId, threadCount, splitRegion);
+
+  if (threadId < total)
+  {
+    str->Filter->ThreadedSweep(splitRegion, str->Color, threadId);
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage, class TClassifiedImage>
+void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::UpdateInputTile(const LabelledImageRegionType& tile)
+{
+  InputImagePointer inputPtr = const_cast<InputImageType*>(this->GetInput());
+
+  InputImageRegionType inputRegion = tile;
+  inputRegion.PadByRadius(m_InputImageNeighborhoodRadius);
+  inputRegion.Crop(inputPtr->GetLargestPossibleRegion());
+
+  inputPtr->SetRequestedRegion(inputRegion);
+  inputPtr->PropagateRequestedRegion();
+  inputPtr->UpdateOutputData();
+}
+
+template <class TInputImage, class TClassifiedImage>
+bool MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::IsInputStreamed() const
+{
+  for (unsigned int dim = 0; dim < InputImageDimension; ++dim)
+  {
+    if (m_StreamingTileSize[dim] == 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
 
-    LabelledImagePixelType value;
-    bool                   changeValueBool;
-    m_Sampler->Compute(dataIterator, labelledIterator);
-    value           = m_Sampler->GetValue();
-    changeValueBool = m_Optimizer->Compute(m_Sampler->GetDeltaEnergy());
-    if (changeValueBool)
+template <class TInputImage, class TClassifiedImage>
+unsigned int MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GetColor(const LabelledImageIndexType& index) const
+{
+  unsigned int color  = 0;
+  unsigned int stride = 1;
+  for (unsigned int dim = 0; dim < ClassifiedImageDimension; ++dim)
+  {
+    const IndexValueType period = m_LabelledImageNeighborhoodRadius[dim] + 1;
+    IndexValueType       pos    = index[dim] % period;
+    if (pos < 0)
     {
-      labelledIterator.SetCenterPixel(value);
-      ++m_ErrorCounter;
-      m_ImageDeltaEnergy += m_Sampler->GetDeltaEnergy();
+      pos += period;
     }
+    color += static_cast<unsigned int>(pos) * stride;
+    stride *= period;
+  }
+  return color;
+}
+
+template <class TInputImage, class TClassifiedImage>
+unsigned int MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::GetNumberOfColors() const
+{
+  unsigned int nbColors = 1;
+  for (unsigned int dim = 0; dim < ClassifiedImageDimension; ++dim)
+  {
+    nbColors *= m_LabelledImageNeighborhoodRadius[dim] + 1;
   }
+  return nbColors;
 }
 
 } // namespace otb
@@ -30,6 +30,8 @@
 #include "otbMRFEnergyGaussianClassification.h"
 #include "otbMRFOptimizerMetropolis.h"
 #include "otbMRFSamplerRandom.h"
+#include "otbMRFSamplerMAP.h"
+#include "otbMRFOptimizerICM.h"
 
 int otbMarkovRandomFieldFilter(int itkNotUsed(argc), char* argv[])
 {
@@ -109,3 +111,79 @@ int otbMarkovRandomFieldFilter(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbMarkovRandomFieldFilterParallelSweep(int itkNotUsed(argc), char* argv[])
+{
+  const unsigned int Dimension = 2;
+
+  typedef double        InternalPixelType;
+  typedef unsigned char LabelledPixelType;
+  typedef otb::Image<InternalPixelType, Dimension> InputImageType;
+  typedef otb::Image<LabelledPixelType, Dimension> LabelledImageType;
+  typedef otb::ImageFileReader<InputImageType>    ReaderType;
+  typedef otb::ImageFileWriter<LabelledImageType> WriterType;
+
+  typedef otb::MarkovRandomFieldFilter<InputImageType, LabelledImageType> MarkovRandomFieldFilterType;
+  typedef otb::MRFSamplerMAP<InputImageType, LabelledImageType>           SamplerType;
+  typedef otb::MRFOptimizerICM OptimizerType;
+  typedef otb::MRFEnergyPotts<LabelledImageType, LabelledImageType>               EnergyRegularizationType;
+  typedef otb::MRFEnergyGaussianClassification<InputImageType, LabelledImageType> EnergyFidelityType;
+
+  const char* inputFilename = argv[1];
+
+  unsigned int nClass = 4;
+
+  EnergyFidelityType::Pointer        energyFidelity = EnergyFidelityType::New();
+  EnergyFidelityType::ParametersType parameters;
+  energyFidelity->SetNumberOfParameters(2 * nClass);
+  parameters.SetSize(energyFidelity->GetNumberOfParameters());
+  parameters[0] = 10.0;  // Class 0 mean
+  parameters[1] = 10.0;  // Class 0 stdev
+  parameters[2] = 80.0;  // Class 1 mean
+  parameters[3] = 10.0;  // Class 1 stdev
+  parameters[4] = 150.0; // Class 2 mean
+  parameters[5] = 10.0;  // Class 2 stdev
+  parameters[6] = 220.0; // Class 3 mean
+  parameters[7] = 10.0;  // Class 3 stde
+  energyFidelity->SetParameters(parameters);
+
+  MarkovRandomFieldFilterType::SizeType tileSize;
+  tileSize.Fill(atoi(argv[4]));
+
+  // The same tiled sweep is computed with one thread and with the default
+  // number of threads: with a deterministic sampler and optimizer, the
+  // results must be identical.
+  for (unsigned int run = 0; run < 2; ++run)
+  {
+    ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName(inputFilename);
+
+    MarkovRandomFieldFilterType::Pointer markovFilter = MarkovRandomFieldFilterType::New();
+    markovFilter->SetNumberOfClasses(nClass);
+    markovFilter->SetMaximumNumberOfIterations(atoi(argv[5]));
+    markovFilter->SetErrorTolerance(0.0);
+    markovFilter->SetLambda(1.0);
+    markovFilter->SetNeighborhoodRadius(1);
+    markovFilter->SetEnergyRegularization(EnergyRegularizationType::New());
+    markovFilter->SetEnergyFidelity(energyFidelity);
+    markovFilter->SetOptimizer(OptimizerType::New());
+    markovFilter->SetSampler(SamplerType::New());
+    markovFilter->ParallelSweepOn();
+    markovFilter->SetStreamingTileSize(tileSize);
+    if (run == 0)
+    {
+      markovFilter->SetNumberOfThreads(1);
+    }
+    markovFilter->SetInput(reader->GetOutput());
+
+    // Same random starting point for both runs
+    markovFilter->InitializeSeed(2);
+
+    WriterType::Pointer writer = WriterType::New();
+    writer->SetFileName(argv[2 + run]);
+    writer->SetInput(markovFilter->GetOutput());
+    writer->Update();
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -25,6 +25,7 @@ void RegisterTests()
   REGISTER_TEST(otbMRFEnergyFisherClassification);
   REGISTER_TEST(otbMRFSamplerRandom);
   REGISTER_TEST(otbMarkovRandomFieldFilter);
+  REGISTER_TEST(otbMarkovRandomFieldFilterParallelSweep);
   REGISTER_TEST(otbMRFSamplerMAP);
   REGISTER_TEST(otbMRFEnergyGaussian);
   REGISTER_TEST(otbMRFOptimizerMetropolis);
@@ -81,6 +81,7 @@ public:
   typedef typename MapType::IndexType      IndexType;
   typedef typename MapType::SizeType       SizeType;
   typedef typename MapType::RegionType     RegionType;
+  typedef typename MapType::OffsetType     OffsetType;
   typedef typename MapType::Pointer        MapPointerType;
 
 protected:
@@ -121,6 +122,21 @@ protected:
   {
     Superclass::Step(currentIteration);
   }
+
+  typedef typename Superclass::NeighborType     NeighborType;
+  typedef typename Superclass::NeighborListType NeighborListType;
+
+  /**
+  * Elliptic neighborhood of a winner in batch mode.
+  * \param radius The radius of the neighbourhood,
+  * \param neighbors The output list of offsets and weights.
+  */
+  void GetNeighborhood(const SizeType& radius, NeighborListType& neighbors) const override;
+  /** The map is a torus */
+  bool IsPeriodic() const override
+  {
+    return true;
+  }
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override
   {
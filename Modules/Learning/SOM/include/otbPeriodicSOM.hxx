@@ -97,6 +97,47 @@ void PeriodicSOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoo
   }
 }
 
+/**
+ * Elliptic neighborhood of a winner in batch mode, weighted as in UpdateMap().
+ * \param radius The radius of the neighbourhood,
+ * \param neighbors The output list of offsets and weights.
+ */
+template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, class TSOMNeighborhoodBehaviorFunctor>
+void PeriodicSOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::GetNeighborhood(const SizeType& radius,
+                                                                                                                   NeighborListType& neighbors) const
+{
+  unsigned int i, j;
+
+  neighbors.clear();
+
+  // Same offsets, in the same order, as the neighborhood iterator of UpdateMap()
+  unsigned long size = 1;
+  for (j = 0; j < MapType::ImageDimension; ++j)
+    size *= 2 * radius[j] + 1;
+
+  for (i = 0; i < size; ++i)
+  {
+    OffsetType    offset;
+    unsigned long remainder = i;
+    for (j = 0; j < MapType::ImageDimension; ++j)
+    {
+      offset[j] = static_cast<typename OffsetType::OffsetValueType>(remainder % (2 * radius[j] + 1)) -
+                  static_cast<typename OffsetType::OffsetValueType>(radius[j]);
+      remainder /= 2 * radius[j] + 1;
+    }
+
+    // The neighborhood is of elliptic shape
+    double theDistance = itk::NumericTraits<double>::Zero;
+    for (j = 0; j < MapType::ImageDimension; ++j)
+      theDistance += pow(static_cast<double>(offset[j]), 2.0) / pow(static_cast<double>(radius[j]), 2.0);
+
+    if (theDistance <= 1.0)
+    {
+      neighbors.push_back(NeighborType(offset, 1.0 / (1.0 + theDistance)));
+    }
+  }
+}
+
 } // end of namespace otb
 
 #endif
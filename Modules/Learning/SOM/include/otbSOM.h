@@ -28,6 +28,8 @@
 #include "otbCzihoSOMLearningBehaviorFunctor.h"
 #include "otbCzihoSOMNeighborhoodBehaviorFunctor.h"
 
+#include <vector>
+
 namespace otb
 {
 /**
@@ -48,6 +50,13 @@ namespace otb
  * The SOMMap produced as output can be either initialized with a constant custom value or randomly
  * generated following a normal law. The seed for the random initialization can be modified.
  *
+ * In batch mode, the winning neurons of all the samples (or of a mini-batch of samples) are
+ * searched in parallel against a frozen copy of the map, then each neuron is moved once towards
+ * the neighborhood-weighted mean of the samples:
+ * \f[ w_n \leftarrow w_n + \beta \frac{\sum_s h_{ns} (x_s - w_n)}{\sum_s h_{ns}} \f]
+ * where the weights \f$ h_{ns} \f$ are the ones of the sequential update. The winners are searched
+ * with the squared euclidean distance, ignoring the missing components of the samples.
+ *
  * \sa SOMMap
  * \sa SOMActivationBuilder
  * \sa CzihoSOMLearningBehaviorFunctor
@@ -79,6 +88,7 @@ public:
   typedef typename MapType::IndexType      IndexType;
   typedef typename MapType::SizeType       SizeType;
   typedef typename MapType::RegionType     RegionType;
+  typedef typename MapType::OffsetType     OffsetType;
   typedef typename MapType::Pointer        MapPointerType;
 
   typedef TSOMLearningBehaviorFunctor     SOMLearningBehaviorFunctorType;
@@ -109,6 +119,17 @@ public:
   itkGetObjectMacro(ListSample, ListSampleType);
   itkSetObjectMacro(ListSample, ListSampleType);
 
+  /** Set/Get the batch training mode (off by default) */
+  itkSetMacro(BatchMode, bool);
+  itkGetMacro(BatchMode, bool);
+  itkBooleanMacro(BatchMode);
+
+  /** Set/Get the number of samples used for each update of the map in
+   * batch mode. 0 (default) means all the samples, i.e. one update per
+   * iteration. */
+  itkSetMacro(BatchSize, unsigned int);
+  itkGetMacro(BatchSize, unsigned int);
+
   void SetBetaFunctor(const SOMLearningBehaviorFunctorType& functor)
   {
     m_BetaFunctor = functor;
@@ -141,6 +162,41 @@ protected:
    * Step one iteration.
    */
   virtual void Step(unsigned int currentIteration);
+
+  /** Offset of a neuron from the winner and its weight in the batch update */
+  typedef std::pair<OffsetType, double> NeighborType;
+  typedef std::vector<NeighborType>     NeighborListType;
+
+  /**
+   * Step one iteration in batch mode.
+   */
+  virtual void BatchStep(unsigned int currentIteration);
+  /**
+   * Neurons updated around a winner in batch mode, with their weights. They
+   * must match the ones of UpdateMap().
+   * \param radius The radius of the neighbourhood,
+   * \param neighbors The output list of offsets and weights.
+   */
+  virtual void GetNeighborhood(const SizeType& radius, NeighborListType& neighbors) const;
+  /** Whether the map is considered as a torus in batch mode */
+  virtual bool IsPeriodic() const
+  {
+    return false;
+  }
+  /** Whether a sample component is missing: it is then ignored in batch mode */
+  virtual bool IsMissingComponent(const ValueType& itkNotUsed(value)) const
+  {
+    return false;
+  }
+  /** Search the winners of the part of the current batch assigned to a thread */
+  virtual void ThreadedFindWinners(itk::ThreadIdType threadId, itk::ThreadIdType threadCount);
+  /** Static function used as a "callback" by the MultiThreader */
+  static ITK_THREAD_RETURN_TYPE BatchThreaderCallback(void* arg);
+  /** Internal structure used for passing the filter to the threads */
+  struct BatchThreadStruct
+  {
+    Pointer Filter;
+  };
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -171,6 +227,19 @@ private:
   SOMLearningBehaviorFunctorType m_BetaFunctor;
   /** Behavior of the Neighborhood extent */
   SOMNeighborhoodBehaviorFunctorType m_NeighborhoodSizeFunctor;
+  /** Batch training mode */
+  bool m_BatchMode;
+  /** Number of samples of a mini-batch (0 for all the samples) */
+  unsigned int m_BatchSize;
+  /** Frozen copy of the neuron weights during a batch update */
+  std::vector<double> m_NeuronWeights;
+  /** Squared norms of the neurons of the frozen copy */
+  std::vector<double> m_NeuronSquaredNorms;
+  /** Winners (linear offset in the map) of the samples of the current batch */
+  std::vector<unsigned long> m_Winners;
+  /** Range of samples of the current batch */
+  unsigned long m_BatchBegin;
+  unsigned long m_BatchEnd;
 };
 } // end namespace otb
 
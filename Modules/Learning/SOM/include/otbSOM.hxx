@@ -28,6 +28,12 @@
 #include "otbMacro.h"
 #include "itkImageRegionIterator.h"
 #include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkMultiThreader.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <limits>
 
 namespace otb
 {
@@ -49,6 +55,10 @@ SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunc
   m_MaxWeight  = static_cast<ValueType>(128.0);
   m_RandomInit = false;
   m_Seed       = 123574651;
+  m_BatchMode  = false;
+  m_BatchSize  = 0;
+  m_BatchBegin = 0;
+  m_BatchEnd   = 0;
 }
 /**
  * Destructor
@@ -122,6 +132,12 @@ void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehavio
 template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, class TSOMNeighborhoodBehaviorFunctor>
 void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::Step(unsigned int currentIteration)
 {
+  if (m_BatchMode)
+  {
+    this->BatchStep(currentIteration);
+    return;
+  }
+
   // Compute the new learning coefficient
   double newBeta = m_BetaFunctor(currentIteration, m_NumberOfIterations, m_BetaInit, m_BetaEnd);
 
@@ -135,6 +151,281 @@ void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehavio
     UpdateMap(it.GetMeasurementVector(), newBeta, newSize);
   }
 }
+/**
+ * Neighborhood of a winner in batch mode: the square window of UpdateMap(),
+ * weighted by 1 / (1 + distance to the winner).
+ */
+template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, class TSOMNeighborhoodBehaviorFunctor>
+void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::GetNeighborhood(const SizeType& radius,
+                                                                                                            NeighborListType& neighbors) const
+{
+  neighbors.clear();
+
+  RegionType window;
+  IndexType  windowIndex;
+  SizeType   windowSize;
+  for (unsigned int i = 0; i < MapType::ImageDimension; ++i)
+  {
+    windowIndex[i] = -static_cast<typename IndexType::IndexValueType>(radius[i]);
+    windowSize[i]  = 2 * radius[i] + 1;
+  }
+  window.SetIndex(windowIndex);
+  window.SetSize(windowSize);
+
+  for (unsigned long n = 0; n < window.GetNumberOfPixels(); ++n)
+  {
+    OffsetType offset;
+    unsigned long remainder = n;
+    double        squaredDistance = 0.;
+    for (unsigned int i = 0; i < MapType::ImageDimension; ++i)
+    {
+      offset[i] = windowIndex[i] + static_cast<typename OffsetType::OffsetValueType>(remainder % windowSize[i]);
+      remainder /= windowSize[i];
+      squaredDistance += static_cast<double>(offset[i] * offset[i]);
+    }
+    neighbors.push_back(NeighborType(offset, 1. / (1. + std::sqrt(squaredDistance))));
+  }
+}
+/**
+ * Step one iteration in batch mode.
+ */
+template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, class TSOMNeighborhoodBehaviorFunctor>
+void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::BatchStep(unsigned int currentIteration)
+{
+  // Compute the new learning coefficient
+  double newBeta = m_BetaFunctor(currentIteration, m_NumberOfIterations, m_BetaInit, m_BetaEnd);
+
+  // Compute the new neighborhood size
+  SizeType newSize = m_NeighborhoodSizeFunctor(currentIteration, m_NumberOfIterations, m_NeighborhoodSizeInit);
+
+  otbMsgDebugMacro(<< "Beta: " << newBeta << ", radius: " << newSize);
+
+  typedef itk::ImageRegionIterator<MapType> IteratorType;
+
+  MapPointerType     map          = this->GetOutput(0);
+  const RegionType   mapRegion    = map->GetLargestPossibleRegion();
+  const unsigned int nbNeurons    = mapRegion.GetNumberOfPixels();
+  const unsigned int nbComponents = map->GetNumberOfComponentsPerPixel();
+  const unsigned long nbSamples   = m_ListSample->Size();
+  const unsigned long batchSize   = (m_BatchSize == 0 || m_BatchSize > nbSamples) ? nbSamples : m_BatchSize;
+  const bool          periodic    = this->IsPeriodic();
+
+  NeighborListType neighbors;
+  this->GetNeighborhood(newSize, neighbors);
+
+  m_NeuronWeights.resize(nbNeurons * nbComponents);
+  m_NeuronSquaredNorms.resize(nbNeurons);
+  m_Winners.resize(batchSize);
+
+  // Sums and counts of the samples won by each neuron, and neighborhood
+  // weighted reductions of them for each neuron
+  std::vector<double> sums(nbNeurons * nbComponents), counts(nbNeurons * nbComponents);
+  std::vector<double> numerators(nbNeurons * nbComponents), denominators(nbNeurons * nbComponents);
+  std::vector<bool>   hit(nbNeurons);
+
+  for (m_BatchBegin = 0; m_BatchBegin < nbSamples; m_BatchBegin += batchSize)
+  {
+    m_BatchEnd = std::min(m_BatchBegin + batchSize, nbSamples);
+
+    // Frozen copy of the map, in raster order
+    IteratorType mapIt(map, mapRegion);
+    unsigned int n = 0;
+    for (mapIt.GoToBegin(); !mapIt.IsAtEnd(); ++mapIt, ++n)
+    {
+      const NeuronType neuron = mapIt.Get();
+      double           norm   = 0.;
+      for (unsigned int j = 0; j < nbComponents; ++j)
+      {
+        const double w                      = static_cast<double>(neuron[j]);
+        m_NeuronWeights[n * nbComponents + j] = w;
+        norm += w * w;
+      }
+      m_NeuronSquaredNorms[n] = norm;
+    }
+
+    // Search the winners in parallel
+    BatchThreadStruct str;
+    str.Filter = this;
+    this->GetMultiThreader()->SetNumberOfThreads(this->GetNumberOfThreads());
+    this->GetMultiThreader()->SetSingleMethod(Self::BatchThreaderCallback, &str);
+    this->GetMultiThreader()->SingleMethodExecute();
+
+    // Accumulate the samples on their winners
+    std::fill(sums.begin(), sums.end(), 0.);
+    std::fill(counts.begin(), counts.end(), 0.);
+    std::fill(hit.begin(), hit.end(), false);
+    for (unsigned long s = m_BatchBegin; s < m_BatchEnd; ++s)
+    {
+      const typename ListSampleType::MeasurementVectorType& sample = m_ListSample->GetMeasurementVector(s);
+      const unsigned long                                   winner = m_Winners[s - m_BatchBegin];
+      hit[winner]                                                  = true;
+      for (unsigned int j = 0; j < nbComponents; ++j)
+      {
+        if (!this->IsMissingComponent(static_cast<ValueType>(sample[j])))
+        {
+          sums[winner * nbComponents + j] += static_cast<double>(sample[j]);
+          counts[winner * nbComponents + j] += 1.;
+        }
+      }
+    }
+
+    // Spread the accumulations over the neighborhoods of the winners
+    std::fill(numerators.begin(), numerators.end(), 0.);
+    std::fill(denominators.begin(), denominators.end(), 0.);
+    for (unsigned long winner = 0; winner < nbNeurons; ++winner)
+    {
+      if (!hit[winner])
+      {
+        continue;
+      }
+      const IndexType winnerIndex = map->ComputeIndex(winner);
+      for (typename NeighborListType::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it)
+      {
+        IndexType index = winnerIndex + it->first;
+        if (periodic)
+        {
+          for (unsigned int i = 0; i < MapType::ImageDimension; ++i)
+          {
+            const typename IndexType::IndexValueType size = static_cast<typename IndexType::IndexValueType>(mapRegion.GetSize()[i]);
+            index[i] = ((index[i] % size) + size) % size;
+          }
+        }
+        else if (!mapRegion.IsInside(index))
+        {
+          continue;
+        }
+        const unsigned long neighbor = map->ComputeOffset(index);
+        for (unsigned int j = 0; j < nbComponents; ++j)
+        {
+          const double count = counts[winner * nbComponents + j];
+          numerators[neighbor * nbComponents + j] +=
+              it->second * (sums[winner * nbComponents + j] - count * m_NeuronWeights[neighbor * nbComponents + j]);
+          denominators[neighbor * nbComponents + j] += it->second * count;
+        }
+      }
+    }
+
+    // Update the map
+    n = 0;
+    for (mapIt.GoToBegin(); !mapIt.IsAtEnd(); ++mapIt, ++n)
+    {
+      NeuronType neuron = mapIt.Get();
+      for (unsigned int j = 0; j < nbComponents; ++j)
+      {
+        const double denominator = denominators[n * nbComponents + j];
+        if (denominator > 0.)
+        {
+          neuron[j] = static_cast<typename NeuronType::ValueType>(m_NeuronWeights[n * nbComponents + j] +
+                                                                   newBeta * numerators[n * nbComponents + j] / denominator);
+        }
+      }
+      mapIt.Set(neuron);
+    }
+  }
+}
+/**
+ * Search the winners of the part of the current batch assigned to a thread.
+ * Samples are processed by blocks so that each neuron of the frozen map is
+ * read once per block: the squared euclidean distance reduces to
+ * ||w||^2 - 2 x.w, ||x||^2 being constant for a given sample. Ties are
+ * broken as in SOMMap::GetWinner(), the last neuron in raster order wins.
+ */
+template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, class TSOMNeighborhoodBehaviorFunctor>
+void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::ThreadedFindWinners(itk::ThreadIdType threadId,
+                                                                                                                itk::ThreadIdType threadCount)
+{
+  const unsigned long batchLength = m_BatchEnd - m_BatchBegin;
+  const unsigned long chunk       = (batchLength + threadCount - 1) / threadCount;
+  const unsigned long begin       = m_BatchBegin + std::min(batchLength, threadId * chunk);
+  const unsigned long end         = m_BatchBegin + std::min(batchLength, (threadId + 1) * chunk);
+
+  const unsigned int nbComponents = m_ListSample->GetMeasurementVectorSize();
+  const unsigned int nbNeurons    = m_NeuronSquaredNorms.size();
+  const unsigned int blockSize    = 64;
+
+  std::vector<double>        block(blockSize * nbComponents);
+  std::vector<bool>          missing(blockSize * nbComponents);
+  std::vector<bool>          hasMissing(blockSize);
+  std::vector<double>        bestDistance(blockSize);
+  std::vector<unsigned long> bestNeuron(blockSize);
+
+  for (unsigned long blockBegin = begin; blockBegin < end; blockBegin += blockSize)
+  {
+    const unsigned int blockLength = static_cast<unsigned int>(std::min<unsigned long>(blockSize, end - blockBegin));
+
+    // Copy the samples of the block in a contiguous buffer
+    for (unsigned int b = 0; b < blockLength; ++b)
+    {
+      const typename ListSampleType::MeasurementVectorType& sample = m_ListSample->GetMeasurementVector(blockBegin + b);
+      hasMissing[b]                                                = false;
+      for (unsigned int j = 0; j < nbComponents; ++j)
+      {
+        missing[b * nbComponents + j] = this->IsMissingComponent(static_cast<ValueType>(sample[j]));
+        hasMissing[b]                 = hasMissing[b] || missing[b * nbComponents + j];
+        block[b * nbComponents + j]   = static_cast<double>(sample[j]);
+      }
+      bestDistance[b] = std::numeric_limits<double>::max();
+      bestNeuron[b]   = 0;
+    }
+
+    for (unsigned int n = 0; n < nbNeurons; ++n)
+    {
+      const double* weights = &m_NeuronWeights[n * nbComponents];
+      for (unsigned int b = 0; b < blockLength; ++b)
+      {
+        const double* x        = &block[b * nbComponents];
+        double        distance = 0.;
+        if (!hasMissing[b])
+        {
+          double dot = 0.;
+          for (unsigned int j = 0; j < nbComponents; ++j)
+          {
+            dot += x[j] * weights[j];
+          }
+          distance = m_NeuronSquaredNorms[n] - 2. * dot;
+        }
+        else
+        {
+          // Missing components are skipped, as in the distances handling them
+          for (unsigned int j = 0; j < nbComponents; ++j)
+          {
+            if (!missing[b * nbComponents + j])
+            {
+              distance += (x[j] - weights[j]) * (x[j] - weights[j]);
+            }
+          }
+        }
+        if (distance <= bestDistance[b])
+        {
+          bestDistance[b] = distance;
+          bestNeuron[b]   = n;
+        }
+      }
+    }
+
+    for (unsigned int b = 0; b < blockLength; ++b)
+    {
+      m_Winners[blockBegin + b - m_BatchBegin] = bestNeuron[b];
+    }
+  }
+}
+/**
+ * Static function used as a "callback" by the MultiThreader.
+ */
+template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, class TSOMNeighborhoodBehaviorFunctor>
+ITK_THREAD_RETURN_TYPE SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::BatchThreaderCallback(void* arg)
+{
+  BatchThreadStruct* str;
+  itk::ThreadIdType  threadId, threadCount;
+
+  threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+  str         = (BatchThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+
+  str->Filter->ThreadedFindWinners(threadId, threadCount);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
 /**
  *  Output information redefinition
  */
@@ -221,6 +512,8 @@ template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, clas
 void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "BatchMode: " << m_BatchMode << std::endl;
+  os << indent << "BatchSize: " << m_BatchSize << std::endl;
 }
 
 } // end namespace otb
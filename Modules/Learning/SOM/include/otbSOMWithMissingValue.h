@@ -103,6 +103,11 @@ protected:
   {
     Superclass::Step(currentIteration);
   }
+  /** Missing components are the ones flagged by the distance */
+  bool IsMissingComponent(const ValueType& value) const override
+  {
+    return DistanceType::IsMissingValue(value);
+  }
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
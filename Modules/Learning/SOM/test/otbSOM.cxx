@@ -95,3 +95,79 @@ int otbSOM(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbSOMBatch(int itkNotUsed(argc), char* argv[])
+{
+  const unsigned int Dimension           = 2;
+  char*              inputFileName       = argv[1];
+  char*              outputFileName      = argv[2];
+  char*              outputFileNameMono  = argv[3];
+  unsigned int       sizeX               = atoi(argv[4]);
+  unsigned int       sizeY               = atoi(argv[5]);
+  unsigned int       neighInitX          = atoi(argv[6]);
+  unsigned int       neighInitY          = atoi(argv[7]);
+  unsigned int       nbIterations        = atoi(argv[8]);
+  double             betaInit            = atof(argv[9]);
+  double             betaEnd             = atof(argv[10]);
+  double             initValue           = atof(argv[11]);
+  unsigned int       batchSize           = atoi(argv[12]);
+
+  typedef double                                              ComponentType;
+  typedef itk::VariableLengthVector<ComponentType>            PixelType;
+  typedef itk::Statistics::EuclideanDistanceMetric<PixelType> DistanceType;
+  typedef otb::SOMMap<PixelType, DistanceType, Dimension> MapType;
+  typedef otb::VectorImage<ComponentType, Dimension> ImageType;
+  typedef otb::ImageFileReader<ImageType>        ReaderType;
+  typedef itk::Statistics::ListSample<PixelType> ListSampleType;
+
+  typedef otb::SOM<ListSampleType, MapType> SOMType;
+  typedef otb::ImageFileWriter<MapType> WriterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFileName);
+  reader->Update();
+
+  ListSampleType::Pointer listSample = ListSampleType::New();
+  listSample->SetMeasurementVectorSize(reader->GetOutput()->GetNumberOfComponentsPerPixel());
+
+  itk::ImageRegionIterator<ImageType> it(reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion());
+
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    listSample->PushBack(it.Get());
+  }
+
+  SOMType::SizeType size;
+  size[0] = sizeX;
+  size[1] = sizeY;
+  SOMType::SizeType radius;
+  radius[0] = neighInitX;
+  radius[1] = neighInitY;
+
+  // The batch update must not depend on the number of threads
+  for (unsigned int run = 0; run < 2; ++run)
+  {
+    SOMType::Pointer som = SOMType::New();
+    som->SetListSample(listSample);
+    som->SetMapSize(size);
+    som->SetNeighborhoodSizeInit(radius);
+    som->SetNumberOfIterations(nbIterations);
+    som->SetBetaInit(betaInit);
+    som->SetBetaEnd(betaEnd);
+    som->SetMaxWeight(initValue);
+    som->SetRandomInit(true);
+    som->BatchModeOn();
+    som->SetBatchSize(batchSize);
+    if (run == 1)
+    {
+      som->SetNumberOfThreads(1);
+    }
+
+    WriterType::Pointer writer = WriterType::New();
+    writer->SetFileName(run == 0 ? outputFileName : outputFileNameMono);
+    writer->SetInput(som->GetOutput());
+    writer->Update();
+  }
+
+  return EXIT_SUCCESS;
+}
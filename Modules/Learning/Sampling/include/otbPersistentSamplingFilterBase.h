@@ -24,6 +24,7 @@
 #include "otbPersistentImageFilter.h"
 #include "otbOGRDataSourceWrapper.h"
 #include "otbImage.h"
+#include "otbScanlineRasterizer.h"
 #include <string>
 
 namespace otb
@@ -93,6 +94,13 @@ public:
   itkSetMacro(OutLayerName, std::string);
   itkGetMacro(OutLayerName, std::string);
 
+  /** Set/Get macro for the all-touched mode : when enabled, a polygon uses
+   *  every pixel it intersects, instead of the pixels whose center is inside.
+   *  Default is off. */
+  itkSetMacro(AllTouched, bool);
+  itkGetMacro(AllTouched, bool);
+  itkBooleanMacro(AllTouched);
+
 protected:
   /** Constructor */
   PersistentSamplingFilterBase();
@@ -121,10 +129,13 @@ protected:
   /** Process a geometry, recursive method when the geometry is a collection */
   void ExploreGeometry(const ogr::Feature& feature, OGRGeometry* geom, RegionType& region, itk::ThreadIdType& threadid);
 
-  /** Process a line string : use pixels that cross the line */
+  /** Process a line string : use pixels that cross the line. Pixels are
+   *  found with a supercover traversal of the line, the exact intersection
+   *  test being only used on pixels that the line barely touches. */
   virtual void ProcessLine(const ogr::Feature& feature, OGRLineString* line, RegionType& region, itk::ThreadIdType& threadid);
 
-  /** Process a polygon : use pixels inside the polygon */
+  /** Process a polygon : use pixels inside the polygon. Pixels are found
+   *  by spans along each row, with a scanline rasterization of the rings. */
   virtual void ProcessPolygon(const ogr::Feature& feature, OGRPolygon* polygon, RegionType& region, itk::ThreadIdType& threadid);
 
   /** Generic method called for each matching pixel position (NOT IMPLEMENTED)*/
@@ -140,6 +151,20 @@ protected:
   /** Common function to test if a pixel crosses the line */
   bool IsSampleOnLine(OGRLineString* line, typename TInputImage::PointType& position, typename TInputImage::SpacingType& absSpacing, OGRPolygon& tmpPolygon);
 
+  /** Common function to test if a pixel intersects a geometry */
+  bool IsSampleOnGeometry(OGRGeometry* geom, typename TInputImage::PointType& position, typename TInputImage::SpacingType& absSpacing,
+                          OGRPolygon& tmpPolygon);
+
+  /** Prepare the polygon used to test pixel footprints, and the absolute pixel size */
+  void InitializePixelPolygon(OGRPolygon& tmpPolygon, typename TInputImage::SpacingType& absSpacing) const;
+
+  /** Prepare a rasterizer on the grid of pixel centers of a region. Returns
+   *  false if the grid is not aligned with the physical axes. */
+  bool InitializeRasterizer(const RegionType& region, ScanlineRasterizer& rasterizer) const;
+
+  /** Process one pixel of a region, if it is not masked */
+  void ProcessRegionPixel(const ogr::Feature& feature, const RegionType& region, unsigned int column, unsigned int row, itk::ThreadIdType& threadid);
+
   /** Get the region bounding a set of features */
   RegionType FeatureBoundingRegion(const TInputImage* image, otb::ogr::Layer::const_iterator& featIt) const;
 
@@ -205,6 +230,9 @@ private:
   /** name of the output layers */
   std::string m_OutLayerName;
 
+  /** Use every pixel touched by polygons */
+  bool m_AllTouched;
+
   /** Creation option for output layers */
   std::vector<std::string> m_OGRLayerCreationOptions;
 
@@ -38,6 +38,7 @@ PersistentSamplingFilterBase<TInputImage, TMaskImage>::PersistentSamplingFilterB
     m_FieldIndex(0),
     m_LayerIndex(0),
     m_OutLayerName(std::string("output")),
+    m_AllTouched(false),
     m_OGRLayerCreationOptions(),
     m_AdditionalFields(),
     m_InMemoryInputs(),
@@ -426,24 +427,45 @@ template <class TInputImage, class TMaskImage>
 void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessLine(const ogr::Feature& feature, OGRLineString* line, RegionType& region,
                                                                         itk::ThreadIdType& threadid)
 {
-  OGRPolygon    tmpPolygon;
-  OGRLinearRing ring;
-  ring.addPoint(0.0, 0.0, 0.0);
-  ring.addPoint(1.0, 0.0, 0.0);
-  ring.addPoint(1.0, 1.0, 0.0);
-  ring.addPoint(0.0, 1.0, 0.0);
-  ring.addPoint(0.0, 0.0, 0.0);
-  tmpPolygon.addRing(&ring);
-  const TInputImage*                img  = this->GetInput();
-  TMaskImage*                       mask = const_cast<TMaskImage*>(this->GetMask());
-  typename TInputImage::IndexType   imgIndex;
-  typename TInputImage::PointType   imgPoint;
-  typename TInputImage::SpacingType imgAbsSpacing = img->GetSignedSpacing();
-  if (imgAbsSpacing[0] < 0)
-    imgAbsSpacing[0] = -imgAbsSpacing[0];
-  if (imgAbsSpacing[1] < 0)
-    imgAbsSpacing[1] = -imgAbsSpacing[1];
+  OGRPolygon                        tmpPolygon;
+  typename TInputImage::SpacingType imgAbsSpacing;
+  this->InitializePixelPolygon(tmpPolygon, imgAbsSpacing);
+  const TInputImage*              img  = this->GetInput();
+  TMaskImage*                     mask = const_cast<TMaskImage*>(this->GetMask());
+  typename TInputImage::IndexType imgIndex;
+  typename TInputImage::PointType imgPoint;
+
+  ScanlineRasterizer rasterizer;
+  if (this->InitializeRasterizer(region, rasterizer))
+  {
+    std::vector<double> x(line->getNumPoints());
+    std::vector<double> y(line->getNumPoints());
+    for (int i = 0; i < line->getNumPoints(); ++i)
+    {
+      x[i] = line->getX(i);
+      y[i] = line->getY(i);
+    }
+    ScanlineRasterizer::CellListType cells;
+    rasterizer.RasterizeLine(x, y, cells);
 
+    for (const auto& cell : cells)
+    {
+      imgIndex[0] = region.GetIndex(0) + cell.column;
+      imgIndex[1] = region.GetIndex(1) + cell.row;
+      if (mask && !mask->GetPixel(imgIndex))
+      {
+        continue;
+      }
+      img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+      if (cell.certain || this->IsSampleOnLine(line, imgPoint, imgAbsSpacing, tmpPolygon))
+      {
+        this->ProcessSample(feature, imgIndex, imgPoint, threadid);
+      }
+    }
+    return;
+  }
+
+  // The image grid is rotated : test every pixel
   if (mask)
   {
     // For pixels in consideredRegion and not masked
@@ -485,12 +507,82 @@ template <class TInputImage, class TMaskImage>
 void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessPolygon(const ogr::Feature& feature, OGRPolygon* polygon, RegionType& region,
                                                                            itk::ThreadIdType& threadid)
 {
-  const TInputImage*              img  = this->GetInput();
-  TMaskImage*                     mask = const_cast<TMaskImage*>(this->GetMask());
-  typename TInputImage::IndexType imgIndex;
-  typename TInputImage::PointType imgPoint;
-  OGRPoint                        tmpPoint;
+  const TInputImage*                img  = this->GetInput();
+  TMaskImage*                       mask = const_cast<TMaskImage*>(this->GetMask());
+  typename TInputImage::IndexType   imgIndex;
+  typename TInputImage::PointType   imgPoint;
+  OGRPoint                          tmpPoint;
+  OGRPolygon                        tmpPolygon;
+  typename TInputImage::SpacingType imgAbsSpacing;
+  this->InitializePixelPolygon(tmpPolygon, imgAbsSpacing);
+
+  ScanlineRasterizer rasterizer;
+  if (this->InitializeRasterizer(region, rasterizer))
+  {
+    std::vector<double> x, y;
+    for (int k = -1; k < polygon->getNumInteriorRings(); ++k)
+    {
+      OGRLinearRing* ring = (k < 0) ? polygon->getExteriorRing() : polygon->getInteriorRing(k);
+      x.resize(ring->getNumPoints());
+      y.resize(ring->getNumPoints());
+      for (int i = 0; i < ring->getNumPoints(); ++i)
+      {
+        x[i] = ring->getX(i);
+        y[i] = ring->getY(i);
+      }
+      rasterizer.AddRing(x, y);
+    }
+
+    std::vector<ScanlineRasterizer::SpanListType> rowSpans;
+    rasterizer.RasterizePolygon(rowSpans);
+
+    // In all-touched mode, pixels crossed by the rings are added to the spans
+    ScanlineRasterizer::CellListType boundary;
+    if (m_AllTouched)
+    {
+      rasterizer.RasterizeBoundary(boundary);
+    }
+    auto cellIt      = boundary.cbegin();
+    auto processCell = [&](const ScanlineRasterizer::CellType& cell) {
+      imgIndex[0] = region.GetIndex(0) + cell.column;
+      imgIndex[1] = region.GetIndex(1) + cell.row;
+      if (mask && !mask->GetPixel(imgIndex))
+      {
+        return;
+      }
+      img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+      if (cell.certain || this->IsSampleOnGeometry(polygon, imgPoint, imgAbsSpacing, tmpPolygon))
+      {
+        this->ProcessSample(feature, imgIndex, imgPoint, threadid);
+      }
+    };
+
+    for (unsigned int row = 0; row < rowSpans.size(); ++row)
+    {
+      for (const auto& span : rowSpans[row])
+      {
+        for (unsigned int column = span.first; column < span.second; ++column)
+        {
+          for (; cellIt != boundary.cend() && cellIt->row == row && cellIt->column < column; ++cellIt)
+          {
+            processCell(*cellIt);
+          }
+          if (cellIt != boundary.cend() && cellIt->row == row && cellIt->column == column)
+          {
+            ++cellIt;
+          }
+          this->ProcessRegionPixel(feature, region, column, row, threadid);
+        }
+      }
+      for (; cellIt != boundary.cend() && cellIt->row == row; ++cellIt)
+      {
+        processCell(*cellIt);
+      }
+    }
+    return;
+  }
 
+  // The image grid is rotated : test every pixel
   if (mask)
   {
     // For pixels in consideredRegion and not masked
@@ -503,7 +595,7 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessPolygon(const
       img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
       tmpPoint.setX(imgPoint[0]);
       tmpPoint.setY(imgPoint[1]);
-      bool isInside = this->IsSampleInsidePolygon(polygon, &tmpPoint);
+      bool isInside = m_AllTouched ? this->IsSampleOnGeometry(polygon, imgPoint, imgAbsSpacing, tmpPolygon) : this->IsSampleInsidePolygon(polygon, &tmpPoint);
       if (isInside)
       {
         this->ProcessSample(feature, imgIndex, imgPoint, threadid);
@@ -522,7 +614,7 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessPolygon(const
       img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
       tmpPoint.setX(imgPoint[0]);
       tmpPoint.setY(imgPoint[1]);
-      bool isInside = this->IsSampleInsidePolygon(polygon, &tmpPoint);
+      bool isInside = m_AllTouched ? this->IsSampleOnGeometry(polygon, imgPoint, imgAbsSpacing, tmpPolygon) : this->IsSampleInsidePolygon(polygon, &tmpPoint);
       if (isInside)
       {
         this->ProcessSample(feature, imgIndex, imgPoint, threadid);
@@ -532,6 +624,57 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessPolygon(const
   }
 }
 
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessRegionPixel(const ogr::Feature& feature, const RegionType& region, unsigned int column,
+                                                                               unsigned int row, itk::ThreadIdType& threadid)
+{
+  typename TInputImage::IndexType imgIndex;
+  typename TInputImage::PointType imgPoint;
+  imgIndex[0] = region.GetIndex(0) + column;
+  imgIndex[1] = region.GetIndex(1) + row;
+
+  const TMaskImage* mask = this->GetMask();
+  if (mask && !mask->GetPixel(imgIndex))
+  {
+    return;
+  }
+  this->GetInput()->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+  this->ProcessSample(feature, imgIndex, imgPoint, threadid);
+}
+
+template <class TInputImage, class TMaskImage>
+bool PersistentSamplingFilterBase<TInputImage, TMaskImage>::InitializeRasterizer(const RegionType& region, ScanlineRasterizer& rasterizer) const
+{
+  const TInputImage* img = this->GetInput();
+  if (img->GetDirection()[0][1] != 0. || img->GetDirection()[1][0] != 0.)
+  {
+    return false;
+  }
+
+  // Pixel centers computed as in the pixel by pixel loop, so that the
+  // rasterizer tests the very same coordinates
+  typename TInputImage::IndexType imgIndex = region.GetIndex();
+  typename TInputImage::PointType imgPoint;
+  std::vector<double>             columnX(region.GetSize(0));
+  std::vector<double>             rowY(region.GetSize(1));
+  for (unsigned int i = 0; i < columnX.size(); ++i)
+  {
+    imgIndex[0] = region.GetIndex(0) + i;
+    img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+    columnX[i] = imgPoint[0];
+  }
+  imgIndex[0] = region.GetIndex(0);
+  for (unsigned int j = 0; j < rowY.size(); ++j)
+  {
+    imgIndex[1] = region.GetIndex(1) + j;
+    img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+    rowY[j] = imgPoint[1];
+  }
+
+  const typename TInputImage::SpacingType spacing = img->GetSignedSpacing();
+  return rasterizer.SetGrid(columnX, rowY, spacing[0], spacing[1]);
+}
+
 template <class TInputImage, class TMaskImage>
 void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessSample(const ogr::Feature&, typename TInputImage::IndexType&,
                                                                           typename TInputImage::PointType&, itk::ThreadIdType&)
@@ -566,13 +709,38 @@ inline bool PersistentSamplingFilterBase<TInputImage, TMaskImage>::IsSampleInsid
 template <class TInputImage, class TMaskImage>
 inline bool PersistentSamplingFilterBase<TInputImage, TMaskImage>::IsSampleOnLine(OGRLineString* line, typename TInputImage::PointType& position,
                                                                                   typename TInputImage::SpacingType& absSpacing, OGRPolygon& tmpPolygon)
+{
+  return this->IsSampleOnGeometry(line, position, absSpacing, tmpPolygon);
+}
+
+template <class TInputImage, class TMaskImage>
+inline bool PersistentSamplingFilterBase<TInputImage, TMaskImage>::IsSampleOnGeometry(OGRGeometry* geom, typename TInputImage::PointType& position,
+                                                                                      typename TInputImage::SpacingType& absSpacing, OGRPolygon& tmpPolygon)
 {
   tmpPolygon.getExteriorRing()->setPoint(0, position[0] - 0.5 * absSpacing[0], position[1] - 0.5 * absSpacing[1], 0.0);
   tmpPolygon.getExteriorRing()->setPoint(1, position[0] + 0.5 * absSpacing[0], position[1] - 0.5 * absSpacing[1], 0.0);
   tmpPolygon.getExteriorRing()->setPoint(2, position[0] + 0.5 * absSpacing[0], position[1] + 0.5 * absSpacing[1], 0.0);
   tmpPolygon.getExteriorRing()->setPoint(3, position[0] - 0.5 * absSpacing[0], position[1] + 0.5 * absSpacing[1], 0.0);
   tmpPolygon.getExteriorRing()->setPoint(4, position[0] - 0.5 * absSpacing[0], position[1] - 0.5 * absSpacing[1], 0.0);
-  return line->Intersects(&tmpPolygon);
+  return geom->Intersects(&tmpPolygon);
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::InitializePixelPolygon(OGRPolygon& tmpPolygon, typename TInputImage::SpacingType& absSpacing) const
+{
+  OGRLinearRing ring;
+  ring.addPoint(0.0, 0.0, 0.0);
+  ring.addPoint(1.0, 0.0, 0.0);
+  ring.addPoint(1.0, 1.0, 0.0);
+  ring.addPoint(0.0, 1.0, 0.0);
+  ring.addPoint(0.0, 0.0, 0.0);
+  tmpPolygon.addRing(&ring);
+
+  absSpacing = this->GetInput()->GetSignedSpacing();
+  if (absSpacing[0] < 0)
+    absSpacing[0] = -absSpacing[0];
+  if (absSpacing[1] < 0)
+    absSpacing[1] = -absSpacing[1];
 }
 
 template <class TInputImage, class TMaskImage>
@@ -25,6 +25,7 @@
 #include <omp.h>
 #endif
 
+#include "otbSampleNeighborSearch.h"
 #include <vector>
 #include <algorithm>
 #include <random>
@@ -158,26 +159,55 @@ double ComputeSquareDistance(const SampleType& x, const SampleType& y)
 
 using NNIndicesType = std::vector<NeighborType>;
 using NNVectorType  = std::vector<NNIndicesType>;
-/** Returns the indices of the nearest neighbors for each input sample
+/** Returns the indices of the nearest neighbors for each input sample,
+* sorted by increasing distance (ComputeSquareDistance()), equal
+* distances being sorted by increasing index. The search uses a KD-tree
+* or a blocked exhaustive search, see otb::SampleNeighborSearch.
 */
 void FindKNNIndices(const SampleVectorType& inSamples, const size_t nbNeighbors, NNVectorType& nnVector)
 {
-  const long long nbSamples = static_cast<long long>(inSamples.size());
+  const long long    nbSamples    = static_cast<long long>(inSamples.size());
+  const unsigned int nbComponents = nbSamples > 0 ? static_cast<unsigned int>(inSamples[0].size()) : 0;
+  const unsigned int k            = static_cast<unsigned int>(nbNeighbors);
   nnVector.resize(nbSamples);
+
+  std::vector<double> samples;
+  samples.reserve(static_cast<size_t>(nbSamples) * nbComponents);
+  for (const auto& sample : inSamples)
+  {
+    samples.insert(samples.end(), sample.begin(), sample.end());
+  }
+  SampleNeighborSearch search;
+  search.SetSamples(samples, nbComponents);
+
+  // Queries are processed by blocks, each thread reusing its own buffers
+  const long long blockSize = 64;
+  const long long nbBlocks  = (nbSamples + blockSize - 1) / blockSize;
+  const double    norm      = static_cast<double>(nbComponents) * nbComponents;
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-  for (long long sampleIdx = 0; sampleIdx < nbSamples; ++sampleIdx)
   {
-    NNIndicesType nns;
-    for (long long neighborIdx = 0; neighborIdx < nbSamples; ++neighborIdx)
+    std::vector<unsigned int> indices(blockSize * k);
+    std::vector<double>       distances(blockSize * k);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (long long block = 0; block < nbBlocks; ++block)
     {
-      if (sampleIdx != neighborIdx)
-        nns.push_back({static_cast<size_t>(neighborIdx), ComputeSquareDistance(inSamples[sampleIdx], inSamples[neighborIdx])});
+      const long long    first     = block * blockSize;
+      const unsigned int nbQueries = static_cast<unsigned int>(std::min(blockSize, nbSamples - first));
+      const unsigned int nbFound   = search.Search(static_cast<unsigned int>(first), nbQueries, k, indices.data(), distances.data());
+      for (unsigned int q = 0; q < nbQueries; ++q)
+      {
+        NNIndicesType& nns = nnVector[first + q];
+        nns.resize(nbFound);
+        for (unsigned int n = 0; n < nbFound; ++n)
+        {
+          nns[n] = {indices[q * k + n], distances[q * k + n] / norm};
+        }
+      }
     }
-    std::partial_sort(nns.begin(), nns.begin() + nbNeighbors, nns.end(), NeighborSorter{});
-    nns.resize(nbNeighbors);
-    nnVector[sampleIdx] = std::move(nns);
   }
 }
 
@@ -196,6 +226,10 @@ Chawla, N. V., Bowyer, K. W., Hall, L. O., & Kegelmeyer, W. P., Smote:
 synthetic minority over-sampling technique, Journal of artificial
 intelligence research, 16(), 321–357 (2002).
 http://dx.doi.org/10.1613/jair.953
+
+The new samples are generated by chunks, each chunk drawing from its own
+random generator seeded by the seed and the chunk number, so that the
+result only depends on the seed, whatever the number of threads.
 */
 void Smote(const SampleVectorType& inSamples, const size_t nbSamples, SampleVectorType& newSamples, const int nbNeighbors, const int seed = std::time(nullptr))
 {
@@ -203,18 +237,33 @@ void Smote(const SampleVectorType& inSamples, const size_t nbSamples, SampleVect
   const long long nbSamplesLL = static_cast<long long>(nbSamples);
   NNVectorType    nnVector;
   FindKNNIndices(inSamples, nbNeighbors, nnVector);
-  // The input samples are selected randomly with replacement
-  std::srand(seed);
+
+  const long long chunkSize = 256;
+  const long long nbChunks  = (nbSamplesLL + chunkSize - 1) / chunkSize;
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic)
 #endif
-  for (long long i = 0; i < nbSamplesLL; ++i)
+  for (long long chunk = 0; chunk < nbChunks; ++chunk)
   {
-    const auto sampleIdx   = std::rand() % (inSamples.size());
-    const auto sample      = inSamples[sampleIdx];
-    const auto neighborIdx = nnVector[sampleIdx][std::rand() % nbNeighbors].index;
-    const auto neighbor    = inSamples[neighborIdx];
-    newSamples[i]          = SmoteCombine(sample, neighbor, std::rand() / double{RAND_MAX});
+    std::seed_seq seedSequence{static_cast<unsigned int>(seed), static_cast<unsigned int>(chunk)};
+    std::mt19937  gen(seedSequence);
+    // The input samples are selected randomly with replacement
+    std::uniform_int_distribution<size_t>  sampleDis(0, inSamples.size() - 1);
+    std::uniform_real_distribution<double> positionDis(0.0, 1.0);
+
+    const long long last = std::min(nbSamplesLL, (chunk + 1) * chunkSize);
+    for (long long i = chunk * chunkSize; i < last; ++i)
+    {
+      const auto  sampleIdx = sampleDis(gen);
+      const auto& neighbors = nnVector[sampleIdx];
+      if (neighbors.empty())
+      {
+        newSamples[i] = inSamples[sampleIdx];
+        continue;
+      }
+      const auto neighborIdx = neighbors[std::uniform_int_distribution<size_t>(0, neighbors.size() - 1)(gen)].index;
+      newSamples[i]          = SmoteCombine(inSamples[sampleIdx], inSamples[neighborIdx], positionDis(gen));
+    }
   }
 }
 
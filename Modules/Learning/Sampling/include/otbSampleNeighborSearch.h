@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSampleNeighborSearch_h
+#define otbSampleNeighborSearch_h
+
+#include "OTBSamplingExport.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class SampleNeighborSearch
+ * \brief Exact K nearest neighbors of each sample of a set, among the others.
+ *
+ * Two backends give the same result:
+ * - a KD-tree (median splits on the dimension of largest spread), which pays
+ * off when there are many more samples than \f$ 2^{dimension} \f$,
+ * - a blocked exhaustive search, where a block of samples stays in cache
+ * while it is compared to a block of queries.
+ *
+ * Both backends keep the neighbors of each query in a bounded sorted list,
+ * so that no buffer proportional to the number of samples is allocated.
+ * Neighbors are sorted by increasing squared distance, equal distances being
+ * sorted by increasing sample index.
+ *
+ * Search() is const, so it can be called concurrently from several threads
+ * on different queries.
+ *
+ * \ingroup OTBSampling
+ */
+class OTBSampling_EXPORT SampleNeighborSearch
+{
+public:
+  enum ModeType
+  {
+    AUTOMATIC = 0,
+    KD_TREE,
+    EXHAUSTIVE
+  };
+
+  SampleNeighborSearch();
+
+  /** Choose the backend. The automatic mode selects the KD-tree when the
+   * number of samples is larger than 2^dimension. Must be called before
+   * SetSamples(). */
+  void SetMode(ModeType mode)
+  {
+    m_Mode = mode;
+  }
+
+  ModeType GetMode() const
+  {
+    return m_Mode;
+  }
+
+  /** Set the samples, as a row-major nbSamples x dimension matrix. The
+   * samples are copied. */
+  void SetSamples(const std::vector<double>& samples, unsigned int dimension);
+
+  /** True if the KD-tree is used */
+  bool IsUsingKDTree() const
+  {
+    return !m_Nodes.empty();
+  }
+
+  unsigned int GetNumberOfSamples() const
+  {
+    return m_NumberOfSamples;
+  }
+
+  unsigned int GetDimension() const
+  {
+    return m_Dimension;
+  }
+
+  /** Find the k nearest neighbors of the samples [firstSample, firstSample +
+   * nbQueries[, each sample being excluded from its own neighbors. indices
+   * and distances must hold nbQueries x k values, and receive the sample
+   * indices and squared distances of the neighbors of each query, the list
+   * of query q starting at q x k. Returns
+   * the number of neighbors found per query, which is
+   * min(k, GetNumberOfSamples() - 1). */
+  unsigned int Search(unsigned int firstSample, unsigned int nbQueries, unsigned int k, unsigned int* indices, double* distances) const;
+
+  /** Squared euclidean distance */
+  static double SquaredDistance(const double* u, const double* v, unsigned int dimension);
+
+private:
+  struct Node
+  {
+    unsigned int begin;
+    unsigned int end;
+    int          splitDimension; // -1 for leaves
+    double       splitValue;
+    unsigned int left;
+    unsigned int right;
+  };
+
+  unsigned int BuildNode(unsigned int begin, unsigned int end);
+
+  void SearchNode(unsigned int nodeId, const double* query, unsigned int queryIndex, unsigned int k, unsigned int* indices, double* distances,
+                  unsigned int& count) const;
+
+  /** Neighbor lists are stored every stride values */
+  void SearchExhaustive(unsigned int firstSample, unsigned int nbQueries, unsigned int k, unsigned int stride, unsigned int* indices, double* distances) const;
+
+  /** Insert a candidate in the sorted list of the k nearest neighbors */
+  static void Insert(double distance, unsigned int index, unsigned int k, unsigned int* indices, double* distances, unsigned int& count);
+
+  ModeType     m_Mode;
+  unsigned int m_Dimension;
+  unsigned int m_NumberOfSamples;
+
+  /** Samples, in tree order when the KD-tree is used */
+  std::vector<double> m_Samples;
+
+  /** Sample index of each position, and position of each sample index */
+  std::vector<unsigned int> m_Indices;
+  std::vector<unsigned int> m_Positions;
+
+  std::vector<Node> m_Nodes;
+};
+
+} // end namespace otb
+
+#endif
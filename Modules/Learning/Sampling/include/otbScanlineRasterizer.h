@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbScanlineRasterizer_h
+#define otbScanlineRasterizer_h
+
+#include "OTBSamplingExport.h"
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class ScanlineRasterizer
+ * \brief Find the pixels of an axis-aligned grid covered by polygons and lines.
+ *
+ * The grid is given by the physical coordinates of the pixel centers of each
+ * column and each row, and by the signed pixel size.
+ *
+ * Polygons are rasterized with an edge table: each edge is registered on the
+ * range of rows it crosses, and each row only visits its active edges. The
+ * result is a list of column spans per row. A pixel is inside when its
+ * center is inside the exterior ring and outside every interior ring, each
+ * ring being tested with the even-odd rule. The crossing test is the one of
+ * OGRLinearRing::isPointInRing(): whenever a pixel center is close enough to
+ * an edge for rounding to matter, the crossing is evaluated with the very
+ * same floating point expression, so that the result is identical to a pixel
+ * by pixel test with OGR.
+ *
+ * Lines (and polygon boundaries in the all-touched mode) are traversed with a
+ * supercover: for each row of pixels crossed by a segment, the segment is
+ * clipped to the row and every pixel overlapping the clipped part is
+ * reported. Each reported cell is flagged as certain when the segment
+ * crosses the pixel square shrunk by a small margin, or uncertain when the
+ * segment only passes near its border, in which case the caller should
+ * confirm with an exact intersection test.
+ *
+ * \ingroup OTBSampling
+ */
+class OTBSampling_EXPORT ScanlineRasterizer
+{
+public:
+  /** Columns [first, second[ of a row */
+  typedef std::pair<unsigned int, unsigned int> SpanType;
+  typedef std::vector<SpanType> SpanListType;
+
+  /** Pixel reported by the supercover traversal */
+  struct CellType
+  {
+    unsigned int row;
+    unsigned int column;
+    bool         certain;
+  };
+  typedef std::vector<CellType> CellListType;
+
+  ScanlineRasterizer();
+
+  /** Set the grid. Column coordinates must be strictly monotonic, as well as
+   * row coordinates. Returns false if they are not. */
+  bool SetGrid(const std::vector<double>& columnX, const std::vector<double>& rowY, double spacingX, double spacingY);
+
+  /** Remove all rings */
+  void ClearRings();
+
+  /** Add a polygon ring: the first ring is the exterior ring, the next ones
+   * are the interior rings */
+  void AddRing(const std::vector<double>& x, const std::vector<double>& y);
+
+  /** Compute the spans of pixels whose center is inside the polygon, for
+   * every row of the grid */
+  void RasterizePolygon(std::vector<SpanListType>& rowSpans) const;
+
+  /** Compute the pixels whose square intersects the polyline, sorted by row
+   * and column */
+  void RasterizeLine(const std::vector<double>& x, const std::vector<double>& y, CellListType& cells) const;
+
+  /** Compute the pixels whose square intersects the boundary of the polygon,
+   * sorted by row and column */
+  void RasterizeBoundary(CellListType& cells) const;
+
+private:
+  struct EdgeType
+  {
+    unsigned int ring;
+    double       previousX;
+    double       previousY;
+    double       currentX;
+    double       currentY;
+  };
+
+  /** Same expression as in OGRLinearRing::isPointInRing() */
+  static bool IsCrossing(const EdgeType& edge, double testX, double testY);
+
+  /** Supercover of one segment, appended to cells */
+  void RasterizeSegment(double x0, double y0, double x1, double y1, CellListType& cells) const;
+
+  /** Sort cells by row and column, merging duplicates */
+  static void SortCells(CellListType& cells);
+
+  /** Grid, columns and rows in increasing coordinate order */
+  std::vector<double> m_ColumnX;
+  std::vector<double> m_RowY;
+  bool                m_ReversedColumns;
+  bool                m_ReversedRows;
+
+  /** Grid, in index order */
+  double m_FirstColumnX;
+  double m_FirstRowY;
+  double m_SpacingX;
+  double m_SpacingY;
+
+  unsigned int          m_NumberOfRings;
+  std::vector<EdgeType> m_Edges;
+
+  /** Vertices of each ring, for the boundary traversal */
+  std::vector<std::vector<double>> m_RingX;
+  std::vector<std::vector<double>> m_RingY;
+};
+
+} // end namespace otb
+
+#endif
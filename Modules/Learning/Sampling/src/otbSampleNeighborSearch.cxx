@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSampleNeighborSearch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace otb
+{
+
+namespace
+{
+// Maximum number of samples in a leaf
+const unsigned int LeafSize = 16;
+
+// Number of samples compared to a block of queries by the exhaustive search
+const unsigned int SampleBlockSize = 128;
+
+// (distance, index) lexicographic order
+inline bool IsCloser(double distance, unsigned int index, double refDistance, unsigned int refIndex)
+{
+  return distance < refDistance || (distance == refDistance && index < refIndex);
+}
+}
+
+SampleNeighborSearch::SampleNeighborSearch() : m_Mode(AUTOMATIC), m_Dimension(0), m_NumberOfSamples(0)
+{
+}
+
+double SampleNeighborSearch::SquaredDistance(const double* u, const double* v, unsigned int dimension)
+{
+  double sum = 0.;
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    const double diff = u[d] - v[d];
+    sum += diff * diff;
+  }
+  return sum;
+}
+
+void SampleNeighborSearch::SetSamples(const std::vector<double>& samples, unsigned int dimension)
+{
+  m_Nodes.clear();
+  m_Dimension       = dimension;
+  m_NumberOfSamples = dimension ? static_cast<unsigned int>(samples.size() / dimension) : 0;
+  m_Samples.assign(samples.begin(), samples.begin() + static_cast<size_t>(m_NumberOfSamples) * dimension);
+  m_Indices.resize(m_NumberOfSamples);
+  std::iota(m_Indices.begin(), m_Indices.end(), 0);
+  m_Positions = m_Indices;
+
+  const bool useTree = (m_Mode == KD_TREE) || (m_Mode == AUTOMATIC && std::log2(static_cast<double>(m_NumberOfSamples)) > dimension);
+  if (!useTree || m_NumberOfSamples == 0 || dimension == 0)
+  {
+    return;
+  }
+
+  m_Nodes.reserve(2 * (m_NumberOfSamples / LeafSize + 1));
+  BuildNode(0, m_NumberOfSamples);
+
+  // Store the samples in tree order
+  std::vector<double> ordered(m_Samples.size());
+  for (unsigned int i = 0; i < m_NumberOfSamples; ++i)
+  {
+    const double* sample = &m_Samples[static_cast<size_t>(m_Indices[i]) * dimension];
+    std::copy(sample, sample + dimension, &ordered[static_cast<size_t>(i) * dimension]);
+    m_Positions[m_Indices[i]] = i;
+  }
+  m_Samples.swap(ordered);
+}
+
+unsigned int SampleNeighborSearch::BuildNode(unsigned int begin, unsigned int end)
+{
+  const unsigned int nodeId = static_cast<unsigned int>(m_Nodes.size());
+  Node               node   = {begin, end, -1, 0., 0, 0};
+  m_Nodes.push_back(node);
+
+  if (end - begin <= LeafSize)
+  {
+    return nodeId;
+  }
+
+  // Split on the dimension of largest spread
+  int    splitDimension = -1;
+  double largestSpread  = 0.;
+  for (unsigned int d = 0; d < m_Dimension; ++d)
+  {
+    double minValue = std::numeric_limits<double>::max();
+    double maxValue = std::numeric_limits<double>::lowest();
+    for (unsigned int i = begin; i < end; ++i)
+    {
+      const double value = m_Samples[static_cast<size_t>(m_Indices[i]) * m_Dimension + d];
+      minValue           = std::min(minValue, value);
+      maxValue           = std::max(maxValue, value);
+    }
+    if (maxValue - minValue > largestSpread)
+    {
+      largestSpread  = maxValue - minValue;
+      splitDimension = static_cast<int>(d);
+    }
+  }
+
+  // All samples are identical
+  if (splitDimension < 0)
+  {
+    return nodeId;
+  }
+
+  const unsigned int mid = begin + (end - begin) / 2;
+  const unsigned int dim = static_cast<unsigned int>(splitDimension);
+  std::nth_element(m_Indices.begin() + begin, m_Indices.begin() + mid, m_Indices.begin() + end, [this, dim](unsigned int a, unsigned int b) {
+    return m_Samples[static_cast<size_t>(a) * m_Dimension + dim] < m_Samples[static_cast<size_t>(b) * m_Dimension + dim];
+  });
+
+  const double       splitValue = m_Samples[static_cast<size_t>(m_Indices[mid]) * m_Dimension + dim];
+  const unsigned int left       = BuildNode(begin, mid);
+  const unsigned int right      = BuildNode(mid, end);
+
+  m_Nodes[nodeId].splitDimension = splitDimension;
+  m_Nodes[nodeId].splitValue     = splitValue;
+  m_Nodes[nodeId].left           = left;
+  m_Nodes[nodeId].right          = right;
+  return nodeId;
+}
+
+void SampleNeighborSearch::Insert(double distance, unsigned int index, unsigned int k, unsigned int* indices, double* distances, unsigned int& count)
+{
+  if (count == k && !IsCloser(distance, index, distances[k - 1], indices[k - 1]))
+  {
+    return;
+  }
+
+  // Sorted insertion
+  unsigned int pos = (count < k) ? count++ : k - 1;
+  while (pos > 0 && IsCloser(distance, index, distances[pos - 1], indices[pos - 1]))
+  {
+    distances[pos] = distances[pos - 1];
+    indices[pos]   = indices[pos - 1];
+    --pos;
+  }
+  distances[pos] = distance;
+  indices[pos]   = index;
+}
+
+unsigned int SampleNeighborSearch::Search(unsigned int firstSample, unsigned int nbQueries, unsigned int k, unsigned int* indices, double* distances) const
+{
+  const unsigned int nbNeighbors = std::min(k, m_NumberOfSamples > 0 ? m_NumberOfSamples - 1 : 0);
+  if (nbNeighbors == 0)
+  {
+    return 0;
+  }
+
+  if (m_Nodes.empty())
+  {
+    SearchExhaustive(firstSample, nbQueries, nbNeighbors, k, indices, distances);
+  }
+  else
+  {
+    for (unsigned int q = 0; q < nbQueries; ++q)
+    {
+      const unsigned int queryIndex = firstSample + q;
+      const double*      query      = &m_Samples[static_cast<size_t>(m_Positions[queryIndex]) * m_Dimension];
+      unsigned int       count      = 0;
+      SearchNode(0, query, queryIndex, nbNeighbors, indices + static_cast<size_t>(q) * k, distances + static_cast<size_t>(q) * k, count);
+    }
+  }
+  return nbNeighbors;
+}
+
+void SampleNeighborSearch::SearchExhaustive(unsigned int firstSample, unsigned int nbQueries, unsigned int k, unsigned int stride, unsigned int* indices,
+                                            double* distances) const
+{
+  std::vector<unsigned int> counts(nbQueries, 0);
+  for (unsigned int blockStart = 0; blockStart < m_NumberOfSamples; blockStart += SampleBlockSize)
+  {
+    const unsigned int blockEnd = std::min(m_NumberOfSamples, blockStart + SampleBlockSize);
+    for (unsigned int q = 0; q < nbQueries; ++q)
+    {
+      const unsigned int queryIndex = firstSample + q;
+      const double*      query      = &m_Samples[static_cast<size_t>(queryIndex) * m_Dimension];
+      for (unsigned int i = blockStart; i < blockEnd; ++i)
+      {
+        if (i != queryIndex)
+        {
+          Insert(SquaredDistance(query, &m_Samples[static_cast<size_t>(i) * m_Dimension], m_Dimension), i, k, indices + static_cast<size_t>(q) * stride,
+                 distances + static_cast<size_t>(q) * stride, counts[q]);
+        }
+      }
+    }
+  }
+}
+
+void SampleNeighborSearch::SearchNode(unsigned int nodeId, const double* query, unsigned int queryIndex, unsigned int k, unsigned int* indices,
+                                      double* distances, unsigned int& count) const
+{
+  const Node& node = m_Nodes[nodeId];
+
+  if (node.splitDimension < 0)
+  {
+    for (unsigned int i = node.begin; i < node.end; ++i)
+    {
+      const unsigned int index = m_Indices[i];
+      if (index != queryIndex)
+      {
+        Insert(SquaredDistance(query, &m_Samples[static_cast<size_t>(i) * m_Dimension], m_Dimension), index, k, indices, distances, count);
+      }
+    }
+    return;
+  }
+
+  // Left samples are below or on the split value, right samples above or on
+  // it. A rounded sum of squares is never below one of its rounded terms, so
+  // the far side can be skipped without approximation when its bound is
+  // strictly larger than the current k-th distance.
+  const double       diff      = query[node.splitDimension] - node.splitValue;
+  const bool         leftFirst = diff <= 0;
+  const unsigned int nearId    = leftFirst ? node.left : node.right;
+  const unsigned int farId     = leftFirst ? node.right : node.left;
+
+  SearchNode(nearId, query, queryIndex, k, indices, distances, count);
+
+  if (count < k || diff * diff <= distances[k - 1])
+  {
+    SearchNode(farId, query, queryIndex, k, indices, distances, count);
+  }
+}
+
+} // end namespace otb
@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbScanlineRasterizer.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+namespace otb
+{
+
+namespace
+{
+// Margin around pixel borders in the supercover traversal, in pixels
+const double CellMargin = 1e-6;
+
+// Check that values are strictly monotonic, and copy them in increasing order
+bool SortedCopy(const std::vector<double>& values, std::vector<double>& sorted, bool& reversed)
+{
+  reversed = values.size() > 1 && values[1] < values[0];
+  sorted   = values;
+  if (reversed)
+  {
+    std::reverse(sorted.begin(), sorted.end());
+  }
+  for (unsigned int i = 1; i < sorted.size(); ++i)
+  {
+    if (!(sorted[i - 1] < sorted[i]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Clip the segment (u0, v0) - (u1, v1) to the band lo <= v <= hi, and
+// return the range of u over the clipped part
+bool ClipToBand(double u0, double v0, double u1, double v1, double lo, double hi, double& uMin, double& uMax)
+{
+  if (lo > hi)
+  {
+    return false;
+  }
+  double tMin = 0.;
+  double tMax = 1.;
+  if (v1 == v0)
+  {
+    if (v0 < lo || v0 > hi)
+    {
+      return false;
+    }
+  }
+  else
+  {
+    const double ta = (lo - v0) / (v1 - v0);
+    const double tb = (hi - v0) / (v1 - v0);
+    tMin            = std::max(tMin, std::min(ta, tb));
+    tMax            = std::min(tMax, std::max(ta, tb));
+    if (tMin > tMax)
+    {
+      return false;
+    }
+  }
+  const double ua = u0 + tMin * (u1 - u0);
+  const double ub = u0 + tMax * (u1 - u0);
+  uMin            = std::min(ua, ub);
+  uMax            = std::max(ua, ub);
+  return true;
+}
+}
+
+ScanlineRasterizer::ScanlineRasterizer()
+  : m_ReversedColumns(false),
+    m_ReversedRows(false),
+    m_FirstColumnX(0.),
+    m_FirstRowY(0.),
+    m_SpacingX(1.),
+    m_SpacingY(1.),
+    m_NumberOfRings(0)
+{
+}
+
+bool ScanlineRasterizer::SetGrid(const std::vector<double>& columnX, const std::vector<double>& rowY, double spacingX, double spacingY)
+{
+  m_FirstColumnX = columnX.empty() ? 0. : columnX.front();
+  m_FirstRowY    = rowY.empty() ? 0. : rowY.front();
+  m_SpacingX     = spacingX;
+  m_SpacingY     = spacingY;
+  const bool okX = SortedCopy(columnX, m_ColumnX, m_ReversedColumns);
+  const bool okY = SortedCopy(rowY, m_RowY, m_ReversedRows);
+  return okX && okY && spacingX != 0. && spacingY != 0.;
+}
+
+void ScanlineRasterizer::ClearRings()
+{
+  m_NumberOfRings = 0;
+  m_Edges.clear();
+  m_RingX.clear();
+  m_RingY.clear();
+}
+
+void ScanlineRasterizer::AddRing(const std::vector<double>& x, const std::vector<double>& y)
+{
+  assert(x.size() == y.size());
+  const unsigned int nbPoints = static_cast<unsigned int>(x.size());
+
+  // Same edges as isPointInRing(): (i - 1, i), the first one wrapping around.
+  // Horizontal edges never cross a row.
+  for (unsigned int i = 0; i < nbPoints; ++i)
+  {
+    const unsigned int previous = (i == 0) ? nbPoints - 1 : i - 1;
+    if (y[previous] != y[i])
+    {
+      EdgeType edge = {m_NumberOfRings, x[previous], y[previous], x[i], y[i]};
+      m_Edges.push_back(edge);
+    }
+  }
+  m_RingX.push_back(x);
+  m_RingY.push_back(y);
+  ++m_NumberOfRings;
+}
+
+bool ScanlineRasterizer::IsCrossing(const EdgeType& edge, double testX, double testY)
+{
+  const double x1 = edge.currentX - testX;
+  const double y1 = edge.currentY - testY;
+  const double x2 = edge.previousX - testX;
+  const double y2 = edge.previousY - testY;
+  if (((y1 > 0) && (y2 <= 0)) || ((y2 > 0) && (y1 <= 0)))
+  {
+    const double intersection = (x1 * y2 - x2 * y1) / (y2 - y1);
+    return 0.0 < intersection;
+  }
+  return false;
+}
+
+void ScanlineRasterizer::RasterizePolygon(std::vector<SpanListType>& rowSpans) const
+{
+  const unsigned int nbRows    = static_cast<unsigned int>(m_RowY.size());
+  const unsigned int nbColumns = static_cast<unsigned int>(m_ColumnX.size());
+  rowSpans.assign(nbRows, SpanListType());
+  if (m_NumberOfRings == 0 || nbColumns == 0)
+  {
+    return;
+  }
+
+  // Edge table: an edge crosses the rows with min(y) <= rowY < max(y)
+  std::vector<std::vector<unsigned int>> edgeTable(nbRows);
+  std::vector<unsigned int>              lastRow(m_Edges.size());
+  for (unsigned int e = 0; e < m_Edges.size(); ++e)
+  {
+    const double       yMin  = std::min(m_Edges[e].previousY, m_Edges[e].currentY);
+    const double       yMax  = std::max(m_Edges[e].previousY, m_Edges[e].currentY);
+    const unsigned int first = static_cast<unsigned int>(std::lower_bound(m_RowY.begin(), m_RowY.end(), yMin) - m_RowY.begin());
+    lastRow[e]               = static_cast<unsigned int>(std::lower_bound(m_RowY.begin(), m_RowY.end(), yMax) - m_RowY.begin());
+    if (first < lastRow[e])
+    {
+      edgeTable[first].push_back(e);
+    }
+  }
+
+  // Toggle events (column, ring) along the current row
+  std::vector<std::pair<unsigned int, unsigned int>> events;
+  std::vector<unsigned int>                          activeEdges;
+  std::vector<bool>                                  oddRing(m_NumberOfRings);
+
+  for (unsigned int row = 0; row < nbRows; ++row)
+  {
+    const double testY = m_RowY[row];
+
+    // Update the active edge table
+    activeEdges.erase(std::remove_if(activeEdges.begin(), activeEdges.end(), [&lastRow, row](unsigned int e) { return lastRow[e] <= row; }),
+                      activeEdges.end());
+    activeEdges.insert(activeEdges.end(), edgeTable[row].begin(), edgeTable[row].end());
+    if (activeEdges.empty())
+    {
+      continue;
+    }
+
+    events.clear();
+    for (unsigned int e : activeEdges)
+    {
+      const EdgeType& edge = m_Edges[e];
+      // The crossing is counted for the pixel centers left of the intersection
+      const double crossX = edge.previousX + (testY - edge.previousY) * (edge.currentX - edge.previousX) / (edge.currentY - edge.previousY);
+      // Bound on the rounding errors of crossX and of the OGR expression
+      const double tolerance = 64. * DBL_EPSILON * (std::abs(edge.previousX) + std::abs(edge.currentX) + std::abs(crossX));
+
+      const unsigned int certainEnd =
+          static_cast<unsigned int>(std::lower_bound(m_ColumnX.begin(), m_ColumnX.end(), crossX - tolerance) - m_ColumnX.begin());
+      const unsigned int uncertainEnd =
+          static_cast<unsigned int>(std::upper_bound(m_ColumnX.begin(), m_ColumnX.end(), crossX + tolerance) - m_ColumnX.begin());
+
+      if (certainEnd > 0)
+      {
+        events.push_back(std::make_pair(0u, edge.ring));
+        events.push_back(std::make_pair(certainEnd, edge.ring));
+      }
+      for (unsigned int column = certainEnd; column < uncertainEnd; ++column)
+      {
+        if (IsCrossing(edge, m_ColumnX[column], testY))
+        {
+          events.push_back(std::make_pair(column, edge.ring));
+          events.push_back(std::make_pair(column + 1, edge.ring));
+        }
+      }
+    }
+    std::sort(events.begin(), events.end());
+
+    // Inside the exterior ring, and outside every interior ring
+    std::fill(oddRing.begin(), oddRing.end(), false);
+    unsigned int  oddInteriorRings = 0;
+    SpanListType& spans            = rowSpans[m_ReversedRows ? nbRows - 1 - row : row];
+    for (unsigned int i = 0; i < events.size();)
+    {
+      const unsigned int column = events[i].first;
+      for (; i < events.size() && events[i].first == column; ++i)
+      {
+        const unsigned int ring = events[i].second;
+        oddRing[ring]           = !oddRing[ring];
+        if (ring > 0 && oddRing[ring])
+        {
+          ++oddInteriorRings;
+        }
+        else if (ring > 0)
+        {
+          --oddInteriorRings;
+        }
+      }
+      const unsigned int next = (i < events.size()) ? std::min(events[i].first, nbColumns) : nbColumns;
+      if (oddRing[0] && oddInteriorRings == 0 && column < next)
+      {
+        if (!spans.empty() && spans.back().second == column)
+        {
+          spans.back().second = next;
+        }
+        else
+        {
+          spans.push_back(SpanType(column, next));
+        }
+      }
+    }
+
+    if (m_ReversedColumns)
+    {
+      for (auto& span : spans)
+      {
+        span = SpanType(nbColumns - span.second, nbColumns - span.first);
+      }
+      std::reverse(spans.begin(), spans.end());
+    }
+  }
+}
+
+void ScanlineRasterizer::RasterizeSegment(double x0, double y0, double x1, double y1, CellListType& cells) const
+{
+  const int nbColumns = static_cast<int>(m_ColumnX.size());
+  const int nbRows    = static_cast<int>(m_RowY.size());
+
+  // Continuous pixel coordinates, pixel (c, r) covering [c - 0.5, c + 0.5] x [r - 0.5, r + 0.5]
+  const double u0 = (x0 - m_FirstColumnX) / m_SpacingX;
+  const double v0 = (y0 - m_FirstRowY) / m_SpacingY;
+  const double u1 = (x1 - m_FirstColumnX) / m_SpacingX;
+  const double v1 = (y1 - m_FirstRowY) / m_SpacingY;
+
+  const int firstRow = std::max(0, static_cast<int>(std::ceil(std::min(v0, v1) - 0.5 - CellMargin)));
+  const int lastRow  = std::min(nbRows - 1, static_cast<int>(std::floor(std::max(v0, v1) + 0.5 + CellMargin)));
+
+  for (int row = firstRow; row <= lastRow; ++row)
+  {
+    double uMin, uMax;
+    if (!ClipToBand(u0, v0, u1, v1, row - 0.5 - CellMargin, row + 0.5 + CellMargin, uMin, uMax))
+    {
+      continue;
+    }
+    double     innerMin = 0., innerMax = -1.;
+    const bool inner    = ClipToBand(u0, v0, u1, v1, row - 0.5 + CellMargin, row + 0.5 - CellMargin, innerMin, innerMax);
+
+    const int firstColumn = std::max(0, static_cast<int>(std::ceil(uMin - 0.5 - CellMargin)));
+    const int lastColumn  = std::min(nbColumns - 1, static_cast<int>(std::floor(uMax + 0.5 + CellMargin)));
+    for (int column = firstColumn; column <= lastColumn; ++column)
+    {
+      CellType cell;
+      cell.row     = static_cast<unsigned int>(row);
+      cell.column  = static_cast<unsigned int>(column);
+      cell.certain = inner && innerMax >= column - 0.5 + CellMargin && innerMin <= column + 0.5 - CellMargin;
+      cells.push_back(cell);
+    }
+  }
+}
+
+void ScanlineRasterizer::SortCells(CellListType& cells)
+{
+  std::sort(cells.begin(), cells.end(), [](const CellType& a, const CellType& b) { return a.row < b.row || (a.row == b.row && a.column < b.column); });
+
+  unsigned int count = 0;
+  for (unsigned int i = 0; i < cells.size(); ++i)
+  {
+    if (count > 0 && cells[count - 1].row == cells[i].row && cells[count - 1].column == cells[i].column)
+    {
+      cells[count - 1].certain = cells[count - 1].certain || cells[i].certain;
+    }
+    else
+    {
+      cells[count++] = cells[i];
+    }
+  }
+  cells.resize(count);
+}
+
+void ScanlineRasterizer::RasterizeLine(const std::vector<double>& x, const std::vector<double>& y, CellListType& cells) const
+{
+  assert(x.size() == y.size());
+  cells.clear();
+  if (m_ColumnX.empty() || m_RowY.empty() || x.empty())
+  {
+    return;
+  }
+  if (x.size() == 1)
+  {
+    RasterizeSegment(x[0], y[0], x[0], y[0], cells);
+  }
+  for (unsigned int i = 1; i < x.size(); ++i)
+  {
+    RasterizeSegment(x[i - 1], y[i - 1], x[i], y[i], cells);
+  }
+  SortCells(cells);
+}
+
+void ScanlineRasterizer::RasterizeBoundary(CellListType& cells) const
+{
+  cells.clear();
+  if (m_ColumnX.empty() || m_RowY.empty())
+  {
+    return;
+  }
+  for (unsigned int ring = 0; ring < m_NumberOfRings; ++ring)
+  {
+    const std::vector<double>& x = m_RingX[ring];
+    const std::vector<double>& y = m_RingY[ring];
+    for (unsigned int i = 0; i < x.size(); ++i)
+    {
+      const unsigned int previous = (i == 0) ? static_cast<unsigned int>(x.size()) - 1 : i - 1;
+      RasterizeSegment(x[previous], y[previous], x[i], y[i], cells);
+    }
+  }
+  SortCells(cells);
+}
+
+} // end namespace otb
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include "otbSampleNeighborSearch.h"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+int otbSampleNeighborSearch(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  std::mt19937 generator(0);
+
+  unsigned int nbErrors = 0;
+  for (unsigned int trial = 0; trial < 12; ++trial)
+  {
+    const unsigned int nbSamples = 50 + 300 * (trial % 4);
+    const unsigned int dimension = 1 + (trial * 3) % 7;
+    const unsigned int k         = 1 + trial % 6;
+
+    // Samples on a coarse grid, so that many distances are equal
+    std::uniform_int_distribution<int> valueDist(0, 6);
+    std::vector<double>                samples(static_cast<size_t>(nbSamples) * dimension);
+    for (auto& value : samples)
+    {
+      value = 0.5 * valueDist(generator);
+    }
+
+    otb::SampleNeighborSearch treeSearch, exhaustiveSearch;
+    treeSearch.SetMode(otb::SampleNeighborSearch::KD_TREE);
+    exhaustiveSearch.SetMode(otb::SampleNeighborSearch::EXHAUSTIVE);
+    treeSearch.SetSamples(samples, dimension);
+    exhaustiveSearch.SetSamples(samples, dimension);
+
+    std::vector<unsigned int> treeIndices(static_cast<size_t>(nbSamples) * k), exhaustiveIndices(static_cast<size_t>(nbSamples) * k);
+    std::vector<double>       treeDistances(treeIndices.size()), exhaustiveDistances(treeIndices.size());
+    treeSearch.Search(0, nbSamples, k, treeIndices.data(), treeDistances.data());
+    // Several calls, as done by the threads
+    for (unsigned int first = 0; first < nbSamples; first += 37)
+    {
+      const unsigned int nbQueries = std::min(37u, nbSamples - first);
+      exhaustiveSearch.Search(first, nbQueries, k, &exhaustiveIndices[static_cast<size_t>(first) * k], &exhaustiveDistances[static_cast<size_t>(first) * k]);
+    }
+
+    // Reference: sort all the other samples by (distance, index)
+    for (unsigned int q = 0; q < nbSamples; ++q)
+    {
+      std::vector<std::pair<double, unsigned int>> candidates;
+      for (unsigned int i = 0; i < nbSamples; ++i)
+      {
+        if (i != q)
+        {
+          candidates.emplace_back(
+              otb::SampleNeighborSearch::SquaredDistance(&samples[static_cast<size_t>(q) * dimension], &samples[static_cast<size_t>(i) * dimension], dimension),
+              i);
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      for (unsigned int n = 0; n < k; ++n)
+      {
+        const size_t pos = static_cast<size_t>(q) * k + n;
+        if (treeIndices[pos] != candidates[n].second || treeDistances[pos] != candidates[n].first || exhaustiveIndices[pos] != candidates[n].second ||
+            exhaustiveDistances[pos] != candidates[n].first)
+        {
+          ++nbErrors;
+        }
+      }
+    }
+  }
+
+  if (nbErrors > 0)
+  {
+    std::cout << nbErrors << " wrong neighbors" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
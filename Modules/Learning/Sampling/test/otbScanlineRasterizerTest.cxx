@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include "otbScanlineRasterizer.h"
+#include "ogr_geometry.h"
+#include <iostream>
+#include <random>
+
+int otbScanlineRasterizer(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // North-up grid of 40 x 30 pixels, vertices lying on pixel centers and
+  // borders to stress the ties of the point in ring test
+  const unsigned int  nbColumns = 40;
+  const unsigned int  nbRows    = 30;
+  const double        originX = 1000.25, originY = 5000.75, spacingX = 0.5, spacingY = -0.5;
+  std::vector<double> columnX(nbColumns), rowY(nbRows);
+  for (unsigned int i = 0; i < nbColumns; ++i)
+  {
+    columnX[i] = originX + spacingX * i;
+  }
+  for (unsigned int j = 0; j < nbRows; ++j)
+  {
+    rowY[j] = originY + spacingY * j;
+  }
+
+  std::mt19937                                generator(0);
+  std::uniform_int_distribution<unsigned int> columnDist(0, 2 * nbColumns - 2), rowDist(0, 2 * nbRows - 2);
+
+  unsigned int nbErrors = 0;
+  for (unsigned int trial = 0; trial < 50; ++trial)
+  {
+    otb::ScanlineRasterizer rasterizer;
+    if (!rasterizer.SetGrid(columnX, rowY, spacingX, spacingY))
+    {
+      std::cout << "Grid rejected" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    OGRPolygon polygon;
+    for (unsigned int k = 0; k < 1 + trial % 3; ++k)
+    {
+      OGRLinearRing       ring;
+      std::vector<double> x, y;
+      for (unsigned int i = 0; i < 3 + trial % 7; ++i)
+      {
+        x.push_back(originX + 0.5 * spacingX * columnDist(generator));
+        y.push_back(originY + 0.5 * spacingY * rowDist(generator));
+      }
+      x.push_back(x.front());
+      y.push_back(y.front());
+      for (unsigned int i = 0; i < x.size(); ++i)
+      {
+        ring.addPoint(x[i], y[i]);
+      }
+      polygon.addRing(&ring);
+      rasterizer.AddRing(x, y);
+    }
+
+    std::vector<otb::ScanlineRasterizer::SpanListType> rowSpans;
+    rasterizer.RasterizePolygon(rowSpans);
+
+    otb::ScanlineRasterizer::CellListType cells;
+    std::vector<double>                   lineX, lineY;
+    for (int i = 0; i < polygon.getExteriorRing()->getNumPoints(); ++i)
+    {
+      lineX.push_back(polygon.getExteriorRing()->getX(i));
+      lineY.push_back(polygon.getExteriorRing()->getY(i));
+    }
+    rasterizer.RasterizeLine(lineX, lineY, cells);
+    OGRLineString line;
+    line.setPoints(static_cast<int>(lineX.size()), lineX.data(), lineY.data());
+
+    auto cellIt = cells.cbegin();
+    for (unsigned int j = 0; j < nbRows; ++j)
+    {
+      std::vector<bool> inPolygon(nbColumns, false);
+      for (const auto& span : rowSpans[j])
+      {
+        for (unsigned int i = span.first; i < span.second; ++i)
+        {
+          inPolygon[i] = true;
+        }
+      }
+
+      for (unsigned int i = 0; i < nbColumns; ++i)
+      {
+        // Reference: the pixel by pixel tests of PersistentSamplingFilterBase
+        OGRPoint point(columnX[i], rowY[j]);
+        bool     expected = polygon.getExteriorRing()->isPointInRing(&point);
+        for (int k = 0; expected && k < polygon.getNumInteriorRings(); ++k)
+        {
+          expected = !polygon.getInteriorRing(k)->isPointInRing(&point);
+        }
+        if (inPolygon[i] != expected)
+        {
+          std::cout << "Polygon " << trial << ", pixel (" << i << ", " << j << "): got " << inPolygon[i] << ", expected " << expected << std::endl;
+          ++nbErrors;
+        }
+
+        OGRPolygon    square;
+        OGRLinearRing squareRing;
+        squareRing.addPoint(columnX[i] - 0.25, rowY[j] - 0.25);
+        squareRing.addPoint(columnX[i] + 0.25, rowY[j] - 0.25);
+        squareRing.addPoint(columnX[i] + 0.25, rowY[j] + 0.25);
+        squareRing.addPoint(columnX[i] - 0.25, rowY[j] + 0.25);
+        squareRing.addPoint(columnX[i] - 0.25, rowY[j] - 0.25);
+        square.addRing(&squareRing);
+        const bool onLine = line.Intersects(&square);
+
+        bool listed = false, certain = false;
+        if (cellIt != cells.cend() && cellIt->row == j && cellIt->column == i)
+        {
+          listed  = true;
+          certain = cellIt->certain;
+          ++cellIt;
+        }
+        if ((onLine && !listed) || (!onLine && certain))
+        {
+          std::cout << "Line " << trial << ", pixel (" << i << ", " << j << "): intersects " << onLine << ", listed " << listed << ", certain " << certain
+                    << std::endl;
+          ++nbErrors;
+        }
+      }
+    }
+  }
+
+  if (nbErrors > 0)
+  {
+    std::cout << nbErrors << " errors" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
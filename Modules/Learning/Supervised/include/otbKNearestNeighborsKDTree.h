@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbKNearestNeighborsKDTree_h
+#define otbKNearestNeighborsKDTree_h
+
+#include "OTBSupervisedExport.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class KNearestNeighborsKDTree
+ * \brief Exact K nearest neighbors search in a KD-tree.
+ *
+ * The tree is built once over a set of training samples (median splits on
+ * the dimension of largest spread) and can then be queried concurrently
+ * from several threads.
+ *
+ * The search is exact and reproduces the brute force search of
+ * cv::ml::KNearest: squared distances are accumulated in single precision
+ * with the same grouping of terms, neighbors are sorted by increasing
+ * distance, and equal distances are sorted by increasing training index.
+ * Pruning uses a conservative bound, so the tree never discards a neighbor
+ * that the brute force search would have kept.
+ *
+ * \ingroup OTBSupervised
+ */
+class OTBSupervised_EXPORT KNearestNeighborsKDTree
+{
+public:
+  KNearestNeighborsKDTree();
+
+  /** Build the tree over nbSamples row-major samples. The samples are copied. */
+  void Build(const float* samples, unsigned int nbSamples, unsigned int dimension);
+
+  /** Remove all samples */
+  void Clear();
+
+  bool IsEmpty() const
+  {
+    return m_NumberOfSamples == 0;
+  }
+
+  unsigned int GetNumberOfSamples() const
+  {
+    return m_NumberOfSamples;
+  }
+
+  unsigned int GetDimension() const
+  {
+    return m_Dimension;
+  }
+
+  /** Find the k nearest samples of query. indices and distances must hold k
+   * values, and receive the training indices and squared distances of the
+   * neighbors, sorted by increasing distance. Returns the number of
+   * neighbors found, which is min(k, GetNumberOfSamples()). */
+  unsigned int Search(const float* query, unsigned int k, unsigned int* indices, float* distances) const;
+
+  /** Squared euclidean distance, computed as in cv::ml::KNearest */
+  static float SquaredDistance(const float* u, const float* v, unsigned int dimension);
+
+private:
+  struct Node
+  {
+    unsigned int begin;
+    unsigned int end;
+    int          splitDimension; // -1 for leaves
+    float        splitValue;
+    unsigned int left;
+    unsigned int right;
+  };
+
+  unsigned int BuildNode(unsigned int begin, unsigned int end);
+
+  void SearchNode(unsigned int nodeId, const float* query, unsigned int k, unsigned int* indices, float* distances, unsigned int& count) const;
+
+  unsigned int m_Dimension;
+  unsigned int m_NumberOfSamples;
+
+  /** Safety factor applied to the pruning bound */
+  double m_PruningFactor;
+
+  /** Samples in tree order, so that leaves are contiguous */
+  std::vector<float> m_Samples;
+
+  /** Training index of each sample, in tree order */
+  std::vector<unsigned int> m_Indices;
+
+  std::vector<Node> m_Nodes;
+};
+
+} // end namespace otb
+
+#endif
@@ -26,6 +26,7 @@
 #include "itkLightObject.h"
 #include "itkFixedArray.h"
 #include "otbMachineLearningModel.h"
+#include "otbKNearestNeighborsKDTree.h"
 
 #include "otbOpenCVUtils.h"
 
@@ -41,14 +42,17 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef typename Superclass::InputValueType       InputValueType;
-  typedef typename Superclass::InputSampleType      InputSampleType;
-  typedef typename Superclass::InputListSampleType  InputListSampleType;
-  typedef typename Superclass::TargetValueType      TargetValueType;
-  typedef typename Superclass::TargetSampleType     TargetSampleType;
-  typedef typename Superclass::TargetListSampleType TargetListSampleType;
-  typedef typename Superclass::ConfidenceValueType  ConfidenceValueType;
-  typedef typename Superclass::ProbaSampleType      ProbaSampleType;
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ConfidenceSampleType     ConfidenceSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
   /** Run-time type information (and related methods). */
   itkNewMacro(Self);
   itkTypeMacro(KNearestNeighborsMachineLearningModel, MachineLearningModel);
@@ -106,6 +110,12 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict values for a range of samples. The nearest neighbors are searched
+   * in a KD-tree built once over the training samples; the outputs are the
+   * same as DoPredict(), which uses the OpenCV brute force search. */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -113,11 +123,18 @@ private:
   KNearestNeighborsMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Build m_SearchTree and m_Responses from the training samples */
+  void BuildSearchTree(const cv::Mat& samples, const cv::Mat& responses);
+
   cv::Ptr<cv::ml::KNearest> m_KNearestModel;
 
   int m_K;
 
   int m_DecisionRule;
+
+  /** Index of the training samples, and their responses, for batch prediction */
+  KNearestNeighborsKDTree m_SearchTree;
+  std::vector<float>      m_Responses;
 };
 } // end namespace otb
 
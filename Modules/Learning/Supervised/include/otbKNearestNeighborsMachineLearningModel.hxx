@@ -27,6 +27,7 @@
 
 #include <fstream>
 #include <set>
+#include <algorithm>
 #include "itkMacro.h"
 
 namespace otb
@@ -76,6 +77,8 @@ void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::Train()
   m_KNearestModel->setIsClassifier(!this->m_RegressionMode);
   // setEmax() ?
   m_KNearestModel->train(cv::ml::TrainData::create(samples, cv::ml::ROW_SAMPLE, labels));
+
+  this->BuildSearchTree(samples, labels);
 }
 
 template <class TInputValue, class TTargetValue>
@@ -133,6 +136,132 @@ KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::DoPredict(cons
   return target;
 }
 
+template <class TInputValue, class TTargetValue>
+void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                      const unsigned int& size, TargetListSampleType* targets,
+                                                                                      ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  assert(input->Size() == targets->Size() && "Input sample list and target label list do not have the same size.");
+  assert(((quality == nullptr) || (quality->Size() == input->Size())) &&
+         "Quality samples list is not null and does not have the same size as input samples list");
+  assert(((proba == nullptr) || (input->Size() == proba->Size())) && "Proba sample list and target label list do not have the same size.");
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  if (m_SearchTree.IsEmpty() || proba != nullptr || m_K <= 0 || input->GetMeasurementVectorSize() != m_SearchTree.GetDimension())
+  {
+    Superclass::DoPredictBatch(input, startIndex, size, targets, quality, proba);
+    return;
+  }
+
+  const unsigned int k            = static_cast<unsigned int>(m_K);
+  const unsigned int dimension    = m_SearchTree.GetDimension();
+  const bool         isClassifier = m_KNearestModel->getIsClassifier();
+
+  std::vector<float>        sample(dimension);
+  std::vector<unsigned int> indices(k);
+  std::vector<float>        distances(k);
+  std::vector<float>        nearest(k);
+
+  for (unsigned int id = startIndex; id < startIndex + size; ++id)
+  {
+    const InputSampleType& inputSample = input->GetMeasurementVector(id);
+    for (unsigned int i = 0; i < dimension; ++i)
+    {
+      sample[i] = inputSample[i];
+    }
+
+    // Missing neighbors (less than k training samples) have a null response,
+    // as in the OpenCV search
+    const unsigned int found = m_SearchTree.Search(sample.data(), k, indices.data(), distances.data());
+    for (unsigned int n = 0; n < k; ++n)
+    {
+      nearest[n] = (n < found) ? m_Responses[indices[n]] : 0.f;
+    }
+
+    // Same decision as cv::ml::KNearest: the mean of the responses (summed in
+    // the neighbors order) for regression, the most frequent response (the
+    // lowest one in case of tie) for classification
+    float result = 0.f;
+    if (!isClassifier)
+    {
+      for (unsigned int n = 0; n < k; ++n)
+      {
+        result += nearest[n];
+      }
+      result = result * (1.f / k);
+    }
+    std::sort(nearest.begin(), nearest.end());
+    if (isClassifier)
+    {
+      unsigned int prevStart = 0;
+      unsigned int bestCount = 0;
+      result                 = nearest[0];
+      for (unsigned int n = 1; n <= k; ++n)
+      {
+        if (n == k || nearest[n] != nearest[n - 1])
+        {
+          if (bestCount < n - prevStart)
+          {
+            bestCount = n - prevStart;
+            result    = nearest[n - 1];
+          }
+          prevStart = n;
+        }
+      }
+    }
+
+    // compute quality if asked (only happens in classification mode)
+    if (quality != nullptr)
+    {
+      ConfidenceSampleType confidence;
+      confidence[0] = static_cast<ConfidenceValueType>(std::count(nearest.begin(), nearest.end(), result));
+      quality->SetMeasurementVector(id, confidence);
+    }
+
+    // MEDIAN is not an OpenCV decision rule
+    if (this->m_DecisionRule == KNN_MEDIAN)
+    {
+      result = nearest[k >> 1];
+    }
+
+    TargetSampleType target;
+    target[0] = static_cast<TTargetValue>(result);
+    targets->SetMeasurementVector(id, target);
+  }
+}
+
+template <class TInputValue, class TTargetValue>
+void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::BuildSearchTree(const cv::Mat& samples, const cv::Mat& responses)
+{
+  m_SearchTree.Clear();
+  m_Responses.clear();
+
+  if (samples.empty() || responses.total() != static_cast<size_t>(samples.rows))
+  {
+    return;
+  }
+
+  cv::Mat floatSamples, floatResponses;
+  samples.convertTo(floatSamples, CV_32F);
+  responses.convertTo(floatResponses, CV_32F);
+  if (!floatSamples.isContinuous())
+  {
+    floatSamples = floatSamples.clone();
+  }
+  floatResponses = floatResponses.clone();
+
+  m_Responses.assign(floatResponses.ptr<float>(0), floatResponses.ptr<float>(0) + floatResponses.total());
+  m_SearchTree.Build(floatSamples.ptr<float>(0), floatSamples.rows, floatSamples.cols);
+}
+
 template <class TInputValue, class TTargetValue>
 void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::Save(const std::string& filename, const std::string& name)
 {
@@ -171,6 +300,12 @@ void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::Load(cons
     m_KNearestModel->read(fs.getFirstTopLevelNode());
     m_DecisionRule = (int)(fs.getFirstTopLevelNode()["DecisionRule"]);
     m_K = m_KNearestModel->getDefaultK();
+
+    // The training samples are not exposed by cv::ml::KNearest, read them from the model file
+    cv::Mat samples, responses;
+    fs.getFirstTopLevelNode()["samples"] >> samples;
+    fs.getFirstTopLevelNode()["responses"] >> responses;
+    this->BuildSearchTree(samples, responses);
     return;
   }
   ifs.open(filename);
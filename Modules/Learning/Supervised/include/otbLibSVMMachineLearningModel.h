@@ -24,6 +24,7 @@
 #include "itkLightObject.h"
 #include "itkFixedArray.h"
 #include "otbMachineLearningModel.h"
+#include "otbSVMKernelBatchEvaluator.h"
 
 #include "svm.h"
 
@@ -39,14 +40,17 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef typename Superclass::InputValueType       InputValueType;
-  typedef typename Superclass::InputSampleType      InputSampleType;
-  typedef typename Superclass::InputListSampleType  InputListSampleType;
-  typedef typename Superclass::TargetValueType      TargetValueType;
-  typedef typename Superclass::TargetSampleType     TargetSampleType;
-  typedef typename Superclass::TargetListSampleType TargetListSampleType;
-  typedef typename Superclass::ConfidenceValueType  ConfidenceValueType;
-  typedef typename Superclass::ProbaSampleType      ProbaSampleType;
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ConfidenceSampleType     ConfidenceSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
   /** enum to choose the way confidence is computed
    *   CM_INDEX : compute the difference between highest and second highest probability
    *   CM_PROBA : returns probabilities for all classes
@@ -275,6 +279,14 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict values for a range of samples. When no probability estimate is
+   * involved and the kernel is linear, polynomial, RBF or sigmoid, the kernel
+   * matrix between the samples and the support vectors is computed block-wise
+   * and the decision functions are applied to the whole batch. Otherwise, this
+   * falls back to one DoPredict() call per sample. */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -292,6 +304,12 @@ private:
 
   void OptimizeParameters(void);
 
+  /** Copy the support vectors and decision functions of m_Model into m_BatchEvaluator */
+  void BuildBatchEvaluator(void);
+
+  /** Can DoPredictBatch() use m_BatchEvaluator for this request ? */
+  bool CanUseBatchEvaluator(bool withQuality, bool withProba) const;
+
   /** Container to hold the SVM model itself */
   struct svm_model* m_Model;
 
@@ -324,6 +342,9 @@ private:
 
   /** Temporary array to store cross-validation results */
   std::vector<double> m_TmpTarget;
+
+  /** Batch evaluation of the decision functions of m_Model */
+  SVMKernelBatchEvaluator m_BatchEvaluator;
 };
 } // end namespace otb
 
@@ -22,6 +22,8 @@
 #define otbLibSVMMachineLearningModel_hxx
 
 #include <fstream>
+#include <algorithm>
+#include <numeric>
 #include "otbLibSVMMachineLearningModel.h"
 #include "otbSVMCrossValidationCostFunction.h"
 #include "otbExhaustiveExponentialOptimizer.h"
@@ -96,6 +98,8 @@ void LibSVMMachineLearningModel<TInputValue, TOutputValue>::Train()
   m_Model = svm_train(&m_Problem, &m_Parameters);
 
   this->m_ConfidenceIndex = this->HasProbabilities();
+
+  this->BuildBatchEvaluator();
 }
 
 template <class TInputValue, class TOutputValue>
@@ -199,6 +203,213 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                           const unsigned int& size, TargetListSampleType* targets,
+                                                                           ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  assert(input->Size() == targets->Size() && "Input sample list and target label list do not have the same size.");
+  assert(((quality == nullptr) || (quality->Size() == input->Size())) &&
+         "Quality samples list is not null and does not have the same size as input samples list");
+  assert(((proba == nullptr) || (input->Size() == proba->Size())) && "Proba sample list and target label list do not have the same size.");
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  if (!this->CanUseBatchEvaluator(quality != nullptr, proba != nullptr))
+  {
+    Superclass::DoPredictBatch(input, startIndex, size, targets, quality, proba);
+    return;
+  }
+
+  const int          svm_type  = svm_get_svm_type(m_Model);
+  const unsigned int nr_class  = svm_get_nr_class(m_Model);
+  const unsigned int dimension = input->GetMeasurementVectorSize();
+  const unsigned int nbValues  = m_BatchEvaluator.GetNumberOfDecisionFunctions();
+
+  // Prob. model for test data: target value = predicted value + z
+  // z: Laplace distribution e^(-|z|/sigma)/(2sigma)
+  // sigma is output as confidence index
+  const double svrSigma = (quality != nullptr) ? svm_get_svr_probability(m_Model) : 0.;
+
+  // Samples are converted and evaluated by chunks to bound the memory footprint
+  const unsigned int  chunkSize = 1024;
+  std::vector<double> samples;
+  std::vector<double> decisionValues;
+
+  for (unsigned int chunkStart = startIndex; chunkStart < startIndex + size; chunkStart += chunkSize)
+  {
+    const unsigned int nbSamples = std::min(chunkSize, startIndex + size - chunkStart);
+
+    samples.resize(static_cast<size_t>(nbSamples) * dimension);
+    decisionValues.resize(static_cast<size_t>(nbSamples) * nbValues);
+
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      const InputSampleType& sample = input->GetMeasurementVector(chunkStart + s);
+      for (unsigned int i = 0; i < dimension; ++i)
+      {
+        samples[s * dimension + i] = sample[i];
+      }
+    }
+
+    m_BatchEvaluator.Evaluate(samples.data(), nbSamples, dimension, decisionValues.data());
+
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      const double*    values = &decisionValues[static_cast<size_t>(s) * nbValues];
+      TargetSampleType target;
+      target.Fill(0);
+
+      if (svm_type == ONE_CLASS)
+      {
+        target[0] = static_cast<TargetValueType>(values[0] > 0 ? 1 : -1);
+      }
+      else if (svm_type == EPSILON_SVR || svm_type == NU_SVR)
+      {
+        target[0] = static_cast<TargetValueType>(values[0]);
+      }
+      else
+      {
+        target[0] = static_cast<TargetValueType>(m_Model->label[SVMKernelBatchEvaluator::Vote(values, nr_class)]);
+      }
+      targets->SetMeasurementVector(chunkStart + s, target);
+
+      if (quality != nullptr)
+      {
+        ConfidenceSampleType confidence;
+        confidence[0] = static_cast<ConfidenceValueType>(svrSigma);
+        quality->SetMeasurementVector(chunkStart + s, confidence);
+      }
+    }
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+bool LibSVMMachineLearningModel<TInputValue, TOutputValue>::CanUseBatchEvaluator(bool withQuality, bool withProba) const
+{
+  if (m_BatchEvaluator.IsEmpty() || withProba)
+  {
+    return false;
+  }
+
+  const int svm_type = svm_get_svm_type(m_Model);
+  if (!withQuality)
+  {
+    // DoPredict() calls svm_predict_probability() as soon as the model has
+    // probabilities, which may give a different label than the decision values
+    return !svm_check_probability_model(m_Model);
+  }
+
+  // The SVR confidence index is a model constant, all other confidence modes
+  // need probability estimates or per-sample hyperplane distances
+  return this->m_ConfidenceIndex && m_ConfidenceMode == CM_INDEX && (svm_type == EPSILON_SVR || svm_type == NU_SVR);
+}
+
+template <class TInputValue, class TOutputValue>
+void LibSVMMachineLearningModel<TInputValue, TOutputValue>::BuildBatchEvaluator()
+{
+  m_BatchEvaluator.Clear();
+
+  if (m_Model == nullptr || m_Model->l == 0)
+  {
+    return;
+  }
+
+  const svm_parameter& param = m_Model->param;
+  switch (param.kernel_type)
+  {
+  case LINEAR:
+    m_BatchEvaluator.SetKernel(SVMKernelBatchEvaluator::LINEAR, param.gamma, param.coef0, param.degree);
+    break;
+  case POLY:
+    m_BatchEvaluator.SetKernel(SVMKernelBatchEvaluator::POLY, param.gamma, param.coef0, param.degree);
+    break;
+  case RBF:
+    m_BatchEvaluator.SetKernel(SVMKernelBatchEvaluator::RBF, param.gamma, param.coef0, param.degree);
+    break;
+  case SIGMOID:
+    m_BatchEvaluator.SetKernel(SVMKernelBatchEvaluator::SIGMOID, param.gamma, param.coef0, param.degree);
+    break;
+  default:
+    // Precomputed kernels are left to svm_predict()
+    return;
+  }
+
+  // Dense copy of the (sparse) support vectors
+  const int nbSV      = m_Model->l;
+  int       dimension = 1;
+  for (int i = 0; i < nbSV; ++i)
+  {
+    for (const svm_node* node = m_Model->SV[i]; node->index != -1; ++node)
+    {
+      dimension = std::max(dimension, node->index);
+    }
+  }
+
+  std::vector<double> supportVectors(static_cast<size_t>(nbSV) * dimension, 0.);
+  for (int i = 0; i < nbSV; ++i)
+  {
+    for (const svm_node* node = m_Model->SV[i]; node->index != -1; ++node)
+    {
+      if (node->index > 0)
+      {
+        supportVectors[static_cast<size_t>(i) * dimension + node->index - 1] = node->value;
+      }
+    }
+  }
+  m_BatchEvaluator.SetSupportVectors(supportVectors, dimension);
+
+  std::vector<unsigned int> indices;
+  std::vector<double>       coefs;
+
+  if (param.svm_type == ONE_CLASS || param.svm_type == EPSILON_SVR || param.svm_type == NU_SVR)
+  {
+    indices.resize(nbSV);
+    std::iota(indices.begin(), indices.end(), 0);
+    coefs.assign(m_Model->sv_coef[0], m_Model->sv_coef[0] + nbSV);
+    m_BatchEvaluator.AddDecisionFunction(indices, coefs, m_Model->rho[0]);
+    return;
+  }
+
+  // One-vs-one decision functions, in the same order as svm_predict_values():
+  // the support vectors are grouped by class, and the coefficients of the
+  // (i, j) classifier are in sv_coef[j-1] for class i and sv_coef[i] for class j
+  const int        nr_class = m_Model->nr_class;
+  std::vector<int> start(nr_class, 0);
+  for (int i = 1; i < nr_class; ++i)
+  {
+    start[i] = start[i - 1] + m_Model->nSV[i - 1];
+  }
+
+  int p = 0;
+  for (int i = 0; i < nr_class; ++i)
+  {
+    for (int j = i + 1; j < nr_class; ++j, ++p)
+    {
+      indices.clear();
+      coefs.clear();
+      for (int k = 0; k < m_Model->nSV[i]; ++k)
+      {
+        indices.push_back(start[i] + k);
+        coefs.push_back(m_Model->sv_coef[j - 1][start[i] + k]);
+      }
+      for (int k = 0; k < m_Model->nSV[j]; ++k)
+      {
+        indices.push_back(start[j] + k);
+        coefs.push_back(m_Model->sv_coef[i][start[j] + k]);
+      }
+      m_BatchEvaluator.AddDecisionFunction(indices, coefs, m_Model->rho[p]);
+    }
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void LibSVMMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& itkNotUsed(name))
 {
@@ -220,6 +431,8 @@ void LibSVMMachineLearningModel<TInputValue, TOutputValue>::Load(const std::stri
   m_Parameters = m_Model->param;
 
   this->m_ConfidenceIndex = this->HasProbabilities();
+
+  this->BuildBatchEvaluator();
 }
 
 template <class TInputValue, class TOutputValue>
@@ -389,6 +602,7 @@ void LibSVMMachineLearningModel<TInputValue, TOutputValue>::DeleteModel(void)
     svm_free_and_destroy_model(&m_Model);
   }
   m_Model = nullptr;
+  m_BatchEvaluator.Clear();
 }
 
 template <class TInputValue, class TOutputValue>
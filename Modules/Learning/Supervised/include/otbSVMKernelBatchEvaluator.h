@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSVMKernelBatchEvaluator_h
+#define otbSVMKernelBatchEvaluator_h
+
+#include "OTBSupervisedExport.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class SVMKernelBatchEvaluator
+ * \brief Evaluate the decision functions of a trained SVM on a batch of samples.
+ *
+ * The support vectors are stored as a dense row-major matrix. For a block of
+ * samples, the dot products with every support vector are computed at once
+ * (a matrix product between the sample block and the transposed support
+ * vector matrix), and the kernel is then applied element-wise using the
+ * dot-product expansion:
+ *
+ * - linear: \f$ u'v \f$
+ * - polynomial: \f$ (\gamma u'v + c_0)^d \f$
+ * - radial basis function: \f$ \exp(-\gamma (|u|^2 + |v|^2 - 2u'v)) \f$
+ * - sigmoid: \f$ \tanh(\gamma u'v + c_0) \f$
+ *
+ * Each decision function is a sparse combination of the kernel values,
+ * \f$ f(x) = \sum_k \alpha_k K(x, sv_{i_k}) - \rho \f$. For one-vs-one
+ * classifiers, the decision functions are expected in the usual (i, j),
+ * i < j order, and Vote() returns the index of the winning class.
+ *
+ * This class holds no reference to the SVM library it was built from: the
+ * LibSVM and OpenCV models fill it once after training or loading, and use it
+ * in DoPredictBatch(). Evaluate() is const and allocates its own buffers, so it
+ * can be called concurrently from several threads.
+ *
+ * \ingroup OTBSupervised
+ */
+class OTBSupervised_EXPORT SVMKernelBatchEvaluator
+{
+public:
+  typedef enum { LINEAR, POLY, RBF, SIGMOID } KernelType;
+
+  SVMKernelBatchEvaluator();
+
+  /** Set the kernel type and its parameters */
+  void SetKernel(KernelType type, double gamma, double coef0, double degree);
+
+  /** Set the support vectors, as a row-major nbSupportVectors x dimension matrix */
+  void SetSupportVectors(const std::vector<double>& supportVectors, unsigned int dimension);
+
+  /** Append a decision function sum_k coefs[k] * K(x, sv[indices[k]]) - rho */
+  void AddDecisionFunction(const std::vector<unsigned int>& indices, const std::vector<double>& coefs, double rho);
+
+  /** Remove the support vectors and decision functions */
+  void Clear();
+
+  /** Is the evaluator ready to be used ? */
+  bool IsEmpty() const
+  {
+    return m_Rho.empty();
+  }
+
+  unsigned int GetNumberOfSupportVectors() const
+  {
+    return m_NumberOfSupportVectors;
+  }
+
+  unsigned int GetNumberOfDecisionFunctions() const
+  {
+    return static_cast<unsigned int>(m_Rho.size());
+  }
+
+  unsigned int GetDimension() const
+  {
+    return m_Dimension;
+  }
+
+  /** Evaluate every decision function on nbSamples samples.
+   * samples is a row-major nbSamples x sampleDimension matrix. Components
+   * beyond the support vectors dimension are considered to be zero in the
+   * support vectors. decisionValues must hold
+   * nbSamples x GetNumberOfDecisionFunctions() values, row-major. */
+  void Evaluate(const double* samples, unsigned int nbSamples, unsigned int sampleDimension, double* decisionValues) const;
+
+  /** One-vs-one vote from the nbClasses * (nbClasses - 1) / 2 decision values of
+   * a sample. A positive value votes for the first class of the pair. Ties are
+   * resolved in favor of the lowest class index. */
+  static unsigned int Vote(const double* decisionValues, unsigned int nbClasses);
+
+private:
+  void ComputeKernelBlock(const double* samples, unsigned int nbSamples, unsigned int sampleDimension, double* kernel) const;
+
+  KernelType m_KernelType;
+  double     m_Gamma;
+  double     m_Coef0;
+  double     m_Degree;
+
+  unsigned int m_Dimension;
+  unsigned int m_NumberOfSupportVectors;
+
+  /** Dense support vectors, row-major */
+  std::vector<double> m_SupportVectors;
+
+  /** Squared norm of each support vector (RBF kernel) */
+  std::vector<double> m_SupportVectorsSquaredNorm;
+
+  /** Decision functions, in compressed row storage */
+  std::vector<unsigned int> m_Offsets;
+  std::vector<unsigned int> m_Indices;
+  std::vector<double>       m_Coefs;
+  std::vector<double>       m_Rho;
+};
+
+} // end namespace otb
+
+#endif
@@ -25,6 +25,7 @@
 #include "itkLightObject.h"
 #include "itkFixedArray.h"
 #include "otbMachineLearningModel.h"
+#include "otbSVMKernelBatchEvaluator.h"
 
 #include "otbOpenCVUtils.h"
 
@@ -48,14 +49,17 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef typename Superclass::InputValueType       InputValueType;
-  typedef typename Superclass::InputSampleType      InputSampleType;
-  typedef typename Superclass::InputListSampleType  InputListSampleType;
-  typedef typename Superclass::TargetValueType      TargetValueType;
-  typedef typename Superclass::TargetSampleType     TargetSampleType;
-  typedef typename Superclass::TargetListSampleType TargetListSampleType;
-  typedef typename Superclass::ConfidenceValueType  ConfidenceValueType;
-  typedef typename Superclass::ProbaSampleType      ProbaSampleType;
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ConfidenceSampleType     ConfidenceSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
   /** Run-time type information (and related methods). */
   itkNewMacro(Self);
   itkTypeMacro(SVMMachineLearningModel, MachineLearningModel);
@@ -138,12 +142,23 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict values for a range of samples. For linear, polynomial, RBF and
+   * sigmoid kernels, the kernel matrix between the samples and the support
+   * vectors is computed block-wise and the decision functions are applied to
+   * the whole batch. Other kernels fall back to one DoPredict() call per sample. */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
 private:
   SVMMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
+
+  /** Copy the support vectors and decision functions of m_SVMModel into m_BatchEvaluator */
+  void BuildBatchEvaluator(const cv::Mat& classLabels);
+
   cv::Ptr<cv::ml::SVM> m_SVMModel;
   int    m_SVMType;
   int    m_KernelType;
@@ -164,6 +179,9 @@ private:
   double m_OutputC;
   double m_OutputNu;
   double m_OutputP;
+  // Batch prediction
+  SVMKernelBatchEvaluator m_BatchEvaluator;
+  std::vector<int>        m_ClassLabels;
 };
 } // end namespace otb
 
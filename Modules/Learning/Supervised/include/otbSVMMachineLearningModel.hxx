@@ -22,6 +22,8 @@
 #define otbSVMMachineLearningModel_hxx
 
 #include <fstream>
+#include <algorithm>
+#include <cmath>
 #include "itkMacro.h"
 #include "otbSVMMachineLearningModel.h"
 #include "otbOpenCVUtils.h"
@@ -92,13 +94,15 @@ void SVMMachineLearningModel<TInputValue, TOutputValue>::Train()
   m_SVMModel->setP(m_P);
   m_SVMModel->setTermCriteria(cv::TermCriteria(m_TermCriteriaType, m_MaxIter, m_Epsilon));
 
+  cv::Ptr<cv::ml::TrainData> trainData =
+      cv::ml::TrainData::create(samples, cv::ml::ROW_SAMPLE, labels, cv::noArray(), cv::noArray(), cv::noArray(), var_type);
   if (!m_ParameterOptimization)
   {
-    m_SVMModel->train(cv::ml::TrainData::create(samples, cv::ml::ROW_SAMPLE, labels, cv::noArray(), cv::noArray(), cv::noArray(), var_type));
+    m_SVMModel->train(trainData);
   }
   else
   {
-    m_SVMModel->trainAuto(cv::ml::TrainData::create(samples, cv::ml::ROW_SAMPLE, labels, cv::noArray(), cv::noArray(), cv::noArray(), var_type));
+    m_SVMModel->trainAuto(trainData);
   }
 
   m_OutputDegree = m_SVMModel->getDegree();
@@ -107,6 +111,8 @@ void SVMMachineLearningModel<TInputValue, TOutputValue>::Train()
   m_OutputC      = m_SVMModel->getC();
   m_OutputNu     = m_SVMModel->getNu();
   m_OutputP      = m_SVMModel->getP();
+
+  this->BuildBatchEvaluator(this->m_RegressionMode ? cv::Mat() : trainData->getClassLabels());
 }
 
 template <class TInputValue, class TOutputValue>
@@ -133,6 +139,178 @@ SVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampleT
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void SVMMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                        const unsigned int& size, TargetListSampleType* targets,
+                                                                        ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  assert(input != nullptr);
+  assert(targets != nullptr);
+
+  assert(input->Size() == targets->Size() && "Input sample list and target label list do not have the same size.");
+  assert(((quality == nullptr) || (quality->Size() == input->Size())) &&
+         "Quality samples list is not null and does not have the same size as input samples list");
+  assert(((proba == nullptr) || (input->Size() == proba->Size())) && "Proba sample list and target label list do not have the same size.");
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  const int svmType = m_SVMModel->getType();
+
+  // The raw output of a one class SVM depends on the OpenCV version
+  if (m_BatchEvaluator.IsEmpty() || proba != nullptr || (quality != nullptr && svmType == cv::ml::SVM::ONE_CLASS))
+  {
+    Superclass::DoPredictBatch(input, startIndex, size, targets, quality, proba);
+    return;
+  }
+
+  const bool         isClassifier = (svmType == cv::ml::SVM::C_SVC || svmType == cv::ml::SVM::NU_SVC);
+  const unsigned int nbClasses    = static_cast<unsigned int>(m_ClassLabels.size());
+  const unsigned int dimension    = input->GetMeasurementVectorSize();
+  const unsigned int nbValues     = m_BatchEvaluator.GetNumberOfDecisionFunctions();
+
+  // Samples are converted and evaluated by chunks to bound the memory footprint
+  const unsigned int  chunkSize = 1024;
+  std::vector<double> samples;
+  std::vector<double> decisionValues;
+
+  for (unsigned int chunkStart = startIndex; chunkStart < startIndex + size; chunkStart += chunkSize)
+  {
+    const unsigned int nbSamples = std::min(chunkSize, startIndex + size - chunkStart);
+
+    samples.resize(static_cast<size_t>(nbSamples) * dimension);
+    decisionValues.resize(static_cast<size_t>(nbSamples) * nbValues);
+
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      const InputSampleType& sample = input->GetMeasurementVector(chunkStart + s);
+      for (unsigned int i = 0; i < dimension; ++i)
+      {
+        samples[s * dimension + i] = sample[i];
+      }
+    }
+
+    m_BatchEvaluator.Evaluate(samples.data(), nbSamples, dimension, decisionValues.data());
+
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      const double*    values = &decisionValues[static_cast<size_t>(s) * nbValues];
+      TargetSampleType target;
+      // Same conventions as cv::ml::SVM::predict() and its RAW_OUTPUT flag
+      double rawOutput = values[nbValues - 1];
+
+      if (isClassifier)
+      {
+        const double label = m_ClassLabels[SVMKernelBatchEvaluator::Vote(values, nbClasses)];
+        target[0]          = static_cast<TOutputValue>(label);
+        if (nbClasses != 2)
+        {
+          rawOutput = label;
+        }
+      }
+      else if (svmType == cv::ml::SVM::ONE_CLASS)
+      {
+        target[0] = static_cast<TOutputValue>(values[0] > 0 ? 1 : 0);
+      }
+      else
+      {
+        target[0] = static_cast<TOutputValue>(static_cast<float>(values[0]));
+      }
+      targets->SetMeasurementVector(chunkStart + s, target);
+
+      if (quality != nullptr)
+      {
+        ConfidenceSampleType confidence;
+        confidence[0] = static_cast<ConfidenceValueType>(static_cast<float>(rawOutput));
+        quality->SetMeasurementVector(chunkStart + s, confidence);
+      }
+    }
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void SVMMachineLearningModel<TInputValue, TOutputValue>::BuildBatchEvaluator(const cv::Mat& classLabels)
+{
+  m_BatchEvaluator.Clear();
+  m_ClassLabels.clear();
+
+  if (m_SVMModel.empty() || !m_SVMModel->isTrained())
+  {
+    return;
+  }
+
+  const double gamma  = m_SVMModel->getGamma();
+  const double coef0  = m_SVMModel->getCoef0();
+  const double degree = m_SVMModel->getDegree();
+  switch (m_SVMModel->getKernelType())
+  {
+  case cv::ml::SVM::LINEAR:
+    m_BatchEvaluator.SetKernel(SVMKernelBatchEvaluator::LINEAR, gamma, coef0, degree);
+    break;
+  case cv::ml::SVM::POLY:
+    // cv::pow() uses absolute values for non-integer powers
+    if (std::floor(degree) != degree)
+    {
+      return;
+    }
+    m_BatchEvaluator.SetKernel(SVMKernelBatchEvaluator::POLY, gamma, coef0, degree);
+    break;
+  case cv::ml::SVM::RBF:
+    m_BatchEvaluator.SetKernel(SVMKernelBatchEvaluator::RBF, gamma, coef0, degree);
+    break;
+  case cv::ml::SVM::SIGMOID:
+    // OpenCV evaluates this kernel as -tanh(gamma*u'v + coef0)
+    m_BatchEvaluator.SetKernel(SVMKernelBatchEvaluator::SIGMOID, -gamma, -coef0, degree);
+    break;
+  default:
+    // CHI2, INTER and custom kernels are left to cv::ml::SVM::predict()
+    return;
+  }
+
+  const int    svmType      = m_SVMModel->getType();
+  const bool   isClassifier = (svmType == cv::ml::SVM::C_SVC || svmType == cv::ml::SVM::NU_SVC);
+  unsigned int nbFunctions  = 1;
+  if (isClassifier)
+  {
+    if (classLabels.empty())
+    {
+      return;
+    }
+    cv::Mat labels;
+    classLabels.convertTo(labels, CV_32S);
+    m_ClassLabels.assign(labels.begin<int>(), labels.end<int>());
+    nbFunctions = static_cast<unsigned int>(m_ClassLabels.size() * (m_ClassLabels.size() - 1) / 2);
+  }
+
+  // With a linear kernel, OpenCV stores one compressed support vector per
+  // decision function; the decision function indices refer to them
+  cv::Mat supportVectors = m_SVMModel->getSupportVectors();
+  cv::Mat svDouble;
+  supportVectors.convertTo(svDouble, CV_64F);
+  const unsigned int  dimension = static_cast<unsigned int>(svDouble.cols);
+  std::vector<double> dense(static_cast<size_t>(svDouble.rows) * dimension);
+  for (int r = 0; r < svDouble.rows; ++r)
+  {
+    std::copy(svDouble.ptr<double>(r), svDouble.ptr<double>(r) + dimension, dense.begin() + static_cast<size_t>(r) * dimension);
+  }
+  m_BatchEvaluator.SetSupportVectors(dense, dimension);
+
+  for (unsigned int f = 0; f < nbFunctions; ++f)
+  {
+    cv::Mat      alpha, svIndex;
+    const double rho = m_SVMModel->getDecisionFunction(f, alpha, svIndex);
+    cv::Mat      alphaDouble, svIndexInt;
+    alpha.convertTo(alphaDouble, CV_64F);
+    svIndex.convertTo(svIndexInt, CV_32S);
+    const std::vector<double>       coefs(alphaDouble.begin<double>(), alphaDouble.end<double>());
+    const std::vector<unsigned int> indices(svIndexInt.begin<int>(), svIndexInt.end<int>());
+    m_BatchEvaluator.AddDecisionFunction(indices, coefs, rho);
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void SVMMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
@@ -147,7 +325,16 @@ template <class TInputValue, class TOutputValue>
 void SVMMachineLearningModel<TInputValue, TOutputValue>::Load(const std::string& filename, const std::string& name)
 {
   cv::FileStorage fs(filename, cv::FileStorage::READ);
-  m_SVMModel->read(name.empty() ? fs.getFirstTopLevelNode() : fs[name]);
+  cv::FileNode    node = name.empty() ? fs.getFirstTopLevelNode() : fs[name];
+  m_SVMModel->read(node);
+
+  // The class labels are not exposed by cv::ml::SVM, read them from the model file
+  cv::Mat classLabels;
+  if (!node["class_labels"].empty())
+  {
+    node["class_labels"] >> classLabels;
+  }
+  this->BuildBatchEvaluator(classLabels);
 }
 
 template <class TInputValue, class TOutputValue>
@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbKNearestNeighborsKDTree.h"
+#include <algorithm>
+#include <cfloat>
+#include <limits>
+#include <numeric>
+
+namespace otb
+{
+
+namespace
+{
+// Maximum number of samples in a leaf
+const unsigned int LeafSize = 16;
+
+// (distance, index) lexicographic order, as in the brute force search
+inline bool IsCloser(float distance, unsigned int index, float refDistance, unsigned int refIndex)
+{
+  return distance < refDistance || (distance == refDistance && index < refIndex);
+}
+}
+
+KNearestNeighborsKDTree::KNearestNeighborsKDTree() : m_Dimension(0), m_NumberOfSamples(0), m_PruningFactor(1.)
+{
+}
+
+float KNearestNeighborsKDTree::SquaredDistance(const float* u, const float* v, unsigned int dimension)
+{
+  float        s = 0;
+  unsigned int i = 0;
+  for (; i + 4 <= dimension; i += 4)
+  {
+    float t0 = u[i] - v[i], t1 = u[i + 1] - v[i + 1];
+    float t2 = u[i + 2] - v[i + 2], t3 = u[i + 3] - v[i + 3];
+    s += t0 * t0 + t1 * t1 + t2 * t2 + t3 * t3;
+  }
+  for (; i < dimension; ++i)
+  {
+    float t0 = u[i] - v[i];
+    s += t0 * t0;
+  }
+  return s;
+}
+
+void KNearestNeighborsKDTree::Clear()
+{
+  m_Dimension       = 0;
+  m_NumberOfSamples = 0;
+  m_Samples.clear();
+  m_Indices.clear();
+  m_Nodes.clear();
+}
+
+void KNearestNeighborsKDTree::Build(const float* samples, unsigned int nbSamples, unsigned int dimension)
+{
+  Clear();
+  if (nbSamples == 0 || dimension == 0)
+  {
+    return;
+  }
+
+  m_Dimension       = dimension;
+  m_NumberOfSamples = nbSamples;
+  // The single precision distances may underestimate the exact ones by a
+  // relative error growing with the number of accumulated terms
+  m_PruningFactor = 1. - std::min(0.5, 4. * (dimension + 4) * FLT_EPSILON);
+  m_Samples.assign(samples, samples + static_cast<size_t>(nbSamples) * dimension);
+  m_Indices.resize(nbSamples);
+  std::iota(m_Indices.begin(), m_Indices.end(), 0);
+
+  m_Nodes.reserve(2 * (nbSamples / LeafSize + 1));
+  BuildNode(0, nbSamples);
+
+  // Store the samples in tree order
+  std::vector<float> ordered(m_Samples.size());
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    std::copy(&m_Samples[static_cast<size_t>(m_Indices[i]) * dimension], &m_Samples[static_cast<size_t>(m_Indices[i]) * dimension] + dimension,
+              &ordered[static_cast<size_t>(i) * dimension]);
+  }
+  m_Samples.swap(ordered);
+}
+
+unsigned int KNearestNeighborsKDTree::BuildNode(unsigned int begin, unsigned int end)
+{
+  const unsigned int nodeId = static_cast<unsigned int>(m_Nodes.size());
+  Node               node   = {begin, end, -1, 0.f, 0, 0};
+  m_Nodes.push_back(node);
+
+  if (end - begin <= LeafSize)
+  {
+    return nodeId;
+  }
+
+  // Split on the dimension of largest spread
+  int   splitDimension = -1;
+  float largestSpread  = 0.f;
+  for (unsigned int d = 0; d < m_Dimension; ++d)
+  {
+    float minValue = std::numeric_limits<float>::max();
+    float maxValue = std::numeric_limits<float>::lowest();
+    for (unsigned int i = begin; i < end; ++i)
+    {
+      const float value = m_Samples[static_cast<size_t>(m_Indices[i]) * m_Dimension + d];
+      minValue          = std::min(minValue, value);
+      maxValue          = std::max(maxValue, value);
+    }
+    if (maxValue - minValue > largestSpread)
+    {
+      largestSpread  = maxValue - minValue;
+      splitDimension = static_cast<int>(d);
+    }
+  }
+
+  // All samples are identical
+  if (splitDimension < 0)
+  {
+    return nodeId;
+  }
+
+  const unsigned int mid = begin + (end - begin) / 2;
+  const unsigned int dim = static_cast<unsigned int>(splitDimension);
+  std::nth_element(m_Indices.begin() + begin, m_Indices.begin() + mid, m_Indices.begin() + end, [this, dim](unsigned int a, unsigned int b) {
+    return m_Samples[static_cast<size_t>(a) * m_Dimension + dim] < m_Samples[static_cast<size_t>(b) * m_Dimension + dim];
+  });
+
+  const float        splitValue = m_Samples[static_cast<size_t>(m_Indices[mid]) * m_Dimension + dim];
+  const unsigned int left       = BuildNode(begin, mid);
+  const unsigned int right      = BuildNode(mid, end);
+
+  m_Nodes[nodeId].splitDimension = splitDimension;
+  m_Nodes[nodeId].splitValue     = splitValue;
+  m_Nodes[nodeId].left           = left;
+  m_Nodes[nodeId].right          = right;
+  return nodeId;
+}
+
+unsigned int KNearestNeighborsKDTree::Search(const float* query, unsigned int k, unsigned int* indices, float* distances) const
+{
+  unsigned int count = 0;
+  if (k > 0 && !m_Nodes.empty())
+  {
+    SearchNode(0, query, k, indices, distances, count);
+  }
+  return count;
+}
+
+void KNearestNeighborsKDTree::SearchNode(unsigned int nodeId, const float* query, unsigned int k, unsigned int* indices, float* distances,
+                                         unsigned int& count) const
+{
+  const Node& node = m_Nodes[nodeId];
+
+  if (node.splitDimension < 0)
+  {
+    for (unsigned int i = node.begin; i < node.end; ++i)
+    {
+      const float        distance = SquaredDistance(query, &m_Samples[static_cast<size_t>(i) * m_Dimension], m_Dimension);
+      const unsigned int index    = m_Indices[i];
+      if (count == k && !IsCloser(distance, index, distances[k - 1], indices[k - 1]))
+      {
+        continue;
+      }
+
+      // Sorted insertion
+      unsigned int pos = (count < k) ? count++ : k - 1;
+      while (pos > 0 && IsCloser(distance, index, distances[pos - 1], indices[pos - 1]))
+      {
+        distances[pos] = distances[pos - 1];
+        indices[pos]   = indices[pos - 1];
+        --pos;
+      }
+      distances[pos] = distance;
+      indices[pos]   = index;
+    }
+    return;
+  }
+
+  // Left samples are below or on the split value, right samples above or on it
+  const double       diff      = static_cast<double>(query[node.splitDimension]) - static_cast<double>(node.splitValue);
+  const bool         leftFirst = diff <= 0;
+  const unsigned int nearId    = leftFirst ? node.left : node.right;
+  const unsigned int farId     = leftFirst ? node.right : node.left;
+
+  SearchNode(nearId, query, k, indices, distances, count);
+
+  const double bound = diff * diff * m_PruningFactor;
+  if (count < k || bound <= static_cast<double>(distances[k - 1]))
+  {
+    SearchNode(farId, query, k, indices, distances, count);
+  }
+}
+
+} // end namespace otb
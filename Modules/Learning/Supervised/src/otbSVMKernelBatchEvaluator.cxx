@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSVMKernelBatchEvaluator.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace otb
+{
+
+namespace
+{
+// Number of samples whose kernel rows are computed together
+const unsigned int SampleBlockSize = 64;
+// Number of support vectors kept hot in cache while sweeping a sample block
+const unsigned int SupportVectorTileSize = 256;
+}
+
+SVMKernelBatchEvaluator::SVMKernelBatchEvaluator()
+  : m_KernelType(LINEAR), m_Gamma(1.), m_Coef0(0.), m_Degree(1.), m_Dimension(0), m_NumberOfSupportVectors(0)
+{
+  m_Offsets.push_back(0);
+}
+
+void SVMKernelBatchEvaluator::SetKernel(KernelType type, double gamma, double coef0, double degree)
+{
+  m_KernelType = type;
+  m_Gamma      = gamma;
+  m_Coef0      = coef0;
+  m_Degree     = degree;
+}
+
+void SVMKernelBatchEvaluator::SetSupportVectors(const std::vector<double>& supportVectors, unsigned int dimension)
+{
+  assert(dimension == 0 || supportVectors.size() % dimension == 0);
+
+  m_SupportVectors         = supportVectors;
+  m_Dimension              = dimension;
+  m_NumberOfSupportVectors = dimension ? static_cast<unsigned int>(supportVectors.size() / dimension) : 0;
+
+  m_SupportVectorsSquaredNorm.assign(m_NumberOfSupportVectors, 0.);
+  for (unsigned int v = 0; v < m_NumberOfSupportVectors; ++v)
+  {
+    const double* sv   = &m_SupportVectors[v * m_Dimension];
+    double        norm = 0.;
+    for (unsigned int d = 0; d < m_Dimension; ++d)
+    {
+      norm += sv[d] * sv[d];
+    }
+    m_SupportVectorsSquaredNorm[v] = norm;
+  }
+}
+
+void SVMKernelBatchEvaluator::AddDecisionFunction(const std::vector<unsigned int>& indices, const std::vector<double>& coefs, double rho)
+{
+  assert(indices.size() == coefs.size());
+
+  m_Indices.insert(m_Indices.end(), indices.begin(), indices.end());
+  m_Coefs.insert(m_Coefs.end(), coefs.begin(), coefs.end());
+  m_Offsets.push_back(static_cast<unsigned int>(m_Indices.size()));
+  m_Rho.push_back(rho);
+}
+
+void SVMKernelBatchEvaluator::Clear()
+{
+  m_Dimension              = 0;
+  m_NumberOfSupportVectors = 0;
+  m_SupportVectors.clear();
+  m_SupportVectorsSquaredNorm.clear();
+  m_Offsets.assign(1, 0);
+  m_Indices.clear();
+  m_Coefs.clear();
+  m_Rho.clear();
+}
+
+void SVMKernelBatchEvaluator::ComputeKernelBlock(const double* samples, unsigned int nbSamples, unsigned int sampleDimension, double* kernel) const
+{
+  const unsigned int nbSV      = m_NumberOfSupportVectors;
+  const unsigned int commonDim = std::min(sampleDimension, m_Dimension);
+
+  // Dot products: kernel = samples * supportVectors^T. The support vectors are
+  // swept by tiles so that each tile is reused for the whole sample block.
+  for (unsigned int tileStart = 0; tileStart < nbSV; tileStart += SupportVectorTileSize)
+  {
+    const unsigned int tileEnd = std::min(tileStart + SupportVectorTileSize, nbSV);
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      const double* x   = samples + static_cast<size_t>(s) * sampleDimension;
+      double*       row = kernel + static_cast<size_t>(s) * nbSV;
+      for (unsigned int v = tileStart; v < tileEnd; ++v)
+      {
+        const double* sv  = &m_SupportVectors[static_cast<size_t>(v) * m_Dimension];
+        double        dot = 0.;
+        for (unsigned int d = 0; d < commonDim; ++d)
+        {
+          dot += x[d] * sv[d];
+        }
+        row[v] = dot;
+      }
+    }
+  }
+
+  // Element-wise kernel
+  for (unsigned int s = 0; s < nbSamples; ++s)
+  {
+    double* row = kernel + static_cast<size_t>(s) * nbSV;
+    switch (m_KernelType)
+    {
+    case LINEAR:
+      break;
+    case POLY:
+      for (unsigned int v = 0; v < nbSV; ++v)
+      {
+        row[v] = std::pow(m_Gamma * row[v] + m_Coef0, m_Degree);
+      }
+      break;
+    case RBF:
+    {
+      const double* x          = samples + static_cast<size_t>(s) * sampleDimension;
+      double        sampleNorm = 0.;
+      for (unsigned int d = 0; d < sampleDimension; ++d)
+      {
+        sampleNorm += x[d] * x[d];
+      }
+      for (unsigned int v = 0; v < nbSV; ++v)
+      {
+        // The expansion may be slightly negative due to rounding
+        const double dist2 = std::max(0., sampleNorm + m_SupportVectorsSquaredNorm[v] - 2. * row[v]);
+        row[v]             = std::exp(-m_Gamma * dist2);
+      }
+      break;
+    }
+    case SIGMOID:
+      for (unsigned int v = 0; v < nbSV; ++v)
+      {
+        row[v] = std::tanh(m_Gamma * row[v] + m_Coef0);
+      }
+      break;
+    }
+  }
+}
+
+void SVMKernelBatchEvaluator::Evaluate(const double* samples, unsigned int nbSamples, unsigned int sampleDimension, double* decisionValues) const
+{
+  const unsigned int nbSV = m_NumberOfSupportVectors;
+  const unsigned int nbDF = GetNumberOfDecisionFunctions();
+
+  std::vector<double> kernel(static_cast<size_t>(std::min(nbSamples, SampleBlockSize)) * nbSV);
+
+  for (unsigned int blockStart = 0; blockStart < nbSamples; blockStart += SampleBlockSize)
+  {
+    const unsigned int blockSize = std::min(SampleBlockSize, nbSamples - blockStart);
+    ComputeKernelBlock(samples + static_cast<size_t>(blockStart) * sampleDimension, blockSize, sampleDimension, kernel.data());
+
+    for (unsigned int s = 0; s < blockSize; ++s)
+    {
+      const double* row = &kernel[static_cast<size_t>(s) * nbSV];
+      double*       out = decisionValues + static_cast<size_t>(blockStart + s) * nbDF;
+      for (unsigned int f = 0; f < nbDF; ++f)
+      {
+        double sum = 0.;
+        for (unsigned int k = m_Offsets[f]; k < m_Offsets[f + 1]; ++k)
+        {
+          sum += m_Coefs[k] * row[m_Indices[k]];
+        }
+        out[f] = sum - m_Rho[f];
+      }
+    }
+  }
+}
+
+unsigned int SVMKernelBatchEvaluator::Vote(const double* decisionValues, unsigned int nbClasses)
+{
+  std::vector<unsigned int> votes(nbClasses, 0);
+  unsigned int              p = 0;
+  for (unsigned int i = 0; i < nbClasses; ++i)
+  {
+    for (unsigned int j = i + 1; j < nbClasses; ++j, ++p)
+    {
+      ++votes[decisionValues[p] > 0 ? i : j];
+    }
+  }
+  return static_cast<unsigned int>(std::max_element(votes.begin(), votes.end()) - votes.begin());
+}
+
+} // end namespace otb
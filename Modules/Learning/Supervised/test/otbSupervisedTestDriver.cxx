@@ -37,6 +37,7 @@ void RegisterTests()
 #ifdef OTB_USE_LIBSVM
   REGISTER_TEST(otbLibSVMMachineLearningModelCanRead);
   REGISTER_TEST(otbLibSVMMachineLearningModel);
+  REGISTER_TEST(otbLibSVMMachineLearningModelBatchPredict);
   REGISTER_TEST(otbLibSVMRegressionTests);
   REGISTER_TEST(otbLabelMapClassifier);
 #endif
@@ -52,7 +53,9 @@ void RegisterTests()
   REGISTER_TEST(otbKNNMachineLearningModelCanRead);
   // training tests
   REGISTER_TEST(otbSVMMachineLearningModel);
+  REGISTER_TEST(otbSVMMachineLearningModelBatchPredict);
   REGISTER_TEST(otbKNearestNeighborsMachineLearningModel);
+  REGISTER_TEST(otbKNearestNeighborsMachineLearningModelBatchPredict);
   REGISTER_TEST(otbRandomForestsMachineLearningModel);
   REGISTER_TEST(otbBoostMachineLearningModel);
   REGISTER_TEST(otbANNMachineLearningModel);
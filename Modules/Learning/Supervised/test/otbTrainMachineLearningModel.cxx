@@ -111,6 +111,24 @@ int otbGenericMachineLearningModel(int argc, char* argv[])
   return (std::abs(kappaLoad - kappa) < 0.00000001 ? EXIT_SUCCESS : EXIT_FAILURE);
 }
 
+template <class TModel>
+int CheckBatchPredictionConsistency(TModel* classifier, typename TModel::InputListSampleType* samples, double maxMismatchRatio)
+{
+  typename TModel::TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
+
+  unsigned int nbMismatches = 0;
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    if (classifier->Predict(samples->GetMeasurementVector(i))[0] != predicted->GetMeasurementVector(i)[0])
+    {
+      ++nbMismatches;
+    }
+  }
+  otbLogMacro(Info, << nbMismatches << " / " << samples->Size() << " batch predictions differ from sample-wise predictions");
+
+  return (nbMismatches <= maxMismatchRatio * samples->Size() ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
 // -------------------------- LibSVM -------------------------------------------
 #ifdef OTB_USE_LIBSVM
 #include "otbLibSVMMachineLearningModel.h"
@@ -120,6 +138,42 @@ int otbLibSVMMachineLearningModel(int argc, char* argv[])
 {
   return otbGenericMachineLearningModel<LibSVMType>(argc, argv);
 }
+
+int otbLibSVMMachineLearningModelBatchPredict(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::cout << "Wrong number of arguments " << std::endl;
+    std::cout << "Usage : sample file" << std::endl;
+    return EXIT_FAILURE;
+  }
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+  if (!otb::ReadDataFile(argv[1], samples, labels))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int status = EXIT_SUCCESS;
+  for (int kernel : {LINEAR, POLY, RBF, SIGMOID})
+  {
+    otbLogMacro(Info, << "Kernel type " << kernel);
+    LibSVMType::Pointer classifier = LibSVMType::New();
+    classifier->SetInputListSample(samples);
+    classifier->SetTargetListSample(labels);
+    classifier->SetKernelType(kernel);
+    classifier->SetKernelGamma(0.5);
+    classifier->SetKernelCoef0(0.);
+    classifier->Train();
+    // Decision values very close to zero may flip because of rounding
+    if (CheckBatchPredictionConsistency<LibSVMType>(classifier, samples, 0.001) != EXIT_SUCCESS)
+    {
+      status = EXIT_FAILURE;
+    }
+  }
+  return status;
+}
 #endif
 
 // -------------------------- OpenCV -------------------------------------------
@@ -139,6 +193,42 @@ int otbSVMMachineLearningModel(int argc, char* argv[])
   return otbGenericMachineLearningModel<SVMType>(argc, argv);
 }
 
+int otbSVMMachineLearningModelBatchPredict(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::cout << "Wrong number of arguments " << std::endl;
+    std::cout << "Usage : sample file" << std::endl;
+    return EXIT_FAILURE;
+  }
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+  if (!otb::ReadDataFile(argv[1], samples, labels))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int status = EXIT_SUCCESS;
+  for (int kernel : {CvSVM::LINEAR, CvSVM::POLY, CvSVM::RBF, CvSVM::SIGMOID})
+  {
+    otbLogMacro(Info, << "Kernel type " << kernel);
+    SVMType::Pointer classifier = SVMType::New();
+    classifier->SetInputListSample(samples);
+    classifier->SetTargetListSample(labels);
+    classifier->SetKernelType(kernel);
+    classifier->SetGamma(0.5);
+    classifier->SetDegree(3);
+    classifier->Train();
+    // Decision values very close to zero may flip because of rounding
+    if (CheckBatchPredictionConsistency<SVMType>(classifier, samples, 0.001) != EXIT_SUCCESS)
+    {
+      status = EXIT_FAILURE;
+    }
+  }
+  return status;
+}
+
 int otbSVMMachineLearningRegressionModel(int argc, char* argv[])
 {
   if (argc != 3)
@@ -214,6 +304,60 @@ int otbKNearestNeighborsMachineLearningModel(int argc, char* argv[])
   return otbGenericMachineLearningModel<KNearestNeighborsType>(argc, argv);
 }
 
+int otbKNearestNeighborsMachineLearningModelBatchPredict(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::cout << "Wrong number of arguments " << std::endl;
+    std::cout << "Usage : sample file" << std::endl;
+    return EXIT_FAILURE;
+  }
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+  if (!otb::ReadDataFile(argv[1], samples, labels))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The KD-tree search must give exactly the same outputs as the OpenCV search
+  int status = EXIT_SUCCESS;
+
+  KNearestNeighborsType::Pointer classifier = KNearestNeighborsType::New();
+  classifier->SetInputListSample(samples);
+  classifier->SetTargetListSample(labels);
+  classifier->Train();
+  if (CheckBatchPredictionConsistency<KNearestNeighborsType>(classifier, samples, 0.) != EXIT_SUCCESS)
+  {
+    status = EXIT_FAILURE;
+  }
+
+  // Use the labels as regression targets
+  typedef otb::KNearestNeighborsMachineLearningModel<InputValueRegressionType, TargetValueRegressionType> KNNRegressionType;
+  InputListSampleRegressionType::Pointer  regSamples = InputListSampleRegressionType::New();
+  TargetListSampleRegressionType::Pointer regLabels  = TargetListSampleRegressionType::New();
+  if (!otb::ReadDataFile(argv[1], regSamples, regLabels))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (int rule : {KNNRegressionType::KNN_MEAN, KNNRegressionType::KNN_MEDIAN})
+  {
+    KNNRegressionType::Pointer regression = KNNRegressionType::New();
+    regression->SetRegressionMode(true);
+    regression->SetK(7);
+    regression->SetDecisionRule(rule);
+    regression->SetInputListSample(regSamples);
+    regression->SetTargetListSample(regLabels);
+    regression->Train();
+    if (CheckBatchPredictionConsistency<KNNRegressionType>(regression, regSamples, 0.) != EXIT_SUCCESS)
+    {
+      status = EXIT_FAILURE;
+    }
+  }
+  return status;
+}
+
 using RandomForestType = otb::RandomForestsMachineLearningModel<InputValueType, TargetValueType>;
 int otbRandomForestsMachineLearningModel(int argc, char* argv[])
 {
@@ -23,6 +23,10 @@ otb_add_test(NAME leTvLibSVMMachineLearningModel COMMAND otbSupervisedTestDriver
   ${INPUTDATA}/letter_light.scale
   ${TEMP}/libsvm_model.txt
   )
+otb_add_test(NAME leTvLibSVMMachineLearningModelBatchPredict COMMAND otbSupervisedTestDriver
+  otbLibSVMMachineLearningModelBatchPredict
+  ${INPUTDATA}/letter_light.scale
+  )
 otb_add_test(NAME leTvImageClassificationFilterLibSVM COMMAND otbSupervisedTestDriver
   --compare-image ${NOTOL}
   ${BASELINE}/leSVMImageClassificationFilterOutput.tif
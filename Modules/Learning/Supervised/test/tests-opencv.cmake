@@ -58,6 +58,11 @@ otb_add_test(NAME leTvSVMMachineLearningModel COMMAND otbSupervisedTestDriver
   ${TEMP}/svm_model.txt
   )
 
+otb_add_test(NAME leTvSVMMachineLearningModelBatchPredict COMMAND otbSupervisedTestDriver
+  otbSVMMachineLearningModelBatchPredict
+  ${INPUTDATA}/letter_light.scale
+  )
+
 otb_add_test(NAME leTvNormalBayesMachineLearningModel COMMAND otbSupervisedTestDriver
   otbNormalBayesMachineLearningModel
   ${INPUTDATA}/letter_light.scale
@@ -76,6 +81,11 @@ otb_add_test(NAME leTvKNearestNeighborsMachineLearningModel COMMAND otbSupervise
   ${TEMP}/knn_model.txt
   )
 
+otb_add_test(NAME leTvKNearestNeighborsMachineLearningModelBatchPredict COMMAND otbSupervisedTestDriver
+  otbKNearestNeighborsMachineLearningModelBatchPredict
+  ${INPUTDATA}/letter_light.scale
+  )
+
 otb_add_test(NAME leTvDecisionTreeMachineLearningModel COMMAND otbSupervisedTestDriver
   otbDecisionTreeMachineLearningModel
   ${INPUTDATA}/letter_light.scale
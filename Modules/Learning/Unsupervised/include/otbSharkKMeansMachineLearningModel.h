@@ -24,6 +24,7 @@
 
 #include "itkLightObject.h"
 #include "otbMachineLearningModel.h"
+#include "otbNearestCentroidSearch.h"
 
 // Quiet a deprecation warning
 #define BOOST_BIND_GLOBAL_PLACEHOLDERS
@@ -159,6 +160,9 @@ private:
   SharkKMeansMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Copy the centroids into the batch nearest centroid search */
+  void BuildCentroidSearch();
+
   // Parameters set by the user
   unsigned int m_K;
   unsigned int m_MaximumNumberOfIterations;
@@ -169,6 +173,9 @@ private:
 
   /** shark Model could be SoftClusteringModel or HardClusteringModel */
   std::shared_ptr<ClusteringModelType> m_ClusteringModel;
+
+  /** Nearest centroid search used for batch prediction */
+  NearestCentroidSearch m_CentroidSearch;
 };
 } // end namespace otb
 
@@ -20,6 +20,7 @@
 #ifndef otbSharkKMeansMachineLearningModel_hxx
 #define otbSharkKMeansMachineLearningModel_hxx
 
+#include <algorithm>
 #include <fstream>
 #include <utility>
 
@@ -75,6 +76,23 @@ void SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::Train()
   // Use a Hard Clustering Model for classification
   shark::kMeans(data, m_K, m_Centroids, m_MaximumNumberOfIterations);
   m_ClusteringModel = std::make_shared<ClusteringModelType>(&m_Centroids);
+  BuildCentroidSearch();
+}
+
+template <class TInputValue, class TOutputValue>
+void SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::BuildCentroidSearch()
+{
+  std::vector<double> centroids;
+  unsigned int        dimension = 0;
+  for (const auto& centroid : m_Centroids.centroids().elements())
+  {
+    dimension = static_cast<unsigned int>(centroid.size());
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      centroids.push_back(centroid(d));
+    }
+  }
+  m_CentroidSearch.SetCentroids(centroids, dimension);
 }
 
 template <class TInputValue, class TOutputValue>
@@ -127,30 +145,39 @@ void SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(
                       << "[");
   }
 
-  // Convert input list of features to shark data format
-  std::vector<shark::RealVector> features;
-  otb::Shark::ListSampleRangeToSharkVector(input, features, startIndex, size);
-  shark::Data<shark::RealVector> inputSamples = shark::createDataFromRange(features);
-
-  shark::Data<ClusteringOutputType> clusters;
-  try
-  {
-    clusters = (*m_ClusteringModel)(inputSamples);
-  }
-  catch (...)
+  const unsigned int dimension = m_CentroidSearch.GetDimension();
+  if (size > 0 && input->GetMeasurementVectorSize() != dimension)
   {
     itkExceptionMacro(
         "Failed to run clustering classification. "
         "The number of features of input samples and the model could differ.");
   }
 
-  unsigned int id = startIndex;
-  for (const auto& p : clusters.elements())
+  // Nearest centroid search by blocks, the same as the hard clustering model
+  const unsigned int        blockSize = 1024;
+  std::vector<double>       samples(static_cast<size_t>(std::min(size, blockSize)) * dimension);
+  std::vector<unsigned int> clusters(std::min(size, blockSize));
+
+  for (unsigned int blockStart = startIndex; blockStart < startIndex + size; blockStart += blockSize)
   {
-    TargetSampleType target;
-    target[0] = static_cast<TOutputValue>(p);
-    targets->SetMeasurementVector(id, target);
-    ++id;
+    const unsigned int nbSamples = std::min(blockSize, startIndex + size - blockStart);
+    for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+      const InputSampleType sample = input->GetMeasurementVector(blockStart + i);
+      for (unsigned int d = 0; d < dimension; ++d)
+      {
+        samples[static_cast<size_t>(i) * dimension + d] = sample[d];
+      }
+    }
+
+    m_CentroidSearch.Assign(samples.data(), nbSamples, clusters.data());
+
+    for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+      TargetSampleType target;
+      target[0] = static_cast<TOutputValue>(clusters[i]);
+      targets->SetMeasurementVector(blockStart + i, target);
+    }
   }
 
   // Change quality measurement only if SoftClustering or other clustering method is used.
@@ -200,6 +227,7 @@ void SharkKMeansMachineLearningModel<TInputValue, TOutputValue>::Load(const std:
   shark::TextInArchive ia(ifs);
   m_ClusteringModel->load(ia, 0);
   ifs.close();
+  BuildCentroidSearch();
 }
 
 template <class TInputValue, class TOutputValue>
@@ -0,0 +1,521 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageToSurfaceReflectanceImageFilter_h
+#define otbImageToSurfaceReflectanceImageFilter_h
+
+#include "otbVarSol.h"
+#include "otbUnaryImageFunctorWithVectorImageFilter.h"
+#include "otbAtmosphericRadiativeTerms.h"
+#include "otbMacro.h"
+#include "otbMath.h"
+
+#include <algorithm>
+
+namespace otb
+{
+namespace Functor
+{
+/** \class ImageToSurfaceReflectanceImageFunctor
+ *  \brief Fused transform from a raw value to a TOA or TOC reflectance value.
+ *
+ * The image to radiance and radiance to reflectance transforms are composed
+ * into a single affine transform:
+ * \f[ \rho_{TOA} = \frac{\pi C}{E_S} \left( \frac{DN}{\alpha} + \beta \right) \f]
+ * where \f$ C \f$ is the illumination correction coefficient. When the
+ * surface reflectance terms are set, the affine part of the 6S correction
+ * \f$ A (\rho_{TOA} - \rho_{atm}) \f$ is folded into the same transform, as
+ * long as the TOA reflectance is not clamped, and the spherical albedo term
+ * is applied afterwards:
+ * \f[ \rho_{TOC} = \frac{\rho}{1 + S \rho} \f]
+ * The output can finally be clamped in [0, 1] and scaled (for instance to
+ * milli-reflectance), which saves the clamp and multiply filters.
+ *
+ * \sa ImageToSurfaceReflectanceImageFilter
+ *
+ * \ingroup Functor
+ * \ingroup Radiometry
+ *
+ * \ingroup OTBOpticalCalibration
+ */
+template <class TInput, class TOutput>
+class ImageToSurfaceReflectanceImageFunctor
+{
+public:
+  ImageToSurfaceReflectanceImageFunctor()
+    : m_Gain(1.),
+      m_Bias(0.),
+      m_UseClamp(true),
+      m_UseSurfaceReflectance(false),
+      m_Coefficient(1.),
+      m_Residu(0.),
+      m_SphericalAlbedo(0.),
+      m_UseOutputClamp(false),
+      m_Scale(1.),
+      m_FusedGain(1.),
+      m_FusedBias(0.)
+  {
+  }
+
+  virtual ~ImageToSurfaceReflectanceImageFunctor()
+  {
+  }
+
+  /** Set the image to TOA reflectance transform, from the absolute
+   * calibration gain and bias, the solar illumination and the illumination
+   * correction coefficient. */
+  void SetTopOfAtmosphereParameters(double alpha, double beta, double solarIllumination, double illuminationCorrectionCoefficient)
+  {
+    const double factor = CONST_PI * illuminationCorrectionCoefficient / solarIllumination;
+    m_Gain              = factor / alpha;
+    m_Bias              = factor * beta;
+    this->ComposeTransforms();
+  }
+
+  /** Set the TOA to surface reflectance transform, from the terms computed
+   * by ReflectanceToSurfaceReflectanceImageFilter. */
+  void SetSurfaceReflectanceParameters(double coefficient, double residu, double sphericalAlbedo)
+  {
+    m_Coefficient           = coefficient;
+    m_Residu                = residu;
+    m_SphericalAlbedo       = sphericalAlbedo;
+    m_UseSurfaceReflectance = true;
+    this->ComposeTransforms();
+  }
+
+  void SetUseClamp(bool useClamp)
+  {
+    m_UseClamp = useClamp;
+    this->ComposeTransforms();
+  }
+  void SetUseOutputClamp(bool useOutputClamp)
+  {
+    m_UseOutputClamp = useOutputClamp;
+  }
+  void SetScale(double scale)
+  {
+    m_Scale = scale;
+  }
+
+  double GetGain() const
+  {
+    return m_Gain;
+  }
+  double GetBias() const
+  {
+    return m_Bias;
+  }
+  bool GetUseClamp() const
+  {
+    return m_UseClamp;
+  }
+  bool GetUseSurfaceReflectance() const
+  {
+    return m_UseSurfaceReflectance;
+  }
+  double GetCoefficient() const
+  {
+    return m_Coefficient;
+  }
+  double GetResidu() const
+  {
+    return m_Residu;
+  }
+  double GetSphericalAlbedo() const
+  {
+    return m_SphericalAlbedo;
+  }
+  bool GetUseOutputClamp() const
+  {
+    return m_UseOutputClamp;
+  }
+  double GetScale() const
+  {
+    return m_Scale;
+  }
+
+  inline TOutput operator()(const TInput& inPixel) const
+  {
+    double value = static_cast<double>(inPixel) * m_FusedGain + m_FusedBias;
+
+    if (m_UseClamp)
+    {
+      value = std::min(std::max(value, 0.), 1.);
+      if (m_UseSurfaceReflectance)
+      {
+        value = (value + m_Residu) * m_Coefficient;
+      }
+    }
+
+    if (m_UseSurfaceReflectance)
+    {
+      value = value / (1. + m_SphericalAlbedo * value);
+    }
+
+    if (m_UseOutputClamp)
+    {
+      value = std::min(std::max(value, 0.), 1.);
+    }
+
+    return static_cast<TOutput>(value * m_Scale);
+  }
+
+private:
+  /** Fold the surface reflectance affine part into the TOA transform when
+   * no clamping stands between them */
+  void ComposeTransforms()
+  {
+    if (m_UseSurfaceReflectance && !m_UseClamp)
+    {
+      m_FusedGain = m_Gain * m_Coefficient;
+      m_FusedBias = (m_Bias + m_Residu) * m_Coefficient;
+    }
+    else
+    {
+      m_FusedGain = m_Gain;
+      m_FusedBias = m_Bias;
+    }
+  }
+
+  double m_Gain;
+  double m_Bias;
+  bool   m_UseClamp;
+  bool   m_UseSurfaceReflectance;
+  double m_Coefficient;
+  double m_Residu;
+  double m_SphericalAlbedo;
+  bool   m_UseOutputClamp;
+  double m_Scale;
+  double m_FusedGain;
+  double m_FusedBias;
+};
+}
+
+/** \class ImageToSurfaceReflectanceImageFilter
+ *  \brief Convert a raw value into a TOA or TOC reflectance value in a single pass
+ *
+ * This filter computes in one pass what the ImageToRadianceImageFilter,
+ * RadianceToReflectanceImageFilter and ReflectanceToSurfaceReflectanceImageFilter
+ * chain computes in three, without the intermediate buffers: the per band
+ * coefficients of the three filters are composed into one transform (see
+ * ImageToSurfaceReflectanceImageFunctor).
+ *
+ * The calibration parameters are the ones of ImageToReflectanceImageFilter,
+ * and are read from the metadata when they are not set. When atmospheric
+ * radiative terms are set, the output is the surface (TOC) reflectance,
+ * otherwise it is the TOA reflectance. As in the other calibration filters,
+ * null input pixels give null output pixels.
+ *
+ * The adjacency effects correction needs a neighborhood of TOC reflectances
+ * and can not be fused: SurfaceAdjacencyEffectCorrectionSchemeFilter has to
+ * be plugged on the output of this filter.
+ *
+ * \ingroup ImageToSurfaceReflectanceImageFunctor
+ * \ingroup ImageToReflectanceImageFilter
+ * \ingroup ReflectanceToSurfaceReflectanceImageFilter
+ * \ingroup Radiometry
+ *
+ * \ingroup OTBOpticalCalibration
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT ImageToSurfaceReflectanceImageFilter
+    : public UnaryImageFunctorWithVectorImageFilter<
+          TInputImage, TOutputImage,
+          typename Functor::ImageToSurfaceReflectanceImageFunctor<typename TInputImage::InternalPixelType, typename TOutputImage::InternalPixelType>>
+{
+public:
+  /**   Extract input and output images dimensions.*/
+  itkStaticConstMacro(InputImageDimension, unsigned int, TInputImage::ImageDimension);
+  itkStaticConstMacro(OutputImageDimension, unsigned int, TOutputImage::ImageDimension);
+
+  /** "typedef" to simplify the variables definition and the declaration. */
+  typedef TInputImage  InputImageType;
+  typedef TOutputImage OutputImageType;
+  typedef typename Functor::ImageToSurfaceReflectanceImageFunctor<typename InputImageType::InternalPixelType, typename OutputImageType::InternalPixelType>
+      FunctorType;
+
+  /** "typedef" for standard classes. */
+  typedef ImageToSurfaceReflectanceImageFilter Self;
+  typedef UnaryImageFunctorWithVectorImageFilter<InputImageType, OutputImageType, FunctorType> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** object factory method. */
+  itkNewMacro(Self);
+
+  /** return class name. */
+  itkTypeMacro(ImageToSurfaceReflectanceImageFilter, UnaryImageFunctorWithVectorImageFilter);
+
+  /** Supported images definition. */
+  typedef typename InputImageType::PixelType          InputPixelType;
+  typedef typename InputImageType::InternalPixelType  InputInternalPixelType;
+  typedef typename InputImageType::RegionType         InputImageRegionType;
+  typedef typename OutputImageType::PixelType         OutputPixelType;
+  typedef typename OutputImageType::InternalPixelType OutputInternalPixelType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+
+  typedef typename itk::VariableLengthVector<double> VectorType;
+
+  typedef AtmosphericRadiativeTerms::Pointer AtmosphericRadiativeTermsPointerType;
+
+  /** Image size "typedef" definition. */
+  typedef typename InputImageType::SizeType SizeType;
+
+  /** Set the absolute calibration gains. */
+  itkSetMacro(Alpha, VectorType);
+  /** Give the absolute calibration gains. */
+  itkGetConstReferenceMacro(Alpha, VectorType);
+
+  /** Set the absolute calibration bias. */
+  itkSetMacro(Beta, VectorType);
+  /** Give the absolute calibration bias. */
+  itkGetConstReferenceMacro(Beta, VectorType);
+
+  /** Set the solar illumination value. */
+  itkSetMacro(SolarIllumination, VectorType);
+  /** Give the solar illumination value. */
+  itkGetConstReferenceMacro(SolarIllumination, VectorType);
+
+  /** Set the zenithal solar angle. */
+  itkSetMacro(ZenithalSolarAngle, double);
+  /** Give the zenithal solar angle. */
+  itkGetConstReferenceMacro(ZenithalSolarAngle, double);
+
+  /** Set the useClamp flag (clamping of the TOA reflectance between 0 and 1). */
+  itkSetMacro(UseClamp, bool);
+  /** Give the useClamp flag. */
+  itkGetConstReferenceMacro(UseClamp, bool);
+
+  /** Set the useOutputClamp flag (clamping of the output reflectance between 0 and 1). */
+  itkSetMacro(UseOutputClamp, bool);
+  /** Give the useOutputClamp flag. */
+  itkGetConstReferenceMacro(UseOutputClamp, bool);
+
+  /** Set the scale applied to the output reflectance (1000 for milli-reflectance). */
+  itkSetMacro(Scale, double);
+  /** Give the output scale. */
+  itkGetConstReferenceMacro(Scale, double);
+
+  /** Set/Get the sun elevation angle (internally handled by the zenithal angle)*/
+  virtual void SetElevationSolarAngle(double elevationAngle)
+  {
+    double zenithalAngle = 90.0 - elevationAngle;
+    if (this->m_ZenithalSolarAngle != zenithalAngle)
+    {
+      this->m_ZenithalSolarAngle = zenithalAngle;
+      this->Modified();
+    }
+  }
+
+  virtual double GetElevationSolarAngle() const
+  {
+    return 90.0 - this->m_ZenithalSolarAngle;
+  }
+
+  /** Set the flux normalization coefficient. */
+  void SetFluxNormalizationCoefficient(double coef)
+  {
+    m_FluxNormalizationCoefficient      = coef;
+    m_IsSetFluxNormalizationCoefficient = true;
+    this->Modified();
+  }
+
+  /** Set the solar distance. */
+  void SetSolarDistance(double value)
+  {
+    m_SolarDistance      = value;
+    m_IsSetSolarDistance = true;
+    this->Modified();
+  }
+  /** Give the solar distance. */
+  itkGetConstReferenceMacro(SolarDistance, double);
+  /** Set the IsSetSolarDistance boolean. */
+  itkSetMacro(IsSetSolarDistance, bool);
+  /** Give the IsSetSolarDistance boolean. */
+  itkGetConstReferenceMacro(IsSetSolarDistance, bool);
+
+  /** Set the acquisition day. */
+  itkSetClampMacro(Day, int, 1, 31);
+  /** Get the acquisition day. */
+  itkGetConstReferenceMacro(Day, int);
+  /** Set the acquisition month. */
+  itkSetClampMacro(Month, int, 1, 12);
+  /** Get the  acquisition month. */
+  itkGetConstReferenceMacro(Month, int);
+
+  /** Set the atmospheric radiative terms. If not set, the output is the TOA reflectance. */
+  itkSetObjectMacro(AtmosphericRadiativeTerms, AtmosphericRadiativeTerms);
+  /** Get the atmospheric radiative terms. */
+  itkGetObjectMacro(AtmosphericRadiativeTerms, AtmosphericRadiativeTerms);
+
+protected:
+  /** Constructor */
+  ImageToSurfaceReflectanceImageFilter()
+    : m_ZenithalSolarAngle(120.), // invalid value which will lead to negative radiometry
+      m_FluxNormalizationCoefficient(1.),
+      m_UseClamp(true),
+      m_UseOutputClamp(false),
+      m_Scale(1.),
+      m_IsSetFluxNormalizationCoefficient(false),
+      m_Day(0),
+      m_Month(0),
+      m_SolarDistance(1.0),
+      m_IsSetSolarDistance(false)
+  {
+    m_Alpha.SetSize(0);
+    m_Beta.SetSize(0);
+    m_SolarIllumination.SetSize(0);
+  };
+
+  /** Destructor */
+  ~ImageToSurfaceReflectanceImageFilter() override
+  {
+  }
+
+  /** Update the functor list and input parameters */
+  void BeforeThreadedGenerateData(void) override
+  {
+    const auto & metadata = this->GetInput()->GetImageMetadata();
+
+    if (m_Alpha.GetSize() == 0 && metadata.HasBandMetadata(MDNum::PhysicalGain))
+    {
+      m_Alpha = metadata.GetAsVector(MDNum::PhysicalGain);
+    }
+
+    if (m_Beta.GetSize() == 0 && metadata.HasBandMetadata(MDNum::PhysicalBias))
+    {
+      m_Beta = metadata.GetAsVector(MDNum::PhysicalBias);
+    }
+
+    if (m_Day == 0 && (!m_IsSetFluxNormalizationCoefficient) && (!m_IsSetSolarDistance)
+        && metadata.Has(MDTime::AcquisitionDate))
+    {
+      m_Day = metadata[MDTime::AcquisitionDate].GetDay();
+    }
+
+    if (m_Month == 0 && (!m_IsSetFluxNormalizationCoefficient) && (!m_IsSetSolarDistance)
+        && metadata.Has(MDTime::AcquisitionDate))
+    {
+      m_Month = metadata[MDTime::AcquisitionDate].GetMonth();
+    }
+
+    if (m_SolarIllumination.GetSize() == 0 && metadata.HasBandMetadata(MDNum::SolarIrradiance))
+    {
+      m_SolarIllumination = metadata.GetAsVector(MDNum::SolarIrradiance);
+    }
+
+    if (m_ZenithalSolarAngle == 120.0 && metadata.Has(MDNum::SunElevation))
+    {
+      // the zenithal angle is the complementary of the elevation angle
+      m_ZenithalSolarAngle = 90.0 - metadata[MDNum::SunElevation];
+    }
+
+    otbMsgDevMacro(<< "Using correction parameters: ");
+    otbMsgDevMacro(<< "Alpha (gain): " << m_Alpha);
+    otbMsgDevMacro(<< "Beta (bias):  " << m_Beta);
+    otbMsgDevMacro(<< "Day:               " << m_Day);
+    otbMsgDevMacro(<< "Month:             " << m_Month);
+    otbMsgDevMacro(<< "Solar irradiance:  " << m_SolarIllumination);
+    otbMsgDevMacro(<< "Zenithal angle:    " << m_ZenithalSolarAngle);
+
+    if ((m_Alpha.GetSize() != this->GetInput()->GetNumberOfComponentsPerPixel()) || (m_Beta.GetSize() != this->GetInput()->GetNumberOfComponentsPerPixel()) ||
+        (m_SolarIllumination.GetSize() != this->GetInput()->GetNumberOfComponentsPerPixel()))
+    {
+      itkExceptionMacro(<< "Alpha, Beta and SolarIllumination parameters should have the same size as the number of bands");
+    }
+
+    double coefTemp = 0.;
+    if (m_IsSetFluxNormalizationCoefficient)
+    {
+      coefTemp = std::cos(m_ZenithalSolarAngle * CONST_PI_180) * m_FluxNormalizationCoefficient * m_FluxNormalizationCoefficient;
+    }
+    else if (m_IsSetSolarDistance)
+    {
+      coefTemp = std::cos(m_ZenithalSolarAngle * CONST_PI_180) / (m_SolarDistance * m_SolarDistance);
+    }
+    else if (m_Day * m_Month != 0 && m_Day < 32 && m_Month < 13)
+    {
+      coefTemp = std::cos(m_ZenithalSolarAngle * CONST_PI_180) * VarSol::GetVarSol(m_Day, m_Month);
+    }
+    else
+    {
+      itkExceptionMacro(<< "Day has to be included between 1 and 31, Month between 1 and 12.");
+    }
+
+    this->GetFunctorVector().clear();
+    for (unsigned int i = 0; i < this->GetInput()->GetNumberOfComponentsPerPixel(); ++i)
+    {
+      FunctorType functor;
+      functor.SetTopOfAtmosphereParameters(m_Alpha[i], m_Beta[i], m_SolarIllumination[i], 1. / coefTemp);
+      functor.SetUseClamp(m_UseClamp);
+
+      if (m_AtmosphericRadiativeTerms.IsNotNull())
+      {
+        // Same terms as in ReflectanceToSurfaceReflectanceImageFilter
+        double coef = m_AtmosphericRadiativeTerms->GetTotalGaseousTransmission(i) * m_AtmosphericRadiativeTerms->GetDownwardTransmittance(i) *
+                      m_AtmosphericRadiativeTerms->GetUpwardTransmittance(i);
+        functor.SetSurfaceReflectanceParameters(1. / coef, -m_AtmosphericRadiativeTerms->GetIntrinsicAtmosphericReflectance(i),
+                                                m_AtmosphericRadiativeTerms->GetSphericalAlbedo(i));
+      }
+
+      functor.SetUseOutputClamp(m_UseOutputClamp);
+      functor.SetScale(m_Scale);
+
+      otbMsgDevMacro(<< "Band " << i << ": gain " << functor.GetGain() << ", bias " << functor.GetBias());
+
+      this->GetFunctorVector().push_back(functor);
+    }
+  }
+
+private:
+  /** Ponderation declaration*/
+  VectorType m_Alpha;
+  VectorType m_Beta;
+  /** Set the zenithal soalr angle. */
+  double m_ZenithalSolarAngle;
+  /** Flux normalization coefficient. */
+  double m_FluxNormalizationCoefficient;
+  /** Solar illumination value. */
+  VectorType m_SolarIllumination;
+  /** Flag to activate clamping of the TOA reflectance between 0 and 1 */
+  bool m_UseClamp;
+  /** Flag to activate clamping of the output reflectance between 0 and 1 */
+  bool m_UseOutputClamp;
+  /** Scale of the output reflectance */
+  double m_Scale;
+  /** Used to know if the user has set a value for the FluxNormalizationCoefficient parameter
+   * or if the class has to compute it */
+  bool m_IsSetFluxNormalizationCoefficient;
+  /** Acquisition Day*/
+  int m_Day;
+  /** Acquisition Month*/
+  int m_Month;
+  /** Solar distance. */
+  double m_SolarDistance;
+  /** Used to know if the user has set a value for the SolarDistance parameter
+   * or if the class has to compute it */
+  bool m_IsSetSolarDistance;
+  /** Atmospheric radiative terms, for the surface reflectance */
+  AtmosphericRadiativeTermsPointerType m_AtmosphericRadiativeTerms;
+};
+
+} // end namespace otb
+
+#endif
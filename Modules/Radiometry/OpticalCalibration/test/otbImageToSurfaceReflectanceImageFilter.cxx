@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "itkMacro.h"
+
+#include "otbImageToSurfaceReflectanceImageFilter.h"
+#include "otbImageToRadianceImageFilter.h"
+#include "otbRadianceToReflectanceImageFilter.h"
+#include "otbReflectanceToSurfaceReflectanceImageFilter.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+
+// Check that the fused filter gives the same surface reflectance as the chain of filters
+int otbImageToSurfaceReflectanceImageFilter(int itkNotUsed(argc), char* argv[])
+{
+  const char*  inputFileName         = argv[1];
+  const char*  fusedOutputFileName   = argv[2];
+  const char*  chainedOutputFileName = argv[3];
+  const double angle                 = static_cast<double>(atof(argv[4]));
+  const bool   useClamp              = atoi(argv[17]) != 0;
+
+  const unsigned int Dimension = 2;
+  typedef double     PixelType;
+  typedef otb::VectorImage<PixelType, Dimension> ImageType;
+  typedef otb::ImageFileReader<ImageType>        ReaderType;
+  typedef otb::ImageFileWriter<ImageType>        WriterType;
+  typedef otb::ImageToSurfaceReflectanceImageFilter<ImageType, ImageType>       FusedFilterType;
+  typedef otb::ImageToRadianceImageFilter<ImageType, ImageType>                 ImageToRadianceFilterType;
+  typedef otb::RadianceToReflectanceImageFilter<ImageType, ImageType>           RadianceToReflectanceFilterType;
+  typedef otb::ReflectanceToSurfaceReflectanceImageFilter<ImageType, ImageType> ReflectanceToSurfaceReflectanceFilterType;
+  typedef FusedFilterType::VectorType                                           VectorType;
+  typedef otb::AtmosphericRadiativeTerms::DataVectorType                        DataVectorType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFileName);
+  reader->UpdateOutputInformation();
+
+  unsigned int nbOfComponent = reader->GetOutput()->GetNumberOfComponentsPerPixel();
+
+  VectorType alpha(nbOfComponent);
+  VectorType beta(nbOfComponent);
+  VectorType solarIllumination(nbOfComponent);
+
+  for (unsigned int i = 0; i < nbOfComponent; ++i)
+  {
+    alpha[i]             = static_cast<double>(atof(argv[i + 5]));
+    beta[i]              = static_cast<double>(atof(argv[i + 9]));
+    solarIllumination[i] = static_cast<double>(atof(argv[i + 13]));
+  }
+
+  DataVectorType intrinsic(nbOfComponent, static_cast<double>(atof(argv[18])));
+  DataVectorType albedo(nbOfComponent, static_cast<double>(atof(argv[19])));
+  DataVectorType gaseous(nbOfComponent, static_cast<double>(atof(argv[20])));
+  DataVectorType downTrans(nbOfComponent, static_cast<double>(atof(argv[21])));
+  DataVectorType upTrans(nbOfComponent, static_cast<double>(atof(argv[22])));
+
+  otb::AtmosphericRadiativeTerms::Pointer atmoRadTerms = otb::AtmosphericRadiativeTerms::New();
+  atmoRadTerms->SetIntrinsicAtmosphericReflectances(intrinsic);
+  atmoRadTerms->SetSphericalAlbedos(albedo);
+  atmoRadTerms->SetTotalGaseousTransmissions(gaseous);
+  atmoRadTerms->SetDownwardTransmittances(downTrans);
+  atmoRadTerms->SetUpwardTransmittances(upTrans);
+
+  // Fused filter
+  FusedFilterType::Pointer fused = FusedFilterType::New();
+  fused->SetAlpha(alpha);
+  fused->SetBeta(beta);
+  fused->SetZenithalSolarAngle(angle);
+  fused->SetSolarIllumination(solarIllumination);
+  fused->SetSolarDistance(1.);
+  fused->SetUseClamp(useClamp);
+  fused->SetAtmosphericRadiativeTerms(atmoRadTerms);
+  fused->SetInput(reader->GetOutput());
+
+  WriterType::Pointer fusedWriter = WriterType::New();
+  fusedWriter->SetFileName(fusedOutputFileName);
+  fusedWriter->SetInput(fused->GetOutput());
+  fusedWriter->Update();
+
+  // Chain of filters
+  ImageToRadianceFilterType::Pointer imageToRadiance = ImageToRadianceFilterType::New();
+  imageToRadiance->SetAlpha(alpha);
+  imageToRadiance->SetBeta(beta);
+  imageToRadiance->SetInput(reader->GetOutput());
+
+  RadianceToReflectanceFilterType::Pointer radianceToReflectance = RadianceToReflectanceFilterType::New();
+  radianceToReflectance->SetZenithalSolarAngle(angle);
+  radianceToReflectance->SetSolarIllumination(solarIllumination);
+  radianceToReflectance->SetSolarDistance(1.);
+  radianceToReflectance->SetUseClamp(useClamp);
+  radianceToReflectance->SetInput(imageToRadiance->GetOutput());
+
+  ReflectanceToSurfaceReflectanceFilterType::Pointer reflectanceToSurfaceReflectance = ReflectanceToSurfaceReflectanceFilterType::New();
+  reflectanceToSurfaceReflectance->SetAtmosphericRadiativeTerms(atmoRadTerms);
+  reflectanceToSurfaceReflectance->SetInput(radianceToReflectance->GetOutput());
+
+  WriterType::Pointer chainedWriter = WriterType::New();
+  chainedWriter->SetFileName(chainedOutputFileName);
+  chainedWriter->SetInput(reflectanceToSurfaceReflectance->GetOutput());
+  chainedWriter->Update();
+
+  return EXIT_SUCCESS;
+}
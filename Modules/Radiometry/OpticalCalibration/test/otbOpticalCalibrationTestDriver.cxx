@@ -34,6 +34,7 @@ void RegisterTests()
   REGISTER_TEST(otbImageToReflectanceImageFilterAuto);
   REGISTER_TEST(otbAtmosphericRadiativeTermsTest);
   REGISTER_TEST(otbImageToReflectanceImageFilter);
+  REGISTER_TEST(otbImageToSurfaceReflectanceImageFilter);
   REGISTER_TEST(otbRadianceToReflectanceImageFilter);
   REGISTER_TEST(otbReflectanceToImageImageFilterAuto);
   REGISTER_TEST(otbAeronetExtractData);
@@ -24,6 +24,7 @@
 #include "itkImageToImageFilter.h"
 #include "otbGenericRSTransform.h"
 #include "otbLineOfSightOptimizer.h"
+#include "otbLineOfSightGrid.h"
 #include "otbVectorImage.h"
 #include "otbImage.h"
 
@@ -37,6 +38,11 @@ namespace otb
  *  The output image contains the 3D points coordinates for each location of input disparity.
  *  The 3D coordinates (sorted by band) are : longitude , latitude (in degree, wrt WGS84) and altitude (in meters)
  *
+ *  When UseLineOfSightGrid is on, the sensor models are only evaluated on a coarse grid
+ *  (one node every LineOfSightGridStep sensor pixels) covering the sensor positions of each
+ *  thread region, the lines of sight are interpolated bilinearly in between, and the
+ *  intersection is solved in closed form. It is off by default.
+ *
  *  \sa FineRegistrationImageFilter
  *  \sa StereorectificationDisplacementFieldSource
  *  \sa SubPixelDisparityImageFilter
@@ -87,6 +93,8 @@ public:
   typedef typename PointSetType::PointsContainer    PointsContainer;
   typedef typename PointSetType::PointDataContainer LabelContainer;
 
+  typedef otb::LineOfSightGrid<PrecisionType> LineOfSightGridType;
+
   typedef otb::ImageKeywordlist ImageKeywordListType;
 
   /** Set horizontal disparity map input */
@@ -137,6 +145,41 @@ public:
     return this->m_RightKeywordList;
   }
 
+  /** Set ImageMetadata of the left sensor image (used instead of the keywordlist when set) */
+  void SetLeftImageMetadata(const ImageMetadata* imd)
+  {
+    this->m_LeftImageMetadata = imd;
+    this->Modified();
+  }
+
+  /** Get ImageMetadata of the left sensor image */
+  const ImageMetadata* GetLeftImageMetadata() const
+  {
+    return this->m_LeftImageMetadata;
+  }
+
+  /** Set ImageMetadata of the right sensor image (used instead of the keywordlist when set) */
+  void SetRightImageMetadata(const ImageMetadata* imd)
+  {
+    this->m_RightImageMetadata = imd;
+    this->Modified();
+  }
+
+  /** Get ImageMetadata of the right sensor image */
+  const ImageMetadata* GetRightImageMetadata() const
+  {
+    return this->m_RightImageMetadata;
+  }
+
+  /** Set/Get the interpolation of the lines of sight from a coarse grid (off by default) */
+  itkSetMacro(UseLineOfSightGrid, bool);
+  itkGetConstMacro(UseLineOfSightGrid, bool);
+  itkBooleanMacro(UseLineOfSightGrid);
+
+  /** Set/Get the step of the line of sight grids, in sensor image pixels */
+  itkSetMacro(LineOfSightGridStep, unsigned int);
+  itkGetConstMacro(LineOfSightGridStep, unsigned int);
+
 protected:
   /** Constructor */
   DisparityMapTo3DFilter();
@@ -156,6 +199,11 @@ protected:
   /** Threaded generate data */
   void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
+  /** Compute the 3D points of 'region' from the sensor positions of its
+   * pixels, with interpolated lines of sight */
+  void GridGenerateData(const RegionType& region, const std::vector<double>& sensorPositions, const std::vector<bool>& validPositions,
+                        PrecisionType elevationMin, PrecisionType elevationMax);
+
   /** Override VerifyInputInformation() since this filter's inputs do
     * not need to occupy the same physical space.
     *
@@ -179,8 +227,20 @@ private:
   /** Left sensor image transform */
   RSTransformType::Pointer m_LeftToGroundTransform;
 
+  /** ImageMetadata of left sensor image */
+  const ImageMetadata* m_LeftImageMetadata = nullptr;
+
+  /** ImageMetadata of right sensor image */
+  const ImageMetadata* m_RightImageMetadata = nullptr;
+
   /** Right sensor image transform */
   RSTransformType::Pointer m_RightToGroundTransform;
+
+  /** Interpolate the lines of sight from coarse grids */
+  bool m_UseLineOfSightGrid;
+
+  /** Step of the line of sight grids, in sensor image pixels */
+  unsigned int m_LineOfSightGridStep;
 };
 } // end namespace otb
 
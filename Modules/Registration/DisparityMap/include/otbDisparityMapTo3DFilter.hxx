@@ -24,6 +24,7 @@
 #include "otbDisparityMapTo3DFilter.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -35,6 +36,9 @@ DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, TMaskI
   this->SetNumberOfRequiredInputs(5);
   this->SetNumberOfRequiredInputs(1);
 
+  m_UseLineOfSightGrid  = false;
+  m_LineOfSightGridStep = 16;
+
   // Set the outputs
   this->SetNumberOfRequiredOutputs(1);
   this->SetNthOutput(0, TOutputImage::New());
@@ -186,10 +190,10 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
     maskDisp->SetRequestedRegion(outputDEM->GetRequestedRegion());
   }
 
-  // Check that the keywordlists are not empty
-  if (m_LeftKeywordList.GetSize() == 0 || m_RightKeywordList.GetSize() == 0)
+  // Check that the sensor models are available
+  if ((m_LeftKeywordList.GetSize() == 0 && !m_LeftImageMetadata) || (m_RightKeywordList.GetSize() == 0 && !m_RightImageMetadata))
   {
-    itkExceptionMacro(<< "At least one of the image keywordlist is empty : can't instantiate corresponding projection");
+    itkExceptionMacro(<< "At least one of the image keywordlist or metadata is missing : can't instantiate corresponding projection");
   }
 }
 
@@ -203,6 +207,14 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
   //TODO: Replace KeywordLists by ImageMetadatas
   //m_LeftToGroundTransform->SetInputKeywordList(m_LeftKeywordList);
   //m_RightToGroundTransform->SetInputKeywordList(m_RightKeywordList);
+  if (m_LeftImageMetadata)
+  {
+    m_LeftToGroundTransform->SetInputImageMetadata(m_LeftImageMetadata);
+  }
+  if (m_RightImageMetadata)
+  {
+    m_RightToGroundTransform->SetInputImageMetadata(m_RightImageMetadata);
+  }
 
   m_LeftToGroundTransform->InstantiateTransform();
   m_RightToGroundTransform->InstantiateTransform();
@@ -210,7 +222,7 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
 
 template <class TDisparityImage, class TOutputImage, class TEpipolarGridImage, class TMaskImage>
 void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, TMaskImage>::ThreadedGenerateData(
-    const RegionType& itkNotUsed(outputRegionForThread), itk::ThreadIdType itkNotUsed(threadId))
+    const RegionType& outputRegionForThread, itk::ThreadIdType itkNotUsed(threadId))
 {
   const TDisparityImage* horizDisp = this->GetHorizontalDisparityMapInput();
   const TDisparityImage* vertiDisp = this->GetVerticalDisparityMapInput();
@@ -225,10 +237,8 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
 
   typename TEpipolarGridImage::RegionType gridRegion = leftGrid->GetLargestPossibleRegion();
 
-  typename TOutputImage::RegionType outputRequestedRegion = outputDEM->GetRequestedRegion();
-
-  itk::ImageRegionIterator<OutputImageType>                demIt(outputDEM, outputRequestedRegion);
-  itk::ImageRegionConstIteratorWithIndex<DisparityMapType> horizIt(horizDisp, outputRequestedRegion);
+  itk::ImageRegionIterator<OutputImageType>                demIt(outputDEM, outputRegionForThread);
+  itk::ImageRegionConstIteratorWithIndex<DisparityMapType> horizIt(horizDisp, outputRegionForThread);
 
   demIt.GoToBegin();
   horizIt.GoToBegin();
@@ -238,7 +248,7 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
   if (vertiDisp)
   {
     useVerti = true;
-    vertiIt  = itk::ImageRegionConstIteratorWithIndex<DisparityMapType>(vertiDisp, outputRequestedRegion);
+    vertiIt  = itk::ImageRegionConstIteratorWithIndex<DisparityMapType>(vertiDisp, outputRegionForThread);
     vertiIt.GoToBegin();
   }
 
@@ -247,7 +257,7 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
   if (disparityMask)
   {
     useMask = true;
-    maskIt  = itk::ImageRegionConstIterator<MaskImageType>(disparityMask, outputRequestedRegion);
+    maskIt  = itk::ImageRegionConstIterator<MaskImageType>(disparityMask, outputRegionForThread);
     maskIt.GoToBegin();
   }
 
@@ -277,6 +287,16 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
   TDPointType rightGroundHmin;
   TDPointType rightGroundHmax;
 
+  // Sensor positions (left x, left y, right x, right y) of each pixel, kept
+  // until the line of sight grids are built
+  std::vector<double> sensorPositions;
+  std::vector<bool>   validPositions;
+  if (m_UseLineOfSightGrid)
+  {
+    sensorPositions.reserve(4 * outputRegionForThread.GetNumberOfPixels());
+    validPositions.reserve(outputRegionForThread.GetNumberOfPixels());
+  }
+
   while (!demIt.IsAtEnd() && !horizIt.IsAtEnd())
   {
     // check mask value if any
@@ -289,6 +309,12 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
         pixel3D.Fill(0);
         demIt.Set(pixel3D);
 
+        if (m_UseLineOfSightGrid)
+        {
+          sensorPositions.insert(sensorPositions.end(), 4, 0.);
+          validPositions.push_back(false);
+        }
+
         ++demIt;
         ++horizIt;
         if (useVerti)
@@ -343,11 +369,14 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
 
     sensorPoint[0] = cPixel[0];
     sensorPoint[1] = cPixel[1];
-    sensorPoint[2] = elevationMin;
-    leftGroundHmin = m_LeftToGroundTransform->TransformPoint(sensorPoint);
+    if (!m_UseLineOfSightGrid)
+    {
+      sensorPoint[2] = elevationMin;
+      leftGroundHmin = m_LeftToGroundTransform->TransformPoint(sensorPoint);
 
-    sensorPoint[2] = elevationMax;
-    leftGroundHmax = m_LeftToGroundTransform->TransformPoint(sensorPoint);
+      sensorPoint[2] = elevationMax;
+      leftGroundHmax = m_LeftToGroundTransform->TransformPoint(sensorPoint);
+    }
 
     // compute right ray
     itk::ContinuousIndex<double, 2> rightIndexEstimate;
@@ -400,6 +429,24 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
     cPixel     = (ulPixel * (1.0 - subPixIndex[0]) + urPixel * subPixIndex[0]) * (1.0 - subPixIndex[1]) +
              (llPixel * (1.0 - subPixIndex[0]) + lrPixel * subPixIndex[0]) * subPixIndex[1];
 
+    if (m_UseLineOfSightGrid)
+    {
+      // Lines of sight are computed once the grids are built
+      sensorPositions.push_back(sensorPoint[0]);
+      sensorPositions.push_back(sensorPoint[1]);
+      sensorPositions.push_back(cPixel[0]);
+      sensorPositions.push_back(cPixel[1]);
+      validPositions.push_back(true);
+
+      ++demIt;
+      ++horizIt;
+      if (useVerti)
+        ++vertiIt;
+      if (useMask)
+        ++maskIt;
+      continue;
+    }
+
     sensorPoint[0]  = cPixel[0];
     sensorPoint[1]  = cPixel[1];
     sensorPoint[2]  = elevationMin;
@@ -439,6 +486,87 @@ void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, T
     if (useMask)
       ++maskIt;
   }
+
+  if (m_UseLineOfSightGrid)
+  {
+    this->GridGenerateData(outputRegionForThread, sensorPositions, validPositions, elevationMin, elevationMax);
+  }
+}
+
+template <class TDisparityImage, class TOutputImage, class TEpipolarGridImage, class TMaskImage>
+void DisparityMapTo3DFilter<TDisparityImage, TOutputImage, TEpipolarGridImage, TMaskImage>::GridGenerateData(const RegionType&          region,
+                                                                                                             const std::vector<double>& sensorPositions,
+                                                                                                             const std::vector<bool>&   validPositions,
+                                                                                                             PrecisionType              elevationMin,
+                                                                                                             PrecisionType              elevationMax)
+{
+  // Extent of the left and right sensor positions
+  double       bounds[2][4];
+  bool         found    = false;
+  const size_t nbPixels = validPositions.size();
+  for (size_t i = 0; i < nbPixels; ++i)
+  {
+    if (!validPositions[i])
+    {
+      continue;
+    }
+    for (unsigned int side = 0; side < 2; ++side)
+    {
+      const double x = sensorPositions[4 * i + 2 * side];
+      const double y = sensorPositions[4 * i + 2 * side + 1];
+      if (!found)
+      {
+        bounds[side][0] = bounds[side][1] = x;
+        bounds[side][2] = bounds[side][3] = y;
+      }
+      bounds[side][0] = std::min(bounds[side][0], x);
+      bounds[side][1] = std::max(bounds[side][1], x);
+      bounds[side][2] = std::min(bounds[side][2], y);
+      bounds[side][3] = std::max(bounds[side][3], y);
+    }
+    found = true;
+  }
+
+  if (!found)
+  {
+    return;
+  }
+
+  LineOfSightGridType    grids[2];
+  const RSTransformType* transforms[2] = {m_LeftToGroundTransform, m_RightToGroundTransform};
+  for (unsigned int side = 0; side < 2; ++side)
+  {
+    grids[side].Build(transforms[side], bounds[side][0], bounds[side][2], bounds[side][1], bounds[side][3],
+                      LineOfSightGridType::ComputeNumberOfNodes(bounds[side][1] - bounds[side][0], m_LineOfSightGridStep),
+                      LineOfSightGridType::ComputeNumberOfNodes(bounds[side][3] - bounds[side][2], m_LineOfSightGridStep), elevationMin, elevationMax);
+  }
+
+  itk::ImageRegionIterator<OutputImageType> demIt(this->GetOutput(), region);
+  typename OutputImageType::PixelType      pixel3D(3);
+
+  TDPointType   pointsA[2];
+  TDPointType   pointsB[2];
+  PrecisionType globalResidue;
+
+  size_t i = 0;
+  for (demIt.GoToBegin(); !demIt.IsAtEnd(); ++demIt, ++i)
+  {
+    if (!validPositions[i])
+    {
+      continue;
+    }
+    for (unsigned int side = 0; side < 2; ++side)
+    {
+      grids[side].Evaluate(sensorPositions[4 * i + 2 * side], sensorPositions[4 * i + 2 * side + 1], pointsA[side], pointsB[side]);
+    }
+
+    TDPointType midPoint3D = OptimizerType::Intersect(pointsA, pointsB, 2, globalResidue);
+
+    pixel3D[0] = midPoint3D[0];
+    pixel3D[1] = midPoint3D[1];
+    pixel3D[2] = midPoint3D[2];
+    demIt.Set(pixel3D);
+  }
 }
 }
 
@@ -63,6 +63,15 @@ namespace otb
  *
  * The FineRegistrationImageFilter allows using the full range of itk::ImageToImageMetric provided by itk.
  *
+ * When UseFastCorrelationOn() is set, the metric and the golden section search are not used. Instead, the
+ * normalized cross-correlation (mean subtracted, as the itk::NormalizedCorrelationImageToImageMetric with
+ * SubtractMeanOn()) is computed for all the offsets of the search window at once: the moving image is
+ * resampled once on the fixed grid around each location, the local sums of the moving patch are taken from
+ * summed-area tables, and the cross products are computed in the Fourier domain when the search window is
+ * large enough for this to pay off. The correlation peak is then refined by fitting a quadratic surface on
+ * its 3x3 neighborhood. Locations are processed in parallel. The output metric is the opposite of the correlation, as with
+ * the itk metric.
+ *
  * \example DisparityMap/FineRegistrationImageFilterExample.cxx
  *
  * \sa      FastCorrelationImageFilter, DisparityMapEstimationMethod
@@ -185,6 +194,12 @@ public:
   itkSetObjectMacro(Transform, TransformType);
   itkGetConstObjectMacro(Transform, TransformType);
 
+  /** True to compute the normalized cross-correlation over the whole search window at once, instead of
+   * optimizing the metric. False otherwise (default) */
+  itkSetMacro(UseFastCorrelation, bool);
+  itkGetMacro(UseFastCorrelation, bool);
+  itkBooleanMacro(UseFastCorrelation);
+
 protected:
   /** Constructor */
   FineRegistrationImageFilter();
@@ -200,6 +215,14 @@ protected:
   /** Generate output information */
   void GenerateOutputInformation(void) override;
 
+  /** Fast correlation mode: process the requested region with several threads */
+  void FastCorrelationGenerateData();
+
+  /** Fast correlation mode: process a piece of the requested region */
+  void ThreadedFastCorrelation(const OutputImageRegionType& outputRegion, itk::ThreadIdType threadId);
+
+  static ITK_THREAD_RETURN_TYPE FastCorrelationThreaderCallback(void* arg);
+
 private:
   FineRegistrationImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -247,6 +270,9 @@ private:
 
   /** Transform for initial offset */
   TransformPointerType m_Transform;
+
+  /** Compute the correlation for the whole search window at once */
+  bool m_UseFastCorrelation;
 };
 
 } // end namespace otb
@@ -28,6 +28,10 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkNormalizedCorrelationImageToImageMetric.h"
 #include "itkMacro.h"
+#include "vnl/algo/vnl_fft_2d.h"
+#include <cmath>
+#include <complex>
+#include <memory>
 
 namespace otb
 {
@@ -72,6 +76,8 @@ FineRegistrationImageFilter<TInputImage, T0utputCorrelation, TOutputDisplacement
   m_InitialOffset.Fill(0);
 
   m_Transform = nullptr;
+
+  m_UseFastCorrelation = false;
 }
 
 template <class TInputImage, class T0utputCorrelation, class TOutputDisplacementField>
@@ -337,6 +343,12 @@ void FineRegistrationImageFilter<TInputImage, TOutputCorrelation, TOutputDisplac
   // Allocate outputs
   this->AllocateOutputs();
 
+  if (m_UseFastCorrelation)
+  {
+    this->FastCorrelationGenerateData();
+    return;
+  }
+
   // Get the image pointers
   const TInputImage*        fixedPtr    = this->GetFixedInput();
   const TInputImage*        movingPtr   = this->GetMovingInput();
@@ -560,6 +572,372 @@ void FineRegistrationImageFilter<TInputImage, TOutputCorrelation, TOutputDisplac
     progress.CompletedPixel();
   }
 }
+namespace internal
+{
+/** Smallest integer greater or equal to n whose prime factors are 2, 3 and 5 (sizes handled by vnl_fft) */
+inline unsigned int FFTSmoothSize(unsigned int n)
+{
+  for (;; ++n)
+  {
+    unsigned int m = n;
+    for (unsigned int f : {2u, 3u, 5u})
+    {
+      while (m % f == 0)
+      {
+        m /= f;
+      }
+    }
+    if (m == 1)
+    {
+      return n;
+    }
+  }
+}
+}
+
+template <class TInputImage, class TOutputCorrelation, class TOutputDisplacementField>
+void FineRegistrationImageFilter<TInputImage, TOutputCorrelation, TOutputDisplacementField>::FastCorrelationGenerateData()
+{
+  m_Interpolator->SetInputImage(this->GetMovingInput());
+
+  this->GetMultiThreader()->SetNumberOfThreads(this->GetNumberOfThreads());
+  this->GetMultiThreader()->SetSingleMethod(this->FastCorrelationThreaderCallback, this);
+  this->GetMultiThreader()->SingleMethodExecute();
+}
+
+template <class TInputImage, class TOutputCorrelation, class TOutputDisplacementField>
+ITK_THREAD_RETURN_TYPE FineRegistrationImageFilter<TInputImage, TOutputCorrelation, TOutputDisplacementField>::FastCorrelationThreaderCallback(void* arg)
+{
+  Self*             filter      = (Self*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+  itk::ThreadIdType threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  itk::ThreadIdType threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+
+  OutputImageRegionType splitRegion;
+  unsigned int          total = filter->SplitRequestedRegion(threadId, threadCount, splitRegion);
+
+  if (threadId < total)
+  {
+    filter->ThreadedFastCorrelation(splitRegion, threadId);
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage, class TOutputCorrelation, class TOutputDisplacementField>
+void FineRegistrationImageFilter<TInputImage, TOutputCorrelation, TOutputDisplacementField>::ThreadedFastCorrelation(const OutputImageRegionType& outputRegion,
+                                                                                                                     itk::ThreadIdType           threadId)
+{
+  const TInputImage*        fixedPtr    = this->GetFixedInput();
+  const TInputImage*        movingPtr   = this->GetMovingInput();
+  TOutputCorrelation*       outputPtr   = this->GetOutput();
+  TOutputDisplacementField* outputDfPtr = this->GetOutputDisplacementField();
+
+  itk::ImageRegionIteratorWithIndex<TOutputCorrelation> outputIt(outputPtr, outputRegion);
+  itk::ImageRegionIterator<TOutputDisplacementField>    outputDfIt(outputDfPtr, outputRegion);
+
+  itk::ProgressReporter progress(this, threadId, outputRegion.GetNumberOfPixels());
+
+  const SpacingType  fixedSpacing = fixedPtr->GetSignedSpacing();
+  const unsigned int searchX      = m_SearchRadius[0];
+  const unsigned int searchY      = m_SearchRadius[1];
+  const unsigned int nbShiftsX    = 2 * searchX + 1;
+  const unsigned int nbShiftsY    = 2 * searchY + 1;
+
+  // Buffers reused from one location to the next
+  std::vector<double>                 fixedValues, movingValues, sums, squaredSums, crossProducts, correlation;
+  std::vector<unsigned int>           invalidCounts;
+  std::vector<bool>                   validShifts;
+  vnl_matrix<std::complex<double>>    fixedSpectrum, movingSpectrum;
+  std::unique_ptr<vnl_fft_2d<double>> fft;
+
+  SpacingType           localOffset = m_InitialOffset;
+  DisplacementValueType displacementValue;
+
+  for (outputIt.GoToBegin(), outputDfIt.GoToBegin(); !outputIt.IsAtEnd(); ++outputIt, ++outputDfIt)
+  {
+    // Fixed window, as the metric region of the standard mode
+    IndexType currentIndex = outputIt.GetIndex();
+    for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+    {
+      currentIndex[dim] *= m_GridStep[dim];
+    }
+    InputImageRegionType windowRegion;
+    SizeType             size;
+    size.Fill(1);
+    windowRegion.SetIndex(currentIndex);
+    windowRegion.SetSize(size);
+    windowRegion.PadByRadius(m_Radius);
+    windowRegion.Crop(fixedPtr->GetLargestPossibleRegion());
+
+    const unsigned int windowX     = windowRegion.GetSize()[0];
+    const unsigned int windowY     = windowRegion.GetSize()[1];
+    const unsigned int patchX      = windowX + 2 * searchX;
+    const unsigned int patchY      = windowY + 2 * searchY;
+    const double       nbSamples   = static_cast<double>(windowX) * windowY;
+    const IndexType    windowIndex = windowRegion.GetIndex();
+
+    // Zero-mean fixed window
+    fixedValues.resize(windowX * windowY);
+    double fixedMean = 0.;
+    itk::ImageRegionConstIterator<TInputImage> fixedIt(fixedPtr, windowRegion);
+    unsigned int                               k = 0;
+    for (fixedIt.GoToBegin(); !fixedIt.IsAtEnd(); ++fixedIt, ++k)
+    {
+      fixedValues[k] = static_cast<double>(fixedIt.Get());
+      fixedMean += fixedValues[k];
+    }
+    fixedMean /= nbSamples;
+    double fixedEnergy = 0.;
+    for (k = 0; k < fixedValues.size(); ++k)
+    {
+      fixedValues[k] -= fixedMean;
+      fixedEnergy += fixedValues[k] * fixedValues[k];
+    }
+
+    // Compute the local offset if required (and the transform was specified).
+    // The transform maps fixed points to moving points, so the search is
+    // centered on the moving point T(p), as the metric translation p + offset
+    // of the standard mode.
+    if (m_Transform.IsNotNull())
+    {
+      PointType inputPoint, outputPoint;
+      for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+      {
+        inputPoint[dim] = currentIndex[dim];
+      }
+      outputPoint = m_Transform->TransformPoint(inputPoint);
+      for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+      {
+        localOffset[dim] = outputPoint[dim] - inputPoint[dim];
+      }
+    }
+
+    // Moving patch, resampled on the fixed grid over the window padded by the search radius,
+    // with summed-area tables of the values, squared values and samples outside the moving buffer
+    movingValues.assign(patchX * patchY, 0.);
+    sums.assign((patchX + 1) * (patchY + 1), 0.);
+    squaredSums.assign((patchX + 1) * (patchY + 1), 0.);
+    invalidCounts.assign((patchX + 1) * (patchY + 1), 0);
+    for (unsigned int y = 0; y < patchY; ++y)
+    {
+      double       rowSum = 0., rowSquaredSum = 0.;
+      unsigned int rowInvalid = 0;
+      for (unsigned int x = 0; x < patchX; ++x)
+      {
+        IndexType fixedIndex;
+        fixedIndex[0] = windowIndex[0] + static_cast<int>(x) - static_cast<int>(searchX);
+        fixedIndex[1] = windowIndex[1] + static_cast<int>(y) - static_cast<int>(searchY);
+        PointType point;
+        fixedPtr->TransformIndexToPhysicalPoint(fixedIndex, point);
+        point += localOffset;
+
+        ContinuousIndexType movingIndex;
+        movingPtr->TransformPhysicalPointToContinuousIndex(point, movingIndex);
+        if (m_Interpolator->IsInsideBuffer(movingIndex))
+        {
+          const double value           = m_Interpolator->EvaluateAtContinuousIndex(movingIndex);
+          movingValues[y * patchX + x] = value;
+          rowSum += value;
+          rowSquaredSum += value * value;
+        }
+        else
+        {
+          ++rowInvalid;
+        }
+        const unsigned int t = (y + 1) * (patchX + 1) + x + 1;
+        sums[t]              = sums[t - patchX - 1] + rowSum;
+        squaredSums[t]       = squaredSums[t - patchX - 1] + rowSquaredSum;
+        invalidCounts[t]     = invalidCounts[t - patchX - 1] + rowInvalid;
+      }
+    }
+
+    // Cross products of the zero-mean fixed window with the patch, for every shift
+    crossProducts.assign(nbShiftsX * nbShiftsY, 0.);
+    const unsigned int fftX       = internal::FFTSmoothSize(patchX);
+    const unsigned int fftY       = internal::FFTSmoothSize(patchY);
+    const double       fftSize    = static_cast<double>(fftX) * fftY;
+    const double       directCost = nbSamples * nbShiftsX * nbShiftsY;
+    if (directCost > 6. * fftSize * std::log2(fftSize))
+    {
+      if (!fft || fixedSpectrum.rows() != fftY || fixedSpectrum.cols() != fftX)
+      {
+        fft.reset(new vnl_fft_2d<double>(fftY, fftX));
+        fixedSpectrum.set_size(fftY, fftX);
+        movingSpectrum.set_size(fftY, fftX);
+      }
+      fixedSpectrum.fill(0.);
+      movingSpectrum.fill(0.);
+      for (unsigned int y = 0; y < windowY; ++y)
+      {
+        for (unsigned int x = 0; x < windowX; ++x)
+        {
+          fixedSpectrum(y, x) = fixedValues[y * windowX + x];
+        }
+      }
+      for (unsigned int y = 0; y < patchY; ++y)
+      {
+        for (unsigned int x = 0; x < patchX; ++x)
+        {
+          movingSpectrum(y, x) = movingValues[y * patchX + x];
+        }
+      }
+      fft->fwd_transform(fixedSpectrum);
+      fft->fwd_transform(movingSpectrum);
+      for (unsigned int y = 0; y < fftY; ++y)
+      {
+        for (unsigned int x = 0; x < fftX; ++x)
+        {
+          movingSpectrum(y, x) *= std::conj(fixedSpectrum(y, x));
+        }
+      }
+      fft->bwd_transform(movingSpectrum);
+
+      // The patch is not smaller than the window plus the shifts, so there is no wrap around
+      for (unsigned int v = 0; v < nbShiftsY; ++v)
+      {
+        for (unsigned int u = 0; u < nbShiftsX; ++u)
+        {
+          crossProducts[v * nbShiftsX + u] = movingSpectrum(v, u).real() / fftSize;
+        }
+      }
+    }
+    else
+    {
+      for (unsigned int v = 0; v < nbShiftsY; ++v)
+      {
+        for (unsigned int u = 0; u < nbShiftsX; ++u)
+        {
+          double sum = 0.;
+          for (unsigned int y = 0; y < windowY; ++y)
+          {
+            const double* fixedRow  = &fixedValues[y * windowX];
+            const double* movingRow = &movingValues[(y + v) * patchX + u];
+            for (unsigned int x = 0; x < windowX; ++x)
+            {
+              sum += fixedRow[x] * movingRow[x];
+            }
+          }
+          crossProducts[v * nbShiftsX + u] = sum;
+        }
+      }
+    }
+
+    // Normalized cross-correlation of each shift
+    correlation.assign(nbShiftsX * nbShiftsY, 0.);
+    validShifts.assign(nbShiftsX * nbShiftsY, false);
+    bool         found = false;
+    unsigned int bestU = 0, bestV = 0;
+    for (unsigned int u = 0; u < nbShiftsX; ++u)
+    {
+      for (unsigned int v = 0; v < nbShiftsY; ++v)
+      {
+        const unsigned int t00 = v * (patchX + 1) + u;
+        const unsigned int t01 = t00 + windowX;
+        const unsigned int t10 = t00 + windowY * (patchX + 1);
+        const unsigned int t11 = t10 + windowX;
+        if (invalidCounts[t11] - invalidCounts[t10] - invalidCounts[t01] + invalidCounts[t00] != 0)
+        {
+          continue;
+        }
+        const double movingSum      = sums[t11] - sums[t10] - sums[t01] + sums[t00];
+        const double movingSquares  = squaredSums[t11] - squaredSums[t10] - squaredSums[t01] + squaredSums[t00];
+        const double movingVariance = movingSquares - movingSum * movingSum / nbSamples;
+        const double denom          = fixedEnergy * movingVariance;
+
+        const unsigned int shift = v * nbShiftsX + u;
+        correlation[shift]       = denom > 0. ? crossProducts[shift] / std::sqrt(denom) : 0.;
+        validShifts[shift]       = true;
+
+        if (!found || correlation[shift] > correlation[bestV * nbShiftsX + bestU])
+        {
+          found = true;
+          bestU = u;
+          bestV = v;
+        }
+      }
+    }
+
+    // Sub-pixel refinement: stationary point of the quadratic surface fitted on the 3x3 neighborhood of the
+    // peak, or of a parabola along each axis when the neighborhood is not complete
+    double bestCorrelation = 0., deltaX = 0., deltaY = 0.;
+    if (found)
+    {
+      const unsigned int best = bestV * nbShiftsX + bestU;
+      bestCorrelation         = correlation[best];
+
+      bool fullNeighborhood = bestU > 0 && bestU + 1 < nbShiftsX && bestV > 0 && bestV + 1 < nbShiftsY;
+      for (int dv = -1; dv <= 1 && fullNeighborhood; ++dv)
+      {
+        for (int du = -1; du <= 1 && fullNeighborhood; ++du)
+        {
+          fullNeighborhood = validShifts[best + dv * static_cast<int>(nbShiftsX) + du];
+        }
+      }
+
+      if (fullNeighborhood)
+      {
+        const double gradX  = 0.5 * (correlation[best + 1] - correlation[best - 1]);
+        const double gradY  = 0.5 * (correlation[best + nbShiftsX] - correlation[best - nbShiftsX]);
+        const double hessXX = correlation[best + 1] - 2 * bestCorrelation + correlation[best - 1];
+        const double hessYY = correlation[best + nbShiftsX] - 2 * bestCorrelation + correlation[best - nbShiftsX];
+        const double hessXY = 0.25 * (correlation[best + nbShiftsX + 1] - correlation[best + nbShiftsX - 1] - correlation[best - nbShiftsX + 1] +
+                                      correlation[best - nbShiftsX - 1]);
+        const double det = hessXX * hessYY - hessXY * hessXY;
+        if (hessXX < 0. && det > 0.)
+        {
+          deltaX = std::max(-0.5, std::min(0.5, -(hessYY * gradX - hessXY * gradY) / det));
+          deltaY = std::max(-0.5, std::min(0.5, -(hessXX * gradY - hessXY * gradX) / det));
+        }
+      }
+      else
+      {
+        if (bestU > 0 && bestU + 1 < nbShiftsX && validShifts[best - 1] && validShifts[best + 1])
+        {
+          const double curvature = correlation[best - 1] - 2 * bestCorrelation + correlation[best + 1];
+          if (curvature < 0.)
+          {
+            deltaX = std::max(-0.5, std::min(0.5, 0.5 * (correlation[best - 1] - correlation[best + 1]) / curvature));
+          }
+        }
+        if (bestV > 0 && bestV + 1 < nbShiftsY && validShifts[best - nbShiftsX] && validShifts[best + nbShiftsX])
+        {
+          const double curvature = correlation[best - nbShiftsX] - 2 * bestCorrelation + correlation[best + nbShiftsX];
+          if (curvature < 0.)
+          {
+            deltaY = std::max(-0.5, std::min(0.5, 0.5 * (correlation[best - nbShiftsX] - correlation[best + nbShiftsX]) / curvature));
+          }
+        }
+      }
+    }
+    else
+    {
+      bestU = searchX;
+      bestV = searchY;
+    }
+
+    double optParams[2];
+    optParams[0] = localOffset[0] + (static_cast<double>(bestU) - searchX + deltaX) * fixedSpacing[0];
+    optParams[1] = localOffset[1] + (static_cast<double>(bestV) - searchY + deltaY) * fixedSpacing[1];
+
+    // Store the offset and the correlation value
+    outputIt.Set(-bestCorrelation);
+    if (m_UseSpacing)
+    {
+      displacementValue[0] = optParams[0];
+      displacementValue[1] = optParams[1];
+    }
+    else
+    {
+      displacementValue[0] = optParams[0] / fixedSpacing[0];
+      displacementValue[1] = optParams[1] / fixedSpacing[1];
+    }
+    outputDfIt.Set(displacementValue);
+
+    // Update progress
+    progress.CompletedPixel();
+  }
+}
+
 } // end namespace otb
 
 #endif
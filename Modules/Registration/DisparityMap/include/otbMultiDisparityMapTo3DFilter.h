@@ -24,6 +24,7 @@
 #include "itkImageToImageFilter.h"
 #include "otbGenericRSTransform.h"
 #include "otbLineOfSightOptimizer.h"
+#include "otbLineOfSightGrid.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageRegionConstIterator.h"
 #include "otbVectorImage.h"
@@ -44,6 +45,12 @@ namespace otb
  *  addition, the disparities shall be computed in physical space (not in index space)
  *  N disparity masks can be provided for each disparity map.
  *
+ *  When UseLineOfSightGrid is on, the sensor models are only evaluated on a coarse grid
+ *  (one node every LineOfSightGridStep pixels) covering the positions of each thread region,
+ *  the lines of sight are interpolated bilinearly in between, and the intersection is
+ *  solved in closed form. This is much faster, at the cost of a small interpolation error.
+ *  It is off by default.
+ *
  *  \sa FineRegistrationImageFilter
  *  \sa LineOfSightOptimizer
  *  \sa SubPixelDisparityImageFilter
@@ -94,6 +101,8 @@ public:
   typedef typename PointSetType::PointsContainer    PointsContainer;
   typedef typename PointSetType::PointDataContainer LabelContainer;
 
+  typedef otb::LineOfSightGrid<PrecisionType> LineOfSightGridType;
+
   typedef std::map<unsigned int, itk::ImageRegionConstIterator<DisparityMapType>> DispMapIteratorList;
 
   typedef std::map<unsigned int, itk::ImageRegionConstIterator<MaskImageType>> MaskIteratorList;
@@ -143,6 +152,15 @@ public:
   /** Get ImageMetadata of the moving image 'index' */
   const ImageMetadata* GetMovingImageMetadata(unsigned int index) const;
 
+  /** Set/Get the interpolation of the lines of sight from a coarse grid (off by default) */
+  itkSetMacro(UseLineOfSightGrid, bool);
+  itkGetConstMacro(UseLineOfSightGrid, bool);
+  itkBooleanMacro(UseLineOfSightGrid);
+
+  /** Set/Get the step of the line of sight grids, in pixels */
+  itkSetMacro(LineOfSightGridStep, unsigned int);
+  itkGetConstMacro(LineOfSightGridStep, unsigned int);
+
 protected:
   /** Constructor */
   MultiDisparityMapTo3DFilter();
@@ -159,6 +177,12 @@ protected:
   /** Threaded generate data */
   void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
+  /** Sample the lines of sight of the reference and moving images over the
+   * positions reached by the pixels of 'region' */
+  void BuildLineOfSightGrids(const RegionType& region, const RSTransformType* referenceToGroundTransform,
+                             const std::vector<RSTransformType::Pointer>& movingToGroundTransform, PrecisionType altiMin, PrecisionType altiMax,
+                             LineOfSightGridType& referenceGrid, std::vector<LineOfSightGridType>& movingGrids) const;
+
 private:
   MultiDisparityMapTo3DFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -169,6 +193,11 @@ private:
   /** ImageMetadata of moving sensor images */
   std::vector<const ImageMetadata*> m_MovingImageMetadatas;
 
+  /** Interpolate the lines of sight from coarse grids */
+  bool m_UseLineOfSightGrid;
+
+  /** Step of the line of sight grids, in pixels */
+  unsigned int m_LineOfSightGridStep;
 
 };
 } // end namespace otb
@@ -24,6 +24,8 @@
 #include "otbMultiDisparityMapTo3DFilter.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
+#include <algorithm>
+#include <cmath>
 
 namespace otb
 {
@@ -36,6 +38,9 @@ MultiDisparityMapTo3DFilter<TDisparityImage, TOutputImage, TMaskImage, TResidueI
   this->SetNumberOfRequiredInputs(1);
   this->m_MovingImageMetadatas.resize(1);
 
+  m_UseLineOfSightGrid  = false;
+  m_LineOfSightGridStep = 16;
+
   // Set the outputs
   this->SetNumberOfRequiredOutputs(2);
   this->SetNthOutput(0, TOutputImage::New());
@@ -277,6 +282,96 @@ void MultiDisparityMapTo3DFilter<TDisparityImage, TOutputImage, TMaskImage, TRes
   }
 }
 
+template <class TDisparityImage, class TOutputImage, class TMaskImage, class TResidueImage>
+void MultiDisparityMapTo3DFilter<TDisparityImage, TOutputImage, TMaskImage, TResidueImage>::BuildLineOfSightGrids(
+    const RegionType& region, const RSTransformType* referenceToGroundTransform, const std::vector<RSTransformType::Pointer>& movingToGroundTransform,
+    PrecisionType altiMin, PrecisionType altiMax, LineOfSightGridType& referenceGrid, std::vector<LineOfSightGridType>& movingGrids) const
+{
+  const TOutputImage* outputPtr = this->GetOutput();
+
+  const double stepX = m_LineOfSightGridStep * std::abs(outputPtr->GetSignedSpacing()[0]);
+  const double stepY = m_LineOfSightGridStep * std::abs(outputPtr->GetSignedSpacing()[1]);
+
+  // Reference positions are the pixels of the region
+  typename RegionType::IndexType lastIndex = region.GetIndex();
+  lastIndex[0] += region.GetSize()[0] - 1;
+  lastIndex[1] += region.GetSize()[1] - 1;
+
+  typename OutputImageType::PointType firstPoint, lastPoint;
+  outputPtr->TransformIndexToPhysicalPoint(region.GetIndex(), firstPoint);
+  outputPtr->TransformIndexToPhysicalPoint(lastIndex, lastPoint);
+
+  double xMin = std::min(firstPoint[0], lastPoint[0]);
+  double xMax = std::max(firstPoint[0], lastPoint[0]);
+  double yMin = std::min(firstPoint[1], lastPoint[1]);
+  double yMax = std::max(firstPoint[1], lastPoint[1]);
+
+  referenceGrid.Build(referenceToGroundTransform, xMin, yMin, xMax, yMax, LineOfSightGridType::ComputeNumberOfNodes(xMax - xMin, stepX),
+                      LineOfSightGridType::ComputeNumberOfNodes(yMax - yMin, stepY), altiMin, altiMax);
+
+  // Moving positions are shifted by the disparities: find their extent
+  typename OutputImageType::PointType pointRef;
+  for (unsigned int k = 0; k < movingGrids.size(); ++k)
+  {
+    const TDisparityImage* hDisp = this->GetHorizontalDisparityMapInput(k);
+    const TDisparityImage* vDisp = this->GetVerticalDisparityMapInput(k);
+    const TMaskImage*      mask  = this->GetDisparityMaskInput(k);
+
+    itk::ImageRegionConstIteratorWithIndex<DisparityMapType> hIt(hDisp, region);
+    itk::ImageRegionConstIterator<DisparityMapType>          vIt;
+    itk::ImageRegionConstIterator<MaskImageType>             mIt;
+    if (vDisp)
+    {
+      vIt = itk::ImageRegionConstIterator<DisparityMapType>(vDisp, region);
+      vIt.GoToBegin();
+    }
+    if (mask)
+    {
+      mIt = itk::ImageRegionConstIterator<MaskImageType>(mask, region);
+      mIt.GoToBegin();
+    }
+
+    bool found = false;
+    for (hIt.GoToBegin(); !hIt.IsAtEnd(); ++hIt)
+    {
+      if (!mask || mIt.Get() > 0)
+      {
+        outputPtr->TransformIndexToPhysicalPoint(hIt.GetIndex(), pointRef);
+        const double x = pointRef[0] + hIt.Get();
+        const double y = pointRef[1] + (vDisp ? static_cast<double>(vIt.Get()) : 0.);
+        if (!found)
+        {
+          xMin  = xMax = x;
+          yMin  = yMax = y;
+          found = true;
+        }
+        xMin = std::min(xMin, x);
+        xMax = std::max(xMax, x);
+        yMin = std::min(yMin, y);
+        yMax = std::max(yMax, y);
+      }
+      if (vDisp)
+      {
+        ++vIt;
+      }
+      if (mask)
+      {
+        ++mIt;
+      }
+    }
+
+    if (found)
+    {
+      movingGrids[k].Build(movingToGroundTransform[k], xMin, yMin, xMax, yMax, LineOfSightGridType::ComputeNumberOfNodes(xMax - xMin, stepX),
+                           LineOfSightGridType::ComputeNumberOfNodes(yMax - yMin, stepY), altiMin, altiMax);
+    }
+    else
+    {
+      movingGrids[k].Clear();
+    }
+  }
+}
+
 template <class TDisparityImage, class TOutputImage, class TMaskImage, class TResidueImage>
 void MultiDisparityMapTo3DFilter<TDisparityImage, TOutputImage, TMaskImage, TResidueImage>::ThreadedGenerateData(const RegionType& outputRegionForThread,
                                                                                                                  itk::ThreadIdType itkNotUsed(threadId))
@@ -335,6 +430,16 @@ void MultiDisparityMapTo3DFilter<TDisparityImage, TOutputImage, TMaskImage, TRes
   PrecisionType altiMin = 0;
   PrecisionType altiMax = 500;
 
+  const unsigned int nbMovingImages = this->m_MovingImageMetadatas.size();
+
+  // Coarse grids of lines of sight covering the positions of this region
+  LineOfSightGridType              referenceGrid;
+  std::vector<LineOfSightGridType> movingGrids(nbMovingImages);
+  if (m_UseLineOfSightGrid)
+  {
+    this->BuildLineOfSightGrids(outputRegionForThread, referenceToGroundTransform, movingToGroundTransform, altiMin, altiMax, referenceGrid, movingGrids);
+  }
+
   typename OutputImageType::PointType pointRef;
   TDPointType                         currentPoint;
 
@@ -344,37 +449,38 @@ void MultiDisparityMapTo3DFilter<TDisparityImage, TOutputImage, TMaskImage, TRes
   typename PointSetType::Pointer pointSetA = PointSetType::New();
   typename PointSetType::Pointer pointSetB = PointSetType::New();
 
+  // Starting and ending points of the lines of sight of the current pixel
+  std::vector<TDPointType>  pointsA(nbMovingImages + 1);
+  std::vector<TDPointType>  pointsB(nbMovingImages + 1);
+  std::vector<unsigned int> labels(nbMovingImages + 1);
+
   while (!outIt.IsAtEnd())
   {
-    pointSetA->Initialize();
-    pointSetB->Initialize();
-
     // Compute reference line of sight
-    TDPointType pointA, pointB;
-
     outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), pointRef);
 
-    currentPoint[0] = pointRef[0];
-    currentPoint[1] = pointRef[1];
-    currentPoint[2] = altiMax;
-
-    pointA          = referenceToGroundTransform->TransformPoint(currentPoint);
+    if (m_UseLineOfSightGrid && referenceGrid.IsInside(pointRef[0], pointRef[1]))
+    {
+      referenceGrid.Evaluate(pointRef[0], pointRef[1], pointsA[0], pointsB[0]);
+    }
+    else
+    {
+      currentPoint[0] = pointRef[0];
+      currentPoint[1] = pointRef[1];
+      currentPoint[2] = altiMax;
 
-    currentPoint[2] = altiMin;
-    pointB          = referenceToGroundTransform->TransformPoint(currentPoint);
+      pointsA[0] = referenceToGroundTransform->TransformPoint(currentPoint);
 
-    pointSetA->SetPoint(0, pointA);
-    pointSetB->SetPoint(0, pointB);
-    pointSetA->SetPointData(0, 0);
-    pointSetB->SetPointData(0, 0);
+      currentPoint[2] = altiMin;
+      pointsB[0]      = referenceToGroundTransform->TransformPoint(currentPoint);
+    }
+    labels[0] = 0;
 
     unsigned int nbPoints = 1;
 
-    for (unsigned int k = 0; k < this->m_MovingImageMetadatas.size(); ++k)
+    for (unsigned int k = 0; k < nbMovingImages; ++k)
     {
       // Compute the N moving lines of sight
-      TDPointType pointAi, pointBi;
-
       if (maskIts.count(k) && !(maskIts[k].Get() > 0))
       {
         continue;
@@ -387,25 +493,46 @@ void MultiDisparityMapTo3DFilter<TDisparityImage, TOutputImage, TMaskImage, TRes
         currentPoint[1] += vDispIts[k].Get();
       }
 
-      currentPoint[2] = altiMax;
-      pointAi         = movingToGroundTransform[k]->TransformPoint(currentPoint);
-      currentPoint[2] = altiMin;
-      pointBi         = movingToGroundTransform[k]->TransformPoint(currentPoint);
-      pointSetA->SetPoint(nbPoints, pointAi);
-      pointSetB->SetPoint(nbPoints, pointBi);
-      pointSetA->SetPointData(nbPoints, k + 1);
-      pointSetB->SetPointData(nbPoints, k + 1);
+      if (m_UseLineOfSightGrid && movingGrids[k].IsInside(currentPoint[0], currentPoint[1]))
+      {
+        movingGrids[k].Evaluate(currentPoint[0], currentPoint[1], pointsA[nbPoints], pointsB[nbPoints]);
+      }
+      else
+      {
+        currentPoint[2]   = altiMax;
+        pointsA[nbPoints] = movingToGroundTransform[k]->TransformPoint(currentPoint);
+        currentPoint[2]   = altiMin;
+        pointsB[nbPoints] = movingToGroundTransform[k]->TransformPoint(currentPoint);
+      }
+      labels[nbPoints] = k + 1;
       ++nbPoints;
     }
 
     // Check if there are at least 2 lines of sight, then compute intersection
     if (nbPoints >= 2)
     {
-      TDPointType intersection = optimizer->Compute(pointSetA, pointSetB);
-      outPixel[0]              = intersection[0];
-      outPixel[1]              = intersection[1];
-      outPixel[2]              = intersection[2];
-      globalResidue            = optimizer->GetGlobalResidue();
+      TDPointType intersection;
+      if (m_UseLineOfSightGrid)
+      {
+        intersection = OptimizerType::Intersect(&pointsA[0], &pointsB[0], nbPoints, globalResidue);
+      }
+      else
+      {
+        pointSetA->Initialize();
+        pointSetB->Initialize();
+        for (unsigned int p = 0; p < nbPoints; ++p)
+        {
+          pointSetA->SetPoint(p, pointsA[p]);
+          pointSetB->SetPoint(p, pointsB[p]);
+          pointSetA->SetPointData(p, labels[p]);
+          pointSetB->SetPointData(p, labels[p]);
+        }
+        intersection  = optimizer->Compute(pointSetA, pointSetB);
+        globalResidue = optimizer->GetGlobalResidue();
+      }
+      outPixel[0] = intersection[0];
+      outPixel[1] = intersection[1];
+      outPixel[2] = intersection[2];
     }
     else
     {
@@ -28,8 +28,11 @@ void RegisterTests()
   REGISTER_TEST(otbDisparityTranslateFilter);
   REGISTER_TEST(otbSubPixelDisparityImageFilter);
   REGISTER_TEST(otbDisparityMapTo3DFilter);
+  REGISTER_TEST(otbDisparityMapTo3DFilterLineOfSightGrid);
   REGISTER_TEST(otbMultiDisparityMapTo3DFilter);
+  REGISTER_TEST(otbMultiDisparityMapTo3DFilterLineOfSightGrid);
   REGISTER_TEST(otbFineRegistrationImageFilterTest);
+  REGISTER_TEST(otbFineRegistrationImageFilterFastCorrelationTest);
   REGISTER_TEST(otbNCCRegistrationFilter);
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilter);
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterNCC);
@@ -23,6 +23,8 @@
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
 #include "otbVectorImageToImageListFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include <cmath>
 
 typedef otb::Image<float, 2> FloatImageType;
 
@@ -96,3 +98,122 @@ int otbDisparityMapTo3DFilter(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbDisparityMapTo3DFilterLineOfSightGrid(int argc, char* argv[])
+{
+  typedef otb::ImageFileReader<FloatImageType> ReaderType;
+
+  typedef otb::ImageFileReader<FloatVectorImageType> ReaderVectorType;
+
+  typedef otb::ImageList<FloatImageType> ImageListType;
+
+  typedef otb::VectorImageToImageListFilter<FloatVectorImageType, ImageListType> VectorToListFilterType;
+
+  if (argc < 8)
+  {
+    std::cout << "Usage: " << argv[0] << " dispMap leftImage rightImage leftGrid rightGrid planimetricTolerance altimetricTolerance [disparityMask]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const double planimetricTolerance = atof(argv[6]);
+  const double altimetricTolerance  = atof(argv[7]);
+
+  ReaderVectorType::Pointer dispReader = ReaderVectorType::New();
+  dispReader->SetFileName(argv[1]);
+
+  ReaderType::Pointer leftReader = ReaderType::New();
+  leftReader->SetFileName(argv[2]);
+  leftReader->UpdateOutputInformation();
+
+  ReaderType::Pointer rightReader = ReaderType::New();
+  rightReader->SetFileName(argv[3]);
+  rightReader->UpdateOutputInformation();
+
+  ReaderVectorType::Pointer leftGridReader = ReaderVectorType::New();
+  leftGridReader->SetFileName(argv[4]);
+
+  ReaderVectorType::Pointer rightGridReader = ReaderVectorType::New();
+  rightGridReader->SetFileName(argv[5]);
+
+  // Without a mask, every pixel is valid
+  ReaderType::Pointer maskReader;
+  if (argc > 8)
+  {
+    maskReader = ReaderType::New();
+    maskReader->SetFileName(argv[8]);
+    maskReader->Update();
+  }
+
+  VectorToListFilterType::Pointer vectorToListFilter = VectorToListFilterType::New();
+  vectorToListFilter->SetInput(dispReader->GetOutput());
+  vectorToListFilter->UpdateOutputInformation();
+
+  // Same inputs, exact lines of sight and lines of sight interpolated from a grid
+  StereoFilterType::Pointer filters[2];
+  for (unsigned int mode = 0; mode < 2; ++mode)
+  {
+    filters[mode] = StereoFilterType::New();
+    filters[mode]->SetHorizontalDisparityMapInput(vectorToListFilter->GetOutput()->GetNthElement(0));
+    filters[mode]->SetVerticalDisparityMapInput(vectorToListFilter->GetOutput()->GetNthElement(1));
+    filters[mode]->SetLeftImageMetadata(&(leftReader->GetOutput()->GetImageMetadata()));
+    filters[mode]->SetRightImageMetadata(&(rightReader->GetOutput()->GetImageMetadata()));
+    filters[mode]->SetLeftEpipolarGridInput(leftGridReader->GetOutput());
+    filters[mode]->SetRightEpipolarGridInput(rightGridReader->GetOutput());
+    if (maskReader)
+    {
+      filters[mode]->SetDisparityMaskInput(maskReader->GetOutput());
+    }
+    filters[mode]->SetUseLineOfSightGrid(mode == 1);
+    filters[mode]->Update();
+  }
+
+  // Masked pixels, if any, must be left to 0 by both modes, the other ones must agree
+  // within the tolerances (degrees for longitude and latitude, meters for altitude)
+  const FloatVectorImageType::RegionType            region = filters[0]->GetOutput()->GetLargestPossibleRegion();
+  itk::ImageRegionConstIterator<FloatVectorImageType> exactIt(filters[0]->GetOutput(), region);
+  itk::ImageRegionConstIterator<FloatVectorImageType> gridIt(filters[1]->GetOutput(), region);
+  itk::ImageRegionConstIterator<FloatImageType>       maskIt;
+  if (maskReader)
+  {
+    maskIt = itk::ImageRegionConstIterator<FloatImageType>(maskReader->GetOutput(), region);
+    maskIt.GoToBegin();
+  }
+
+  unsigned int nbErrors = 0;
+  for (exactIt.GoToBegin(), gridIt.GoToBegin(); !exactIt.IsAtEnd(); ++exactIt, ++gridIt)
+  {
+    const FloatVectorImageType::PixelType exact = exactIt.Get();
+    const FloatVectorImageType::PixelType grid  = gridIt.Get();
+    const bool                            valid = !maskReader || maskIt.Get() > 0;
+    bool                                  ok    = true;
+    if (maskReader)
+    {
+      ++maskIt;
+    }
+    if (!valid)
+    {
+      ok = exact[0] == 0 && exact[1] == 0 && exact[2] == 0 && grid[0] == 0 && grid[1] == 0 && grid[2] == 0;
+    }
+    else
+    {
+      ok = std::abs(exact[0] - grid[0]) <= planimetricTolerance && std::abs(exact[1] - grid[1]) <= planimetricTolerance &&
+           std::abs(exact[2] - grid[2]) <= altimetricTolerance;
+    }
+    if (!ok)
+    {
+      if (nbErrors < 10)
+      {
+        std::cout << "At " << exactIt.GetIndex() << ": exact " << exact << ", grid " << grid << std::endl;
+      }
+      ++nbErrors;
+    }
+  }
+
+  if (nbErrors > 0)
+  {
+    std::cout << nbErrors << " pixels differ between the exact and the grid modes" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
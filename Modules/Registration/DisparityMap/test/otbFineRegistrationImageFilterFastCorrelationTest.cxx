@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkFixedArray.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "otbImage.h"
+#include "otbFineRegistrationImageFilter.h"
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+typedef double     PixelType;
+const unsigned int Dimension = 2;
+
+typedef itk::FixedArray<PixelType, Dimension>        DisplacementValueType;
+typedef otb::Image<PixelType, Dimension>             ImageType;
+typedef otb::Image<DisplacementValueType, Dimension> FieldImageType;
+typedef otb::FineRegistrationImageFilter<ImageType, ImageType, FieldImageType> RegistrationFilterType;
+
+double SyntheticSignal(double x, double y)
+{
+  return std::sin(0.3 * x) + std::cos(0.23 * y) + std::sin(0.17 * (x + y)) + 0.5 * std::sin(0.41 * x - 0.29 * y);
+}
+
+/** Register a synthetic image against itself translated by a known
+ *  sub-pixel shift, and count the locations, at least margin pixels away
+ *  from the borders, where the shift or the correlation peak is wrong. */
+unsigned int CountWrongDisplacements(double shiftX, double shiftY, unsigned int searchRadius, RegistrationFilterType::TransformType* transform, int margin)
+{
+  ImageType::RegionType region;
+  ImageType::SizeType   size;
+  size.Fill(96);
+  region.SetSize(size);
+
+  ImageType::Pointer fixed  = ImageType::New();
+  ImageType::Pointer moving = ImageType::New();
+  fixed->SetRegions(region);
+  fixed->Allocate();
+  moving->SetRegions(region);
+  moving->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> fixedIt(fixed, region);
+  itk::ImageRegionIteratorWithIndex<ImageType> movingIt(moving, region);
+  for (fixedIt.GoToBegin(), movingIt.GoToBegin(); !fixedIt.IsAtEnd(); ++fixedIt, ++movingIt)
+  {
+    const double x = fixedIt.GetIndex()[0];
+    const double y = fixedIt.GetIndex()[1];
+    fixedIt.Set(SyntheticSignal(x, y));
+    movingIt.Set(SyntheticSignal(x - shiftX, y - shiftY));
+  }
+
+  RegistrationFilterType::Pointer registration = RegistrationFilterType::New();
+  registration->SetFixedInput(fixed);
+  registration->SetMovingInput(moving);
+  registration->SetRadius(8);
+  registration->SetSearchRadius(searchRadius);
+  registration->SetGridStep(4);
+  if (transform)
+  {
+    registration->SetTransform(transform);
+  }
+  registration->UseFastCorrelationOn();
+  registration->Update();
+
+  // Check the locations whose search window is inside the images
+  unsigned int                                      nbErrors = 0;
+  itk::ImageRegionIteratorWithIndex<ImageType>      correlIt(registration->GetOutput(), registration->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionIteratorWithIndex<FieldImageType> fieldIt(registration->GetOutputDisplacementField(),
+                                                            registration->GetOutputDisplacementField()->GetLargestPossibleRegion());
+  for (correlIt.GoToBegin(), fieldIt.GoToBegin(); !correlIt.IsAtEnd(); ++correlIt, ++fieldIt)
+  {
+    const int x = 4 * fieldIt.GetIndex()[0];
+    const int y = 4 * fieldIt.GetIndex()[1];
+    if (x < margin || y < margin || x > 95 - margin || y > 95 - margin)
+    {
+      continue;
+    }
+    const DisplacementValueType displacement = fieldIt.Get();
+    if (std::abs(displacement[0] - shiftX) > 0.2 || std::abs(displacement[1] - shiftY) > 0.2 || correlIt.Get() > -0.9)
+    {
+      std::cout << "At (" << x << ", " << y << "): displacement (" << displacement[0] << ", " << displacement[1] << "), metric " << correlIt.Get()
+                << std::endl;
+      ++nbErrors;
+    }
+  }
+  return nbErrors;
+}
+}
+
+int otbFineRegistrationImageFilterFastCorrelationTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // Large enough search radius for the Fourier domain to be used
+  unsigned int nbErrors = CountWrongDisplacements(1.3, -0.7, 8, nullptr, 16);
+
+  // With an initial transform, the search is centered on T(p) - p, where
+  // T maps fixed points to moving points, as for the metric based search:
+  // a shift out of the search radius is only found in that direction
+  RegistrationFilterType::TranslationType::Pointer translation = RegistrationFilterType::TranslationType::New();
+  RegistrationFilterType::TranslationType::OutputVectorType offset;
+  offset[0] = 6.;
+  offset[1] = -5.;
+  translation->SetOffset(offset);
+  nbErrors += CountWrongDisplacements(6.3, -4.7, 2, translation, 20);
+
+  if (nbErrors > 0)
+  {
+    std::cout << nbErrors << " wrong displacements" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -23,6 +23,8 @@
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
 #include "otbVectorImageToImageListFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include <cmath>
 
 typedef otb::Image<float, 2> FloatImageType;
 
@@ -110,3 +112,110 @@ int otbMultiDisparityMapTo3DFilter(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbMultiDisparityMapTo3DFilterLineOfSightGrid(int argc, char* argv[])
+{
+  typedef otb::ImageFileReader<FloatImageType> ReaderType;
+
+  typedef otb::ImageFileReader<FloatVectorImageType> ReaderVectorType;
+
+  typedef otb::ImageList<FloatImageType> ImageListType;
+
+  typedef otb::VectorImageToImageListFilter<FloatVectorImageType, ImageListType> VectorToListFilterType;
+
+  if (argc < 10)
+  {
+    std::cout << "Usage: " << argv[0] << " masterImage slaveImage1 slaveImage2 dispMap1 dispMap2 mask1 mask2 planimetricTolerance altimetricTolerance"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const double planimetricTolerance = atof(argv[8]);
+  const double altimetricTolerance  = atof(argv[9]);
+
+  ReaderType::Pointer masterReader = ReaderType::New();
+  masterReader->SetFileName(argv[1]);
+  masterReader->UpdateOutputInformation();
+
+  ReaderType::Pointer       slaveReaders[2];
+  ReaderType::Pointer       maskReaders[2];
+  ReaderVectorType::Pointer dispReaders[2];
+
+  VectorToListFilterType::Pointer vectorToListFilters[2];
+
+  for (unsigned int k = 0; k < 2; ++k)
+  {
+    slaveReaders[k] = ReaderType::New();
+    slaveReaders[k]->SetFileName(argv[2 + k]);
+    slaveReaders[k]->UpdateOutputInformation();
+
+    dispReaders[k] = ReaderVectorType::New();
+    dispReaders[k]->SetFileName(argv[4 + k]);
+
+    vectorToListFilters[k] = VectorToListFilterType::New();
+    vectorToListFilters[k]->SetInput(dispReaders[k]->GetOutput());
+    vectorToListFilters[k]->UpdateOutputInformation();
+
+    maskReaders[k] = ReaderType::New();
+    maskReaders[k]->SetFileName(argv[6 + k]);
+  }
+
+  // Same inputs, exact lines of sight and lines of sight interpolated from grids
+  Multi3DFilterType::Pointer filters[2];
+  for (unsigned int mode = 0; mode < 2; ++mode)
+  {
+    filters[mode] = Multi3DFilterType::New();
+    filters[mode]->SetReferenceImageMetadata(&(masterReader->GetOutput()->GetImageMetadata()));
+    filters[mode]->SetNumberOfMovingImages(2);
+    for (unsigned int k = 0; k < 2; ++k)
+    {
+      filters[mode]->SetHorizontalDisparityMapInput(k, vectorToListFilters[k]->GetOutput()->GetNthElement(0));
+      filters[mode]->SetVerticalDisparityMapInput(k, vectorToListFilters[k]->GetOutput()->GetNthElement(1));
+      filters[mode]->SetDisparityMaskInput(k, maskReaders[k]->GetOutput());
+      filters[mode]->SetMovingImageMetadata(k, &(slaveReaders[k]->GetOutput()->GetImageMetadata()));
+    }
+    filters[mode]->SetUseLineOfSightGrid(mode == 1);
+    filters[mode]->Update();
+  }
+
+  // Pixels with less than two lines of sight must be left to 0 by both
+  // modes, the other ones must agree within the tolerances (degrees for
+  // longitude and latitude, meters for altitude)
+  const FloatVectorImageType::RegionType              region = filters[0]->GetOutput()->GetLargestPossibleRegion();
+  itk::ImageRegionConstIterator<FloatVectorImageType> exactIt(filters[0]->GetOutput(), region);
+  itk::ImageRegionConstIterator<FloatVectorImageType> gridIt(filters[1]->GetOutput(), region);
+  itk::ImageRegionConstIterator<FloatImageType>       mask1It(maskReaders[0]->GetOutput(), region);
+  itk::ImageRegionConstIterator<FloatImageType>       mask2It(maskReaders[1]->GetOutput(), region);
+
+  unsigned int nbErrors = 0;
+  for (exactIt.GoToBegin(), gridIt.GoToBegin(), mask1It.GoToBegin(), mask2It.GoToBegin(); !exactIt.IsAtEnd(); ++exactIt, ++gridIt, ++mask1It, ++mask2It)
+  {
+    const FloatVectorImageType::PixelType exact = exactIt.Get();
+    const FloatVectorImageType::PixelType grid  = gridIt.Get();
+    bool                                  ok    = true;
+    if (!(mask1It.Get() > 0) && !(mask2It.Get() > 0))
+    {
+      ok = exact[0] == 0 && exact[1] == 0 && exact[2] == 0 && grid[0] == 0 && grid[1] == 0 && grid[2] == 0;
+    }
+    else
+    {
+      ok = std::abs(exact[0] - grid[0]) <= planimetricTolerance && std::abs(exact[1] - grid[1]) <= planimetricTolerance &&
+           std::abs(exact[2] - grid[2]) <= altimetricTolerance;
+    }
+    if (!ok)
+    {
+      if (nbErrors < 10)
+      {
+        std::cout << "At " << exactIt.GetIndex() << ": exact " << exact << ", grid " << grid << std::endl;
+      }
+      ++nbErrors;
+    }
+  }
+
+  if (nbErrors > 0)
+  {
+    std::cout << nbErrors << " pixels differ between the exact and the grid modes" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
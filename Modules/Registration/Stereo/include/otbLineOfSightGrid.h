@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLineOfSightGrid_h
+#define otbLineOfSightGrid_h
+
+#include "otbGenericRSTransform.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class LineOfSightGrid
+ *  \brief Coarse grid of lines of sight of a sensor, interpolated bilinearly
+ *
+ *  The lines of sight of a sensor image are sampled on a regular grid covering
+ *  an area of the sensor image: at each node, the sensor model is evaluated at
+ *  a maximum and a minimum height. Evaluate() then interpolates both ground
+ *  points bilinearly, which replaces two sensor model evaluations per pixel by
+ *  a few multiply-adds. Sensor models are smooth at the scale of a few pixels,
+ *  so with a grid step of a few tens of pixels the interpolation error is
+ *  negligible compared to the accuracy of the disparities.
+ *
+ *  Coordinates are physical coordinates of the sensor image, as given to the
+ *  sensor to ground transform.
+ *
+ *  \sa LineOfSightOptimizer
+ *
+ * \ingroup OTBStereo
+ */
+template <class TPrecision = double>
+class ITK_EXPORT LineOfSightGrid
+{
+public:
+  typedef TPrecision                              PrecisionType;
+  typedef GenericRSTransform<PrecisionType, 3, 3> TransformType;
+  typedef typename TransformType::InputPointType  PointType;
+
+  LineOfSightGrid();
+
+  /** Sample the lines of sight over [xMin, xMax] x [yMin, yMax] with
+   *  sizeX x sizeY nodes (at least 2 along each axis). Points at heightMax
+   *  are the starting points of the lines, points at heightMin the ending
+   *  points. */
+  void Build(const TransformType* sensorToGround, double xMin, double yMin, double xMax, double yMax, unsigned int sizeX, unsigned int sizeY,
+             PrecisionType heightMin, PrecisionType heightMax);
+
+  /** Remove all nodes */
+  void Clear();
+
+  /** Number of nodes needed along an axis of the given extent, so that nodes
+   *  are at most 'step' apart */
+  static unsigned int ComputeNumberOfNodes(double extent, double step);
+
+  /** Check that (x, y) is covered by the grid */
+  bool IsInside(double x, double y) const;
+
+  /** Interpolate the starting point 'pointA' (at heightMax) and the ending
+   *  point 'pointB' (at heightMin) of the line of sight at (x, y). The
+   *  position must be inside the grid. */
+  void Evaluate(double x, double y, PointType& pointA, PointType& pointB) const;
+
+private:
+  double       m_OriginX;
+  double       m_OriginY;
+  double       m_StepX;
+  double       m_StepY;
+  unsigned int m_SizeX;
+  unsigned int m_SizeY;
+
+  /** Points at heightMax and heightMin of each node, row by row */
+  std::vector<PointType> m_PointsA;
+  std::vector<PointType> m_PointsB;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbLineOfSightGrid.hxx"
+#endif
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLineOfSightGrid_hxx
+#define otbLineOfSightGrid_hxx
+
+#include "otbLineOfSightGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+template <class TPrecision>
+LineOfSightGrid<TPrecision>::LineOfSightGrid() : m_OriginX(0.), m_OriginY(0.), m_StepX(1.), m_StepY(1.), m_SizeX(0), m_SizeY(0)
+{
+}
+
+template <class TPrecision>
+void LineOfSightGrid<TPrecision>::Build(const TransformType* sensorToGround, double xMin, double yMin, double xMax, double yMax, unsigned int sizeX,
+                                        unsigned int sizeY, PrecisionType heightMin, PrecisionType heightMax)
+{
+  m_SizeX   = std::max(sizeX, 2u);
+  m_SizeY   = std::max(sizeY, 2u);
+  m_OriginX = xMin;
+  m_OriginY = yMin;
+  // A degenerate extent still gives a valid cell around the single position
+  m_StepX = (xMax > xMin) ? (xMax - xMin) / (m_SizeX - 1) : 1.;
+  m_StepY = (yMax > yMin) ? (yMax - yMin) / (m_SizeY - 1) : 1.;
+
+  m_PointsA.resize(m_SizeX * m_SizeY);
+  m_PointsB.resize(m_SizeX * m_SizeY);
+
+  PointType sensorPoint;
+  for (unsigned int j = 0; j < m_SizeY; ++j)
+  {
+    for (unsigned int i = 0; i < m_SizeX; ++i)
+    {
+      sensorPoint[0] = m_OriginX + i * m_StepX;
+      sensorPoint[1] = m_OriginY + j * m_StepY;
+
+      sensorPoint[2]             = heightMax;
+      m_PointsA[j * m_SizeX + i] = sensorToGround->TransformPoint(sensorPoint);
+      sensorPoint[2]             = heightMin;
+      m_PointsB[j * m_SizeX + i] = sensorToGround->TransformPoint(sensorPoint);
+    }
+  }
+}
+
+template <class TPrecision>
+void LineOfSightGrid<TPrecision>::Clear()
+{
+  m_SizeX = 0;
+  m_SizeY = 0;
+  m_PointsA.clear();
+  m_PointsB.clear();
+}
+
+template <class TPrecision>
+unsigned int LineOfSightGrid<TPrecision>::ComputeNumberOfNodes(double extent, double step)
+{
+  if (!(step > 0.))
+  {
+    return 2;
+  }
+  return std::max(2u, static_cast<unsigned int>(std::ceil(std::abs(extent) / step)) + 1);
+}
+
+template <class TPrecision>
+bool LineOfSightGrid<TPrecision>::IsInside(double x, double y) const
+{
+  if (m_SizeX == 0)
+  {
+    return false;
+  }
+  // Tolerance on the last node, which is subject to rounding
+  const double fx = (x - m_OriginX) / m_StepX;
+  const double fy = (y - m_OriginY) / m_StepY;
+  return fx >= -1e-9 && fy >= -1e-9 && fx <= (m_SizeX - 1) + 1e-9 && fy <= (m_SizeY - 1) + 1e-9;
+}
+
+template <class TPrecision>
+void LineOfSightGrid<TPrecision>::Evaluate(double x, double y, PointType& pointA, PointType& pointB) const
+{
+  const double fx = std::max(0., (x - m_OriginX) / m_StepX);
+  const double fy = std::max(0., (y - m_OriginY) / m_StepY);
+
+  const unsigned int i  = std::min(static_cast<unsigned int>(fx), m_SizeX - 2);
+  const unsigned int j  = std::min(static_cast<unsigned int>(fy), m_SizeY - 2);
+  const double       wx = fx - i;
+  const double       wy = fy - j;
+
+  const unsigned int ul = j * m_SizeX + i;
+  const unsigned int ll = ul + m_SizeX;
+
+  const double wul = (1. - wx) * (1. - wy);
+  const double wur = wx * (1. - wy);
+  const double wll = (1. - wx) * wy;
+  const double wlr = wx * wy;
+
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    pointA[d] = wul * m_PointsA[ul][d] + wur * m_PointsA[ul + 1][d] + wll * m_PointsA[ll][d] + wlr * m_PointsA[ll + 1][d];
+    pointB[d] = wul * m_PointsB[ul][d] + wur * m_PointsB[ul + 1][d] + wll * m_PointsB[ll][d] + wlr * m_PointsB[ll + 1][d];
+  }
+}
+
+} // end namespace otb
+
+#endif
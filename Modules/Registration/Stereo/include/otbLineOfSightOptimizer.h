@@ -71,6 +71,13 @@ public:
    *  ending points are stored in 'pointB' (however, the computation is symmetrical)*/
   PointType Compute(PointSetPointerType pointA, PointSetPointerType pointB);
 
+  /** Compute the same intersection as Compute() from nbLines lines of sight
+   *  given as plain arrays of starting points 'pointsA' and ending points
+   *  'pointsB'. The 3x3 system is solved in closed form, without point sets
+   *  nor dynamic allocation, so this can be called for every pixel from
+   *  several threads. The global residue is returned in 'globalResidue'. */
+  static PointType Intersect(const PointType* pointsA, const PointType* pointsB, unsigned int nbLines, PrecisionType& globalResidue);
+
   /** Get the residues from last computation */
   // itkGetMacro(Residues,ResidueType);
   ResidueType GetResidues()
@@ -132,6 +132,84 @@ typename LineOfSightOptimizer<TPrecision, TLabel>::PointType LineOfSightOptimize
 
   return result;
 }
+
+template <class TPrecision, class TLabel>
+typename LineOfSightOptimizer<TPrecision, TLabel>::PointType LineOfSightOptimizer<TPrecision, TLabel>::Intersect(const PointType* pointsA,
+                                                                                                                 const PointType* pointsB,
+                                                                                                                 unsigned int     nbLines,
+                                                                                                                 PrecisionType&   globalResidue)
+{
+  PrecisionType invCumul[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+  PrecisionType secCumul[3]    = {0, 0, 0};
+
+  for (unsigned int l = 0; l < nbLines; ++l)
+  {
+    PrecisionType vi[3];
+    vi[0] = pointsB[l][0] - pointsA[l][0];
+    vi[1] = pointsB[l][1] - pointsA[l][1];
+    vi[2] = pointsB[l][2] - pointsA[l][2];
+
+    PrecisionType norm_inv = 1. / std::sqrt(vi[0] * vi[0] + vi[1] * vi[1] + vi[2] * vi[2]);
+
+    vi[0] *= norm_inv;
+    vi[1] *= norm_inv;
+    vi[2] *= norm_inv;
+
+    for (unsigned int r = 0; r < 3; ++r)
+    {
+      for (unsigned int c = 0; c < 3; ++c)
+      {
+        PrecisionType idMinusViViT = (r == c ? 1. : 0.) - vi[r] * vi[c];
+        invCumul[r][c] += idMinusViViT;
+        secCumul[r] += idMinusViViT * pointsA[l][c];
+      }
+    }
+  }
+
+  // Inverse by cofactors, as vnl_inverse() does for 3x3 matrices
+  PrecisionType cof[3][3];
+  cof[0][0] = invCumul[1][1] * invCumul[2][2] - invCumul[1][2] * invCumul[2][1];
+  cof[0][1] = invCumul[1][2] * invCumul[2][0] - invCumul[1][0] * invCumul[2][2];
+  cof[0][2] = invCumul[1][0] * invCumul[2][1] - invCumul[1][1] * invCumul[2][0];
+  cof[1][0] = invCumul[0][2] * invCumul[2][1] - invCumul[0][1] * invCumul[2][2];
+  cof[1][1] = invCumul[0][0] * invCumul[2][2] - invCumul[0][2] * invCumul[2][0];
+  cof[1][2] = invCumul[0][1] * invCumul[2][0] - invCumul[0][0] * invCumul[2][1];
+  cof[2][0] = invCumul[0][1] * invCumul[1][2] - invCumul[0][2] * invCumul[1][1];
+  cof[2][1] = invCumul[0][2] * invCumul[1][0] - invCumul[0][0] * invCumul[1][2];
+  cof[2][2] = invCumul[0][0] * invCumul[1][1] - invCumul[0][1] * invCumul[1][0];
+
+  PrecisionType det = invCumul[0][0] * cof[0][0] + invCumul[0][1] * cof[0][1] + invCumul[0][2] * cof[0][2];
+
+  PointType result;
+  result.Fill(0);
+  if (det != 0)
+  {
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      result[i] = (cof[0][i] * secCumul[0] + cof[1][i] * secCumul[1] + cof[2][i] * secCumul[2]) / det;
+    }
+  }
+
+  // Compute residues
+  globalResidue = 0;
+  for (unsigned int l = 0; l < nbLines; ++l)
+  {
+    PrecisionType AB[3], AC[3];
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      AB[i] = pointsB[l][i] - pointsA[l][i];
+      AC[i] = result[i] - pointsA[l][i];
+    }
+    PrecisionType abac = AB[0] * AC[0] + AB[1] * AC[1] + AB[2] * AC[2];
+    PrecisionType acac = AC[0] * AC[0] + AC[1] * AC[1] + AC[2] * AC[2];
+    PrecisionType abab = AB[0] * AB[0] + AB[1] * AB[1] + AB[2] * AB[2];
+
+    globalResidue += std::max(PrecisionType(0), acac - (abac * abac) / abab);
+  }
+  globalResidue = std::sqrt(globalResidue);
+
+  return result;
+}
 }
 
 #endif
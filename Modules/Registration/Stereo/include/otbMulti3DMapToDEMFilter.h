@@ -38,10 +38,11 @@ namespace CellFusionMode
 {
 enum CellFusionMode
 {
-  MIN  = 0,
-  MAX  = 1,
-  MEAN = 2,
-  ACC  = 3 // return accumulator for debug purpose
+  MIN    = 0,
+  MAX    = 1,
+  MEAN   = 2,
+  ACC    = 3, // return accumulator for debug purpose
+  MEDIAN = 4
 };
 }
 
@@ -57,6 +58,13 @@ enum CellFusionMode
  * - 1 MAX : we keep the maximum altitude
  * - 2 MEAN : mean is computed
  * - 3 ACC : returns cell count (useful to create mask from output)
+ * - 4 MEDIAN : median is computed (mean of the two middle values for an even count)
+ *
+ *  Points are first scattered in parallel: each thread projects a part of the 3D maps and
+ *  appends the points falling in the output requested region to buckets keyed by DEM row.
+ *  Each thread then reduces the rows of its own output region, gathering the buckets of
+ *  all threads. Memory is thus proportional to the number of input points, not to the
+ *  number of threads times the DEM size, and there is no serial merge step.
  *
  *  empty cell are filled with the NoDataValue (-32768 by default)
  *
@@ -243,6 +251,12 @@ protected:
   /** After threaded generate data */
   void AfterThreadedGenerateData() override;
 
+  /** Static function used as a "callback" by the MultiThreader to scatter the points */
+  static ITK_THREAD_RETURN_TYPE ScatterThreaderCallback(void* arg);
+
+  /** Append the points of the 'threadId' part of each 3D map to the row buckets */
+  void ThreadedScatter(itk::ThreadIdType threadId);
+
   /** Override VerifyInputInformation() since this filter's inputs do
     * not need to occupy the same physical space.
     *
@@ -274,10 +288,16 @@ private:
   /** DEM grid step (in meters) */
   double m_DEMGridStep;
 
-  /** Temporary DEMs for multithreading */
-  std::vector<typename OutputImageType::Pointer> m_TempDEMRegions;
-  /** Temporary accumulator for multithreading and mean calculus*/
-  std::vector<typename AccumulatorImageType::Pointer> m_TempDEMAccumulatorRegions;
+  /** Point of a 3D map falling in a DEM row */
+  struct CellPointType
+  {
+    typename IndexType::IndexValueType column;
+    DEMPixelType                       height;
+  };
+  typedef std::vector<CellPointType> RowBucketType;
+
+  /** Points scattered by each thread, by row of the output requested region */
+  std::vector<std::vector<RowBucketType>> m_RowBuckets;
 
 
   std::vector<unsigned int> m_NumberOfSplit; // number of split for each map
@@ -25,6 +25,7 @@
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
 #include "otbStreamingStatisticsVectorImageFilter.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -468,9 +469,15 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::BeforeThreade
 {
   const TOutputDEMImage* outputDEM = this->GetDEMOutput();
 
+  if (m_CellFusionMode < otb::CellFusionMode::MIN || m_CellFusionMode > otb::CellFusionMode::MEDIAN)
+  {
+    itkExceptionMacro(<< "Unexpected value cell fusion mode :" << this->m_CellFusionMode);
+  }
+
   // create splits
   // for each map we check if the input region can be split into threadNb
   m_NumberOfSplit.resize(this->GetNumberOf3DMaps());
+  m_MapSplitterList->Clear();
 
   unsigned int maximumRegionsNumber = 1;
 
@@ -493,29 +500,10 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::BeforeThreade
       maximumRegionsNumber = regionsNumber;
   }
 
-  m_TempDEMRegions.clear();
-  m_TempDEMAccumulatorRegions.clear();
-  // m_ThreadProcessed.resize(maximumRegionsNumber);
-
-  for (unsigned int i = 0; i < maximumRegionsNumber; i++)
-  {
-    // m_ThreadProcessed[i] = 0;
-    typename TOutputDEMImage::Pointer tmpImg = TOutputDEMImage::New();
-    tmpImg->SetNumberOfComponentsPerPixel(1); // Two components for mean calculus ?
-    tmpImg->SetRegions(outputDEM->GetRequestedRegion());
-    tmpImg->Allocate();
-
-    tmpImg->FillBuffer(m_NoDataValue);
-    m_TempDEMRegions.push_back(tmpImg);
-
-    typename AccumulatorImageType::Pointer tmpImg2 = AccumulatorImageType::New();
-    tmpImg2->SetNumberOfComponentsPerPixel(1); // Two components for mean calculus ?
-    tmpImg2->SetRegions(outputDEM->GetRequestedRegion());
-    tmpImg2->Allocate();
-
-    tmpImg2->FillBuffer(0.);
-    m_TempDEMAccumulatorRegions.push_back(tmpImg2);
-  }
+  // One set of row buckets per scattering thread
+  const unsigned int nbRows = outputDEM->GetRequestedRegion().GetSize()[1];
+  m_RowBuckets.clear();
+  m_RowBuckets.resize(maximumRegionsNumber, std::vector<RowBucketType>(nbRows));
 
   if (!this->m_IsGeographic)
   {
@@ -524,40 +512,36 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::BeforeThreade
     m_GroundTransform->SetOutputProjectionRef(m_ProjectionRef);
     m_GroundTransform->InstantiateTransform();
   }
+
+  // Scatter the points of all the maps
+  this->GetMultiThreader()->SetNumberOfThreads(maximumRegionsNumber);
+  this->GetMultiThreader()->SetSingleMethod(this->ScatterThreaderCallback, this);
+  this->GetMultiThreader()->SingleMethodExecute();
 }
 
 template <class T3DImage, class TMaskImage, class TOutputDEMImage>
-void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ThreadedGenerateData(const RegionType& itkNotUsed(outputRegionForThread),
-                                                                                        itk::ThreadIdType threadId)
+ITK_THREAD_RETURN_TYPE Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ScatterThreaderCallback(void* arg)
 {
-  TOutputDEMImage* outputPtr = this->GetOutput();
+  Self*             filter   = (Self*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+  itk::ThreadIdType threadId = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
 
-  typename OutputImageType::PointType  pointRef;
-  typename OutputImageType::PointType  pointRefStep;
-  typename OutputImageType::RegionType requestedRegion = outputPtr->GetRequestedRegion();
-
-  //  typename TOutputDEMImage::SpacingType step = outputPtr->GetSignedSpacing();
+  if (threadId < filter->m_RowBuckets.size())
+  {
+    filter->ThreadedScatter(threadId);
+  }
 
-  // convert requested region to Long/Lat
+  return ITK_THREAD_RETURN_VALUE;
+}
 
-  //  typename TOutputDEMImage::SizeType size = requestedRegion.GetSize();
+template <class T3DImage, class TMaskImage, class TOutputDEMImage>
+void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ThreadedScatter(itk::ThreadIdType threadId)
+{
+  const TOutputDEMImage* outputPtr = this->GetDEMOutput();
 
-  typename TOutputDEMImage::IndexType index = requestedRegion.GetIndex();
-  outputPtr->TransformIndexToPhysicalPoint(index, pointRef);
-  /*
-  InputInternalPixelType regionLong1 = pointRef[0];
-  InputInternalPixelType regionLat1 = pointRef[1];
-  InputInternalPixelType regionLong2 = pointRef[0] + size[0] * step[0];
-  InputInternalPixelType regionLat2 = pointRef[1] + size[1] * step[1];
-  InputInternalPixelType minLong = std::min(regionLong1, regionLong2);
-  InputInternalPixelType minLat = std::min(regionLat1, regionLat2);
-  InputInternalPixelType maxLong = std::max(regionLong1, regionLong2);
-  InputInternalPixelType maxLat = std::max(regionLat1, regionLat2);
-  */
+  typename TOutputDEMImage::RegionType     outputRequestedRegion = outputPtr->GetRequestedRegion();
+  const typename IndexType::IndexValueType firstRow              = outputRequestedRegion.GetIndex()[1];
 
-  TOutputDEMImage*                     tmpDEM                = nullptr;
-  AccumulatorImageType*                tmpAcc                = nullptr;
-  typename TOutputDEMImage::RegionType outputRequestedRegion = outputPtr->GetRequestedRegion();
+  std::vector<RowBucketType>& buckets = m_RowBuckets[threadId];
 
   typename T3DImage::RegionType splitRegion;
 
@@ -566,293 +550,225 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ThreadedGener
   itk::ImageRegionConstIterator<InputMapType> mapIt;
   for (unsigned int k = 0; k < this->GetNumberOf3DMaps(); ++k)
   {
-    if (m_NumberOfSplit[k] > 0)
+    if (static_cast<unsigned int>(threadId) >= m_NumberOfSplit[k])
     {
-      T3DImage*   imgPtr = const_cast<T3DImage*>(this->Get3DMapInput(k));
-      TMaskImage* mskPtr = const_cast<TMaskImage*>(this->GetMaskInput(k));
+      continue;
+    }
 
-      typename InputMapType::PointType origin;
-      origin = imgPtr->GetOrigin();
-      typename InputMapType::SpacingType spacing;
-      spacing = imgPtr->GetSignedSpacing();
+    const T3DImage*   imgPtr = this->Get3DMapInput(k);
+    const TMaskImage* mskPtr = this->GetMaskInput(k);
 
-      if (static_cast<unsigned int>(threadId) < m_NumberOfSplit[k])
-      {
-        splitRegion = m_MapSplitterList->GetNthElement(k)->GetSplit(threadId, m_NumberOfSplit[k], imgPtr->GetRequestedRegion());
+    splitRegion = m_MapSplitterList->GetNthElement(k)->GetSplit(threadId, m_NumberOfSplit[k], imgPtr->GetRequestedRegion());
 
-        tmpDEM = m_TempDEMRegions[threadId];
-        tmpAcc = m_TempDEMAccumulatorRegions[threadId];
+    mapIt = itk::ImageRegionConstIterator<InputMapType>(imgPtr, splitRegion);
+    mapIt.GoToBegin();
+    itk::ImageRegionConstIterator<MaskImageType> maskIt;
+    bool                                         useMask = false;
+    if (mskPtr)
+    {
+      useMask = true;
+      maskIt  = itk::ImageRegionConstIterator<MaskImageType>(mskPtr, splitRegion);
+      maskIt.GoToBegin();
+    }
 
-        mapIt = itk::ImageRegionConstIterator<InputMapType>(imgPtr, splitRegion);
-        mapIt.GoToBegin();
-        itk::ImageRegionConstIterator<MaskImageType> maskIt;
-        bool                                         useMask = false;
-        if (mskPtr)
+    while (!mapIt.IsAtEnd())
+    {
+      // check mask value if any
+      if (useMask)
+      {
+        if (!(maskIt.Get() > 0))
         {
-          useMask = true;
-          maskIt  = itk::ImageRegionConstIterator<MaskImageType>(mskPtr, splitRegion);
-          maskIt.GoToBegin();
+          ++mapIt;
+          ++maskIt;
+          continue;
         }
+      }
 
-        while (!mapIt.IsAtEnd())
-        {
-          // check mask value if any
-          if (useMask)
-          {
-            if (!(maskIt.Get() > 0))
-            {
-              ++mapIt;
-              ++maskIt;
-              continue;
-            }
-          }
-
-          position = mapIt.Get();
-
-          // std::cout<<"position"<<position<<std::endl;
-          if (!this->m_IsGeographic)
-          {
-            // std::cout<<"is geographic "<<std::endl;
-            typename RSTransform2DType::InputPointType tmpPoint;
-            tmpPoint[0]                                       = position[0];
-            tmpPoint[1]                                       = position[1];
-            RSTransform2DType::OutputPointType groundPosition = m_GroundTransform->TransformPoint(tmpPoint);
-            position[0]                                       = groundPosition[0];
-            position[1]                                       = groundPosition[1];
-          }
-
-          // test if position is in DEM BBOX
-          /**    -Wunused-variable
-          bool isInDEM = (position[0] >= minLong) && (position[0] < maxLong) && (position[1] >= minLat) && (position[1]
-                      < maxLat);
-          **/
-          // Is point inside DEM area ?
-          typename OutputImageType::PointType point2D;
-          point2D[0] = position[0];
-          point2D[1] = position[1];
-          itk::ContinuousIndex<double, 2> continuousIndex;
-
-          // std::cout<<"point2D "<<point2D<<std::endl;
-          // The DEM cell at index 'n' contains continuous indexes from 'n-0.5' to 'n+0.5'
-          outputPtr->TransformPhysicalPointToContinuousIndex(point2D, continuousIndex);
-          typename OutputImageType::IndexType cellIndex;
-          cellIndex[0] = static_cast<int>(std::floor(continuousIndex[0] + 0.5));
-          cellIndex[1] = static_cast<int>(std::floor(continuousIndex[1] + 0.5));
-          // std::cout<<"cellindex "<<cellIndex<<std::endl;
-          // index from physical
-          /** -Wunused-variable
-            typename OutputImageType::IndexType physCellIndex;
-
-          //double CellIndexLong=(position[0]-outOrigin[0])/step[0];
-          //double CellIndexLat=(position[1]-outOrigin[1])/step[1];
-          typename OutputImageType::IndexType cellIndex2;
-          **/
-          if (outputRequestedRegion.IsInside(cellIndex))
-          {
-            // std::cout<<"is inside "<<std::endl;
-            // Add point to its corresponding cell (keep maximum)
-            DEMPixelType cellHeight = static_cast<DEMPixelType>(position[2]);
-            // if (cellHeight > tmpDEM->GetPixel(cellIndex) && cellHeight < static_cast<DEMPixelType>(m_ElevationMax))
-            //  {
-            // tmpDEM->SetPixel(cellIndex,tmpDEM->GetPixel(cellIndex)+1);
+      position = mapIt.Get();
 
-            AccumulatorPixelType accPixel = tmpAcc->GetPixel(cellIndex);
-            tmpAcc->SetPixel(cellIndex, tmpAcc->GetPixel(cellIndex) + 1);
+      if (!this->m_IsGeographic)
+      {
+        typename RSTransform2DType::InputPointType tmpPoint;
+        tmpPoint[0]                                       = position[0];
+        tmpPoint[1]                                       = position[1];
+        RSTransform2DType::OutputPointType groundPosition = m_GroundTransform->TransformPoint(tmpPoint);
+        position[0]                                       = groundPosition[0];
+        position[1]                                       = groundPosition[1];
+      }
 
-            if (accPixel == 0)
-            {
-              tmpDEM->SetPixel(cellIndex, cellHeight);
-            }
-            else
-            {
-              DEMPixelType cellCurrentValue = tmpDEM->GetPixel(cellIndex);
-
-              switch (this->m_CellFusionMode)
-              {
-              case otb::CellFusionMode::MIN:
-              {
-                if (cellHeight < cellCurrentValue)
-                {
-                  tmpDEM->SetPixel(cellIndex, cellHeight);
-                }
-              }
-              break;
-              case otb::CellFusionMode::MAX:
-              {
-                if (cellHeight > cellCurrentValue)
-                {
-                  tmpDEM->SetPixel(cellIndex, cellHeight);
-                }
-              }
-              break;
-              case otb::CellFusionMode::MEAN:
-              {
-                tmpDEM->SetPixel(cellIndex, cellCurrentValue + cellHeight);
-              }
-              break;
-              case otb::CellFusionMode::ACC:
-              {
-              }
-              break;
-              default:
-
-                itkExceptionMacro(<< "Unexpected value cell fusion mode :" << this->m_CellFusionMode);
-                break;
-              }
-            }
-          }
+      // Is point inside DEM area ?
+      typename OutputImageType::PointType point2D;
+      point2D[0] = position[0];
+      point2D[1] = position[1];
+      itk::ContinuousIndex<double, 2> continuousIndex;
 
-          ++mapIt;
+      // The DEM cell at index 'n' contains continuous indexes from 'n-0.5' to 'n+0.5'
+      outputPtr->TransformPhysicalPointToContinuousIndex(point2D, continuousIndex);
+      typename OutputImageType::IndexType cellIndex;
+      cellIndex[0] = static_cast<int>(std::floor(continuousIndex[0] + 0.5));
+      cellIndex[1] = static_cast<int>(std::floor(continuousIndex[1] + 0.5));
 
-          if (useMask)
-            ++maskIt;
-        }
-      }
-      else
+      if (outputRequestedRegion.IsInside(cellIndex))
       {
-        splitRegion = requestedRegion;
-        otbMsgDevMacro("map " << k << " will not be split ");
+        CellPointType cellPoint;
+        cellPoint.column = cellIndex[0];
+        cellPoint.height = static_cast<DEMPixelType>(position[2]);
+        buckets[cellIndex[1] - firstRow].push_back(cellPoint);
       }
+
+      ++mapIt;
+
+      if (useMask)
+        ++maskIt;
     }
   }
 }
 
 template <class T3DImage, class TMaskImage, class TOutputDEMImage>
-void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::AfterThreadedGenerateData()
+void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ThreadedGenerateData(const RegionType& outputRegionForThread,
+                                                                                        itk::ThreadIdType itkNotUsed(threadId))
 {
+  TOutputDEMImage* outputPtr = this->GetOutput();
 
-  TOutputDEMImage* outputDEM = this->GetOutput();
-
-  // check is that case can occur
-  if (m_TempDEMRegions.size() < 1)
-  {
-    outputDEM->FillBuffer(m_NoDataValue);
-    return;
-  }
-
-  itk::ImageRegionIterator<OutputImageType>      outputDEMIt(outputDEM, outputDEM->GetRequestedRegion());
-  itk::ImageRegionIterator<OutputImageType>      firstDEMIt(m_TempDEMRegions[0], outputDEM->GetRequestedRegion());
-  itk::ImageRegionIterator<AccumulatorImageType> firstDEMAccIt(m_TempDEMAccumulatorRegions[0], outputDEM->GetRequestedRegion());
-  // we use the first accumulator as global accumulator over tmpAcc for mean calculus
-
-  outputDEMIt.GoToBegin();
-  firstDEMIt.GoToBegin();
-  firstDEMAccIt.GoToBegin();
-  // Copy first DEM
-
-  while (!outputDEMIt.IsAtEnd() && !firstDEMIt.IsAtEnd() && !firstDEMAccIt.IsAtEnd())
-  {
-
-    AccumulatorPixelType accPixel = firstDEMAccIt.Get();
-    // useless test tempDEm is initialized with NoDataValue
-    if (accPixel == 0)
-    {
-      outputDEMIt.Set(m_NoDataValue);
-    }
-    else
-    {
-
-      DEMPixelType pixelValue = firstDEMIt.Get();
+  const typename IndexType::IndexValueType firstRow    = outputPtr->GetRequestedRegion().GetIndex()[1];
+  const typename IndexType::IndexValueType firstColumn = outputRegionForThread.GetIndex()[0];
+  const typename IndexType::IndexValueType startRow    = outputRegionForThread.GetIndex()[1];
+  const unsigned int                       width       = outputRegionForThread.GetSize()[0];
+  const unsigned int                       height      = outputRegionForThread.GetSize()[1];
 
-      outputDEMIt.Set(pixelValue);
+  // Reduction of one row of the region
+  std::vector<DEMPixelType>         cellValues(width);
+  std::vector<AccumulatorPixelType> cellCounts(width);
+  std::vector<unsigned int>         cellOffsets(width + 1);
+  std::vector<DEMPixelType>         cellHeights;
 
-      if ((this->m_CellFusionMode == otb::CellFusionMode::MEAN) && (m_TempDEMRegions.size() == 1))
-      {
-        outputDEMIt.Set(firstDEMIt.Get() / static_cast<DEMPixelType>(accPixel));
-      }
-      if (this->m_CellFusionMode == otb::CellFusionMode::ACC)
-      {
-        outputDEMIt.Set(static_cast<DEMPixelType>(accPixel));
-      }
-    }
-    ++outputDEMIt;
-    ++firstDEMIt;
-    ++firstDEMAccIt;
-  }
+  itk::ImageRegionIterator<OutputImageType> outputIt(outputPtr, outputRegionForThread);
+  outputIt.GoToBegin();
 
-  // Check DEMs from other threads and keep the maximum elevation
-  for (unsigned int i = 1; i < m_TempDEMRegions.size(); i++)
+  for (unsigned int y = 0; y < height; ++y)
   {
+    const unsigned int row = static_cast<unsigned int>(startRow + y - firstRow);
 
-    itk::ImageRegionIterator<OutputImageType>      tmpDEMIt(m_TempDEMRegions[i], outputDEM->GetRequestedRegion());
-    itk::ImageRegionIterator<AccumulatorImageType> tmpDEMAccIt(m_TempDEMAccumulatorRegions[i], outputDEM->GetRequestedRegion());
+    std::fill(cellCounts.begin(), cellCounts.end(), 0);
 
-    outputDEMIt.GoToBegin();
-    tmpDEMIt.GoToBegin();
-    tmpDEMAccIt.GoToBegin();
-    firstDEMAccIt.GoToBegin(); // Global Accumulator
-    while (!outputDEMIt.IsAtEnd() && !tmpDEMIt.IsAtEnd() && !tmpDEMAccIt.IsAtEnd() && !firstDEMAccIt.IsAtEnd())
+    for (unsigned int t = 0; t < m_RowBuckets.size(); ++t)
     {
-
-      // get the accumulator value
-      AccumulatorPixelType accPixel = tmpDEMAccIt.Get();
-      if (accPixel != 0)
+      const RowBucketType& bucket = m_RowBuckets[t][row];
+      for (typename RowBucketType::const_iterator it = bucket.begin(); it != bucket.end(); ++it)
       {
+        if (it->column < firstColumn || it->column >= firstColumn + static_cast<typename IndexType::IndexValueType>(width))
+        {
+          continue;
+        }
+        const unsigned int c = static_cast<unsigned int>(it->column - firstColumn);
 
-        DEMPixelType cellCurrentValue = outputDEMIt.Get();
-        DEMPixelType cellHeight       = tmpDEMIt.Get();
-        switch (this->m_CellFusionMode)
+        if (cellCounts[c] == 0)
         {
-        case otb::CellFusionMode::MIN:
+          cellValues[c] = it->height;
+        }
+        else
         {
-          if ((cellHeight < cellCurrentValue) || (cellCurrentValue == m_NoDataValue))
+          switch (this->m_CellFusionMode)
+          {
+          case otb::CellFusionMode::MIN:
+          {
+            if (it->height < cellValues[c])
+            {
+              cellValues[c] = it->height;
+            }
+          }
+          break;
+          case otb::CellFusionMode::MAX:
           {
-            outputDEMIt.Set(cellHeight);
+            if (it->height > cellValues[c])
+            {
+              cellValues[c] = it->height;
+            }
           }
-        }
-        break;
-        case otb::CellFusionMode::MAX:
-        {
-          if ((cellHeight > cellCurrentValue) || ((cellCurrentValue == m_NoDataValue)))
+          break;
+          case otb::CellFusionMode::MEAN:
           {
-            outputDEMIt.Set(cellHeight);
+            cellValues[c] += it->height;
           }
-        }
-        break;
-        case otb::CellFusionMode::MEAN:
-        {
-
-          outputDEMIt.Set(cellCurrentValue * static_cast<DEMPixelType>(cellCurrentValue != m_NoDataValue) + cellHeight);
-          firstDEMAccIt.Set(firstDEMAccIt.Get() + accPixel);
-        }
-        break;
-        case otb::CellFusionMode::ACC:
-        {
-          firstDEMAccIt.Set(firstDEMAccIt.Get() + accPixel);
-        }
-        break;
-
-        default:
-          itkExceptionMacro(<< "Unexpected value cell fusion mode :" << this->m_CellFusionMode);
           break;
+          default:
+            break;
+          }
         }
+        ++cellCounts[c];
+      }
+    }
+
+    if (this->m_CellFusionMode == otb::CellFusionMode::MEDIAN)
+    {
+      // Gather the heights of each cell contiguously
+      cellOffsets[0] = 0;
+      for (unsigned int c = 0; c < width; ++c)
+      {
+        cellOffsets[c + 1] = cellOffsets[c] + cellCounts[c];
       }
+      cellHeights.resize(cellOffsets[width]);
 
-      if (i == (m_TempDEMRegions.size() - 1))
+      std::vector<unsigned int> cursors(cellOffsets.begin(), cellOffsets.end() - 1);
+      for (unsigned int t = 0; t < m_RowBuckets.size(); ++t)
       {
-        if (this->m_CellFusionMode == otb::CellFusionMode::MEAN)
+        const RowBucketType& bucket = m_RowBuckets[t][row];
+        for (typename RowBucketType::const_iterator it = bucket.begin(); it != bucket.end(); ++it)
         {
-          if (static_cast<DEMPixelType>(firstDEMAccIt.Get()) != 0)
-          {
-            outputDEMIt.Set(outputDEMIt.Get() / static_cast<DEMPixelType>(firstDEMAccIt.Get()));
-          }
-          else
+          if (it->column >= firstColumn && it->column < firstColumn + static_cast<typename IndexType::IndexValueType>(width))
           {
-            outputDEMIt.Set(m_NoDataValue);
+            cellHeights[cursors[it->column - firstColumn]++] = it->height;
           }
         }
-        else if (this->m_CellFusionMode == otb::CellFusionMode::ACC)
+      }
+
+      for (unsigned int c = 0; c < width; ++c)
+      {
+        if (cellCounts[c] == 0)
         {
-          outputDEMIt.Set(static_cast<DEMPixelType>(firstDEMAccIt.Get()));
+          continue;
         }
+        typename std::vector<DEMPixelType>::iterator first  = cellHeights.begin() + cellOffsets[c];
+        typename std::vector<DEMPixelType>::iterator last   = cellHeights.begin() + cellOffsets[c + 1];
+        typename std::vector<DEMPixelType>::iterator middle = first + cellCounts[c] / 2;
+        std::nth_element(first, middle, last);
+        cellValues[c] = *middle;
+        if (cellCounts[c] % 2 == 0)
+        {
+          // The lower middle value is the maximum of the lower half
+          cellValues[c] = (cellValues[c] + *std::max_element(first, middle)) / 2;
+        }
+      }
+    }
+
+    for (unsigned int c = 0; c < width; ++c, ++outputIt)
+    {
+      if (cellCounts[c] == 0)
+      {
+        outputIt.Set(m_NoDataValue);
+      }
+      else if (this->m_CellFusionMode == otb::CellFusionMode::MEAN)
+      {
+        outputIt.Set(cellValues[c] / static_cast<DEMPixelType>(cellCounts[c]));
+      }
+      else if (this->m_CellFusionMode == otb::CellFusionMode::ACC)
+      {
+        outputIt.Set(static_cast<DEMPixelType>(cellCounts[c]));
+      }
+      else
+      {
+        outputIt.Set(cellValues[c]);
       }
-      ++outputDEMIt;
-      ++tmpDEMIt;
-      ++tmpDEMAccIt;
-      ++firstDEMAccIt;
     }
   }
 }
+
+template <class T3DImage, class TMaskImage, class TOutputDEMImage>
+void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::AfterThreadedGenerateData()
+{
+  // Release the scattered points
+  std::vector<std::vector<RowBucketType>>().swap(m_RowBuckets);
+}
 }
 
 
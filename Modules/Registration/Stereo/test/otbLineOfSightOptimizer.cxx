@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbLineOfSightOptimizer.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+typedef otb::LineOfSightOptimizer<double> OptimizerType;
+typedef OptimizerType::PointSetType       PointSetType;
+typedef OptimizerType::PointType          PointType;
+
+int otbLineOfSightOptimizerIntersect(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  OptimizerType::Pointer optimizer = OptimizerType::New();
+
+  PointType pointsA[4];
+  PointType pointsB[4];
+
+  // Skewed lines of sight passing near (100, 200, 150)
+  std::srand(0);
+  for (unsigned int trial = 0; trial < 100; ++trial)
+  {
+    const unsigned int nbLines = 2 + trial % 3;
+
+    PointSetType::Pointer pointSetA = PointSetType::New();
+    PointSetType::Pointer pointSetB = PointSetType::New();
+
+    for (unsigned int l = 0; l < nbLines; ++l)
+    {
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        const double center = (d == 0 ? 100. : (d == 1 ? 200. : 150.));
+        const double slope  = (d == 2 ? 250. : 200. * (std::rand() / static_cast<double>(RAND_MAX) - 0.5));
+        const double noise  = std::rand() / static_cast<double>(RAND_MAX) - 0.5;
+        pointsA[l][d]       = center + slope + noise;
+        pointsB[l][d]       = center - slope + noise;
+      }
+      pointSetA->SetPoint(l, pointsA[l]);
+      pointSetB->SetPoint(l, pointsB[l]);
+      pointSetA->SetPointData(l, l);
+      pointSetB->SetPointData(l, l);
+    }
+
+    PointType expected = optimizer->Compute(pointSetA, pointSetB);
+
+    double    residue;
+    PointType result = OptimizerType::Intersect(pointsA, pointsB, nbLines, residue);
+
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      if (std::abs(result[d] - expected[d]) > 1e-9 * (1. + std::abs(expected[d])))
+      {
+        std::cout << "Trial " << trial << ": intersection " << result << " differs from " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (std::abs(residue - optimizer->GetGlobalResidue()) > 1e-9 * (1. + optimizer->GetGlobalResidue()))
+    {
+      std::cout << "Trial " << trial << ": residue " << residue << " differs from " << optimizer->GetGlobalResidue() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -24,6 +24,7 @@
 #include "otbImageFileWriter.h"
 #include "otbVectorImageToImageListFilter.h"
 #include <string>
+#include <cmath>
 #include "otbSpatialReference.h"
 
 typedef otb::Image<double, 2> ImageType;
@@ -312,5 +313,96 @@ int otbMulti3DMapToDEMFilter(int argc, char* argv[])
   writer->Update();
 
 
+  return EXIT_SUCCESS;
+}
+
+/** Median fusion of points falling in two DEM cells: an odd number of
+ * heights in the first cell, an even number in the second one and a masked
+ * point that must be ignored. */
+int otbMulti3DMapToDEMFilterMedian(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // x, y, height and mask value of the points of each 3D map
+  const double points[2][4][4] = {{{0.0, 0.0, 10., 1.}, {0.2, 0.1, 30., 1.}, {-0.3, 0.0, 20., 1.}, {1.0, 0.1, 5., 1.}},
+                                  {{1.0, 0.0, 7., 1.}, {1.2, 0.0, 1., 1.}, {0.9, 0.0, 9., 1.}, {0.0, 0.0, 1000., 0.}}};
+
+  VectorImageType::RegionType mapRegion;
+  mapRegion.SetIndex(0, 0);
+  mapRegion.SetIndex(1, 0);
+  mapRegion.SetSize(0, 4);
+  mapRegion.SetSize(1, 1);
+
+  VectorImageType::Pointer maps[2];
+  ImageType::Pointer       masks[2];
+
+  Multi3DFilterType::Pointer multiFilter = Multi3DFilterType::New();
+  multiFilter->SetNumberOf3DMaps(2);
+  multiFilter->SetCellFusionMode(otb::CellFusionMode::MEDIAN);
+
+  for (unsigned int k = 0; k < 2; ++k)
+  {
+    maps[k] = VectorImageType::New();
+    maps[k]->SetRegions(mapRegion);
+    maps[k]->SetNumberOfComponentsPerPixel(3);
+    maps[k]->Allocate();
+
+    masks[k] = ImageType::New();
+    masks[k]->SetRegions(mapRegion);
+    masks[k]->Allocate();
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      VectorImageType::IndexType index;
+      index[0] = i;
+      index[1] = 0;
+
+      VectorImageType::PixelType position(3);
+      position[0] = points[k][i][0];
+      position[1] = points[k][i][1];
+      position[2] = points[k][i][2];
+      maps[k]->SetPixel(index, position);
+      masks[k]->SetPixel(index, points[k][i][3]);
+    }
+
+    multiFilter->Set3DMapInput(k, maps[k]);
+    multiFilter->SetMaskInput(k, masks[k]);
+  }
+
+  // Two cells of one unit centered on (0, 0) and (1, 0)
+  VectorImageType::IndexType start;
+  start.Fill(0);
+  multiFilter->SetOutputStartIndex(start);
+
+  VectorImageType::SizeType size;
+  size[0] = 2;
+  size[1] = 1;
+  multiFilter->SetOutputSize(size);
+
+  VectorImageType::SpacingType spacing;
+  spacing.Fill(1.);
+  multiFilter->SetOutputSpacing(spacing);
+
+  VectorImageType::PointType origin;
+  origin.Fill(0.);
+  multiFilter->SetOutputOrigin(origin);
+
+  multiFilter->SetNumberOfThreads(2);
+  multiFilter->Update();
+
+  // Median of {10, 20, 30} and of {1, 5, 7, 9}
+  const double expected[2] = {20., 6.};
+  for (unsigned int c = 0; c < 2; ++c)
+  {
+    ImageType::IndexType cell;
+    cell[0] = c;
+    cell[1] = 0;
+
+    const double height = multiFilter->GetOutput()->GetPixel(cell);
+    if (std::abs(height - expected[c]) > 1e-9)
+    {
+      std::cout << "Cell " << c << ": median height " << height << " instead of " << expected[c] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
@@ -26,7 +26,9 @@ void RegisterTests()
   REGISTER_TEST(otbMulti3DMapToDEMFilterEPSG);
   REGISTER_TEST(otbMulti3DMapToDEMFilterManual);
   REGISTER_TEST(otbMulti3DMapToDEMFilter);
+  REGISTER_TEST(otbMulti3DMapToDEMFilterMedian);
   REGISTER_TEST(otbAdhesionCorrectionFilter);
   REGISTER_TEST(otbStereoSensorModelToElevationMapFilter);
   REGISTER_TEST(otbStereorectificationDisplacementFieldSource);
+  REGISTER_TEST(otbLineOfSightOptimizerIntersect);
 }
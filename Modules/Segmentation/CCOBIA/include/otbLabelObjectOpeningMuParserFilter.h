@@ -34,6 +34,7 @@
 #include "itkLabelObjectAccessors.h"
 #include "itkProgressReporter.h"
 #include "otbOBIAMuParserFunctor.h"
+#include <memory>
 
 namespace otb
 {
@@ -52,6 +53,11 @@ namespace otb
  * OTB additional constants:
  * e - log2e - log10e - ln2 - ln10 - pi - euler
  *
+ * The expression is evaluated in parallel: the label objects are split in
+ * contiguous batches, one per thread, and each thread evaluates its batch
+ * with its own parser, so that the expression is compiled once per thread.
+ * Rejected objects are then moved to the second output in label order.
+ *
  *
  * \sa Parser
  *
@@ -129,8 +135,30 @@ private:
   LabelObjectOpeningMuParserFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Static function used as a "callback" by the MultiThreader */
+  static ITK_THREAD_RETURN_TYPE EvaluateThreaderCallback(void* arg);
+
+  /** Evaluate the expression on the 'threadId' batch of label objects */
+  void ThreadedEvaluate(itk::ThreadIdType threadId, itk::ThreadIdType threadCount);
+
   FunctorType m_Functor;
   std::string m_Expression;
+
+  /** Attributes given with SetAttributes(), replayed on the thread functors */
+  bool                     m_UseManualAttributes;
+  std::vector<std::string> m_ShapeAttributes;
+  std::vector<std::string> m_StatAttributes;
+  int                      m_NbOfBands;
+
+  /** Per thread functors (the first thread uses m_Functor) */
+  std::vector<std::unique_ptr<FunctorType>> m_ThreadFunctors;
+
+  /** Label objects to evaluate, and their evaluation result */
+  std::vector<LabelObjectType*> m_LabelObjects;
+  std::vector<char>             m_Accepted;
+
+  /** Error raised by each thread, if any */
+  std::vector<std::string> m_ThreadErrors;
 };
 
 } // end namespace otb
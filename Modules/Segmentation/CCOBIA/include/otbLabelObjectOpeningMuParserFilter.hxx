@@ -22,6 +22,7 @@
 #define otbLabelObjectOpeningMuParserFilter_hxx
 
 #include "otbLabelObjectOpeningMuParserFilter.h"
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -33,7 +34,7 @@ namespace otb
 
 // constructor
 template <class TImage, class TFunction>
-LabelObjectOpeningMuParserFilter<TImage, TFunction>::LabelObjectOpeningMuParserFilter()
+LabelObjectOpeningMuParserFilter<TImage, TFunction>::LabelObjectOpeningMuParserFilter() : m_UseManualAttributes(false), m_NbOfBands(0)
 {
   // create the output image for the removed objects
   this->SetNumberOfRequiredOutputs(2);
@@ -106,6 +107,11 @@ void LabelObjectOpeningMuParserFilter<TImage, TFunction>::SetAttributes(std::vec
                                                                         int nbOfBands)
 {
   this->m_Functor.SetAttributes(shapeAttributes, statAttributes, nbOfBands);
+
+  m_UseManualAttributes = true;
+  m_ShapeAttributes     = shapeAttributes;
+  m_StatAttributes      = statAttributes;
+  m_NbOfBands           = nbOfBands;
 }
 
 /** Get the reduced attribute set */
@@ -170,27 +176,97 @@ void LabelObjectOpeningMuParserFilter<TImage, TFunction>::GenerateData()
   // set the background value for the second output - this is not done in the superclasses
   output2->SetBackgroundValue(output->GetBackgroundValue());
 
-  itk::ProgressReporter        progress(this, 0, output->GetNumberOfLabelObjects());
-  typename ImageType::Iterator it(output);
+  m_LabelObjects.clear();
+  m_LabelObjects.reserve(output->GetNumberOfLabelObjects());
+  for (typename ImageType::Iterator it(output); !it.IsAtEnd(); ++it)
+  {
+    m_LabelObjects.push_back(it.GetLabelObject());
+  }
+  m_Accepted.assign(m_LabelObjects.size(), 1);
 
-  while (!it.IsAtEnd())
+  // Parsers are created here, as their construction is not thread safe
+  itk::ThreadIdType nbThreads = std::max<itk::ThreadIdType>(1, std::min<size_t>(this->GetNumberOfThreads(), m_LabelObjects.size()));
+  m_ThreadFunctors.resize(nbThreads);
+  for (itk::ThreadIdType i = 1; i < nbThreads; ++i)
   {
-    typename LabelObjectType::LabelType label       = it.GetLabel();
-    LabelObjectType*                    labelObject = it.GetLabelObject();
+    m_ThreadFunctors[i].reset(new FunctorType);
+    m_ThreadFunctors[i]->SetExpression(m_Expression);
+    if (m_UseManualAttributes)
+    {
+      m_ThreadFunctors[i]->SetAttributes(m_ShapeAttributes, m_StatAttributes, m_NbOfBands);
+    }
+  }
+  m_ThreadErrors.assign(nbThreads, std::string());
+
+  this->GetMultiThreader()->SetNumberOfThreads(nbThreads);
+  this->GetMultiThreader()->SetSingleMethod(this->EvaluateThreaderCallback, this);
+  this->GetMultiThreader()->SingleMethodExecute();
 
-    if (!m_Functor(*labelObject))
+  m_ThreadFunctors.clear();
+
+  for (itk::ThreadIdType i = 0; i < nbThreads; ++i)
+  {
+    if (!m_ThreadErrors[i].empty())
     {
-      // must increment the iterator before removing the object to avoid invalidating the iterator
-      ++it;
-      output2->AddLabelObject(labelObject);
-      output->RemoveLabel(label);
+      itkExceptionMacro(<< m_ThreadErrors[i]);
     }
-    else
+  }
+
+  // Move the rejected objects, in label order
+  for (size_t i = 0; i < m_LabelObjects.size(); ++i)
+  {
+    if (!m_Accepted[i])
     {
-      ++it;
+      LabelObjectType* labelObject = m_LabelObjects[i];
+      output2->AddLabelObject(labelObject);
+      output->RemoveLabel(labelObject->GetLabel());
     }
+  }
+
+  m_LabelObjects.clear();
+  m_Accepted.clear();
+}
+
+template <class TImage, class TFunction>
+ITK_THREAD_RETURN_TYPE LabelObjectOpeningMuParserFilter<TImage, TFunction>::EvaluateThreaderCallback(void* arg)
+{
+  Self*             filter      = (Self*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+  itk::ThreadIdType threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  itk::ThreadIdType threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+
+  filter->ThreadedEvaluate(threadId, threadCount);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TImage, class TFunction>
+void LabelObjectOpeningMuParserFilter<TImage, TFunction>::ThreadedEvaluate(itk::ThreadIdType threadId, itk::ThreadIdType threadCount)
+{
+  if (threadId >= m_ThreadFunctors.size())
+  {
+    return;
+  }
+
+  const size_t nbObjects = m_LabelObjects.size();
+  const size_t first     = nbObjects * threadId / threadCount;
+  const size_t last      = nbObjects * (threadId + 1) / threadCount;
+
+  FunctorType& functor = (threadId == 0) ? m_Functor : *m_ThreadFunctors[threadId];
 
-    progress.CompletedPixel();
+  itk::ProgressReporter progress(this, threadId, last - first);
+
+  try
+  {
+    for (size_t i = first; i < last; ++i)
+    {
+      m_Accepted[i] = functor(*m_LabelObjects[i]) ? 1 : 0;
+      progress.CompletedPixel();
+    }
+  }
+  catch (itk::ExceptionObject& err)
+  {
+    // Exceptions can not cross the thread boundary
+    m_ThreadErrors[threadId] = err.GetDescription();
   }
 }
 
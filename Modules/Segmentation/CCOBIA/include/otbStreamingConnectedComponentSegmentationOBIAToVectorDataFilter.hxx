@@ -63,46 +63,51 @@ PersistentConnectedComponentSegmentationOBIAToVectorDataFilter<TVImage, TLabelIm
   extract->SetExtractionRegion(this->GetOutput()->GetRequestedRegion());
   // WARNING: itk::ExtractImageFilter does not copy the MetadataDictionary
 
-  typename MaskImageType::Pointer mask;
+  // The whole chain is updated once, from the vector data conversion. The
+  // intermediate label images have a single consumer, so their buffers are
+  // released as soon as they have been used.
+  typename MaskMuParserFilterType::Pointer maskFilter;
   if (!m_MaskExpression.empty())
   {
     // Compute the mask
-    typename MaskMuParserFilterType::Pointer maskFilter;
     maskFilter = MaskMuParserFilterType::New();
     maskFilter->SetInput(extract->GetOutput());
     maskFilter->SetExpression(m_MaskExpression);
-    maskFilter->Update();
-    mask = maskFilter->GetOutput();
+    maskFilter->ReleaseDataFlagOn();
   }
 
   // Perform connected components segmentation
   typename ConnectedComponentFilterType::Pointer connected = ConnectedComponentFilterType::New();
   connected->SetInput(extract->GetOutput());
 
-  if (mask.IsNotNull())
-    connected->SetMaskImage(mask);
+  if (maskFilter.IsNotNull())
+    connected->SetMaskImage(maskFilter->GetOutput());
   connected->GetFunctor().SetExpression(m_ConnectedComponentExpression);
-  connected->Update();
+  connected->ReleaseDataFlagOn();
 
   // Relabel connected component output
   typename RelabelComponentFilterType::Pointer relabel = RelabelComponentFilterType::New();
   relabel->SetInput(connected->GetOutput());
   relabel->SetMinimumObjectSize(m_MinimumObjectSize);
-  relabel->Update();
+  relabel->ReleaseDataFlagOn();
 
   // Attributes computation
   // LabelImage to Label Map transformation
   typename LabelImageToLabelMapFilterType::Pointer labelImageToLabelMap = LabelImageToLabelMapFilterType::New();
   labelImageToLabelMap->SetInput(relabel->GetOutput());
   labelImageToLabelMap->SetBackgroundValue(0);
-  labelImageToLabelMap->Update();
 
   typename AttributesLabelMapType::Pointer labelMap = labelImageToLabelMap->GetOutput();
 
+  // Keep the filters of the OBIA branch alive until the final update
+  typename ShapeLabelMapFilterType::Pointer       shapeLabelMapFilter;
+  typename RadiometricLabelMapFilterType::Pointer radiometricLabelMapFilter;
+  typename LabelObjectOpeningFilterType::Pointer  opening;
+
   if (!m_OBIAExpression.empty())
   {
     // shape attributes computation
-    typename ShapeLabelMapFilterType::Pointer shapeLabelMapFilter = ShapeLabelMapFilterType::New();
+    shapeLabelMapFilter = ShapeLabelMapFilterType::New();
     shapeLabelMapFilter->SetInput(labelImageToLabelMap->GetOutput());
     shapeLabelMapFilter->SetReducedAttributeSet(m_ShapeReducedSetOfAttributes);
     shapeLabelMapFilter->SetComputePolygon(m_ComputePolygon);
@@ -111,16 +116,15 @@ PersistentConnectedComponentSegmentationOBIAToVectorDataFilter<TVImage, TLabelIm
     shapeLabelMapFilter->SetComputeFlusser(m_ComputeFlusser);
 
     // band stat attributes computation
-    typename RadiometricLabelMapFilterType::Pointer radiometricLabelMapFilter = RadiometricLabelMapFilterType::New();
+    radiometricLabelMapFilter = RadiometricLabelMapFilterType::New();
     radiometricLabelMapFilter->SetInput(shapeLabelMapFilter->GetOutput());
     radiometricLabelMapFilter->SetFeatureImage(extract->GetOutput());
     radiometricLabelMapFilter->SetReducedAttributeSet(m_StatsReducedSetOfAttributes);
 
     // OBIA Filtering using shape and radiometric object characteristics
-    typename LabelObjectOpeningFilterType::Pointer opening = LabelObjectOpeningFilterType::New();
+    opening = LabelObjectOpeningFilterType::New();
     opening->SetExpression(m_OBIAExpression);
     opening->SetInput(radiometricLabelMapFilter->GetOutput());
-    opening->Update();
 
     labelMap = opening->GetOutput();
   }
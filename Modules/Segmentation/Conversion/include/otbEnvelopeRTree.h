@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbEnvelopeRTree_h
+#define otbEnvelopeRTree_h
+
+#include "OTBConversionExport.h"
+#include "ogr_core.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class EnvelopeRTree
+ * \brief Static R-tree over a set of envelopes, packed with the
+ * Sort-Tile-Recursive algorithm.
+ *
+ * The tree is built once from all the envelopes: at each level, the
+ * entries are sorted by the X coordinate of their center, cut into
+ * vertical slices, and each slice is sorted by the Y coordinate of the
+ * centers and packed into nodes of NodeCapacity entries. Queries return
+ * the indices of the envelopes intersecting a search window, in
+ * increasing order, so that callers can process the matching items in
+ * their original order.
+ *
+ * \ingroup OTBConversion
+ */
+class OTBConversion_EXPORT EnvelopeRTree
+{
+public:
+  /** Maximum number of entries per node */
+  static const unsigned int NodeCapacity = 16;
+
+  EnvelopeRTree();
+
+  /** Build the tree. Item i is the envelope envelopes[i]. */
+  void Build(const std::vector<OGREnvelope>& envelopes);
+
+  /** Remove all items */
+  void Clear();
+
+  unsigned int GetNumberOfItems() const
+  {
+    return m_NumberOfItems;
+  }
+
+  /** Find the items whose envelope intersects the window (borders
+   * included). Indices are returned in increasing order. */
+  void Query(const OGREnvelope& window, std::vector<unsigned int>& items) const;
+
+private:
+  struct Node
+  {
+    OGREnvelope  envelope;
+    unsigned int first; // first child node, or first item for leaves
+    unsigned int count;
+    bool         leaf;
+  };
+
+  unsigned int m_NumberOfItems;
+
+  /** Item indices, in leaf order */
+  std::vector<unsigned int> m_Items;
+
+  /** Item envelopes, in leaf order */
+  std::vector<OGREnvelope> m_ItemEnvelopes;
+
+  /** Nodes, the root being the last one */
+  std::vector<Node> m_Nodes;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGeometryRasterizer_h
+#define otbGeometryRasterizer_h
+
+#include "OTBConversionExport.h"
+#include "otbEnvelopeRTree.h"
+#include "itkMultiThreader.h"
+#include "gdal.h"
+#include "ogr_api.h"
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class GeometryRasterizer
+ * \brief Burn a set of OGR geometries into a pixel buffer, by bands of rows
+ * processed in parallel.
+ *
+ * The geometries are cloned with their burn values (one per burnt band) and
+ * indexed by an EnvelopeRTree. The buffer is then split into horizontal
+ * bands, one per thread: each band is wrapped in its own MEM dataset, and
+ * only the geometries whose envelope intersects the band are passed to
+ * GDALRasterizeGeometries(), in the order they were added so that later
+ * geometries still overwrite earlier ones.
+ *
+ * Scanline filling, burn values and the all-touched rule are the ones of
+ * GDAL. World coordinates are converted to pixel coordinates with the
+ * inverse geotransform of the whole buffer and then shifted by the first row
+ * of the band, so that the burnt pixels do not depend on the band layout.
+ *
+ * \ingroup OTBConversion
+ */
+class OTBConversion_EXPORT GeometryRasterizer
+{
+public:
+  GeometryRasterizer();
+  ~GeometryRasterizer();
+
+  /** Remove all geometries */
+  void Clear();
+
+  /** Number of burn values expected for each geometry */
+  void SetNumberOfBands(unsigned int nbBands)
+  {
+    m_NumberOfBands = nbBands;
+  }
+
+  unsigned int GetNumberOfBands() const
+  {
+    return m_NumberOfBands;
+  }
+
+  /** Set/Get the all touched mode */
+  void SetAllTouched(bool flag)
+  {
+    m_AllTouched = flag;
+  }
+
+  bool GetAllTouched() const
+  {
+    return m_AllTouched;
+  }
+
+  /** Set/Get the number of threads used by Rasterize() */
+  void SetNumberOfThreads(unsigned int nbThreads)
+  {
+    m_NumberOfThreads = nbThreads;
+  }
+
+  unsigned int GetNumberOfThreads() const
+  {
+    return m_NumberOfThreads;
+  }
+
+  unsigned int GetNumberOfGeometries() const
+  {
+    return static_cast<unsigned int>(m_Geometries.size());
+  }
+
+  /** Add a copy of a geometry, burnt with burnValues (GetNumberOfBands()
+   * values). Empty geometries are ignored. */
+  void AddGeometry(OGRGeometryH geometry, const std::vector<double>& burnValues);
+
+  /** Add a copy of the geometries of all the features of a layer. When
+   * burnAttribute is not empty, the burn value of each feature is read from
+   * this field, for all the bands; otherwise burnValues is used. The
+   * geometries are reprojected to projectionRef when the layer has a
+   * different spatial reference, as GDALRasterizeLayers() does. Returns
+   * false, without adding anything, if the burn attribute does not exist
+   * in the layer. */
+  bool AddLayer(OGRLayerH layer, const std::string& burnAttribute, const std::vector<double>& burnValues, const std::string& projectionRef);
+
+  /** Build the spatial index. Called by Rasterize() when needed. */
+  void BuildIndex();
+
+  /** Burn the geometries into a pixel interleaved buffer of width x height
+   * pixels with nbComponents components of the given type. geoTransform is
+   * the GDAL geotransform of the buffer, and bands the 1-based components
+   * to burn (GetNumberOfBands() of them). When background is not null, the
+   * burnt bands are first filled with background[i]. */
+  void Rasterize(void* buffer, GDALDataType dataType, unsigned int nbComponents, unsigned int width, unsigned int height, const double geoTransform[6],
+                 const std::vector<int>& bands, const double* background = nullptr);
+
+private:
+  GeometryRasterizer(const GeometryRasterizer&) = delete;
+  void operator=(const GeometryRasterizer&) = delete;
+
+  struct ThreadStruct;
+
+  static ITK_THREAD_RETURN_TYPE ThreaderCallback(void* arg);
+
+  /** Burn the rows [firstRow, firstRow + nbRows[ of the buffer */
+  void RasterizeBand(const ThreadStruct& str, unsigned int firstRow, unsigned int nbRows) const;
+
+  unsigned int m_NumberOfBands;
+  bool         m_AllTouched;
+  unsigned int m_NumberOfThreads;
+
+  std::vector<OGRGeometryH> m_Geometries;
+
+  /** Burn values, GetNumberOfBands() per geometry */
+  std::vector<double> m_BurnValues;
+
+  std::vector<OGREnvelope> m_Envelopes;
+  EnvelopeRTree            m_Index;
+  bool                     m_IndexUpToDate;
+};
+
+} // end namespace otb
+
+#endif
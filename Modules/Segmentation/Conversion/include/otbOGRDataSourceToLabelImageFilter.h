@@ -28,6 +28,7 @@
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "otbOGRDataSourceWrapper.h"
+#include "otbGeometryRasterizer.h"
 #include <string>
 
 namespace otb
@@ -52,6 +53,9 @@ namespace otb
  *    - Setting the Origin/Size/Spacing of the output image
  *    - Using an existing image as support via SetOutputParametersFromImage(ImageBase)
  *
+ *  The geometries are read once, indexed, and burnt by a GeometryRasterizer:
+ *  each requested region is split into bands of rows processed by separate
+ *  threads, each band only receiving the geometries that intersect it.
  *
  * \ingroup OTBConversion
  */
@@ -164,6 +168,10 @@ private:
   std::vector<OGRLayerH> m_SrcDataSetLayers;
   std::vector<int>       m_BandsToBurn;
 
+  // Geometries of all the layers, read once for all the requested regions
+  GeometryRasterizer m_Rasterizer;
+  bool               m_RasterizerUpToDate;
+
   // Field used to extract the burn value
   std::string m_BurnAttribute;
 
@@ -29,14 +29,11 @@
 #include "otbMetaDataKey.h"
 #include "otbImage.h"
 
-#include "gdal_alg.h"
-#include "stdint.h" //needed for uintptr_t
-
 namespace otb
 {
 template <class TOutputImage>
 OGRDataSourceToLabelImageFilter<TOutputImage>::OGRDataSourceToLabelImageFilter()
-  : m_BurnAttribute("DN"), m_BackgroundValue(0), m_ForegroundValue(255), m_BurnAttributeMode(true), m_AllTouchedMode(false)
+  : m_BurnAttribute("DN"), m_BackgroundValue(0), m_ForegroundValue(255), m_BurnAttributeMode(true), m_AllTouchedMode(false), m_RasterizerUpToDate(false)
 {
   this->SetNumberOfRequiredInputs(1);
 
@@ -44,8 +41,6 @@ OGRDataSourceToLabelImageFilter<TOutputImage>::OGRDataSourceToLabelImageFilter()
   m_OutputSpacing.Fill(1.0);
   m_OutputSize.Fill(0);
   m_OutputStartIndex.Fill(0);
-  m_BandsToBurn.clear();
-  m_BandsToBurn.push_back(1);
 }
 
 template <class TOutputImage>
@@ -136,6 +131,8 @@ void OGRDataSourceToLabelImageFilter<TOutputImage>::GenerateOutputInformation()
   outputPtr->SetProjectionRef(this->GetOutputProjectionRef());
  
   // Generate the OGRLayers from the input OGRDataSource
+  m_SrcDataSetLayers.clear();
+  m_RasterizerUpToDate = false;
   for (unsigned int idx = 0; idx < this->GetNumberOfInputs(); ++idx)
   {
     OGRDataSourcePointerType ogrDS    = dynamic_cast<OGRDataSourceType*>(this->itk::ProcessObject::GetInput(idx));
@@ -171,40 +168,39 @@ void OGRDataSourceToLabelImageFilter<TOutputImage>::GenerateData()
   // nb bands
   const unsigned int& nbBands = this->GetOutput()->GetNumberOfComponentsPerPixel();
 
-  // register drivers
-  GDALAllRegister();
-
-  std::ostringstream stream;
-  stream << "MEM:::"
-         << "DATAPOINTER=" << (uintptr_t)(this->GetOutput()->GetBufferPointer()) << ","
-         << "PIXELS=" << bufferedRegion.GetSize()[0] << ","
-         << "LINES=" << bufferedRegion.GetSize()[1] << ","
-         << "BANDS=" << nbBands << ","
-         << "DATATYPE=" << GDALGetDataTypeName(GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>()) << ","
-         << "PIXELOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands << ","
-         << "LINEOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands * bufferedRegion.GetSize()[0] << ","
-         << "BANDOFFSET=" << sizeof(OutputImageInternalPixelType);
-
-  GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
+  // Read the geometries and their burn values
+  if (!m_RasterizerUpToDate)
+  {
+    std::vector<double> foreground(nbBands, static_cast<double>(m_ForegroundValue));
+    const std::string   burnAttribute = m_BurnAttributeMode ? m_BurnAttribute : std::string();
 
-  // Add the projection ref to the dataset
-  GDALSetProjection(dataset, this->GetOutput()->GetProjectionRef().c_str());
+    m_Rasterizer.Clear();
+    m_Rasterizer.SetNumberOfBands(nbBands);
+    for (unsigned int idx = 0; idx < m_SrcDataSetLayers.size(); ++idx)
+    {
+      if (!m_Rasterizer.AddLayer(m_SrcDataSetLayers[idx], burnAttribute, foreground, this->GetOutput()->GetProjectionRef()))
+      {
+        itkWarningMacro(<< "Failed to find attribute " << m_BurnAttribute << " in layer " << OGR_L_GetName(m_SrcDataSetLayers[idx])
+                        << ", the layer is not rasterized.");
+      }
+    }
+    m_Rasterizer.BuildIndex();
+    m_RasterizerUpToDate = true;
+  }
 
-  // Set the nodata value
+  m_BandsToBurn.resize(nbBands);
   for (unsigned int band = 0; band < nbBands; ++band)
   {
-    GDALRasterBandH hBand = GDALGetRasterBand(dataset, band + 1);
-    GDALFillRaster(hBand, m_BackgroundValue, 0);
+    m_BandsToBurn[band] = band + 1;
   }
 
-  // add the geoTransform to the dataset
-  itk::VariableLengthVector<double> geoTransform(6);
-
   // Reporting origin and spacing of the buffered region
   // the spacing is unchanged, the origin is relative to the buffered region
   OutputIndexType  bufferIndexOrigin = bufferedRegion.GetIndex();
   OutputOriginType bufferOrigin;
   this->GetOutput()->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
+
+  double geoTransform[6];
   geoTransform[0] = bufferOrigin[0] - 0.5 * this->GetOutput()->GetSignedSpacing()[0];
   geoTransform[3] = bufferOrigin[1] - 0.5 * this->GetOutput()->GetSignedSpacing()[1];
   geoTransform[1] = this->GetOutput()->GetSignedSpacing()[0];
@@ -213,29 +209,14 @@ void OGRDataSourceToLabelImageFilter<TOutputImage>::GenerateData()
   // FIXME: Here component 1 and 4 should be replaced by the orientation parameters
   geoTransform[2] = 0.;
   geoTransform[4] = 0.;
-  GDALSetGeoTransform(dataset, const_cast<double*>(geoTransform.GetDataPointer()));
 
-  // Burn the geometries into the dataset
-  if (dataset != nullptr)
-  {
-    std::vector<std::string> options;
-
-    std::vector<double> foreground(nbBands * m_SrcDataSetLayers.size(), m_ForegroundValue);
-
-    if (m_BurnAttributeMode)
-    {
-      options.push_back("ATTRIBUTE=" + m_BurnAttribute);
-    }
-    if (m_AllTouchedMode)
-    {
-      options.push_back("ALL_TOUCHED=TRUE");
-    }
+  // Fill with the background value and burn the geometries
+  std::vector<double> background(nbBands, static_cast<double>(m_BackgroundValue));
 
-    GDALRasterizeLayers(dataset, nbBands, &m_BandsToBurn[0], m_SrcDataSetLayers.size(), &(m_SrcDataSetLayers[0]), nullptr, nullptr, &foreground[0],
-                        ogr::StringListConverter(options).to_ogr(), nullptr, nullptr);
-    // release the dataset
-    GDALClose(dataset);
-  }
+  m_Rasterizer.SetAllTouched(m_AllTouchedMode);
+  m_Rasterizer.SetNumberOfThreads(this->GetNumberOfThreads());
+  m_Rasterizer.Rasterize(this->GetOutput()->GetBufferPointer(), GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>(), nbBands,
+                         bufferedRegion.GetSize()[0], bufferedRegion.GetSize()[1], geoTransform, m_BandsToBurn, &background[0]);
 }
 
 template <class TOutputImage>
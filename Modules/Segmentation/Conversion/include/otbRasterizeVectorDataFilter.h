@@ -31,6 +31,7 @@
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "ogr_srs_api.h"
+#include "otbGeometryRasterizer.h"
 
 namespace otb
 {
@@ -57,6 +58,9 @@ namespace otb
  *  projectionRef. Nothing is done in this class to reproject the
  *  VectorData into the image coordinate system.
  *
+ *  The geometries are burnt by a GeometryRasterizer, which splits each
+ *  requested region into bands of rows processed by separate threads.
+ *
  * \ingroup OTBConversion
  */
 template <class TVectorData, class TInputImage, class TOutputImage = TInputImage>
@@ -169,6 +173,10 @@ private:
   std::vector<int>    m_BandsToBurn;
   bool                m_AllTouchedMode;
 
+  // Geometries of all the layers, read once for all the requested regions
+  GeometryRasterizer m_Rasterizer;
+  bool               m_RasterizerUpToDate;
+
 }; // end of class RasterizeVectorDataFilter
 
 } // end of namespace otb
@@ -28,7 +28,7 @@
 namespace otb
 {
 template <class TVectorData, class TInputImage, class TOutputImage>
-RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::RasterizeVectorDataFilter() : m_OGRDataSourcePointer(nullptr), m_AllTouchedMode(false)
+RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::RasterizeVectorDataFilter() : m_OGRDataSourcePointer(nullptr), m_AllTouchedMode(false), m_RasterizerUpToDate(false)
 {
   this->SetNumberOfRequiredInputs(1);
 }
@@ -54,6 +54,10 @@ void RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::Generate
 {
   Superclass::GenerateOutputInformation();
 
+  m_SrcDataSetLayers.clear();
+  m_FullBurnValues.clear();
+  m_RasterizerUpToDate = false;
+
   // Generate the OGRLayers from the input VectorDatas
   // iteration begin from 1 cause the 0th input is a image
   for (unsigned int idx = 1; idx < this->GetNumberOfInputs(); ++idx)
@@ -140,33 +144,33 @@ void RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::Generate
   // nb bands
   unsigned int nbBands = this->GetOutput()->GetNumberOfComponentsPerPixel();
 
-  // register drivers
-  GDALAllRegister();
-
-  std::ostringstream stream;
-  stream << "MEM:::"
-         << "DATAPOINTER=" << (uintptr_t)(this->GetOutput()->GetBufferPointer()) << ","
-         << "PIXELS=" << bufferedRegion.GetSize()[0] << ","
-         << "LINES=" << bufferedRegion.GetSize()[1] << ","
-         << "BANDS=" << nbBands << ","
-         << "DATATYPE=" << GDALGetDataTypeName(GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>()) << ","
-         << "PIXELOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands << ","
-         << "LINEOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands * bufferedRegion.GetSize()[0] << ","
-         << "BANDOFFSET=" << sizeof(OutputImageInternalPixelType);
-
-  GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
-
-  // Add the projection ref to the dataset
-  GDALSetProjection(dataset, this->GetOutput()->GetProjectionRef().c_str());
+  // Read the geometries, with the burn values of their layer
+  if (!m_RasterizerUpToDate)
+  {
+    const unsigned int nbBandsToBurn = m_BandsToBurn.size();
 
-  // add the geoTransform to the dataset
-  itk::VariableLengthVector<double> geoTransform(6);
+    m_Rasterizer.Clear();
+    m_Rasterizer.SetNumberOfBands(nbBandsToBurn);
+    for (unsigned int idx = 0; idx < m_SrcDataSetLayers.size(); ++idx)
+    {
+      std::vector<double> layerBurnValues(nbBandsToBurn, 0.);
+      for (unsigned int band = 0; band < nbBandsToBurn && idx * nbBandsToBurn + band < m_FullBurnValues.size(); ++band)
+      {
+        layerBurnValues[band] = m_FullBurnValues[idx * nbBandsToBurn + band];
+      }
+      m_Rasterizer.AddLayer(m_SrcDataSetLayers[idx], std::string(), layerBurnValues, this->GetOutput()->GetProjectionRef());
+    }
+    m_Rasterizer.BuildIndex();
+    m_RasterizerUpToDate = true;
+  }
 
   // Reporting origin and spacing of the buffered region
   // the spacing is unchanged, the origin is relative to the buffered region
   InputIndexType bufferIndexOrigin = bufferedRegion.GetIndex();
   InputPointType bufferOrigin;
   this->GetOutput()->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
+
+  double geoTransform[6];
   geoTransform[0] = bufferOrigin[0] - 0.5 * this->GetOutput()->GetSignedSpacing()[0];
   geoTransform[3] = bufferOrigin[1] - 0.5 * this->GetOutput()->GetSignedSpacing()[1];
   geoTransform[1] = this->GetOutput()->GetSignedSpacing()[0];
@@ -175,25 +179,12 @@ void RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::Generate
   // FIXME: Here component 1 and 4 should be replaced by the orientation parameters
   geoTransform[2] = 0.;
   geoTransform[4] = 0.;
-  GDALSetGeoTransform(dataset, const_cast<double*>(geoTransform.GetDataPointer()));
-
-  char** options = nullptr;
-  if (m_AllTouchedMode)
-  {
-    options = CSLSetNameValue(options, "ALL_TOUCHED", "TRUE");
-  }
 
-  // Burn the geometries into the dataset
-  if (dataset != nullptr)
-  {
-    GDALRasterizeLayers(dataset, m_BandsToBurn.size(), &(m_BandsToBurn[0]), m_SrcDataSetLayers.size(), &(m_SrcDataSetLayers[0]), nullptr, nullptr,
-                        &(m_FullBurnValues[0]), options, GDALDummyProgress, nullptr);
-
-    CSLDestroy(options);
-
-    // release the dataset
-    GDALClose(dataset);
-  }
+  // Burn the geometries into the buffer
+  m_Rasterizer.SetAllTouched(m_AllTouchedMode);
+  m_Rasterizer.SetNumberOfThreads(this->GetNumberOfThreads());
+  m_Rasterizer.Rasterize(this->GetOutput()->GetBufferPointer(), GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>(), nbBands,
+                         bufferedRegion.GetSize()[0], bufferedRegion.GetSize()[1], geoTransform, m_BandsToBurn);
 }
 
 template <class TVectorData, class TInputImage, class TOutputImage>
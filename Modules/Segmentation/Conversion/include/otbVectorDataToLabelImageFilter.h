@@ -29,6 +29,7 @@
 
 #include "gdal.h"
 #include "ogr_api.h"
+#include "otbGeometryRasterizer.h"
 #include <string>
 
 namespace otb
@@ -47,6 +48,8 @@ namespace otb
  *
  *  OGRRegisterAll() method must have been called before applying filter.
  *
+ *  The geometries are burnt by a GeometryRasterizer, which splits each
+ *  requested region into bands of rows processed by separate threads.
  *
  * \ingroup OTBConversion
  */
@@ -142,12 +145,6 @@ protected:
   VectorDataToLabelImageFilter();
   ~VectorDataToLabelImageFilter() override
   {
-    // Destroy the geometries stored
-    for (unsigned int idx = 0; idx < m_SrcDataSetGeometries.size(); ++idx)
-    {
-      OGR_G_DestroyGeometry(m_SrcDataSetGeometries[idx]);
-    }
-
     if (m_OGRDataSourcePointer != nullptr)
     {
       GDALClose(m_OGRDataSourcePointer);
@@ -164,12 +161,10 @@ private:
 
   GDALDataset* m_OGRDataSourcePointer;
 
-  // Vector Of OGRGeometyH
-  std::vector<OGRGeometryH> m_SrcDataSetGeometries;
+  // Geometries and their burn values
+  GeometryRasterizer m_Rasterizer;
 
-  std::vector<double> m_BurnValues;
-  std::vector<double> m_FullBurnValues;
-  std::vector<int>    m_BandsToBurn;
+  std::vector<int> m_BandsToBurn;
 
   // Field used to extract the burn value
   std::string m_BurnAttribute;
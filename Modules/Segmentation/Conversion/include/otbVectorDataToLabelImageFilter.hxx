@@ -133,6 +133,9 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateOutputInfo
   itk::MetaDataDictionary& dict = outputPtr->GetMetaDataDictionary();
   itk::EncapsulateMetaData<std::string>(dict, MetaDataKey::ProjectionRefKey, static_cast<std::string>(this->GetOutputProjectionRef()));
 
+  m_Rasterizer.Clear();
+  m_Rasterizer.SetNumberOfBands(m_BandsToBurn.size());
+
   // Generate the OGRLayers from the input VectorDatas
   // iteration begin from 1 cause the 0th input is a image
   for (unsigned int idx = 0; idx < this->GetNumberOfInputs(); ++idx)
@@ -185,27 +188,23 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateOutputInfo
         OGR_L_ResetReading((OGRLayerH)(ogrLayerVector[idx2]));
         while ((hFeat = OGR_L_GetNextFeature((OGRLayerH)(ogrLayerVector[idx2]))) != nullptr)
         {
-          OGRGeometryH hGeom;
           if (OGR_F_GetGeometryRef(hFeat) == nullptr)
           {
             OGR_F_Destroy(hFeat);
             continue;
           }
 
-          hGeom = OGR_G_Clone(OGR_F_GetGeometryRef(hFeat));
-          m_SrcDataSetGeometries.push_back(hGeom);
-
           if (burnField == -1)
           {
             // TODO : if no burnAttribute available, warning or raise an exception??
-            m_FullBurnValues.push_back(m_DefaultBurnValue++);
+            m_Rasterizer.AddGeometry(OGR_F_GetGeometryRef(hFeat), std::vector<double>(1, m_DefaultBurnValue++));
             itkWarningMacro(<< "Failed to find attribute " << m_BurnAttribute << " in layer "
                             << OGR_FD_GetName(OGR_L_GetLayerDefn((OGRLayerH)(ogrLayerVector[idx2])))
                             << " .Setting burn value to default =  " << m_DefaultBurnValue);
           }
           else
           {
-            m_FullBurnValues.push_back(OGR_F_GetFieldAsDouble(hFeat, burnField));
+            m_Rasterizer.AddGeometry(OGR_F_GetGeometryRef(hFeat), std::vector<double>(1, OGR_F_GetFieldAsDouble(hFeat, burnField)));
           }
 
           OGR_F_Destroy(hFeat);
@@ -236,33 +235,13 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateData()
   // nb bands
   unsigned int nbBands = this->GetOutput()->GetNumberOfComponentsPerPixel();
 
-  // register drivers
-  GDALAllRegister();
-
-  std::ostringstream stream;
-  stream << "MEM:::"
-         << "DATAPOINTER=" << (uintptr_t)(this->GetOutput()->GetBufferPointer()) << ","
-         << "PIXELS=" << bufferedRegion.GetSize()[0] << ","
-         << "LINES=" << bufferedRegion.GetSize()[1] << ","
-         << "BANDS=" << nbBands << ","
-         << "DATATYPE=" << GDALGetDataTypeName(GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>()) << ","
-         << "PIXELOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands << ","
-         << "LINEOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands * bufferedRegion.GetSize()[0] << ","
-         << "BANDOFFSET=" << sizeof(OutputImageInternalPixelType);
-
-  GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
-
-  // Add the projection ref to the dataset
-  GDALSetProjection(dataset, this->GetOutput()->GetProjectionRef().c_str());
-
-  // add the geoTransform to the dataset
-  itk::VariableLengthVector<double> geoTransform(6);
-
   // Reporting origin and spacing of the buffered region
   // the spacing is unchanged, the origin is relative to the buffered region
   OutputIndexType  bufferIndexOrigin = bufferedRegion.GetIndex();
   OutputOriginType bufferOrigin;
   this->GetOutput()->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
+
+  double geoTransform[6];
   geoTransform[0] = bufferOrigin[0] - 0.5 * this->GetOutput()->GetSignedSpacing()[0];
   geoTransform[3] = bufferOrigin[1] - 0.5 * this->GetOutput()->GetSignedSpacing()[1];
   geoTransform[1] = this->GetOutput()->GetSignedSpacing()[0];
@@ -271,25 +250,12 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateData()
   // FIXME: Here component 1 and 4 should be replaced by the orientation parameters
   geoTransform[2] = 0.;
   geoTransform[4] = 0.;
-  GDALSetGeoTransform(dataset, const_cast<double*>(geoTransform.GetDataPointer()));
 
-  char** options = nullptr;
-  if (m_AllTouchedMode)
-  {
-    options = CSLSetNameValue(options, "ALL_TOUCHED", "TRUE");
-  }
-
-  // Burn the geometries into the dataset
-  if (dataset != nullptr)
-  {
-    GDALRasterizeGeometries(dataset, m_BandsToBurn.size(), &(m_BandsToBurn[0]), m_SrcDataSetGeometries.size(), &(m_SrcDataSetGeometries[0]), nullptr, nullptr,
-                            &(m_FullBurnValues[0]), options, GDALDummyProgress, nullptr);
-
-    CSLDestroy(options);
-
-    // release the dataset
-    GDALClose(dataset);
-  }
+  // Burn the geometries into the buffer
+  m_Rasterizer.SetAllTouched(m_AllTouchedMode);
+  m_Rasterizer.SetNumberOfThreads(this->GetNumberOfThreads());
+  m_Rasterizer.Rasterize(this->GetOutput()->GetBufferPointer(), GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>(), nbBands,
+                         bufferedRegion.GetSize()[0], bufferedRegion.GetSize()[1], geoTransform, m_BandsToBurn);
 }
 
 template <class TVectorData, class TOutputImage>
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbEnvelopeRTree.h"
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+namespace
+{
+inline bool Intersects(const OGREnvelope& a, const OGREnvelope& b)
+{
+  return a.MinX <= b.MaxX && a.MaxX >= b.MinX && a.MinY <= b.MaxY && a.MaxY >= b.MinY;
+}
+
+inline void Merge(OGREnvelope& a, const OGREnvelope& b)
+{
+  a.MinX = std::min(a.MinX, b.MinX);
+  a.MaxX = std::max(a.MaxX, b.MaxX);
+  a.MinY = std::min(a.MinY, b.MinY);
+  a.MaxY = std::max(a.MaxY, b.MaxY);
+}
+
+// Sort-Tile-Recursive order of a set of envelopes: returns the permutation
+// that groups them into tiles of nodeCapacity entries
+std::vector<unsigned int> TileOrder(const std::vector<OGREnvelope>& envelopes, unsigned int nodeCapacity)
+{
+  const unsigned int        n = static_cast<unsigned int>(envelopes.size());
+  std::vector<unsigned int> order(n);
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    order[i] = i;
+  }
+
+  const unsigned int nbNodes     = (n + nodeCapacity - 1) / nodeCapacity;
+  const unsigned int nbSlices    = static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(nbNodes))));
+  const unsigned int sliceLength = nbSlices * nodeCapacity;
+
+  std::stable_sort(order.begin(), order.end(), [&envelopes](unsigned int a, unsigned int b) {
+    return envelopes[a].MinX + envelopes[a].MaxX < envelopes[b].MinX + envelopes[b].MaxX;
+  });
+  for (unsigned int start = 0; start < n; start += sliceLength)
+  {
+    const unsigned int end = std::min(n, start + sliceLength);
+    std::stable_sort(order.begin() + start, order.begin() + end, [&envelopes](unsigned int a, unsigned int b) {
+      return envelopes[a].MinY + envelopes[a].MaxY < envelopes[b].MinY + envelopes[b].MaxY;
+    });
+  }
+  return order;
+}
+}
+
+EnvelopeRTree::EnvelopeRTree() : m_NumberOfItems(0)
+{
+}
+
+void EnvelopeRTree::Clear()
+{
+  m_NumberOfItems = 0;
+  m_Items.clear();
+  m_ItemEnvelopes.clear();
+  m_Nodes.clear();
+}
+
+void EnvelopeRTree::Build(const std::vector<OGREnvelope>& envelopes)
+{
+  Clear();
+  m_NumberOfItems = static_cast<unsigned int>(envelopes.size());
+  if (m_NumberOfItems == 0)
+  {
+    return;
+  }
+
+  // Leaves
+  m_Items = TileOrder(envelopes, NodeCapacity);
+  m_ItemEnvelopes.resize(m_NumberOfItems);
+  for (unsigned int i = 0; i < m_NumberOfItems; ++i)
+  {
+    m_ItemEnvelopes[i] = envelopes[m_Items[i]];
+  }
+
+  std::vector<std::vector<Node>> levels(1);
+  for (unsigned int start = 0; start < m_NumberOfItems; start += NodeCapacity)
+  {
+    Node node;
+    node.first    = start;
+    node.count    = std::min(NodeCapacity, m_NumberOfItems - start);
+    node.leaf     = true;
+    node.envelope = m_ItemEnvelopes[start];
+    for (unsigned int i = start + 1; i < start + node.count; ++i)
+    {
+      Merge(node.envelope, m_ItemEnvelopes[i]);
+    }
+    levels.back().push_back(node);
+  }
+
+  // Upper levels, until a single root remains. The children of each node
+  // are contiguous in the level below.
+  while (levels.back().size() > 1)
+  {
+    std::vector<Node>&       children = levels.back();
+    std::vector<OGREnvelope> childEnvelopes(children.size());
+    for (unsigned int i = 0; i < children.size(); ++i)
+    {
+      childEnvelopes[i] = children[i].envelope;
+    }
+    const std::vector<unsigned int> order = TileOrder(childEnvelopes, NodeCapacity);
+    std::vector<Node>               sorted(children.size());
+    for (unsigned int i = 0; i < order.size(); ++i)
+    {
+      sorted[i] = children[order[i]];
+    }
+    children.swap(sorted);
+
+    std::vector<Node>  parents;
+    const unsigned int nbChildren = static_cast<unsigned int>(children.size());
+    for (unsigned int start = 0; start < nbChildren; start += NodeCapacity)
+    {
+      Node node;
+      node.first    = start;
+      node.count    = std::min(NodeCapacity, nbChildren - start);
+      node.leaf     = false;
+      node.envelope = children[start].envelope;
+      for (unsigned int i = start + 1; i < start + node.count; ++i)
+      {
+        Merge(node.envelope, children[i].envelope);
+      }
+      parents.push_back(node);
+    }
+    levels.push_back(parents);
+  }
+
+  // Concatenate the levels, bottom-up, with absolute child indices
+  unsigned int offset = 0;
+  for (unsigned int l = 0; l < levels.size(); ++l)
+  {
+    for (Node node : levels[l])
+    {
+      if (!node.leaf)
+      {
+        node.first += offset - static_cast<unsigned int>(levels[l - 1].size());
+      }
+      m_Nodes.push_back(node);
+    }
+    offset += static_cast<unsigned int>(levels[l].size());
+  }
+}
+
+void EnvelopeRTree::Query(const OGREnvelope& window, std::vector<unsigned int>& items) const
+{
+  items.clear();
+  if (m_Nodes.empty())
+  {
+    return;
+  }
+
+  std::vector<unsigned int> stack(1, static_cast<unsigned int>(m_Nodes.size()) - 1);
+  while (!stack.empty())
+  {
+    const Node& node = m_Nodes[stack.back()];
+    stack.pop_back();
+    if (!Intersects(node.envelope, window))
+    {
+      continue;
+    }
+    for (unsigned int i = node.first; i < node.first + node.count; ++i)
+    {
+      if (!node.leaf)
+      {
+        stack.push_back(i);
+      }
+      else if (Intersects(m_ItemEnvelopes[i], window))
+      {
+        items.push_back(m_Items[i]);
+      }
+    }
+  }
+  std::sort(items.begin(), items.end());
+}
+
+} // end namespace otb
@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGeometryRasterizer.h"
+#include "gdal_alg.h"
+#include "ogr_srs_api.h"
+#include "cpl_string.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdint.h> //needed for uintptr_t
+
+namespace otb
+{
+
+namespace
+{
+/** World to band pixel coordinates: inverse geotransform of the whole
+ * buffer, then shift by the first row of the band */
+struct BandTransformType
+{
+  double invGeoTransform[6];
+  double geoTransform[6];
+  double firstRow;
+};
+
+int BandTransform(void* arg, int dstToSrc, int nbPoints, double* x, double* y, double* /*z*/, int* success)
+{
+  const BandTransformType* t = static_cast<const BandTransformType*>(arg);
+  for (int i = 0; i < nbPoints; ++i)
+  {
+    if (dstToSrc)
+    {
+      const double line = y[i] + t->firstRow;
+      const double newX = t->geoTransform[0] + x[i] * t->geoTransform[1] + line * t->geoTransform[2];
+      const double newY = t->geoTransform[3] + x[i] * t->geoTransform[4] + line * t->geoTransform[5];
+      x[i]              = newX;
+      y[i]              = newY;
+    }
+    else
+    {
+      const double newX = t->invGeoTransform[0] + x[i] * t->invGeoTransform[1] + y[i] * t->invGeoTransform[2];
+      const double newY = t->invGeoTransform[3] + x[i] * t->invGeoTransform[4] + y[i] * t->invGeoTransform[5];
+      x[i]              = newX;
+      y[i]              = newY - t->firstRow;
+    }
+    success[i] = TRUE;
+  }
+  return TRUE;
+}
+}
+
+struct GeometryRasterizer::ThreadStruct
+{
+  const GeometryRasterizer* rasterizer;
+  unsigned char*            buffer;
+  GDALDataType              dataType;
+  unsigned int              nbComponents;
+  unsigned int              width;
+  unsigned int              height;
+  double                    geoTransform[6];
+  double                    invGeoTransform[6];
+  const std::vector<int>*   bands;
+  const double*             background;
+};
+
+GeometryRasterizer::GeometryRasterizer() : m_NumberOfBands(1), m_AllTouched(false), m_NumberOfThreads(1), m_IndexUpToDate(false)
+{
+}
+
+GeometryRasterizer::~GeometryRasterizer()
+{
+  Clear();
+}
+
+void GeometryRasterizer::Clear()
+{
+  for (std::vector<OGRGeometryH>::iterator it = m_Geometries.begin(); it != m_Geometries.end(); ++it)
+  {
+    OGR_G_DestroyGeometry(*it);
+  }
+  m_Geometries.clear();
+  m_BurnValues.clear();
+  m_Envelopes.clear();
+  m_Index.Clear();
+  m_IndexUpToDate = false;
+}
+
+void GeometryRasterizer::AddGeometry(OGRGeometryH geometry, const std::vector<double>& burnValues)
+{
+  if (geometry == nullptr || OGR_G_IsEmpty(geometry))
+  {
+    return;
+  }
+
+  OGREnvelope envelope;
+  OGR_G_GetEnvelope(geometry, &envelope);
+
+  m_Geometries.push_back(OGR_G_Clone(geometry));
+  m_Envelopes.push_back(envelope);
+  for (unsigned int band = 0; band < m_NumberOfBands; ++band)
+  {
+    m_BurnValues.push_back(band < burnValues.size() ? burnValues[band] : 0.);
+  }
+  m_IndexUpToDate = false;
+}
+
+bool GeometryRasterizer::AddLayer(OGRLayerH layer, const std::string& burnAttribute, const std::vector<double>& burnValues, const std::string& projectionRef)
+{
+  int burnField = -1;
+  if (!burnAttribute.empty())
+  {
+    burnField = OGR_FD_GetFieldIndex(OGR_L_GetLayerDefn(layer), burnAttribute.c_str());
+    if (burnField == -1)
+    {
+      return false;
+    }
+  }
+
+  // Reprojection to the raster spatial reference, if both are known
+  OGRCoordinateTransformationH transform = nullptr;
+  OGRSpatialReferenceH         layerSRS  = OGR_L_GetSpatialRef(layer);
+  OGRSpatialReferenceH         rasterSRS = nullptr;
+  if (layerSRS != nullptr && !projectionRef.empty())
+  {
+    rasterSRS = OSRNewSpatialReference(projectionRef.c_str());
+    if (rasterSRS != nullptr && !OSRIsSame(layerSRS, rasterSRS))
+    {
+      transform = OCTNewCoordinateTransformation(layerSRS, rasterSRS);
+    }
+  }
+
+  std::vector<double> featureBurnValues(burnValues);
+  OGRFeatureH         feature;
+  OGR_L_ResetReading(layer);
+  while ((feature = OGR_L_GetNextFeature(layer)) != nullptr)
+  {
+    OGRGeometryH geometry = OGR_F_GetGeometryRef(feature);
+    if (geometry == nullptr)
+    {
+      OGR_F_Destroy(feature);
+      continue;
+    }
+
+    if (burnField != -1)
+    {
+      featureBurnValues.assign(m_NumberOfBands, OGR_F_GetFieldAsDouble(feature, burnField));
+    }
+
+    if (transform != nullptr)
+    {
+      OGRGeometryH projected = OGR_G_Clone(geometry);
+      if (OGR_G_Transform(projected, transform) == OGRERR_NONE)
+      {
+        AddGeometry(projected, featureBurnValues);
+      }
+      OGR_G_DestroyGeometry(projected);
+    }
+    else
+    {
+      AddGeometry(geometry, featureBurnValues);
+    }
+
+    OGR_F_Destroy(feature);
+  }
+
+  if (transform != nullptr)
+  {
+    OCTDestroyCoordinateTransformation(transform);
+  }
+  if (rasterSRS != nullptr)
+  {
+    OSRRelease(rasterSRS);
+  }
+  return true;
+}
+
+void GeometryRasterizer::BuildIndex()
+{
+  if (!m_IndexUpToDate)
+  {
+    m_Index.Build(m_Envelopes);
+    m_IndexUpToDate = true;
+  }
+}
+
+void GeometryRasterizer::Rasterize(void* buffer, GDALDataType dataType, unsigned int nbComponents, unsigned int width, unsigned int height,
+                                   const double geoTransform[6], const std::vector<int>& bands, const double* background)
+{
+  if (width == 0 || height == 0 || bands.empty() || bands.size() != m_NumberOfBands)
+  {
+    return;
+  }
+
+  BuildIndex();
+
+  GDALAllRegister();
+
+  ThreadStruct str;
+  str.rasterizer   = this;
+  str.buffer       = static_cast<unsigned char*>(buffer);
+  str.dataType     = dataType;
+  str.nbComponents = nbComponents;
+  str.width        = width;
+  str.height       = height;
+  str.bands        = &bands;
+  str.background   = background;
+  std::copy(geoTransform, geoTransform + 6, str.geoTransform);
+  if (!GDALInvGeoTransform(str.geoTransform, str.invGeoTransform))
+  {
+    return;
+  }
+
+  const unsigned int nbThreads = std::max(1u, std::min(m_NumberOfThreads, height));
+  if (nbThreads == 1)
+  {
+    RasterizeBand(str, 0, height);
+    return;
+  }
+
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(nbThreads);
+  threader->SetSingleMethod(GeometryRasterizer::ThreaderCallback, &str);
+  threader->SingleMethodExecute();
+}
+
+ITK_THREAD_RETURN_TYPE GeometryRasterizer::ThreaderCallback(void* arg)
+{
+  const ThreadStruct* str         = (ThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+  itk::ThreadIdType   threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  itk::ThreadIdType   threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+
+  const unsigned int firstRow = static_cast<unsigned int>((static_cast<unsigned long>(str->height) * threadId) / threadCount);
+  const unsigned int lastRow  = static_cast<unsigned int>((static_cast<unsigned long>(str->height) * (threadId + 1)) / threadCount);
+  if (lastRow > firstRow)
+  {
+    str->rasterizer->RasterizeBand(*str, firstRow, lastRow - firstRow);
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+void GeometryRasterizer::RasterizeBand(const ThreadStruct& str, unsigned int firstRow, unsigned int nbRows) const
+{
+  const size_t pixelSize  = static_cast<size_t>(GDALGetDataTypeSizeBytes(str.dataType));
+  const size_t lineOffset = pixelSize * str.nbComponents * str.width;
+
+  std::ostringstream stream;
+  stream << "MEM:::"
+         << "DATAPOINTER=" << (uintptr_t)(str.buffer + firstRow * lineOffset) << ","
+         << "PIXELS=" << str.width << ","
+         << "LINES=" << nbRows << ","
+         << "BANDS=" << str.nbComponents << ","
+         << "DATATYPE=" << GDALGetDataTypeName(str.dataType) << ","
+         << "PIXELOFFSET=" << pixelSize * str.nbComponents << ","
+         << "LINEOFFSET=" << lineOffset << ","
+         << "BANDOFFSET=" << pixelSize;
+
+  GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
+  if (dataset == nullptr)
+  {
+    return;
+  }
+
+  BandTransformType transform;
+  std::copy(str.geoTransform, str.geoTransform + 6, transform.geoTransform);
+  std::copy(str.invGeoTransform, str.invGeoTransform + 6, transform.invGeoTransform);
+  transform.firstRow = firstRow;
+
+  double bandGeoTransform[6];
+  std::copy(str.geoTransform, str.geoTransform + 6, bandGeoTransform);
+  bandGeoTransform[0] += firstRow * str.geoTransform[2];
+  bandGeoTransform[3] += firstRow * str.geoTransform[5];
+  GDALSetGeoTransform(dataset, bandGeoTransform);
+
+  const std::vector<int>& bands = *str.bands;
+  if (str.background != nullptr)
+  {
+    for (unsigned int band = 0; band < bands.size(); ++band)
+    {
+      GDALFillRaster(GDALGetRasterBand(dataset, bands[band]), str.background[band], 0);
+    }
+  }
+
+  // Geometries touching the band, with a margin of one pixel
+  OGREnvelope window;
+  const double corners[4][2] = {{0., -1.}, {static_cast<double>(str.width), -1.}, {0., nbRows + 1.}, {static_cast<double>(str.width), nbRows + 1.}};
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    double x = corners[i][0], y = corners[i][1];
+    int    success;
+    BandTransform(&transform, TRUE, 1, &x, &y, nullptr, &success);
+    if (i == 0)
+    {
+      window.MinX = window.MaxX = x;
+      window.MinY = window.MaxY = y;
+    }
+    window.MinX = std::min(window.MinX, x);
+    window.MaxX = std::max(window.MaxX, x);
+    window.MinY = std::min(window.MinY, y);
+    window.MaxY = std::max(window.MaxY, y);
+  }
+  const double marginX = std::abs(str.geoTransform[1]) + std::abs(str.geoTransform[2]);
+  const double marginY = std::abs(str.geoTransform[4]) + std::abs(str.geoTransform[5]);
+  window.MinX -= marginX;
+  window.MaxX += marginX;
+  window.MinY -= marginY;
+  window.MaxY += marginY;
+
+  std::vector<unsigned int> items;
+  m_Index.Query(window, items);
+
+  if (!items.empty())
+  {
+    std::vector<OGRGeometryH> geometries(items.size());
+    std::vector<double>       burnValues(items.size() * m_NumberOfBands);
+    for (unsigned int i = 0; i < items.size(); ++i)
+    {
+      geometries[i] = m_Geometries[items[i]];
+      std::copy(m_BurnValues.begin() + static_cast<size_t>(items[i]) * m_NumberOfBands,
+                m_BurnValues.begin() + static_cast<size_t>(items[i] + 1) * m_NumberOfBands, burnValues.begin() + static_cast<size_t>(i) * m_NumberOfBands);
+    }
+
+    char** options = nullptr;
+    if (m_AllTouched)
+    {
+      options = CSLSetNameValue(options, "ALL_TOUCHED", "TRUE");
+    }
+
+    GDALRasterizeGeometries(dataset, static_cast<int>(bands.size()), const_cast<int*>(&bands[0]), static_cast<int>(geometries.size()), &geometries[0],
+                            BandTransform, &transform, &burnValues[0], options, GDALDummyProgress, nullptr);
+
+    CSLDestroy(options);
+  }
+
+  GDALClose(dataset);
+}
+
+} // end namespace otb
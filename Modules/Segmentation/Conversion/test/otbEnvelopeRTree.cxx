@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include "otbEnvelopeRTree.h"
+#include <iostream>
+#include <random>
+
+int otbEnvelopeRTree(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // Integer coordinates produce many envelopes touching the query windows
+  // exactly on their border, which must be reported
+  std::mt19937                       generator(42);
+  std::uniform_int_distribution<int> position(0, 999);
+  std::uniform_int_distribution<int> extent(0, 30);
+
+  unsigned int nbErrors = 0;
+
+  for (unsigned int nbItems : {0u, 1u, 5u, 16u, 17u, 300u, 5000u})
+  {
+    std::vector<OGREnvelope> envelopes(nbItems);
+    for (auto& envelope : envelopes)
+    {
+      envelope.MinX = position(generator);
+      envelope.MaxX = envelope.MinX + extent(generator);
+      envelope.MinY = position(generator);
+      envelope.MaxY = envelope.MinY + extent(generator);
+    }
+
+    otb::EnvelopeRTree tree;
+    tree.Build(envelopes);
+    if (tree.GetNumberOfItems() != nbItems)
+    {
+      std::cout << "Wrong number of items: " << tree.GetNumberOfItems() << ", expected " << nbItems << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::vector<unsigned int> items;
+    for (unsigned int q = 0; q < 200; ++q)
+    {
+      OGREnvelope window;
+      window.MinX = position(generator);
+      window.MaxX = window.MinX + 3 * extent(generator);
+      window.MinY = position(generator);
+      window.MaxY = window.MinY + 3 * extent(generator);
+
+      tree.Query(window, items);
+
+      // Brute force search
+      std::vector<unsigned int> expected;
+      for (unsigned int i = 0; i < nbItems; ++i)
+      {
+        const OGREnvelope& e = envelopes[i];
+        if (e.MinX <= window.MaxX && e.MaxX >= window.MinX && e.MinY <= window.MaxY && e.MaxY >= window.MinY)
+        {
+          expected.push_back(i);
+        }
+      }
+
+      if (items != expected)
+      {
+        if (nbErrors < 10)
+        {
+          std::cout << "Query " << q << " (" << nbItems << " items): got " << items.size() << " items, expected " << expected.size() << std::endl;
+        }
+        ++nbErrors;
+      }
+    }
+  }
+
+  if (nbErrors > 0)
+  {
+    std::cout << nbErrors << " wrong queries" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
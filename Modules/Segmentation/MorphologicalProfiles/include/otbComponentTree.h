@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComponentTree_h
+#define otbComponentTree_h
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace otb
+{
+/** \class ComponentTree
+ *  \brief Max-tree (or min-tree) of a 2D image.
+ *
+ * The nodes of the tree are the connected components of the upper level sets
+ * \f$ \{f \geq t\} \f$ of the image (lower level sets for a min-tree, selected with
+ * TCompare = std::less). The tree is built once, with the union-find
+ * algorithm of Berger et al. over the pixels sorted by value, the sort being
+ * split among several threads.
+ *
+ * Once built, the connected operators are computed by linear walks over the
+ * nodes, which are stored in topological order (a parent always comes before
+ * its children):
+ * - Reconstruct() computes the reconstruction by dilation (erosion for a
+ * min-tree) of a marker under the image, that is the second step of an
+ * opening (closing) by reconstruction,
+ * - FilterByAttribute() keeps the nodes whose attribute reaches a threshold,
+ * which is an area opening (closing) with the node areas of GetNodeAreas().
+ *
+ * These methods are const and allocate their own buffers, so that several
+ * levels of a profile can be computed concurrently from the same tree.
+ *
+ * \sa ReconstructionProfileFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TValue, class TCompare = std::greater<TValue>>
+class ComponentTree
+{
+public:
+  typedef TValue       ValueType;
+  typedef TCompare     CompareType;
+  typedef unsigned int IndexType;
+
+  ComponentTree();
+
+  /** Build the tree of a row-major width x height buffer, with 8-connectivity
+   * if fullyConnected is true, 4-connectivity otherwise */
+  void Build(const ValueType* values, unsigned int width, unsigned int height, bool fullyConnected, unsigned int numberOfThreads = 1);
+
+  /** Remove all the nodes */
+  void Clear();
+
+  size_t GetNumberOfPixels() const
+  {
+    return m_PixelNode.size();
+  }
+
+  size_t GetNumberOfNodes() const
+  {
+    return m_NodeLevel.size();
+  }
+
+  /** Node of each pixel */
+  const std::vector<IndexType>& GetPixelNodes() const
+  {
+    return m_PixelNode;
+  }
+
+  /** Parent of each node, the root (node 0) being its own parent */
+  const std::vector<IndexType>& GetNodeParents() const
+  {
+    return m_NodeParent;
+  }
+
+  /** Grey level of each node */
+  const std::vector<ValueType>& GetNodeLevels() const
+  {
+    return m_NodeLevel;
+  }
+
+  /** Number of pixels of each node, including its descendants */
+  const std::vector<IndexType>& GetNodeAreas() const
+  {
+    return m_NodeArea;
+  }
+
+  /** Reconstruction of the marker under the image of the tree. marker and
+   * output are row-major buffers of GetNumberOfPixels() values, and may be
+   * the same buffer. */
+  template <class TMarker, class TOutput>
+  void Reconstruct(const TMarker* marker, TOutput* output) const;
+
+  /** Replace each pixel by the level of the smallest node containing it
+   * whose attribute is at least threshold. The attribute must not increase
+   * from a node to its children, the root is always kept. */
+  template <class TAttribute, class TOutput>
+  void FilterByAttribute(const std::vector<TAttribute>& attribute, TAttribute threshold, TOutput* output) const;
+
+private:
+  /** Root of the union-find set of pixel, with path halving */
+  static IndexType FindRoot(std::vector<IndexType>& zpar, IndexType pixel);
+
+  /** Sort the pixels from the bottom to the top of the tree, ties being
+   * sorted by pixel index */
+  void SortPixels(const ValueType* values, std::vector<IndexType>& order, unsigned int numberOfThreads) const;
+
+  /** Write the value of the node of each pixel */
+  template <class TOutput>
+  void WritePixels(const std::vector<ValueType>& nodeValues, TOutput* output) const;
+
+  CompareType m_Compare;
+
+  std::vector<IndexType> m_PixelNode;
+  std::vector<IndexType> m_NodeParent;
+  std::vector<ValueType> m_NodeLevel;
+  std::vector<IndexType> m_NodeArea;
+};
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbComponentTree.hxx"
+#endif
+
+#endif
@@ -0,0 +1,332 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComponentTree_hxx
+#define otbComponentTree_hxx
+
+#include "otbComponentTree.h"
+#include "itkMacro.h"
+#include "itkMultiThreader.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace otb
+{
+namespace internal
+{
+/** Order of the pixels from the bottom to the top of a component tree */
+template <class TValue, class TCompare>
+struct ComponentTreePixelOrder
+{
+  const TValue* values;
+  TCompare      compare;
+
+  bool operator()(unsigned int a, unsigned int b) const
+  {
+    if (compare(values[b], values[a]))
+    {
+      return true;
+    }
+    return !compare(values[a], values[b]) && a < b;
+  }
+};
+
+/** Chunks of pixels sorted by each thread */
+template <class TValue, class TCompare>
+struct ComponentTreeSortStruct
+{
+  ComponentTreePixelOrder<TValue, TCompare> order;
+  unsigned int*                             pixels;
+  std::vector<size_t>                       bounds;
+};
+
+template <class TValue, class TCompare>
+ITK_THREAD_RETURN_TYPE ComponentTreeSortCallback(void* arg)
+{
+  typedef ComponentTreeSortStruct<TValue, TCompare> SortStructType;
+  const SortStructType* str      = (SortStructType*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+  itk::ThreadIdType     threadId = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+
+  if (threadId + 1 < str->bounds.size())
+  {
+    std::sort(str->pixels + str->bounds[threadId], str->pixels + str->bounds[threadId + 1], str->order);
+  }
+  return ITK_THREAD_RETURN_VALUE;
+}
+} // End namespace internal
+
+template <class TValue, class TCompare>
+ComponentTree<TValue, TCompare>::ComponentTree()
+{
+}
+
+template <class TValue, class TCompare>
+void ComponentTree<TValue, TCompare>::Clear()
+{
+  m_PixelNode.clear();
+  m_NodeParent.clear();
+  m_NodeLevel.clear();
+  m_NodeArea.clear();
+}
+
+template <class TValue, class TCompare>
+typename ComponentTree<TValue, TCompare>::IndexType ComponentTree<TValue, TCompare>::FindRoot(std::vector<IndexType>& zpar, IndexType pixel)
+{
+  while (zpar[pixel] != pixel)
+  {
+    zpar[pixel] = zpar[zpar[pixel]];
+    pixel       = zpar[pixel];
+  }
+  return pixel;
+}
+
+template <class TValue, class TCompare>
+void ComponentTree<TValue, TCompare>::SortPixels(const ValueType* values, std::vector<IndexType>& order, unsigned int numberOfThreads) const
+{
+  typedef internal::ComponentTreeSortStruct<TValue, TCompare> SortStructType;
+
+  SortStructType str;
+  str.order.values  = values;
+  str.order.compare = m_Compare;
+  str.pixels        = &order[0];
+
+  // Small chunks are not worth a thread
+  const size_t minChunkSize = 65536;
+  const size_t nbChunks     = std::max<size_t>(1, std::min<size_t>(numberOfThreads, order.size() / minChunkSize));
+  for (size_t chunk = 0; chunk <= nbChunks; ++chunk)
+  {
+    str.bounds.push_back(order.size() * chunk / nbChunks);
+  }
+
+  if (nbChunks == 1)
+  {
+    std::sort(order.begin(), order.end(), str.order);
+    return;
+  }
+
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(static_cast<itk::ThreadIdType>(nbChunks));
+  threader->SetSingleMethod(internal::ComponentTreeSortCallback<TValue, TCompare>, &str);
+  threader->SingleMethodExecute();
+
+  // Merge the sorted chunks two by two
+  for (size_t width = 1; width < nbChunks; width *= 2)
+  {
+    for (size_t chunk = 0; chunk + width < nbChunks; chunk += 2 * width)
+    {
+      const size_t last = std::min(chunk + 2 * width, nbChunks);
+      std::inplace_merge(order.begin() + str.bounds[chunk], order.begin() + str.bounds[chunk + width], order.begin() + str.bounds[last], str.order);
+    }
+  }
+}
+
+template <class TValue, class TCompare>
+void ComponentTree<TValue, TCompare>::Build(const ValueType* values, unsigned int width, unsigned int height, bool fullyConnected, unsigned int numberOfThreads)
+{
+  this->Clear();
+
+  const size_t nbPixels = static_cast<size_t>(width) * height;
+  if (nbPixels == 0)
+  {
+    return;
+  }
+  if (nbPixels >= static_cast<size_t>(std::numeric_limits<IndexType>::max()))
+  {
+    itkGenericExceptionMacro(<< "Image too large for a component tree: " << nbPixels << " pixels");
+  }
+
+  std::vector<IndexType> order(nbPixels);
+  std::iota(order.begin(), order.end(), 0);
+  this->SortPixels(values, order, numberOfThreads);
+
+  // Union-find from the top to the bottom of the tree: each pixel becomes the
+  // parent of the roots of its already processed neighbors
+  const IndexType        unprocessed = std::numeric_limits<IndexType>::max();
+  std::vector<IndexType> parent(nbPixels);
+  std::vector<IndexType> zpar(nbPixels, unprocessed);
+
+  const int          offsetX[8]   = {-1, 1, 0, 0, -1, 1, -1, 1};
+  const int          offsetY[8]   = {0, 0, -1, 1, -1, -1, 1, 1};
+  const unsigned int nbNeighbors  = fullyConnected ? 8 : 4;
+  const long         signedWidth  = static_cast<long>(width);
+  const long         signedHeight = static_cast<long>(height);
+
+  for (size_t i = nbPixels; i-- > 0;)
+  {
+    const IndexType pixel = order[i];
+    const long      x     = static_cast<long>(pixel % width);
+    const long      y     = static_cast<long>(pixel / width);
+    parent[pixel]         = pixel;
+    zpar[pixel]           = pixel;
+
+    for (unsigned int k = 0; k < nbNeighbors; ++k)
+    {
+      const long nx = x + offsetX[k];
+      const long ny = y + offsetY[k];
+      if (nx < 0 || ny < 0 || nx >= signedWidth || ny >= signedHeight)
+      {
+        continue;
+      }
+      const IndexType neighbor = static_cast<IndexType>(ny * signedWidth + nx);
+      if (zpar[neighbor] == unprocessed)
+      {
+        continue;
+      }
+      const IndexType root = FindRoot(zpar, neighbor);
+      if (root != pixel)
+      {
+        parent[root] = pixel;
+        zpar[root]   = pixel;
+      }
+    }
+  }
+  zpar = std::vector<IndexType>();
+
+  // Canonize: the parent of each pixel becomes the representative of its node
+  for (size_t i = 0; i < nbPixels; ++i)
+  {
+    const IndexType pixel = order[i];
+    const IndexType q     = parent[pixel];
+    if (values[parent[q]] == values[q])
+    {
+      parent[pixel] = parent[q];
+    }
+  }
+
+  // Number the nodes in the pixel order, parents first
+  m_PixelNode.resize(nbPixels);
+  for (size_t i = 0; i < nbPixels; ++i)
+  {
+    const IndexType pixel = order[i];
+    const IndexType q     = parent[pixel];
+    if (q == pixel || !(values[q] == values[pixel]))
+    {
+      const IndexType node = static_cast<IndexType>(m_NodeLevel.size());
+      m_NodeParent.push_back(q == pixel ? node : m_PixelNode[q]);
+      m_NodeLevel.push_back(values[pixel]);
+      m_NodeArea.push_back(0);
+      m_PixelNode[pixel] = node;
+    }
+    else
+    {
+      m_PixelNode[pixel] = m_PixelNode[q];
+    }
+    ++m_NodeArea[m_PixelNode[pixel]];
+  }
+
+  for (size_t node = m_NodeArea.size() - 1; node > 0; --node)
+  {
+    m_NodeArea[m_NodeParent[node]] += m_NodeArea[node];
+  }
+}
+
+template <class TValue, class TCompare>
+template <class TOutput>
+void ComponentTree<TValue, TCompare>::WritePixels(const std::vector<ValueType>& nodeValues, TOutput* output) const
+{
+  const size_t nbPixels = m_PixelNode.size();
+  for (size_t pixel = 0; pixel < nbPixels; ++pixel)
+  {
+    output[pixel] = static_cast<TOutput>(nodeValues[m_PixelNode[pixel]]);
+  }
+}
+
+template <class TValue, class TCompare>
+template <class TMarker, class TOutput>
+void ComponentTree<TValue, TCompare>::Reconstruct(const TMarker* marker, TOutput* output) const
+{
+  const size_t nbPixels = m_PixelNode.size();
+  const size_t nbNodes  = m_NodeLevel.size();
+  if (nbNodes == 0)
+  {
+    return;
+  }
+
+  // Highest marker value of each node, then of each subtree
+  std::vector<ValueType> nodeValues(nbNodes);
+  std::vector<char>      hasMarker(nbNodes, 0);
+  for (size_t pixel = 0; pixel < nbPixels; ++pixel)
+  {
+    const IndexType node  = m_PixelNode[pixel];
+    const ValueType value = static_cast<ValueType>(marker[pixel]);
+    if (!hasMarker[node] || m_Compare(value, nodeValues[node]))
+    {
+      nodeValues[node] = value;
+      hasMarker[node]  = 1;
+    }
+  }
+  for (size_t node = nbNodes - 1; node > 0; --node)
+  {
+    const IndexType parent = m_NodeParent[node];
+    if (m_Compare(nodeValues[node], nodeValues[parent]))
+    {
+      nodeValues[parent] = nodeValues[node];
+    }
+  }
+
+  // A node reached by the marker above the level of its parent is
+  // reconstructed up to min(level, marker), other nodes take the value of
+  // their parent. Parents come first, so the values can be replaced in place.
+  if (m_Compare(nodeValues[0], m_NodeLevel[0]))
+  {
+    nodeValues[0] = m_NodeLevel[0];
+  }
+  for (size_t node = 1; node < nbNodes; ++node)
+  {
+    const IndexType parent = m_NodeParent[node];
+    if (m_Compare(nodeValues[node], m_NodeLevel[parent]))
+    {
+      if (m_Compare(nodeValues[node], m_NodeLevel[node]))
+      {
+        nodeValues[node] = m_NodeLevel[node];
+      }
+    }
+    else
+    {
+      nodeValues[node] = nodeValues[parent];
+    }
+  }
+
+  this->WritePixels(nodeValues, output);
+}
+
+template <class TValue, class TCompare>
+template <class TAttribute, class TOutput>
+void ComponentTree<TValue, TCompare>::FilterByAttribute(const std::vector<TAttribute>& attribute, TAttribute threshold, TOutput* output) const
+{
+  const size_t nbNodes = m_NodeLevel.size();
+  if (nbNodes == 0)
+  {
+    return;
+  }
+
+  std::vector<ValueType> nodeValues(nbNodes);
+  nodeValues[0] = m_NodeLevel[0];
+  for (size_t node = 1; node < nbNodes; ++node)
+  {
+    nodeValues[node] = attribute[node] >= threshold ? m_NodeLevel[node] : nodeValues[m_NodeParent[node]];
+  }
+
+  this->WritePixels(nodeValues, output);
+}
+} // End namespace otb
+
+#endif
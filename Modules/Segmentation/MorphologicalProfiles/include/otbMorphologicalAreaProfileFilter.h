@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMorphologicalAreaProfileFilter_h
+#define otbMorphologicalAreaProfileFilter_h
+
+#include "otbImageToImageListFilter.h"
+#include "otbComponentTree.h"
+#include "itkMultiThreader.h"
+
+namespace otb
+{
+/** \class MorphologicalAreaProfileFilter
+ *  \brief This filter computes the area opening (or closing) profile.
+ *
+ * The area opening of size \f$ N \f$ removes the bright connected structures of
+ * less than \f$ N \f$ pixels, whatever their shape. The profile is the set of area
+ * openings for the sizes \f$ n_{i} = InitialValue + i \times Step \f$, for \f$ i \f$ in
+ * [0, ProfileSize[. With TCompare = std::less, the dark structures are removed
+ * instead, which gives the area closing profile.
+ *
+ * The max-tree (min-tree) of the input image is built once, then each level
+ * of the profile is a linear walk over the tree nodes, the levels being
+ * computed concurrently. Areas are counted in pixels, and the result is the
+ * one of itk::AreaOpeningImageFilter (itk::AreaClosingImageFilter) without
+ * image spacing.
+ *
+ * \sa ComponentTree
+ * \sa MorphologicalOpeningProfileFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage, class TCompare = std::greater<typename TInputImage::PixelType>>
+class ITK_EXPORT MorphologicalAreaProfileFilter : public ImageToImageListFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef MorphologicalAreaProfileFilter                    Self;
+  typedef ImageToImageListFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>                           Pointer;
+  typedef itk::SmartPointer<const Self>                     ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(MorphologicalAreaProfileFilter, ImageToImageListFilter);
+
+  /** Template parameters typedefs */
+  typedef TInputImage                              InputImageType;
+  typedef TOutputImage                             OutputImageType;
+  typedef typename InputImageType::PixelType       InputPixelType;
+  typedef typename InputImageType::RegionType      InputImageRegionType;
+  typedef typename Superclass::InputImagePointer   InputImagePointerType;
+  typedef typename Superclass::OutputImageListType OutputImageListType;
+  typedef typename OutputImageListType::Pointer    OutputImageListPointerType;
+  typedef ComponentTree<InputPixelType, TCompare>  ComponentTreeType;
+  typedef typename ComponentTreeType::IndexType    AreaType;
+
+  /** Get/Set the smallest area of the profile, in pixels */
+  itkSetMacro(InitialValue, AreaType);
+  itkGetMacro(InitialValue, AreaType);
+  /** Get/Set the profile size */
+  itkSetMacro(ProfileSize, unsigned int);
+  itkGetMacro(ProfileSize, unsigned int);
+  /** Get/Set the profile step, in pixels */
+  itkSetMacro(Step, AreaType);
+  itkGetMacro(Step, AreaType);
+  /** Use 8-connectivity instead of 4-connectivity */
+  itkSetMacro(FullyConnected, bool);
+  itkGetConstMacro(FullyConnected, bool);
+  itkBooleanMacro(FullyConnected);
+
+protected:
+  /** GenerateData method */
+  void GenerateData(void) override;
+  /** GenerateOutputInformation method */
+  void GenerateOutputInformation(void) override;
+  /** Generate input requested region */
+  void GenerateInputRequestedRegion(void) override;
+  /** Constructor */
+  MorphologicalAreaProfileFilter();
+  /** Destructor */
+  ~MorphologicalAreaProfileFilter() override
+  {
+  }
+  /**PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  MorphologicalAreaProfileFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Data shared by the threads */
+  struct FilterStruct
+  {
+    const ComponentTreeType* tree;
+    OutputImageListType*     outputs;
+    std::vector<AreaType>    areas;
+  };
+
+  static ITK_THREAD_RETURN_TYPE FilterThreaderCallback(void* arg);
+
+  /** The profile parameters */
+  unsigned int m_ProfileSize;
+  /** Initial value */
+  AreaType m_InitialValue;
+  /** Step */
+  AreaType m_Step;
+  /** Connectivity */
+  bool m_FullyConnected;
+};
+} // End namespace otb
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbMorphologicalAreaProfileFilter.hxx"
+#endif
+
+#endif
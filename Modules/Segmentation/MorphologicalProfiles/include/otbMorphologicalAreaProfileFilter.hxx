@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMorphologicalAreaProfileFilter_hxx
+#define otbMorphologicalAreaProfileFilter_hxx
+
+#include "otbMorphologicalAreaProfileFilter.h"
+#include <algorithm>
+
+namespace otb
+{
+/**
+ * Constructor
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+MorphologicalAreaProfileFilter<TInputImage, TOutputImage, TCompare>::MorphologicalAreaProfileFilter()
+{
+  m_InitialValue   = 1;
+  m_Step           = 1;
+  m_ProfileSize    = 10;
+  m_FullyConnected = false;
+}
+/**
+ * GenerateOutputInformation method
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void MorphologicalAreaProfileFilter<TInputImage, TOutputImage, TCompare>::GenerateOutputInformation(void)
+{
+  // Retrieving input/output pointers
+  InputImagePointerType      inputPtr  = this->GetInput();
+  OutputImageListPointerType outputPtr = this->GetOutput();
+  if (outputPtr && inputPtr)
+  {
+    if (outputPtr->Size() != m_ProfileSize)
+    {
+      // in this case, clear the list
+      outputPtr->Clear();
+      for (unsigned int i = 0; i < m_ProfileSize; ++i)
+      {
+        // Create the output image
+        outputPtr->PushBack(OutputImageType::New());
+      }
+    }
+    // For each output image
+    typename OutputImageListType::Iterator outputListIt = outputPtr->Begin();
+    while (outputListIt != outputPtr->End())
+    {
+      // Set the image information
+      outputListIt.Get()->CopyInformation(inputPtr);
+      outputListIt.Get()->SetLargestPossibleRegion(inputPtr->GetLargestPossibleRegion());
+      ++outputListIt;
+    }
+  }
+}
+/**
+ * Generate input requested region
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void MorphologicalAreaProfileFilter<TInputImage, TOutputImage, TCompare>::GenerateInputRequestedRegion(void)
+{
+  // The tree is built over the whole image
+  InputImageType* inputPtr = this->GetInput();
+  if (inputPtr)
+  {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+/**
+ * GenerateData method
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void MorphologicalAreaProfileFilter<TInputImage, TOutputImage, TCompare>::GenerateData(void)
+{
+  // Retrieving input/output pointers
+  InputImagePointerType      inputPtr  = this->GetInput();
+  OutputImageListPointerType outputPtr = this->GetOutput();
+
+  if (InputImageType::ImageDimension != 2)
+  {
+    itkExceptionMacro(<< "The area profile is only available for 2D images");
+  }
+
+  const InputImageRegionType region    = inputPtr->GetBufferedRegion();
+  const unsigned int         nbThreads = std::max(1u, static_cast<unsigned int>(this->GetNumberOfThreads()));
+
+  ComponentTreeType tree;
+  tree.Build(inputPtr->GetBufferPointer(), region.GetSize(0), region.GetSize(1), m_FullyConnected, nbThreads);
+
+  FilterStruct str;
+  str.tree    = &tree;
+  str.outputs = outputPtr;
+  for (unsigned int i = 0; i < m_ProfileSize; ++i)
+  {
+    typename OutputImageType::Pointer output = outputPtr->GetNthElement(i);
+    output->SetRequestedRegion(region);
+    output->SetBufferedRegion(region);
+    output->Allocate();
+    str.areas.push_back(m_InitialValue + static_cast<AreaType>(i) * m_Step);
+  }
+
+  this->GetMultiThreader()->SetNumberOfThreads(std::min(nbThreads, std::max(1u, m_ProfileSize)));
+  this->GetMultiThreader()->SetSingleMethod(Self::FilterThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
+}
+
+template <class TInputImage, class TOutputImage, class TCompare>
+ITK_THREAD_RETURN_TYPE MorphologicalAreaProfileFilter<TInputImage, TOutputImage, TCompare>::FilterThreaderCallback(void* arg)
+{
+  const FilterStruct* str         = (FilterStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+  itk::ThreadIdType   threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  itk::ThreadIdType   threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+
+  // One level after the other, the node areas being shared by all levels
+  for (size_t i = threadId; i < str->areas.size(); i += threadCount)
+  {
+    str->tree->FilterByAttribute(str->tree->GetNodeAreas(), str->areas[i], str->outputs->GetNthElement(i)->GetBufferPointer());
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+/**
+ * PrintSelf Method
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void MorphologicalAreaProfileFilter<TInputImage, TOutputImage, TCompare>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ProfileSize: " << m_ProfileSize << std::endl;
+  os << indent << "InitialValue: " << m_InitialValue << std::endl;
+  os << indent << "Step: " << m_Step << std::endl;
+  os << indent << "FullyConnected: " << m_FullyConnected << std::endl;
+}
+} // End namespace otb
+#endif
@@ -21,8 +21,9 @@
 #ifndef otbMorphologicalClosingProfileFilter_h
 #define otbMorphologicalClosingProfileFilter_h
 
-#include "otbImageToProfileFilter.h"
+#include "otbReconstructionProfileFilter.h"
 #include "itkClosingByReconstructionImageFilter.h"
+#include "itkGrayscaleDilateImageFilter.h"
 
 namespace otb
 {
@@ -43,20 +44,24 @@ namespace otb
  * For more information on profiles please refer to the documentation of the otb::ImageToProfileFilter
  * class.
  *
+ * The tree based computation of ReconstructionProfileFilter is used by default.
+ *
  * \sa ImageToProfileFilter
+ * \sa ReconstructionProfileFilter
  * \sa itk::ClosingByReconstructionImageFilter
  *
  * \ingroup OTBMorphologicalProfiles
  */
 template <class TInputImage, class TOutputImage, class TStructuringElement>
 class ITK_EXPORT MorphologicalClosingProfileFilter
-    : public ImageToProfileFilter<TInputImage, TOutputImage, itk::ClosingByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>,
-                                  unsigned int>
+    : public ReconstructionProfileFilter<TInputImage, TOutputImage, itk::ClosingByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>,
+                                         itk::GrayscaleDilateImageFilter<TInputImage, TInputImage, TStructuringElement>, std::less<typename TInputImage::PixelType>>
 {
 public:
   /** Standard typedefs */
   typedef MorphologicalClosingProfileFilter Self;
-  typedef ImageToProfileFilter<TInputImage, TOutputImage, itk::ClosingByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>, unsigned int>
+  typedef ReconstructionProfileFilter<TInputImage, TOutputImage, itk::ClosingByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>,
+                                      itk::GrayscaleDilateImageFilter<TInputImage, TInputImage, TStructuringElement>, std::less<typename TInputImage::PixelType>>
                                         Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
@@ -65,7 +70,7 @@ public:
   itkNewMacro(Self);
 
   /** Creation through object factory macro */
-  itkTypeMacro(MorphologicalClosingProfileFilter, ImageToProfileFilter);
+  itkTypeMacro(MorphologicalClosingProfileFilter, ReconstructionProfileFilter);
 
   typedef TStructuringElement                StructuringElementType;
   typedef typename Superclass::ParameterType ParameterType;
@@ -21,8 +21,9 @@
 #ifndef otbMorphologicalOpeningProfileFilter_h
 #define otbMorphologicalOpeningProfileFilter_h
 
-#include "otbImageToProfileFilter.h"
+#include "otbReconstructionProfileFilter.h"
 #include "itkOpeningByReconstructionImageFilter.h"
+#include "itkGrayscaleErodeImageFilter.h"
 
 namespace otb
 {
@@ -43,20 +44,24 @@ namespace otb
  * For more information on profiles please refer to the documentation of the otb::ImageToProfileFilter
  * class.
  *
+ * The tree based computation of ReconstructionProfileFilter is used by default.
+ *
  * \sa ImageToProfileFilter
+ * \sa ReconstructionProfileFilter
  * \sa itk::OpeningByReconstructionImageFilter
  *
  * \ingroup OTBMorphologicalProfiles
  */
 template <class TInputImage, class TOutputImage, class TStructuringElement>
 class ITK_EXPORT MorphologicalOpeningProfileFilter
-    : public ImageToProfileFilter<TInputImage, TOutputImage, itk::OpeningByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>,
-                                  unsigned int>
+    : public ReconstructionProfileFilter<TInputImage, TOutputImage, itk::OpeningByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>,
+                                         itk::GrayscaleErodeImageFilter<TInputImage, TInputImage, TStructuringElement>, std::greater<typename TInputImage::PixelType>>
 {
 public:
   /** Standard typedefs */
   typedef MorphologicalOpeningProfileFilter Self;
-  typedef ImageToProfileFilter<TInputImage, TOutputImage, itk::OpeningByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>, unsigned int>
+  typedef ReconstructionProfileFilter<TInputImage, TOutputImage, itk::OpeningByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>,
+                                      itk::GrayscaleErodeImageFilter<TInputImage, TInputImage, TStructuringElement>, std::greater<typename TInputImage::PixelType>>
                                         Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
@@ -65,7 +70,7 @@ public:
   itkNewMacro(Self);
 
   /** Creation through object factory macro */
-  itkTypeMacro(MorphologicalOpeningProfileFilter, ImageToProfileFilter);
+  itkTypeMacro(MorphologicalOpeningProfileFilter, ReconstructionProfileFilter);
 
   typedef TStructuringElement                StructuringElementType;
   typedef typename Superclass::ParameterType ParameterType;
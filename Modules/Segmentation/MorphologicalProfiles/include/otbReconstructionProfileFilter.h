@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbReconstructionProfileFilter_h
+#define otbReconstructionProfileFilter_h
+
+#include "otbImageToProfileFilter.h"
+#include "otbComponentTree.h"
+#include "itkMultiThreader.h"
+
+namespace otb
+{
+/** \class ReconstructionProfileFilter
+ *  \brief Base class of the opening and closing by reconstruction profiles.
+ *
+ * An opening (closing) by reconstruction is the reconstruction by dilation
+ * (erosion) under the input image of the erosion (dilation) of the input
+ * image by a structuring element. The reconstruction is a connected operator:
+ * for every level of the profile, it only depends on the max-tree (min-tree)
+ * of the input image and on the marker.
+ *
+ * When UseComponentTree is on (the default), the tree of the input image is
+ * built once. For each level, only the marker is computed with TMarkerFilter
+ * and the reconstruction is a linear walk over the tree, several levels being
+ * reconstructed concurrently. The result is the same as the one of TFilter.
+ *
+ * TFilter is still used for images whose dimension is not 2, or when
+ * PreserveIntensities is on.
+ *
+ * \sa ComponentTree
+ * \sa MorphologicalOpeningProfileFilter
+ * \sa MorphologicalClosingProfileFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage, class TFilter, class TMarkerFilter, class TCompare>
+class ITK_EXPORT ReconstructionProfileFilter : public ImageToProfileFilter<TInputImage, TOutputImage, TFilter, unsigned int>
+{
+public:
+  /** Standard typedefs */
+  typedef ReconstructionProfileFilter                                            Self;
+  typedef ImageToProfileFilter<TInputImage, TOutputImage, TFilter, unsigned int> Superclass;
+  typedef itk::SmartPointer<Self>                                                Pointer;
+  typedef itk::SmartPointer<const Self>                                          ConstPointer;
+
+  /** Creation through object factory macro */
+  itkTypeMacro(ReconstructionProfileFilter, ImageToProfileFilter);
+
+  typedef typename Superclass::InputImageType             InputImageType;
+  typedef typename Superclass::OutputImageType            OutputImageType;
+  typedef typename Superclass::ParameterType              ParameterType;
+  typedef typename Superclass::InputImagePointerType      InputImagePointerType;
+  typedef typename Superclass::OutputImageListPointerType OutputImageListPointerType;
+  typedef typename InputImageType::RegionType             InputImageRegionType;
+  typedef typename InputImageType::PixelType              InputPixelType;
+  typedef TMarkerFilter                                   MarkerFilterType;
+  typedef ComponentTree<InputPixelType, TCompare>         ComponentTreeType;
+
+  /** Use a component tree of the input image for the reconstructions */
+  itkSetMacro(UseComponentTree, bool);
+  itkGetConstMacro(UseComponentTree, bool);
+  itkBooleanMacro(UseComponentTree);
+
+protected:
+  /** GenerateData method */
+  void GenerateData(void) override;
+  /** Constructor */
+  ReconstructionProfileFilter();
+  /** Destructor */
+  ~ReconstructionProfileFilter() override
+  {
+  }
+  /**PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ReconstructionProfileFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Markers reconstructed by the threads, one per thread */
+  struct ReconstructStruct
+  {
+    const ComponentTreeType*                       tree;
+    std::vector<typename InputImageType::Pointer>  markers;
+    std::vector<typename OutputImageType::Pointer> outputs;
+  };
+
+  static ITK_THREAD_RETURN_TYPE ReconstructThreaderCallback(void* arg);
+
+  bool m_UseComponentTree;
+};
+} // End namespace otb
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbReconstructionProfileFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbReconstructionProfileFilter_hxx
+#define otbReconstructionProfileFilter_hxx
+
+#include "otbReconstructionProfileFilter.h"
+#include <algorithm>
+
+namespace otb
+{
+/**
+ * Constructor
+ */
+template <class TInputImage, class TOutputImage, class TFilter, class TMarkerFilter, class TCompare>
+ReconstructionProfileFilter<TInputImage, TOutputImage, TFilter, TMarkerFilter, TCompare>::ReconstructionProfileFilter()
+{
+  m_UseComponentTree = true;
+}
+
+/**
+ * GenerateData method
+ */
+template <class TInputImage, class TOutputImage, class TFilter, class TMarkerFilter, class TCompare>
+void ReconstructionProfileFilter<TInputImage, TOutputImage, TFilter, TMarkerFilter, TCompare>::GenerateData(void)
+{
+  // Retrieving input/output pointers
+  InputImagePointerType      inputPtr  = this->GetInput();
+  OutputImageListPointerType outputPtr = this->GetOutput();
+
+  // The reconstruction always processes the whole image
+  const InputImageRegionType region = inputPtr->GetLargestPossibleRegion();
+  if (!m_UseComponentTree || InputImageType::ImageDimension != 2 || this->GetFilter()->GetPreserveIntensities() || inputPtr->GetBufferedRegion() != region)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  const unsigned int nbThreads   = std::max(1u, static_cast<unsigned int>(this->GetNumberOfThreads()));
+  const unsigned int profileSize = this->GetProfileSize();
+
+  ComponentTreeType tree;
+  tree.Build(inputPtr->GetBufferPointer(), region.GetSize(0), region.GetSize(1), this->GetFilter()->GetFullyConnected(), nbThreads);
+
+  for (unsigned int i = 0; i < profileSize; ++i)
+  {
+    typename OutputImageType::Pointer output = outputPtr->GetNthElement(i);
+    output->SetRequestedRegionToLargestPossibleRegion();
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->Allocate();
+  }
+
+  ReconstructStruct str;
+  str.tree = &tree;
+
+  // Levels are processed by batches of one level per thread, so that at most
+  // nbThreads markers are kept in memory
+  for (unsigned int first = 0; first < profileSize; first += nbThreads)
+  {
+    const unsigned int last = std::min(profileSize, first + nbThreads);
+    str.markers.clear();
+    str.outputs.clear();
+
+    for (unsigned int i = first; i < last; ++i)
+    {
+      this->SetProfileParameter(this->GetInitialValue() + static_cast<ParameterType>(i) * this->GetStep());
+
+      typename MarkerFilterType::Pointer markerFilter = MarkerFilterType::New();
+      markerFilter->SetInput(inputPtr);
+      markerFilter->SetKernel(this->GetFilter()->GetKernel());
+      markerFilter->SetNumberOfThreads(nbThreads);
+      markerFilter->Update();
+
+      str.markers.push_back(markerFilter->GetOutput());
+      str.markers.back()->DisconnectPipeline();
+      str.outputs.push_back(outputPtr->GetNthElement(i));
+    }
+
+    this->GetMultiThreader()->SetNumberOfThreads(last - first);
+    this->GetMultiThreader()->SetSingleMethod(Self::ReconstructThreaderCallback, &str);
+    this->GetMultiThreader()->SingleMethodExecute();
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TFilter, class TMarkerFilter, class TCompare>
+ITK_THREAD_RETURN_TYPE ReconstructionProfileFilter<TInputImage, TOutputImage, TFilter, TMarkerFilter, TCompare>::ReconstructThreaderCallback(void* arg)
+{
+  const ReconstructStruct* str      = (ReconstructStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+  itk::ThreadIdType        threadId = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+
+  if (threadId < str->markers.size())
+  {
+    str->tree->Reconstruct(str->markers[threadId]->GetBufferPointer(), str->outputs[threadId]->GetBufferPointer());
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+/**
+ * PrintSelf Method
+ */
+template <class TInputImage, class TOutputImage, class TFilter, class TMarkerFilter, class TCompare>
+void ReconstructionProfileFilter<TInputImage, TOutputImage, TFilter, TMarkerFilter, TCompare>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseComponentTree: " << m_UseComponentTree << std::endl;
+}
+} // End namespace otb
+#endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMorphologicalAreaProfileFilter.h"
+#include "itkAreaOpeningImageFilter.h"
+#include "itkAreaClosingImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "otbImageFileReader.h"
+#include "otbImage.h"
+
+#include "itkMacro.h"
+#include <iostream>
+
+namespace
+{
+// Compare each level of the profile to the ITK attribute filter
+template <class TProfileFilter, class TReferenceFilter, class TImage>
+bool CheckAreaProfile(TImage* input, unsigned int profileSize, unsigned int initialValue, unsigned int step)
+{
+  typename TProfileFilter::Pointer profileFilter = TProfileFilter::New();
+  profileFilter->SetInput(input);
+  profileFilter->SetProfileSize(profileSize);
+  profileFilter->SetInitialValue(initialValue);
+  profileFilter->SetStep(step);
+  profileFilter->Update();
+
+  bool ok = true;
+  for (unsigned int i = 0; i < profileSize; ++i)
+  {
+    typename TReferenceFilter::Pointer referenceFilter = TReferenceFilter::New();
+    referenceFilter->SetInput(input);
+    referenceFilter->SetLambda(initialValue + i * step);
+    referenceFilter->SetUseImageSpacing(false);
+    referenceFilter->Update();
+
+    itk::ImageRegionConstIterator<TImage> profileIt(profileFilter->GetOutput()->GetNthElement(i), input->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<TImage> refIt(referenceFilter->GetOutput(), input->GetLargestPossibleRegion());
+    unsigned long nbDifferences = 0;
+    for (profileIt.GoToBegin(), refIt.GoToBegin(); !profileIt.IsAtEnd(); ++profileIt, ++refIt)
+    {
+      if (profileIt.Get() != refIt.Get())
+      {
+        ++nbDifferences;
+      }
+    }
+    if (nbDifferences > 0)
+    {
+      std::cerr << referenceFilter->GetNameOfClass() << " level " << i << ": " << nbDifferences << " pixels differ" << std::endl;
+      ok = false;
+    }
+  }
+  return ok;
+}
+}
+
+int otbMorphologicalAreaProfileFilter(int itkNotUsed(argc), char* argv[])
+{
+  const char*        inputFilename = argv[1];
+  const unsigned int profileSize   = atoi(argv[2]);
+  const unsigned int initialValue  = atoi(argv[3]);
+  const unsigned int step          = atoi(argv[4]);
+
+  const unsigned int Dimension = 2;
+  typedef double     PixelType;
+
+  typedef otb::Image<PixelType, Dimension>                                                ImageType;
+  typedef otb::ImageFileReader<ImageType>                                                 ReaderType;
+  typedef otb::MorphologicalAreaProfileFilter<ImageType, ImageType>                       OpeningProfileFilterType;
+  typedef otb::MorphologicalAreaProfileFilter<ImageType, ImageType, std::less<PixelType>> ClosingProfileFilterType;
+  typedef itk::AreaOpeningImageFilter<ImageType, ImageType>                               AreaOpeningFilterType;
+  typedef itk::AreaClosingImageFilter<ImageType, ImageType>                               AreaClosingFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+  reader->Update();
+
+  bool ok = CheckAreaProfile<OpeningProfileFilterType, AreaOpeningFilterType>(reader->GetOutput(), profileSize, initialValue, step);
+  ok      = CheckAreaProfile<ClosingProfileFilterType, AreaClosingFilterType>(reader->GetOutput(), profileSize, initialValue, step) && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
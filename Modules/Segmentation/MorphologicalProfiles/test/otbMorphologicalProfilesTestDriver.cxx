@@ -34,4 +34,6 @@ void RegisterTests()
   REGISTER_TEST(otbProfileDerivativeToMultiScaleCharacteristicsFilter);
   REGISTER_TEST(otbOpeningClosingMorphologicalFilter);
   REGISTER_TEST(otbMorphologicalClosingProfileFilter);
+  REGISTER_TEST(otbReconstructionProfileFilterComponentTree);
+  REGISTER_TEST(otbMorphologicalAreaProfileFilter);
 }
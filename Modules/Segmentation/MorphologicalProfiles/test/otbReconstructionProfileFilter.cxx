@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMorphologicalOpeningProfileFilter.h"
+#include "otbMorphologicalClosingProfileFilter.h"
+#include "itkBinaryBallStructuringElement.h"
+#include "itkImageRegionConstIterator.h"
+#include "otbImageFileReader.h"
+#include "otbImage.h"
+
+#include "itkMacro.h"
+#include <iostream>
+
+namespace
+{
+// Run the profile with and without the component tree, and compare the levels
+template <class TProfileFilter, class TImage>
+bool CheckProfile(TImage* input, unsigned int profileSize, unsigned int initialValue, unsigned int step)
+{
+  typename TProfileFilter::Pointer treeFilter      = TProfileFilter::New();
+  typename TProfileFilter::Pointer referenceFilter = TProfileFilter::New();
+
+  treeFilter->SetInput(input);
+  referenceFilter->SetInput(input);
+  treeFilter->UseComponentTreeOn();
+  referenceFilter->UseComponentTreeOff();
+
+  for (typename TProfileFilter::Pointer filter : {treeFilter, referenceFilter})
+  {
+    filter->SetProfileSize(profileSize);
+    filter->SetInitialValue(initialValue);
+    filter->SetStep(step);
+    filter->Update();
+  }
+
+  bool ok = true;
+  for (unsigned int i = 0; i < profileSize; ++i)
+  {
+    itk::ImageRegionConstIterator<TImage> treeIt(treeFilter->GetOutput()->GetNthElement(i), input->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<TImage> refIt(referenceFilter->GetOutput()->GetNthElement(i), input->GetLargestPossibleRegion());
+    unsigned long nbDifferences = 0;
+    for (treeIt.GoToBegin(), refIt.GoToBegin(); !treeIt.IsAtEnd(); ++treeIt, ++refIt)
+    {
+      if (treeIt.Get() != refIt.Get())
+      {
+        ++nbDifferences;
+      }
+    }
+    if (nbDifferences > 0)
+    {
+      std::cerr << treeFilter->GetNameOfClass() << " level " << i << ": " << nbDifferences << " pixels differ" << std::endl;
+      ok = false;
+    }
+  }
+  return ok;
+}
+}
+
+int otbReconstructionProfileFilterComponentTree(int itkNotUsed(argc), char* argv[])
+{
+  const char*        inputFilename = argv[1];
+  const unsigned int profileSize   = atoi(argv[2]);
+  const unsigned int initialValue  = atoi(argv[3]);
+  const unsigned int step          = atoi(argv[4]);
+
+  const unsigned int Dimension = 2;
+  typedef double     PixelType;
+
+  typedef otb::Image<PixelType, Dimension>                                                     ImageType;
+  typedef otb::ImageFileReader<ImageType>                                                      ReaderType;
+  typedef itk::BinaryBallStructuringElement<PixelType, Dimension>                              StructuringElementType;
+  typedef otb::MorphologicalOpeningProfileFilter<ImageType, ImageType, StructuringElementType> OpeningProfileFilterType;
+  typedef otb::MorphologicalClosingProfileFilter<ImageType, ImageType, StructuringElementType> ClosingProfileFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+  reader->Update();
+
+  bool ok = CheckProfile<OpeningProfileFilterType>(reader->GetOutput(), profileSize, initialValue, step);
+  ok      = CheckProfile<ClosingProfileFilterType>(reader->GetOutput(), profileSize, initialValue, step) && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
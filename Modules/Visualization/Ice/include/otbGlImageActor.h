@@ -305,6 +305,9 @@ private:
   RSTransformType::Pointer m_ViewportToImageTransform;
   RSTransformType::Pointer m_ImageToViewportTransform;
 
+  // Image metadata used by the two transforms above
+  ImageCommons::ImageMetadataConstPointerType m_ImageMetadata;
+
   RigidTransformType::Pointer m_ViewportForwardRotationTransform;
   RigidTransformType::Pointer m_ViewportBackwardRotationTransform;
 
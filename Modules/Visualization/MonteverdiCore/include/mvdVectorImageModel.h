@@ -299,6 +299,9 @@ private:
   //  Generic RS Transform to get lat/long coordinates
   otb::GenericRSTransform<>::Pointer m_ToWgs84;
 
+  //  Image metadata used by m_ToWgs84
+  otb::ImageCommons::ImageMetadataConstPointerType m_ImageMetadata;
+
   /*-[ PRIVATE SLOTS SECTION ]-----------------------------------------------*/
 
   //
@@ -41,6 +41,8 @@
 
 #include "otbWrapperAddProcessToWatchEvent.h"
 #include "otbExtendedFilenameToWriterOptions.h"
+#include "otbPipelineProfiler.h"
+#include "otbConfigurationManager.h"
 
 #include "otbCast.h"
 #include "otbMacro.h"
@@ -957,7 +959,48 @@ int Application::ExecuteAndWriteOutput()
 
   if (status == 0)
   {
-    this->WriteOutput();
+    PipelineProfiler* profiler = PipelineProfiler::Instance();
+    if (profiler->GetEnabled())
+    {
+      profiler->Reset();
+      for (auto const& key : GetParametersKeys(true))
+      {
+        if (GetParameterType(key) == ParameterType_OutputImage && IsParameterEnabled(key) && HasValue(key))
+        {
+          profiler->Watch(GetParameterOutputImage(key));
+        }
+      }
+    }
+
+    try
+    {
+      this->WriteOutput();
+    }
+    catch (...)
+    {
+      profiler->Unwatch();
+      throw;
+    }
+
+    if (profiler->GetEnabled())
+    {
+      profiler->Unwatch();
+      std::ostringstream summary;
+      profiler->PrintSummary(summary);
+      otbAppLogINFO("Pipeline profile:\n" << summary.str());
+      const std::string traceFile = ConfigurationManager::GetProfilerTraceFile();
+      if (!traceFile.empty())
+      {
+        if (profiler->WriteTrace(traceFile))
+        {
+          otbAppLogINFO("Pipeline profile trace written to " << traceFile);
+        }
+        else
+        {
+          otbAppLogWARNING("Could not write the pipeline profile trace to " << traceFile);
+        }
+      }
+    }
   }
 
   this->AfterExecuteAndWriteOutputs();
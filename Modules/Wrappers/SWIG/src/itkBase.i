@@ -169,6 +169,8 @@ public:
 
 } // end of namespace itk
 
+%template(vectorregion) std::vector< itk::ImageRegion<2> >;
+
 #if SWIGPYTHON
 
 %define WRAP_AS_LIST(N, T...)
@@ -42,6 +42,40 @@
 import_array();
 %}
 
+%{
+/** Hand the buffer of a streamed region over to a new image, so that it
+ * survives the computation of the next region. The output of the pipeline
+ * will allocate a new buffer. If the output buffered more than the requested
+ * region, the requested region is copied instead. */
+template <class TImage>
+itkLightObject_Pointer DetachImageRegion(ImageBaseType* img, const itk::ImageRegion<2>& region, typename TImage::InternalPixelType** buffer)
+{
+  TImage* imgDown = dynamic_cast<TImage*>(img);
+  if (!imgDown)
+    {
+    std::cerr << "Image type doesn't match" << std::endl;
+    return nullptr;
+    }
+  typename TImage::Pointer holder = TImage::New();
+  holder->SetNumberOfComponentsPerPixel(imgDown->GetNumberOfComponentsPerPixel());
+  if (imgDown->GetBufferedRegion() == region)
+    {
+    holder->Graft(imgDown);
+    imgDown->SetPixelContainer(TImage::PixelContainer::New());
+    imgDown->SetBufferedRegion(itk::ImageRegion<2>());
+    }
+  else
+    {
+    holder->CopyInformation(imgDown);
+    holder->SetRegions(region);
+    holder->Allocate();
+    itk::ImageAlgorithm::Copy(imgDown, holder.GetPointer(), region, region);
+    }
+  *buffer = holder->GetBufferPointer();
+  return holder.GetPointer();
+}
+%}
+
 /*leave the mess to SWIG and let us not worry.*/
 %apply (signed char* INPLACE_ARRAY3, int DIM1, int DIM2, int DIM3) {(signed char* buffer, int dim1, int dim2, int dim3)};
 %apply (signed short* INPLACE_ARRAY3, int DIM1, int DIM2, int DIM3) {(signed short* buffer, int dim1, int dim2, int dim3)};
@@ -484,6 +518,73 @@ public:
   // CInt16 and CInt32 are not supported in Numpy
 #undef GetVectorImageAsNumpyArrayMacro
 
+  std::vector< itk::ImageRegion<2> > GetImageStreamingRegions_(std::string pkey, unsigned int ram)
+    {
+    typedef otb::RAMDrivenAdaptativeStreamingManager<otb::Wrapper::FloatVectorImageType> StreamingManagerType;
+    ImageBaseType *img = $self->GetParameterOutputImage(pkey);
+    img->UpdateOutputInformation();
+    ImageBaseType::RegionType largest = img->GetLargestPossibleRegion();
+    StreamingManagerType::Pointer streamingManager = StreamingManagerType::New();
+    streamingManager->SetAvailableRAMInMB(ram);
+    streamingManager->PrepareStreaming(img, largest);
+    std::vector< itk::ImageRegion<2> > regions;
+    for (unsigned int i = 0; i < streamingManager->GetNumberOfSplits(); ++i)
+      {
+      // Regions are given relative to the largest possible region
+      ImageBaseType::RegionType split = streamingManager->GetSplit(i);
+      split.SetIndex(0, split.GetIndex(0) - largest.GetIndex(0));
+      split.SetIndex(1, split.GetIndex(1) - largest.GetIndex(1));
+      regions.push_back(split);
+      }
+    return regions;
+    }
+
+  void ResetImageRequestedRegion_(std::string pkey)
+    {
+    $self->GetParameterOutputImage(pkey)->SetRequestedRegionToLargestPossibleRegion();
+    }
+
+#define GetVectorImageRegionAsNumpyArrayMacro(suffix, TPixel)                   \
+  itkLightObject_Pointer GetVectorImageRegionAs##suffix##NumpyArray_            \
+    (std::string pkey, itk::ImageRegion<2> region, ##TPixel##** buffer, int *dim1, int *dim2, int *dim3) \
+    {                                                                           \
+    *buffer = nullptr;                                                          \
+    ImageBaseType *img = $self->GetParameterOutputImage(pkey);                  \
+    ImageBaseType::RegionType largest = img->GetLargestPossibleRegion();        \
+    region.SetIndex(0, region.GetIndex(0) + largest.GetIndex(0));               \
+    region.SetIndex(1, region.GetIndex(1) + largest.GetIndex(1));               \
+    img->SetRequestedRegion(region);                                            \
+    img->PropagateRequestedRegion();                                            \
+    img->UpdateOutputData();                                                    \
+    unsigned int nbComp = img->GetNumberOfComponentsPerPixel();                 \
+    *dim1 = region.GetSize(1);                                                  \
+    *dim2 = region.GetSize(0);                                                  \
+    *dim3 = nbComp;                                                             \
+    std::string className(img->GetNameOfClass());                               \
+    if (className == "VectorImage")                                             \
+      {                                                                         \
+      return DetachImageRegion< otb::VectorImage<##TPixel##,2> >(img, region, buffer); \
+      }                                                                         \
+    else if (nbComp == 1)                                                       \
+      {                                                                         \
+      return DetachImageRegion< otb::Image<##TPixel##,2> >(img, region, buffer); \
+      }                                                                         \
+    std::cerr << "Unhandled number of components in otb::Image (RGB<T> "        \
+        "and RGBA<T> not supported yet)" << std::endl;                          \
+    return nullptr;                                                             \
+    }
+
+  GetVectorImageRegionAsNumpyArrayMacro(UInt8, unsigned char)
+  GetVectorImageRegionAsNumpyArrayMacro(Int16,signed short);
+  GetVectorImageRegionAsNumpyArrayMacro(UInt16,unsigned short);
+  GetVectorImageRegionAsNumpyArrayMacro(Int32,signed int);
+  GetVectorImageRegionAsNumpyArrayMacro(UInt32,unsigned int);
+  GetVectorImageRegionAsNumpyArrayMacro(Float,float);
+  GetVectorImageRegionAsNumpyArrayMacro(Double,double);
+  GetVectorImageRegionAsNumpyArrayMacro(CFloat,std::complex<float> );
+  GetVectorImageRegionAsNumpyArrayMacro(CDouble,std::complex<double> );
+#undef GetVectorImageRegionAsNumpyArrayMacro
+
   std::string ConvertPixelTypeToNumpy(otb::Wrapper::ImagePixelType pixType)
     {
     std::ostringstream oss;
@@ -780,6 +881,18 @@ class ApplicationProxy(object):
 
 #if OTB_SWIGNUMPY
 
+%pythoncode {
+import numpy
+
+class ImageRegionArray(numpy.ndarray):
+  """
+  Numpy view on a streamed image region. The view holds the OTB buffer it
+  points to, so the buffer lives as long as the view, or any view derived
+  from it.
+  """
+  pass
+}
+
 %extend Application
 {
   %pythoncode
@@ -795,6 +908,17 @@ class ApplicationProxy(object):
       ImagePixelType_cfloat : GetVectorImageAsCFloatNumpyArray_,
       ImagePixelType_cdouble : GetVectorImageAsCDoubleNumpyArray_,
       }
+    NumpyRegionExporterMap = {
+      ImagePixelType_uint8 : GetVectorImageRegionAsUInt8NumpyArray_,
+      ImagePixelType_int16 : GetVectorImageRegionAsInt16NumpyArray_,
+      ImagePixelType_uint16 : GetVectorImageRegionAsUInt16NumpyArray_,
+      ImagePixelType_int32 : GetVectorImageRegionAsInt32NumpyArray_,
+      ImagePixelType_uint32 : GetVectorImageRegionAsUInt32NumpyArray_,
+      ImagePixelType_float : GetVectorImageRegionAsFloatNumpyArray_,
+      ImagePixelType_double : GetVectorImageRegionAsDoubleNumpyArray_,
+      ImagePixelType_cfloat : GetVectorImageRegionAsCFloatNumpyArray_,
+      ImagePixelType_cdouble : GetVectorImageRegionAsCDoubleNumpyArray_,
+      }
     ImageImporterMap = {
       ImagePixelType_uint8 : SetImageFromUInt8NumpyArray_,
       ImagePixelType_int16 : SetImageFromInt16NumpyArray_,
@@ -886,6 +1010,84 @@ class ApplicationProxy(object):
       pixT = self.GetImageBasePixelType(paramKey)
       return self.NumpyExporterMap[pixT](self,paramKey)
 
+    def GetVectorImageRegionAsNumpyArray(self, paramKey, region):
+      """
+      This function computes a region of an output image parameter and
+      retrieves it as a Numpy array, without copy. The region is given
+      relative to the largest possible region of the image, as in
+      PropagateRequestedRegion. Only the pipeline needed for this region is
+      executed.
+      NOTE: This method always return an numpy array with 3 dimensions
+      """
+      pixT = self.GetImageBasePixelType(paramKey)
+      holder, array = self.NumpyRegionExporterMap[pixT](self, paramKey, region)
+      view = array.view(ImageRegionArray)
+      view.otbBuffer = holder
+      return view
+
+    def IterVectorImageAsNumpyArray(self, paramKey, ram=0, prefetch=False):
+      """
+      This generator streams an output image parameter: it yields the pairs
+      (region, array) of the regions chosen by the RAM driven streaming
+      manager, in order, each array being a Numpy view on the computed region
+      (see GetVectorImageRegionAsNumpyArray). The optional parameter ram is the
+      available RAM in MB (the configuration option is used when it is 0).
+      When prefetch is True, the next region is computed in a background
+      thread while the current one is consumed. The GIL is released during
+      the computation, so this pays off whenever the consumer spends time in
+      code that also releases it (Numpy, most ML frameworks, I/O).
+      """
+      regions = self.GetImageStreamingRegions_(paramKey, ram)
+      worker = None
+      try:
+        if not prefetch:
+          for region in regions:
+            yield region, self.GetVectorImageRegionAsNumpyArray(paramKey, region)
+          return
+        import threading
+        def compute(region, result):
+          try:
+            result.append(self.GetVectorImageRegionAsNumpyArray(paramKey, region))
+          except Exception as e:
+            result.append(e)
+        result = []
+        for i, region in enumerate(regions):
+          if worker is None:
+            compute(region, result)
+          else:
+            worker.join()
+            worker = None
+          array = result.pop()
+          if isinstance(array, Exception):
+            raise array
+          if i + 1 < len(regions):
+            worker = threading.Thread(target=compute, args=(regions[i + 1], result))
+            worker.start()
+          yield region, array
+      finally:
+        if worker is not None:
+          worker.join()
+        self.ResetImageRequestedRegion_(paramKey)
+
+    def StreamVectorImageThroughFunction(self, paramKey, function, output=None, ram=0, prefetch=True):
+      """
+      This function streams an output image parameter through a Python
+      callable, used as the last stage of the pipeline. The callable receives
+      the Numpy view of each region (see IterVectorImageAsNumpyArray) and
+      returns an array with the same number of rows and columns, or None.
+      When output is given (a Numpy array, possibly a numpy.memmap, with the
+      size of the image), each result is written in the matching rows and
+      columns of output. The next region is computed while the callable runs
+      unless prefetch is False. Returns output.
+      """
+      for region, array in self.IterVectorImageAsNumpyArray(paramKey, ram, prefetch):
+        res = function(array)
+        if output is not None and res is not None:
+          x0 = region.GetIndex()[0]
+          y0 = region.GetIndex()[1]
+          output[y0:y0 + array.shape[0], x0:x0 + array.shape[1], ...] = res
+      return output
+
     def GetImageAsNumpyArray(self, paramKey, dt='float'):
       """
       This function retrieves an output image parameter as a Numpy array.
@@ -25,6 +25,8 @@
 #include "otbWrapperAddProcessToWatchEvent.h"
 #include "otbWrapperDocExampleStructure.h"
 #include "otbWrapperMetaDataHelper.h"
+#include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "itkImageAlgorithm.h"
 
 typedef otb::Wrapper::Application            Application;
 typedef otb::Wrapper::Application::Pointer   Application_Pointer;
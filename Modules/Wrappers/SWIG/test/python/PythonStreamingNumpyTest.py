@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+#-*- coding: utf-8 -*-
+#
+# Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+#
+# This file is part of Orfeo Toolbox
+#
+#     https://www.orfeo-toolbox.org/
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import numpy as np
+
+def test(otb, argv):
+  app = otb.Registry.CreateApplication("Smoothing")
+  app.SetParameterString("in", argv[1])
+  app.SetParameterString("type", "mean")
+  app.Execute()
+
+  reference = np.copy(app.GetVectorImageAsNumpyArray("out"))
+
+  # Stream the output with a tiny amount of RAM, so that it is split
+  for prefetch in [False, True]:
+    streamed = np.zeros(reference.shape, reference.dtype)
+    nbRegions = 0
+    for region, array in app.IterVectorImageAsNumpyArray("out", 1, prefetch):
+      x0 = region.GetIndex()[0]
+      y0 = region.GetIndex()[1]
+      streamed[y0:y0 + array.shape[0], x0:x0 + array.shape[1], :] = array
+      nbRegions += 1
+    if nbRegions < 2:
+      raise RuntimeError("Output image was not split")
+    if not np.array_equal(streamed, reference):
+      raise RuntimeError("Streamed output differs from the full output (prefetch=" + str(prefetch) + ")")
+
+  # Keep views of all the regions alive and check them afterwards
+  views = list(app.IterVectorImageAsNumpyArray("out", 1, True))
+  for region, array in views:
+    x0 = region.GetIndex()[0]
+    y0 = region.GetIndex()[1]
+    if not np.array_equal(array, reference[y0:y0 + array.shape[0], x0:x0 + array.shape[1], :]):
+      raise RuntimeError("Region view was overwritten")
+
+  # Python callable as the last stage of the pipeline
+  output = np.zeros(reference.shape[:2], np.float64)
+  app.StreamVectorImageThroughFunction("out", lambda a: a.sum(axis=2), output, 1)
+  if not np.allclose(output, reference.sum(axis=2)):
+    raise RuntimeError("Streamed function output differs from the expected one")
+
+  # The full output is still available afterwards
+  if not np.array_equal(app.GetVectorImageAsNumpyArray("out"), reference):
+    raise RuntimeError("Full output changed after streaming")